@@ -134,6 +134,10 @@ void Actions::createActions(App * app)
                               tr("Export database as SQL"), this);
     _exportDatabase->setStatusTip(tr("Dump database objects to an SQL file"));
 
+    _importCSV = new QAction(QIcon(":/icons/page_excel.png"),
+                             tr("Import CSV file..."), this);
+    _importCSV->setStatusTip(tr("Load rows of a CSV file into the table"));
+
     // -------------------------------------------------------------------------
 
     _preferences = new QAction(QIcon(":/icons/wrench_orange.png"),
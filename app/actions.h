@@ -40,6 +40,7 @@ public:
     QAction * logClear() const { return _logClear; }
 
     QAction * exportDatabase() const { return _exportDatabase; }
+    QAction * importCSV() const { return _importCSV; }
 
     QAction * preferences() const { return _preferences; }
 
@@ -67,6 +68,7 @@ private:
     QAction * _logClear;
 
     QAction * _exportDatabase;
+    QAction * _importCSV;
     QAction * _preferences;
 };
 
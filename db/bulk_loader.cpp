@@ -0,0 +1,138 @@
+#include "bulk_loader.h"
+#include "connection.h"
+#include "helpers/logger.h"
+
+namespace meow {
+namespace db {
+
+BulkLoader::BulkLoader(Connection * connection,
+                       const QString & quotedTable,
+                       const QStringList & columns)
+    : _connection(connection)
+    , _quotedTable(quotedTable)
+    , _columns(columns)
+    , _bufferedRowsCount(0)
+    , _isInTransaction(false)
+{
+
+}
+
+BulkLoader::~BulkLoader()
+{
+    if (_isInTransaction) {
+        try {
+            rollback();
+        } catch(meow::db::Exception & ex) {
+            meowLogCC(Log::Category::Error, _connection)
+                << "Rollback of bulk load failed: " << ex.message();
+        }
+    }
+}
+
+void BulkLoader::begin()
+{
+    // one transaction is faster than commit per portion
+    // and keeps table untouched if loading fails
+    _connection->query("BEGIN");
+    _isInTransaction = true;
+}
+
+void BulkLoader::commit()
+{
+    _isInTransaction = false;
+    _connection->query("COMMIT");
+}
+
+void BulkLoader::rollback()
+{
+    _isInTransaction = false;
+    clearBuffer();
+    _connection->query("ROLLBACK");
+}
+
+void BulkLoader::addRow(const QStringList & values)
+{
+    Q_ASSERT(values.size() == _columns.size());
+
+    if (_bufferedRowsCount > 0) {
+        _buffer += ',';
+    }
+    _buffer += '(';
+
+    for (int i = 0; i < values.size(); ++i) {
+        if (i > 0) {
+            _buffer += ',';
+        }
+        if (values[i].isNull()) {
+            _buffer += QLatin1String("NULL");
+        } else {
+            _buffer += _connection->escapeString(values[i]);
+        }
+    }
+
+    _buffer += ')';
+    ++_bufferedRowsCount;
+}
+
+BulkLoader::FlushResult BulkLoader::flush()
+{
+    if (_bufferedRowsCount == 0) {
+        return {};
+    }
+
+    QString SQL = "INSERT INTO " + _quotedTable + " (" + quotedColumns()
+            + ") VALUES " + _buffer;
+    clearBuffer();
+
+    _connection->query(SQL);
+
+    return {};
+}
+
+QString BulkLoader::quotedColumns() const
+{
+    return _connection->quoteIdentifiers(_columns).join(", ");
+}
+
+void BulkLoader::appendTextRow(const QStringList & values)
+{
+    for (int i = 0; i < values.size(); ++i) {
+        if (i > 0) {
+            _buffer += '\t';
+        }
+        const QString & value = values[i];
+        if (value.isNull()) {
+            _buffer += QLatin1String("\\N");
+            continue;
+        }
+        for (const QChar & c : value) {
+            switch (c.unicode()) {
+            case '\\':
+                _buffer += QLatin1String("\\\\");
+                break;
+            case '\t':
+                _buffer += QLatin1String("\\t");
+                break;
+            case '\n':
+                _buffer += QLatin1String("\\n");
+                break;
+            case '\r':
+                _buffer += QLatin1String("\\r");
+                break;
+            default:
+                _buffer += c;
+            }
+        }
+    }
+    _buffer += '\n';
+    ++_bufferedRowsCount;
+}
+
+void BulkLoader::clearBuffer()
+{
+    _buffer.clear();
+    _bufferedRowsCount = 0;
+}
+
+} // namespace db
+} // namespace meow
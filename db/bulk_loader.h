@@ -0,0 +1,75 @@
+#ifndef DB_BULK_LOADER_H
+#define DB_BULK_LOADER_H
+
+#include <vector>
+#include <QStringList>
+#include "common.h"
+
+namespace meow {
+namespace db {
+
+class Connection;
+
+// Intent: loads many rows into table by portions inside one transaction.
+// Generic loader sends a multi-row INSERT per portion, connections override
+// it with the fastest path of their server.
+class BulkLoader
+{
+public:
+
+    // Problem with a row of flushed portion
+    struct Issue
+    {
+        int row; // from 0 in portion, -1 if unknown
+        QString message;
+        bool isRejected; // or loaded with changed values
+    };
+
+    // Outcome of flushed portion
+    struct FlushResult
+    {
+        db::ulonglong rejectedCount = 0; // rows not loaded
+        db::ulonglong warningsCount = 0; // of loaded rows, e.g. changed values
+        std::vector<Issue> issues; // may be only first ones of counts
+    };
+
+    BulkLoader(Connection * connection,
+               const QString & quotedTable,
+               const QStringList & columns);
+    virtual ~BulkLoader();
+
+    virtual void begin();
+    virtual void commit();
+    virtual void rollback();
+
+    // Buffers row, values go in columns order, null QString is NULL
+    virtual void addRow(const QStringList & values);
+
+    // Sends buffered rows, throws if whole portion failed
+    virtual FlushResult flush();
+
+    int bufferedRowsCount() const { return _bufferedRowsCount; }
+    int bufferSize() const { return _buffer.size(); } // chars
+
+protected:
+
+    QString quotedColumns() const;
+
+    // Tab-separated line with \N as NULL, format of both
+    // LOAD DATA and COPY in text mode
+    void appendTextRow(const QStringList & values);
+
+    void clearBuffer();
+
+    Connection * _connection;
+    const QString _quotedTable;
+    const QStringList _columns;
+    QString _buffer;
+    int _bufferedRowsCount;
+    bool _isInTransaction;
+};
+
+} // namespace db
+} // namespace meow
+
+#endif // DB_BULK_LOADER_H
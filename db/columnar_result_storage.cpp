@@ -0,0 +1,378 @@
+#include "columnar_result_storage.h"
+#include <algorithm>
+#include <iterator>
+#include <QtNumeric>
+
+namespace meow {
+namespace db {
+
+ColumnarResultStorage::Batch::Batch(std::size_t columnCount,
+                                    std::size_t reserveRows)
+    : _columns(columnCount)
+    , _dataSize(0)
+{
+    for (Column & column : _columns) {
+        column.offsets.reserve(reserveRows + 1);
+        column.offsets.push_back(0);
+        column.validity.reserve(reserveRows / 8 + 1);
+    }
+}
+
+void ColumnarResultStorage::Batch::appendUtf8(std::size_t column,
+                                              const char * data,
+                                              int length)
+{
+    Column & col = _columns[column];
+
+    bool isAscii = true;
+    for (int i = 0; i < length; ++i) {
+        if (static_cast<unsigned char>(data[i]) >= 0x80) {
+            isAscii = false;
+            break;
+        }
+    }
+
+    if (isAscii) { // most of cells (numbers, dates etc), no temp strings
+        appendLatin1(column, data, length);
+        return;
+    }
+
+    // TODO: non-unicode support?
+    col.data.append(QString::fromUtf8(data, length));
+    _dataSize += static_cast<std::size_t>(col.data.size()
+                 - col.offsets.back()) * sizeof(QChar);
+    finishCell(col, false);
+}
+
+void ColumnarResultStorage::Batch::appendLatin1(std::size_t column,
+                                                const char * data,
+                                                int length)
+{
+    Column & col = _columns[column];
+
+    int begin = col.data.size();
+    col.data.resize(begin + length);
+    QChar * dest = col.data.data() + begin;
+    for (int i = 0; i < length; ++i) {
+        dest[i] = QChar(static_cast<unsigned char>(data[i]));
+    }
+    _dataSize += static_cast<std::size_t>(length) * sizeof(QChar);
+
+    finishCell(col, false);
+}
+
+void ColumnarResultStorage::Batch::appendNull(std::size_t column)
+{
+    finishCell(_columns[column], true);
+}
+
+void ColumnarResultStorage::Batch::appendInteger(std::size_t column,
+                                                 qint64 value)
+{
+    appendInteger(column, QString::number(value), value);
+}
+
+void ColumnarResultStorage::Batch::appendFloat(std::size_t column,
+                                               double value,
+                                               int precision)
+{
+    QString text;
+    if (qIsNaN(value)) {
+        text = QStringLiteral("NaN");
+    } else if (qIsInf(value)) {
+        text = value > 0 ? QStringLiteral("Infinity")
+                         : QStringLiteral("-Infinity");
+    } else {
+        text = QString::number(value, 'g', precision);
+    }
+    appendFloat(column, text, value);
+}
+
+void ColumnarResultStorage::Batch::appendInteger(std::size_t column,
+                                                 const QString & text,
+                                                 qint64 value)
+{
+    Column & col = _columns[column];
+    std::size_t row = col.offsets.size() - 1;
+    col.integers.resize(row, 0); // previous NULLs
+    col.integers.push_back(value);
+    _dataSize += (col.integers.size() - row) * sizeof(qint64);
+    appendText(col, text);
+}
+
+void ColumnarResultStorage::Batch::appendFloat(std::size_t column,
+                                               const QString & text,
+                                               double value)
+{
+    Column & col = _columns[column];
+    std::size_t row = col.offsets.size() - 1;
+    col.floats.resize(row, 0.0); // previous NULLs
+    col.floats.push_back(value);
+    _dataSize += (col.floats.size() - row) * sizeof(double);
+    appendText(col, text);
+}
+
+void ColumnarResultStorage::Batch::appendText(Column & column,
+                                              const QString & text)
+{
+    column.data.append(text);
+    _dataSize += static_cast<std::size_t>(text.size()) * sizeof(QChar);
+    finishCell(column, false);
+}
+
+void ColumnarResultStorage::Batch::finishCell(Column & column, bool isNull)
+{
+    std::size_t row = column.offsets.size() - 1;
+    if (row % 8 == 0) {
+        column.validity.push_back(0);
+        _dataSize += 1;
+    }
+    if (!isNull) {
+        column.validity.back() |= static_cast<unsigned char>(1 << (row % 8));
+    }
+    column.offsets.push_back(column.data.size());
+    _dataSize += sizeof(int);
+}
+
+ColumnarResultStorage::ColumnarResultStorage()
+    : _rowCount(0)
+    , _dataSize(0)
+    , _columnCount(0)
+    , _lastChunkIndex(0)
+{
+
+}
+
+void ColumnarResultStorage::addBatch(Batch && batch)
+{
+    Q_ASSERT(batch.columnCount() == _columnCount);
+
+    std::size_t batchRowCount = batch.rowCount();
+    if (batchRowCount == 0) {
+        return;
+    }
+
+    for (Batch::Column & column : batch._columns) {
+        column.data.squeeze();
+        column.integers.shrink_to_fit();
+        column.floats.shrink_to_fit();
+    }
+
+    _chunkFirstRows.push_back(_rowCount);
+    _rowCount += batchRowCount;
+    _dataSize += batch.dataSize();
+    _chunks.emplace_back(new Batch(std::move(batch)));
+}
+
+void ColumnarResultStorage::append(ColumnarResultStorage && other)
+{
+    Q_ASSERT(other._columnCount == _columnCount);
+
+    for (std::size_t i = 0; i < other._chunks.size(); ++i) {
+        _chunkFirstRows.push_back(_rowCount);
+        _rowCount += other.chunkRowCount(i);
+        _chunks.push_back(std::move(other._chunks[i]));
+    }
+    _dataSize += other._dataSize;
+
+    other.clear();
+}
+
+void ColumnarResultStorage::releaseRows(db::ulonglong firstRow,
+                                        db::ulonglong count)
+{
+    if (count == 0) {
+        return;
+    }
+
+    Q_ASSERT(firstRow + count <= _rowCount);
+
+    std::size_t first = chunkIndexForRow(firstRow);
+    std::size_t last = chunkIndexForRow(firstRow + count - 1);
+
+    Q_ASSERT(_chunkFirstRows[first] == firstRow);
+    Q_ASSERT(last + 1 == _chunks.size()
+             || _chunkFirstRows[last + 1] == firstRow + count);
+
+    for (std::size_t i = first; i <= last; ++i) {
+        if (_chunks[i]) {
+            _dataSize -= _chunks[i]->dataSize();
+        }
+    }
+
+    // one empty chunk for the whole range
+    _chunks.erase(_chunks.begin() + first + 1, _chunks.begin() + last + 1);
+    _chunkFirstRows.erase(_chunkFirstRows.begin() + first + 1,
+                          _chunkFirstRows.begin() + last + 1);
+    _chunks[first].reset();
+    _lastChunkIndex = first;
+}
+
+void ColumnarResultStorage::replaceRows(db::ulonglong firstRow,
+                                        ColumnarResultStorage && other)
+{
+    Q_ASSERT(other._columnCount == _columnCount);
+
+    std::size_t index = chunkIndexForRow(firstRow);
+    db::ulonglong count = chunkRowCount(index);
+
+    Q_ASSERT(_chunks[index] == nullptr && _chunkFirstRows[index] == firstRow);
+    Q_ASSERT(other._rowCount <= count);
+
+    if (other._rowCount < count) { // e.g. rows were deleted since release
+        std::size_t missingCount
+                = static_cast<std::size_t>(count - other._rowCount);
+        Batch nulls(_columnCount, missingCount);
+        for (std::size_t row = 0; row < missingCount; ++row) {
+            for (std::size_t column = 0; column < _columnCount; ++column) {
+                nulls.appendNull(column);
+            }
+        }
+        other.addBatch(std::move(nulls));
+    }
+
+    std::vector<db::ulonglong> firstRows;
+    db::ulonglong row = firstRow;
+    for (std::size_t i = 0; i < other._chunks.size(); ++i) {
+        firstRows.push_back(row);
+        row += other.chunkRowCount(i);
+    }
+
+    _chunks.erase(_chunks.begin() + index);
+    _chunkFirstRows.erase(_chunkFirstRows.begin() + index);
+    _chunks.insert(_chunks.begin() + index,
+                   std::make_move_iterator(other._chunks.begin()),
+                   std::make_move_iterator(other._chunks.end()));
+    _chunkFirstRows.insert(_chunkFirstRows.begin() + index,
+                           firstRows.begin(), firstRows.end());
+    _dataSize += other._dataSize;
+    _lastChunkIndex = index;
+
+    other.clear();
+}
+
+bool ColumnarResultStorage::isRowReleased(db::ulonglong row) const
+{
+    std::size_t localRow = 0;
+    return chunkForRow(row, &localRow) == nullptr;
+}
+
+bool ColumnarResultStorage::isNull(db::ulonglong row,
+                                   std::size_t column) const
+{
+    std::size_t localRow = 0;
+    const Batch * chunk = chunkForRow(row, &localRow);
+    if (chunk == nullptr) {
+        return true;
+    }
+    const Batch::Column & col = chunk->_columns[column];
+    return (col.validity[localRow / 8] & (1 << (localRow % 8))) == 0;
+}
+
+QStringRef ColumnarResultStorage::cellRef(db::ulonglong row,
+                                          std::size_t column) const
+{
+    std::size_t localRow = 0;
+    const Batch * chunk = chunkForRow(row, &localRow);
+    if (chunk == nullptr) {
+        return QStringRef();
+    }
+    const Batch::Column & col = chunk->_columns[column];
+    int begin = col.offsets[localRow];
+    return QStringRef(&col.data, begin, col.offsets[localRow + 1] - begin);
+}
+
+QString ColumnarResultStorage::cell(db::ulonglong row,
+                                    std::size_t column) const
+{
+    if (isNull(row, column)) {
+        return QString();
+    }
+    QStringRef ref = cellRef(row, column);
+    if (ref.isEmpty()) {
+        return QString(QLatin1String("")); // empty, but not null
+    }
+    return ref.toString();
+}
+
+bool ColumnarResultStorage::integerValue(db::ulonglong row,
+                                         std::size_t column,
+                                         qint64 * value) const
+{
+    std::size_t localRow = 0;
+    const Batch * chunk = chunkForRow(row, &localRow);
+    if (chunk == nullptr) {
+        return false;
+    }
+    const Batch::Column & col = chunk->_columns[column];
+    if (localRow >= col.integers.size()
+            || (col.validity[localRow / 8] & (1 << (localRow % 8))) == 0) {
+        return false;
+    }
+    *value = col.integers[localRow];
+    return true;
+}
+
+bool ColumnarResultStorage::floatValue(db::ulonglong row,
+                                       std::size_t column,
+                                       double * value) const
+{
+    std::size_t localRow = 0;
+    const Batch * chunk = chunkForRow(row, &localRow);
+    if (chunk == nullptr) {
+        return false;
+    }
+    const Batch::Column & col = chunk->_columns[column];
+    if (localRow >= col.floats.size()
+            || (col.validity[localRow / 8] & (1 << (localRow % 8))) == 0) {
+        return false;
+    }
+    *value = col.floats[localRow];
+    return true;
+}
+
+void ColumnarResultStorage::clear()
+{
+    _chunks.clear();
+    _chunkFirstRows.clear();
+    _rowCount = 0;
+    _dataSize = 0;
+    _lastChunkIndex = 0;
+}
+
+const ColumnarResultStorage::Batch * ColumnarResultStorage::chunkForRow(
+        db::ulonglong row, std::size_t * localRow) const
+{
+    std::size_t index = chunkIndexForRow(row);
+    *localRow = static_cast<std::size_t>(row - _chunkFirstRows[index]);
+    return _chunks[index].get();
+}
+
+std::size_t ColumnarResultStorage::chunkIndexForRow(db::ulonglong row) const
+{
+    Q_ASSERT(row < _rowCount);
+
+    std::size_t index = _lastChunkIndex;
+
+    if (index >= _chunks.size()
+            || row < _chunkFirstRows[index]
+            || row >= _chunkFirstRows[index] + chunkRowCount(index)) {
+        auto it = std::upper_bound(_chunkFirstRows.begin(),
+                                   _chunkFirstRows.end(),
+                                   row);
+        index = static_cast<std::size_t>(it - _chunkFirstRows.begin()) - 1;
+        _lastChunkIndex = index;
+    }
+
+    return index;
+}
+
+db::ulonglong ColumnarResultStorage::chunkRowCount(std::size_t index) const
+{
+    db::ulonglong nextFirstRow = (index + 1 < _chunkFirstRows.size())
+            ? _chunkFirstRows[index + 1] : _rowCount;
+    return nextFirstRow - _chunkFirstRows[index];
+}
+
+} // namespace db
+} // namespace meow
@@ -0,0 +1,125 @@
+#ifndef DB_COLUMNAR_RESULT_STORAGE_H
+#define DB_COLUMNAR_RESULT_STORAGE_H
+
+#include <memory>
+#include <vector>
+#include <QLocale>
+#include <QString>
+#include "common.h"
+
+namespace meow {
+namespace db {
+
+// Intent: keeps query result data decoded once and column by column.
+// Rows are added in batches, every batch has one UTF-16 buffer, cell offsets
+// and validity (not null) bitmap per column. Added batches are never changed,
+// so cells are referenced without any conversion.
+// Columns of numbers decoded from binary results also keep typed values,
+// so sorting doesn't parse text back.
+// Rows of added batches may be released to free memory and put back later,
+// numbers of rows stay the same, released rows read as NULL.
+class ColumnarResultStorage
+{
+public:
+
+    // Rows to be added to storage, filled row by row and cell by cell
+    class Batch
+    {
+    public:
+        explicit Batch(std::size_t columnCount = 0,
+                       std::size_t reserveRows = 0);
+
+        void appendUtf8(std::size_t column, const char * data, int length);
+        void appendLatin1(std::size_t column, const char * data, int length);
+        void appendNull(std::size_t column);
+        // text of cell is made from value
+        void appendInteger(std::size_t column, qint64 value);
+        void appendFloat(std::size_t column, double value,
+                         int precision = QLocale::FloatingPointShortest);
+        // text is given, value is kept for sorting
+        void appendInteger(std::size_t column,
+                           const QString & text, qint64 value);
+        void appendFloat(std::size_t column,
+                         const QString & text, double value);
+
+        std::size_t columnCount() const { return _columns.size(); }
+        std::size_t rowCount() const {
+            return _columns.empty() ? 0 : _columns[0].offsets.size() - 1;
+        }
+        std::size_t dataSize() const { return _dataSize; } // bytes
+
+    private:
+
+        friend class ColumnarResultStorage;
+
+        struct Column
+        {
+            QString data;
+            std::vector<int> offsets; // cell i is [offsets[i], offsets[i+1])
+            std::vector<unsigned char> validity; // bit is set if not null
+            std::vector<qint64> integers; // by row, empty if not typed
+            std::vector<double> floats; // by row, empty if not typed
+        };
+
+        void appendText(Column & column, const QString & text);
+
+        void finishCell(Column & column, bool isNull);
+
+        std::vector<Column> _columns;
+        std::size_t _dataSize;
+    };
+
+    ColumnarResultStorage();
+
+    void setColumnCount(std::size_t count) { _columnCount = count; }
+    std::size_t columnCount() const { return _columnCount; }
+
+    void addBatch(Batch && batch);
+    void append(ColumnarResultStorage && other); // moves all rows of other
+
+    db::ulonglong rowCount() const { return _rowCount; }
+    std::size_t dataSize() const { return _dataSize; } // bytes
+
+    // frees rows [firstRow, firstRow + count), range must consist of whole
+    // added batches
+    void releaseRows(db::ulonglong firstRow, db::ulonglong count);
+    // puts rows of other to the released range starting at firstRow, missing
+    // rows are filled with NULLs
+    void replaceRows(db::ulonglong firstRow, ColumnarResultStorage && other);
+    bool isRowReleased(db::ulonglong row) const;
+
+    bool isNull(db::ulonglong row, std::size_t column) const;
+
+    // valid while storage is alive
+    QStringRef cellRef(db::ulonglong row, std::size_t column) const;
+
+    // null QString for NULL cells
+    QString cell(db::ulonglong row, std::size_t column) const;
+
+    // false if cell has no typed value (text result or NULL)
+    bool integerValue(db::ulonglong row, std::size_t column,
+                      qint64 * value) const;
+    bool floatValue(db::ulonglong row, std::size_t column,
+                    double * value) const;
+
+    void clear();
+
+private:
+
+    // nullptr if row is released
+    const Batch * chunkForRow(db::ulonglong row, std::size_t * localRow) const;
+    std::size_t chunkIndexForRow(db::ulonglong row) const;
+    db::ulonglong chunkRowCount(std::size_t index) const;
+
+    std::vector<std::unique_ptr<Batch>> _chunks; // nullptr for released rows
+    std::vector<db::ulonglong> _chunkFirstRows; // prefix sums of row counts
+    db::ulonglong _rowCount;
+    std::size_t _dataSize;
+    std::size_t _columnCount;
+    mutable std::size_t _lastChunkIndex; // rows are mostly read in sequence
+};
+
+} // namespace db
+} // namespace meow
+
+#endif // DB_COLUMNAR_RESULT_STORAGE_H
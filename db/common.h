@@ -12,10 +12,30 @@ namespace db {
 typedef unsigned long long ulonglong;
 
 const int DATA_ROWS_PER_STEP = 1000;
-const int DATA_MAX_ROWS = 100 * 1000;
 const int DATA_MAX_LOAD_TEXT_LEN = 256;
 const int FOREIGN_MAX_ROWS = 10000;
 const int DEFAULT_KEEP_ALIVE_TIMEOUT = 20; // seconds
+const int DEFAULT_CONNECTION_POOL_SIZE = 3; // extra connections per session
+const int PREPARED_STATEMENTS_CACHE_SIZE = 32; // per connection
+const int DUMP_CONNECTIONS_COUNT = 4; // parallel readers of database dump
+const ulonglong DUMP_CHUNK_ROWS = 100000; // bigger tables are split by PK
+const int DUMP_MAX_INSERT_LENGTH = 1024 * 1024; // chars of extended INSERT
+const int BULK_LOAD_ROWS_PER_FLUSH = 10000;
+const int BULK_LOAD_MAX_BUFFER_SIZE = 4 * 1024 * 1024; // chars per flush
+const int IMPORT_MAX_REPORTED_REJECTS = 1000; // rest are only counted
+const ulonglong DATA_STREAM_MAX_BUFFER_SIZE = 512ULL * 1024 * 1024; // bytes
+const ulonglong DATA_TABLE_MAX_BUFFER_SIZE = 512ULL * 1024 * 1024; // bytes
+const int FILE_DB_BUSY_TIMEOUT = 5000; // ms to wait for lock of other handle
+const int SQL_SCRIPT_READ_CHUNK_SIZE = 1024 * 1024; // bytes per read of file
+const int SQL_SCRIPT_LAZY_SPLIT_SIZE = 1024 * 1024; // chars, bigger scripts
+                                                    // are split while running
+const int COMPLETION_MAX_SUGGESTIONS = 50;
+const int COMPLETION_TABLES_PER_BATCH = 50; // structures read per index update
+const int COMPLETION_REFRESH_DELAY = 500; // ms, changes in a row give one
+const int COMPLETION_RETRY_INTERVAL = 1000; // ms to wait for idle connection
+const int SCHEMA_CACHE_VERSION = 3; // of file format, other ones are ignored
+const int TABLES_STATUS_PER_BATCH = 100; // tables listed without stats
+const int TABLES_STATUS_RETRY_INTERVAL = 1000; // ms to wait for idle connection
 
 } // namespace db
 } // namespace meow
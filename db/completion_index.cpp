@@ -0,0 +1,258 @@
+#include "completion_index.h"
+#include <algorithm>
+
+namespace meow {
+namespace db {
+
+namespace {
+
+// greater than any char of names, prefix + it is above all names
+// starting with prefix
+const QChar PREFIX_RANGE_END(0xFFFF);
+
+} // namespace
+
+CompletionIndex::CompletionIndex()
+{
+
+}
+
+void CompletionIndex::addItems(const std::vector<Item> & items)
+{
+    if (items.empty()) {
+        return;
+    }
+
+    std::vector<Entry> entries;
+    entries.reserve(items.size());
+    for (const Item & item : items) {
+        entries.push_back({item.name.toLower(), item.parent.toLower(), item});
+    }
+
+    ChunkPtr chunk = createChunk(std::move(entries));
+
+    // merging is done aside, readers keep using current chunks
+    QMutexLocker writeLocker(&_writeMutex);
+
+    Chunks chunks = snapshot();
+
+    // like binary counter: keeps about log(size) chunks
+    while (!chunks.empty()
+           && chunks.back()->entries.size() <= chunk->entries.size()) {
+        chunk = mergeChunks(*chunks.back(), *chunk);
+        chunks.pop_back();
+    }
+    chunks.push_back(chunk);
+
+    QMutexLocker locker(&_mutex);
+    _chunks.swap(chunks);
+}
+
+void CompletionIndex::addItems(Kind kind,
+                               const QStringList & names,
+                               const QString & parent)
+{
+    std::vector<Item> items;
+    items.reserve(static_cast<std::size_t>(names.size()));
+    for (const QString & name : names) {
+        items.push_back({name, parent, kind});
+    }
+    addItems(items);
+}
+
+std::vector<CompletionIndex::Item> CompletionIndex::complete(
+        const QString & word,
+        const QString & parent,
+        int limit) const
+{
+    std::vector<Item> result;
+    if (limit <= 0) {
+        return result;
+    }
+
+    const QString key = word.toLower();
+    const QString parentKey = parent.toLower();
+    const bool byParent = !parentKey.isEmpty();
+    const std::size_t maxCount = static_cast<std::size_t>(limit);
+
+    Chunks chunks = snapshot();
+
+    auto entryAt = [byParent](const Chunk & chunk, int index) -> const Entry * {
+        if (byParent) {
+            index = chunk.byParent[static_cast<std::size_t>(index)];
+        }
+        return &chunk.entries[static_cast<std::size_t>(index)];
+    };
+
+    auto isSame = [](const Entry * a, const Entry * b) {
+        return a->item.kind == b->item.kind && a->key == b->key;
+    };
+
+    auto lessByKey = [](const Entry * a, const Entry * b) {
+        int cmp = a->key.compare(b->key);
+        if (cmp != 0) {
+            return cmp < 0;
+        }
+        return a->item.kind < b->item.kind;
+    };
+
+    // every chunk gives up to limit of its first distinct matches, so
+    // limit of all of them is in the sorted union
+    auto collect = [&](bool fuzzy, std::vector<const Entry *> * matches) {
+        for (const ChunkPtr & chunk : chunks) {
+            std::pair<int, int> range = prefixRange(
+                *chunk, fuzzy ? key.left(1) : key, parentKey);
+            std::size_t count = 0;
+            const Entry * prev = nullptr;
+            for (int i = range.first; i < range.second && count < maxCount;
+                 ++i) {
+                const Entry * entry = entryAt(*chunk, i);
+                if (prev && isSame(prev, entry)) {
+                    continue;
+                }
+                if (fuzzy && (entry->key.startsWith(key)
+                              || !isFuzzyMatch(key, entry->key))) {
+                    continue;
+                }
+                matches->push_back(entry);
+                prev = entry;
+                ++count;
+            }
+        }
+        std::sort(matches->begin(), matches->end(), lessByKey);
+        matches->erase(std::unique(matches->begin(), matches->end(), isSame),
+                       matches->end());
+    };
+
+    std::vector<const Entry *> matches;
+    collect(false, &matches);
+
+    if (matches.size() < maxCount && key.length() >= 2) {
+        std::vector<const Entry *> fuzzyMatches;
+        collect(true, &fuzzyMatches);
+        matches.insert(matches.end(),
+                       fuzzyMatches.begin(), fuzzyMatches.end());
+    }
+
+    std::size_t count = std::min(matches.size(), maxCount);
+    result.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        result.push_back(matches[i]->item);
+    }
+
+    return result;
+}
+
+std::size_t CompletionIndex::size() const
+{
+    std::size_t total = 0;
+    for (const ChunkPtr & chunk : snapshot()) {
+        total += chunk->entries.size();
+    }
+    return total;
+}
+
+CompletionIndex::ChunkPtr CompletionIndex::createChunk(
+        std::vector<Entry> && entries)
+{
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry & a, const Entry & b) {
+        int cmp = a.key.compare(b.key);
+        if (cmp != 0) {
+            return cmp < 0;
+        }
+        return a.item.kind < b.item.kind;
+    });
+
+    std::shared_ptr<Chunk> chunk = std::make_shared<Chunk>();
+    chunk->entries = std::move(entries);
+
+    chunk->byParent.resize(chunk->entries.size());
+    for (std::size_t i = 0; i < chunk->byParent.size(); ++i) {
+        chunk->byParent[i] = static_cast<int>(i);
+    }
+    const std::vector<Entry> & sorted = chunk->entries;
+    // stable keeps key order inside of parent
+    std::stable_sort(chunk->byParent.begin(), chunk->byParent.end(),
+                     [&sorted](int a, int b) {
+        return sorted[static_cast<std::size_t>(a)].parentKey
+                < sorted[static_cast<std::size_t>(b)].parentKey;
+    });
+
+    return chunk;
+}
+
+CompletionIndex::ChunkPtr CompletionIndex::mergeChunks(const Chunk & a,
+                                                       const Chunk & b)
+{
+    std::vector<Entry> entries;
+    entries.reserve(a.entries.size() + b.entries.size());
+    entries.insert(entries.end(), a.entries.begin(), a.entries.end());
+    entries.insert(entries.end(), b.entries.begin(), b.entries.end());
+    return createChunk(std::move(entries));
+}
+
+std::pair<int, int> CompletionIndex::prefixRange(const Chunk & chunk,
+                                                 const QString & prefix,
+                                                 const QString & parentKey)
+{
+    const QString prefixEnd = prefix + PREFIX_RANGE_END;
+
+    if (parentKey.isEmpty()) {
+        auto less = [](const Entry & entry, const QString & key) {
+            return entry.key < key;
+        };
+        auto begin = std::lower_bound(chunk.entries.begin(),
+                                      chunk.entries.end(),
+                                      prefix, less);
+        auto end = std::lower_bound(begin, chunk.entries.end(),
+                                    prefixEnd, less);
+        return std::make_pair(
+            static_cast<int>(begin - chunk.entries.begin()),
+            static_cast<int>(end - chunk.entries.begin()));
+    }
+
+    const std::vector<Entry> & entries = chunk.entries;
+    auto less = [&entries, &parentKey](int index, const QString & key) {
+        const Entry & entry = entries[static_cast<std::size_t>(index)];
+        int cmp = entry.parentKey.compare(parentKey);
+        if (cmp != 0) {
+            return cmp < 0;
+        }
+        return entry.key < key;
+    };
+    auto begin = std::lower_bound(chunk.byParent.begin(),
+                                  chunk.byParent.end(),
+                                  prefix, less);
+    auto end = std::lower_bound(begin, chunk.byParent.end(),
+                                prefixEnd, less);
+    return std::make_pair(
+        static_cast<int>(begin - chunk.byParent.begin()),
+        static_cast<int>(end - chunk.byParent.begin()));
+}
+
+bool CompletionIndex::isFuzzyMatch(const QString & word, const QString & key)
+{
+    // chars of word go in key in same order: usr_nm ~ user_name
+    int keyIndex = 0;
+    const int keyLength = key.length();
+    for (const QChar & c : word) {
+        while (keyIndex < keyLength && key.at(keyIndex) != c) {
+            ++keyIndex;
+        }
+        if (keyIndex == keyLength) {
+            return false;
+        }
+        ++keyIndex;
+    }
+    return true;
+}
+
+CompletionIndex::Chunks CompletionIndex::snapshot() const
+{
+    QMutexLocker locker(&_mutex);
+    return _chunks;
+}
+
+} // namespace db
+} // namespace meow
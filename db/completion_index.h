@@ -0,0 +1,94 @@
+#ifndef DB_COMPLETION_INDEX_H
+#define DB_COMPLETION_INDEX_H
+
+#include <memory>
+#include <utility>
+#include <vector>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+#include "common.h"
+
+namespace meow {
+namespace db {
+
+// Intent: names of session objects for autocompletion. Filled by portions
+// from any thread, every portion becomes a sorted chunk and small chunks
+// are merged, so lookup is a few binary searches and never waits for
+// filling (readers take a snapshot of chunks).
+class CompletionIndex
+{
+public:
+
+    enum class Kind {
+        Database,
+        Table,
+        View,
+        Routine,
+        Column
+    };
+
+    struct Item
+    {
+        QString name;
+        QString parent; // database of table, table of column
+        Kind kind;
+    };
+
+    CompletionIndex();
+
+    // Thread-safe
+    void addItems(const std::vector<Item> & items);
+    void addItems(Kind kind,
+                  const QStringList & names,
+                  const QString & parent = QString());
+
+    // Names starting with word (case-insensitive), then names containing
+    // chars of word in same order and starting with same char.
+    // Only children of parent if it is set. Same names of same kind go once.
+    std::vector<Item> complete(const QString & word,
+                               const QString & parent = QString(),
+                               int limit = COMPLETION_MAX_SUGGESTIONS) const;
+
+    std::size_t size() const;
+
+private:
+
+    struct Entry
+    {
+        QString key; // lower case name
+        QString parentKey; // lower case parent
+        Item item;
+    };
+
+    struct Chunk
+    {
+        std::vector<Entry> entries; // by key
+        std::vector<int> byParent; // entries indices by parentKey and key
+    };
+
+    using ChunkPtr = std::shared_ptr<const Chunk>;
+    using Chunks = std::vector<ChunkPtr>;
+
+    static ChunkPtr createChunk(std::vector<Entry> && entries);
+    static ChunkPtr mergeChunks(const Chunk & a, const Chunk & b);
+
+    // Returns [begin, end) of entries (or byParent indices if parentKey
+    // is not empty) with keys starting with prefix
+    static std::pair<int, int> prefixRange(const Chunk & chunk,
+                                           const QString & prefix,
+                                           const QString & parentKey);
+
+    static bool isFuzzyMatch(const QString & word, const QString & key);
+
+    Chunks snapshot() const;
+
+    mutable QMutex _mutex; // protects _chunks
+    QMutex _writeMutex; // one portion is merged at once
+    Chunks _chunks; // the oldest and biggest first
+};
+
+} // namespace db
+} // namespace meow
+
+#endif // DB_COMPLETION_INDEX_H
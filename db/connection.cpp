@@ -12,14 +12,26 @@
 #include "db/entity/routine_entity.h"
 #include "db/entity/trigger_entity.h"
 #include "table_engines_fetcher.h"
+#include "table_structures_fetcher.h"
 #include "query_data_editor.h"
 #include "helpers/parsing.h"
 #include "trigger_structure_parser.h"
 #include "threads/db_thread.h"
+#include "threads/helpers.h"
 #include "db_thread_initializer.h"
 #include "connection_query_killer.h"
+#include "connection_pool.h"
+#include "prepared_statement_cache.h"
+#include "bulk_loader.h"
+#include "completion_index.h"
+#include "threads/completion_index_task.h"
+#include "schema_cache.h"
+#include "threads/schema_cache_validation_task.h"
+#include "threads/tables_status_task.h"
+#include "helpers/logger.h"
 
 #include <QDebug>
+#include <QHash>
 
 namespace meow {
 namespace db {
@@ -33,15 +45,49 @@ Connection::Connection(const ConnectionParameters & params)
     , _characterSet()
     , _isUnicode(false)
     , _useAllDatabases(true)
+    , _isCompletionIndexOutdated(false)
+    , _isSchemaCacheValidationPosted(false)
+    , _isPooled(false)
 {
     _keepAliveTimer.setInterval(params.keepAliveTimeoutSeconds() * 1000);
     connect(&_keepAliveTimer, &QTimer::timeout,
             this, &Connection::keepAliveTimeout);
+
+    _completionIndexTimer.setSingleShot(true);
+    connect(&_completionIndexTimer, &QTimer::timeout,
+            this, &Connection::populateCompletionIndex);
+
+    _tablesStatusTimer.setSingleShot(true);
+    connect(&_tablesStatusTimer, &QTimer::timeout,
+            this, &Connection::startTablesStatusFetching);
+
+    // queued if database is changed in DbThread
+    connect(this, &Connection::databaseChanged,
+            this, &Connection::refreshCompletionIndex);
+    connect(this, &Connection::databaseEntitiesRefreshed,
+            this, &Connection::refreshCompletionIndex);
 }
 
 Connection::~Connection()
 {
     // H: clears
+    if (_completionIndexTask) {
+        _completionIndexTask->abort(); // pool waits for its threads
+    }
+    if (_schemaCacheTask) {
+        _schemaCacheTask->abort();
+    }
+    if (_tablesStatusTask) {
+        _tablesStatusTask->abort();
+    }
+    if (_schemaCache) {
+        for (auto it = _databaseEntitiesCache.cbegin();
+             it != _databaseEntitiesCache.cend(); ++it) {
+            _schemaCache->updateEntities(it.key(),
+                                         SchemaCache::toRecords(it.value()));
+        }
+        _schemaCache->save();
+    }
 }
 
 void Connection::doBeforeConnect()
@@ -52,7 +98,8 @@ void Connection::doBeforeConnect()
 
 void Connection::doAfterConnect()
 {
-    _keepAliveTimer.start();
+    // queued if connected in DbThread (pooled one), timer lives in main
+    QMetaObject::invokeMethod(&_keepAliveTimer, "start", Qt::AutoConnection);
 }
 
 QStringList Connection::allDatabases(bool refresh /*= false */)
@@ -93,28 +140,110 @@ QList<EntityPtr> Connection::getDbEntities(const QString & dbName,
 
     if (hasInCache) {
         return _databaseEntitiesCache.value(dbName);
-    } else {
-        // fetch
-        DataBaseEntitiesFetcher * fetcherPtr = createDbEntitiesFetcher();
+    }
+
+    if (_schemaCache && !refresh) {
+        SchemaCache::DatabaseRecord record;
+        if (_schemaCache->database(dbName, &record)) {
+            // cached entities are shown until checked
+            validateSchemaCache(dbName, record.fingerprint);
+            QList<EntityPtr> cachedList
+                    = SchemaCache::toEntities(record.entities);
+            _databaseEntitiesCache.insert(dbName, cachedList);
+            return cachedList;
+        }
+    }
 
-        std::shared_ptr<DataBaseEntitiesFetcher> fetcher(fetcherPtr);
+    // fetch
+    DataBaseEntitiesFetcher * fetcherPtr = createDbEntitiesFetcher();
 
-        QList<EntityPtr> newList = fetcherPtr->run(dbName);
-        _databaseEntitiesCache.insert(dbName, newList);
+    std::shared_ptr<DataBaseEntitiesFetcher> fetcher(fetcherPtr);
 
-        return newList;
+    QList<EntityPtr> newList = fetcherPtr->run(dbName);
+    _databaseEntitiesCache.insert(dbName, newList);
+
+    if (refresh && !_isPooled) { // pooled ones fill no index
+        refreshCompletionIndex();
+    }
+
+    if (_schemaCache) {
+        // saved with fingerprint read in background, a change in between
+        // is noticed on next change only
+        _schemaCache->removeDatabase(dbName);
+        validateSchemaCache(dbName, QString());
     }
+
+    return newList;
 }
 
 bool Connection::deleteAllCachedEntitiesInDatabase(const QString & dbName)
 {
     if (_databaseEntitiesCache.contains(dbName)) {
+        if (_schemaCache) {
+            // keeps create codes fetched since
+            _schemaCache->updateEntities(dbName, SchemaCache::toRecords(
+                _databaseEntitiesCache.value(dbName)));
+        }
         _databaseEntitiesCache.remove(dbName);
         return true;
     }
     return false;
 }
 
+QString Connection::schemaFingerprint(const QString & dbName)
+{
+    std::unique_ptr<DataBaseEntitiesFetcher> fetcher(
+                createDbEntitiesFetcher());
+    return fetcher->fingerprint(dbName);
+}
+
+QList<TableStatus> Connection::fetchTablesStatus(const QString & dbName,
+                                                 const QStringList & tables)
+{
+    std::unique_ptr<DataBaseEntitiesFetcher> fetcher(
+                createDbEntitiesFetcher());
+    return fetcher->fetchTablesStatus(dbName, tables);
+}
+
+void Connection::fetchTablesStatusLater(const QString & dbName)
+{
+    MEOW_ASSERT_MAIN_THREAD
+
+    QStringList tables;
+    for (const EntityPtr & entity : _databaseEntitiesCache.value(dbName)) {
+        if (entity->type() == Entity::Type::Table
+            && !static_cast<TableEntity *>(entity.get())->isStatusFetched()) {
+            tables << entity->name();
+        }
+    }
+
+    if (tables.isEmpty()) {
+        return;
+    }
+
+    _tablesStatusToFetch.insert(dbName, tables);
+
+    startTablesStatusFetching();
+}
+
+void Connection::enableSchemaCache()
+{
+    MEOW_ASSERT_MAIN_THREAD
+
+    if (_schemaCache == nullptr) {
+        _schemaCache.reset(new SchemaCache(_connectionParams));
+    }
+}
+
+void Connection::clearSchemaCache()
+{
+    if (_schemaCache) {
+        _schemaCache->clear();
+    }
+    _schemaCacheToValidate.clear();
+    refreshCompletionIndex();
+}
+
 void Connection::setCharacterSet(const QString & characterSet)
 {
    _characterSet = characterSet;
@@ -175,6 +304,35 @@ QueryPtr Connection::getResults(const QString & SQL)
     return query;
 }
 
+std::vector<QueryPtr> Connection::getPipelinedResults(
+        const QStringList & SQLs,
+        QStringList * errors)
+{
+    QStringList queryErrors;
+    std::vector<QueryResults> resultsList = queryPipelined(SQLs, &queryErrors);
+
+    std::vector<QueryPtr> queries;
+    queries.reserve(resultsList.size());
+
+    for (std::size_t i = 0; i < resultsList.size(); ++i) {
+        const QString & error = queryErrors[static_cast<int>(i)];
+        if (!error.isEmpty()) {
+            queries.push_back(nullptr);
+            continue;
+        }
+        QueryPtr query = createQuery();
+        query->setSQL(SQLs[static_cast<int>(i)]);
+        query->setResults(resultsList[i]);
+        queries.push_back(query);
+    }
+
+    if (errors) {
+        *errors = queryErrors;
+    }
+
+    return queries;
+}
+
 QStringList Connection::getRow(const QString & SQL)
 {
     // TODO: say query to skip columns parsing
@@ -333,6 +491,31 @@ QString Connection::defaultTableEngine()
     return _tableEnginesFetcher->defaultEngine();
 }
 
+QueryResults Connection::queryStreamed(const QString & SQL)
+{
+    return query(SQL, true);
+}
+
+std::vector<QueryResults> Connection::queryPipelined(const QStringList & SQLs,
+                                                     QStringList * errors)
+{
+    std::vector<QueryResults> resultsList;
+    resultsList.reserve(static_cast<std::size_t>(SQLs.size()));
+    errors->clear();
+
+    for (const QString & SQL : SQLs) {
+        try {
+            resultsList.push_back(query(SQL, true));
+            errors->append(QString());
+        } catch (meow::db::Exception & ex) {
+            resultsList.push_back(QueryResults());
+            errors->append(ex.message());
+        }
+    }
+
+    return resultsList;
+}
+
 QueryPtr Connection::createQuery()
 {
     return std::make_shared<Query>(this);
@@ -345,9 +528,48 @@ void Connection::emitDatabaseChanged(const QString& newName)
 
 void Connection::stopThread()
 {
+    // may run in own thread if there was no idle pooled connection
+    if (_schemaCacheTask) {
+        _schemaCacheTask->abort();
+    }
     _thread.reset();
 }
 
+PreparedStatementPtr Connection::prepareCached(const QString & SQL)
+{
+    if (!features()->supportsPreparedStatements()) {
+        return nullptr;
+    }
+
+    if (threads::isCurrentThreadMain()) {
+        ping(true); // reconnect closes statements, do it before lookup
+    }
+
+    threads::MutexLocker locker(mutex()); // protects cache
+
+    if (!_preparedStatements) {
+        _preparedStatements.reset(
+            new PreparedStatementCache(PREPARED_STATEMENTS_CACHE_SIZE));
+    }
+
+    PreparedStatementPtr statement = _preparedStatements->get(SQL);
+    if (!statement) {
+        statement = prepare(SQL);
+        if (statement) {
+            _preparedStatements->put(statement);
+        }
+    }
+    return statement;
+}
+
+void Connection::clearPreparedStatements()
+{
+    threads::MutexLocker locker(mutex());
+    if (_preparedStatements) {
+        _preparedStatements->clear();
+    }
+}
+
 void Connection::keepAliveTimeout()
 {
     if (_active) {
@@ -387,6 +609,45 @@ void Connection::parseTableStructure(TableEntity * table, bool refresh)
     tableStructureParser()->run(table);
 }
 
+void Connection::parseTableStructures(const QString & dbName,
+                                      const QList<TableEntity *> & tables,
+                                      bool refresh)
+{
+    QList<TableEntity *> toParse;
+    for (TableEntity * table : tables) {
+        if (table->isNew()) continue;
+        if (!refresh && table->hasStructure()) continue;
+        toParse.append(table);
+    }
+
+    if (toParse.isEmpty()) {
+        return;
+    }
+
+    // a few catalog queries cost more than one create code
+    if (toParse.size() > 1) {
+        std::unique_ptr<TableStructuresFetcher> fetcher(
+                    createTableStructuresFetcher());
+        if (fetcher) {
+            try {
+                fetcher->run(dbName, toParse);
+                return;
+            } catch(meow::db::Exception & ex) {
+                meowLogCC(Log::Category::Error, this)
+                    << "Failed to fetch structures of tables of " << dbName
+                    << ": " << ex.message();
+            }
+        }
+    }
+
+    for (TableEntity * table : toParse) {
+        // create code is fetched via parent database
+        if (table->connection()) {
+            tableStructureParser()->run(table);
+        }
+    }
+}
+
 void Connection::parseViewStructure(ViewEntity * view, bool refresh)
 {
     if (!refresh && view->hasStructure()) {
@@ -604,6 +865,14 @@ ConnectionQueryKillerPtr Connection::createQueryKiller() const
                 const_cast<Connection *>(this));
 }
 
+std::unique_ptr<BulkLoader> Connection::createBulkLoader(
+        const TableEntity * table,
+        const QStringList & columns)
+{
+    return std::unique_ptr<BulkLoader>(
+                new BulkLoader(this, quotedFullName(table), columns));
+}
+
 bool Connection::emptyEntityInDB(Entity * entity)
 {
     if (entity->type() == Entity::Type::Table
@@ -665,6 +934,308 @@ threads::DbThread * Connection::thread()
     return _thread.get();
 }
 
+ConnectionPool * Connection::pool()
+{
+    if (_pool == nullptr) {
+        int poolSize = _connectionParams.connectionPoolSize();
+        if (poolSize > 0) {
+            _pool.reset(new ConnectionPool(this, poolSize));
+        }
+    }
+    return _pool.get();
+}
+
+std::shared_ptr<CompletionIndex> Connection::completionIndex()
+{
+    MEOW_ASSERT_MAIN_THREAD
+
+    if (_completionIndex == nullptr) {
+        _completionIndex = std::make_shared<CompletionIndex>();
+        populateCompletionIndex();
+    }
+    return _completionIndex;
+}
+
+void Connection::refreshCompletionIndex()
+{
+    MEOW_ASSERT_MAIN_THREAD
+
+    if (_completionIndex == nullptr) {
+        return; // filled on first use
+    }
+
+    _completionIndexTimer.start(COMPLETION_REFRESH_DELAY);
+}
+
+void Connection::populateCompletionIndex()
+{
+    _completionIndexTimer.stop();
+
+    if (_completionIndexTask) {
+        _completionIndexTask->abort(); // started again when finished
+        _isCompletionIndexOutdated = true;
+        return;
+    }
+    _isCompletionIndexOutdated = false;
+
+    ConnectionPool * pool = this->pool();
+    bool isPoolFailed = false;
+    if (pool) {
+        try {
+            _completionIndexConnection = pool->acquire(); // nullptr if full
+        } catch(meow::db::Exception & ex) {
+            isPoolFailed = true;
+            meowLogCC(Log::Category::Error, this)
+                << "Pooled connection failed: " << ex.message();
+        }
+    }
+
+    // first filling is seen by portions, refresh is done aside
+    bool isEmpty = _completionIndex->size() == 0;
+    std::shared_ptr<CompletionIndex> index = isEmpty
+            ? _completionIndex : std::make_shared<CompletionIndex>();
+
+    if (_completionIndexConnection == nullptr) {
+        if (pool && !isPoolFailed) {
+            // pool is opening or all connections are busy
+            _completionIndexTimer.start(COMPLETION_RETRY_INTERVAL);
+            if (!isEmpty) {
+                return;
+            }
+        }
+        // entities caches of this connection are for main thread only
+        try {
+            index->addItems(CompletionIndex::Kind::Database, databases());
+            _completionIndex = index;
+        } catch(meow::db::Exception & ex) {
+            meowLogCC(Log::Category::Error, this)
+                << "Failed to fill autocompletion: " << ex.message();
+        }
+        return;
+    }
+
+    _completionIndexTask = std::make_shared<threads::CompletionIndexTask>(
+        index, _completionIndexConnection.get());
+
+    connect(_completionIndexTask.get(), &threads::ThreadTask::finished,
+            this, [=]() {
+        _completionIndexTask.reset();
+        _completionIndexConnection.reset(); // back to pool
+        if (_isCompletionIndexOutdated) {
+            populateCompletionIndex();
+        } else {
+            _completionIndex = index;
+        }
+    });
+
+    _completionIndexConnection->thread()->postTask(_completionIndexTask);
+}
+
+void Connection::validateSchemaCache(const QString & dbName,
+                                     const QString & fingerprint)
+{
+    _schemaCacheToValidate.insert(dbName, fingerprint);
+
+    if (_schemaCacheTask || _isSchemaCacheValidationPosted) {
+        return;
+    }
+
+    // after entities are shown, never before
+    _isSchemaCacheValidationPosted = true;
+    QTimer::singleShot(0, this, [=]() {
+        _isSchemaCacheValidationPosted = false;
+        startSchemaCacheValidation();
+    });
+}
+
+void Connection::startSchemaCacheValidation()
+{
+    if (_schemaCacheTask || _schemaCacheToValidate.isEmpty()) {
+        return;
+    }
+
+    ConnectionPool * pool = this->pool();
+    if (pool) {
+        try {
+            _schemaCacheConnection = pool->acquire(); // nullptr if full
+        } catch(meow::db::Exception & ex) {
+            meowLogCC(Log::Category::Error, this)
+                << "Pooled connection failed: " << ex.message();
+        }
+    }
+
+    // else fingerprints are read in own thread of this connection and
+    // outdated entities are fetched again in main one (its caches)
+    Connection * connection = _schemaCacheConnection
+            ? _schemaCacheConnection.get() : this;
+
+    _schemaCacheTask = std::make_shared<threads::SchemaCacheValidationTask>(
+        _schemaCacheToValidate, connection, connection != this);
+    _schemaCacheToValidate.clear();
+
+    connect(_schemaCacheTask.get(), &threads::ThreadTask::finished,
+            this, &Connection::onSchemaCacheValidated);
+
+    // own ref: task is run right here if there is no multithreading
+    std::shared_ptr<threads::ThreadTask> task = _schemaCacheTask;
+    connection->thread()->postTask(task);
+}
+
+void Connection::onSchemaCacheValidated()
+{
+    std::shared_ptr<threads::SchemaCacheValidationTask> task;
+    task.swap(_schemaCacheTask);
+    _schemaCacheConnection.reset(); // back to pool
+
+    const QMap<QString, QString> & databases = task->databases();
+    const QMap<QString, QString> & fingerprints = task->fingerprints();
+    const QMap<QString, SchemaCache::DatabaseRecord> & outdated
+            = task->outdated();
+
+    for (auto it = databases.cbegin(); it != databases.cend(); ++it) {
+        const QString & dbName = it.key();
+        const QString fingerprint = fingerprints.value(dbName);
+
+        // cache was cleared or filled again while checking
+        if (_schemaCache->fingerprint(dbName) != it.value()) {
+            continue;
+        }
+
+        if (it.value().isEmpty()) { // fetched, not cached yet
+            if (!fingerprint.isEmpty()
+                    && _databaseEntitiesCache.contains(dbName)) {
+                SchemaCache::DatabaseRecord record;
+                record.fingerprint = fingerprint;
+                record.entities = SchemaCache::toRecords(
+                    _databaseEntitiesCache.value(dbName));
+                _schemaCache->setDatabase(dbName, record);
+            }
+            continue;
+        }
+
+        if (!fingerprint.isEmpty() && fingerprint == it.value()) {
+            continue;
+        }
+
+        if (!outdated.contains(dbName)) {
+            // checked in own thread: fetched again here if it is shown
+            _schemaCache->removeDatabase(dbName);
+            if (_databaseEntitiesCache.contains(dbName)) {
+                try {
+                    getDbEntities(dbName, true);
+                    emit databaseEntitiesRefreshed(dbName);
+                } catch(meow::db::Exception & ex) {
+                    meowLogCC(Log::Category::Error, this)
+                        << "Failed to fetch entities of " << dbName
+                        << ": " << ex.message();
+                }
+            }
+            continue;
+        }
+
+        const SchemaCache::DatabaseRecord & record = outdated.value(dbName);
+        if (record.fingerprint.isEmpty()) {
+            _schemaCache->removeDatabase(dbName);
+        } else {
+            _schemaCache->setDatabase(dbName, record);
+        }
+
+        if (_databaseEntitiesCache.contains(dbName)) {
+            _databaseEntitiesCache.insert(
+                dbName, SchemaCache::toEntities(record.entities));
+            emit databaseEntitiesRefreshed(dbName);
+        }
+    }
+
+    startSchemaCacheValidation();
+}
+
+void Connection::startTablesStatusFetching()
+{
+    if (_tablesStatusTask || _tablesStatusToFetch.isEmpty()) {
+        return;
+    }
+
+    // not in own thread: fetching locks connection and UI would wait for it
+    ConnectionPool * pool = this->pool();
+    if (pool == nullptr) {
+        _tablesStatusToFetch.clear();
+        return;
+    }
+
+    try {
+        _tablesStatusConnection = pool->acquire(); // nullptr if full
+    } catch(meow::db::Exception & ex) {
+        meowLogCC(Log::Category::Error, this)
+            << "Pooled connection failed: " << ex.message();
+    }
+
+    if (_tablesStatusConnection == nullptr) {
+        _tablesStatusTimer.start(TABLES_STATUS_RETRY_INTERVAL);
+        return;
+    }
+
+    auto next = _tablesStatusToFetch.begin();
+    _tablesStatusTask = std::make_shared<threads::TablesStatusTask>(
+        next.key(), next.value(), _tablesStatusConnection.get());
+    _tablesStatusToFetch.erase(next);
+
+    threads::TablesStatusTask * task = _tablesStatusTask.get();
+
+    connect(task, &threads::TablesStatusTask::batchFetched,
+            this, [=]() {
+        applyTablesStatus(task->database(), task->takeFetched());
+    });
+
+    connect(task, &threads::ThreadTask::finished,
+            this, &Connection::onTablesStatusTaskFinished);
+
+    _tablesStatusConnection->thread()->postTask(_tablesStatusTask);
+}
+
+void Connection::onTablesStatusTaskFinished()
+{
+    std::shared_ptr<threads::TablesStatusTask> task;
+    task.swap(_tablesStatusTask);
+    _tablesStatusConnection.reset(); // back to pool
+
+    applyTablesStatus(task->database(), task->takeFetched());
+
+    startTablesStatusFetching();
+}
+
+void Connection::applyTablesStatus(const QString & dbName,
+                                   const QList<TableStatus> & statusList)
+{
+    if (statusList.isEmpty()) {
+        return;
+    }
+
+    // cache may be refreshed since, so tables are found by names
+    QHash<QString, TableEntity *> tables;
+    for (const EntityPtr & entity : _databaseEntitiesCache.value(dbName)) {
+        if (entity->type() == Entity::Type::Table) {
+            auto table = static_cast<TableEntity *>(entity.get());
+            if (!table->isStatusFetched()) {
+                tables.insert(table->name(), table);
+            }
+        }
+    }
+
+    bool isApplied = false;
+    for (const TableStatus & status : statusList) {
+        TableEntity * table = tables.value(status.name, nullptr);
+        if (table) {
+            table->setStatus(status);
+            isApplied = true;
+        }
+    }
+
+    if (isApplied) {
+        emit tablesStatusFetched(dbName);
+    }
+}
+
 std::unique_ptr<DbThreadInitializer> Connection::createThreadInitializer() const
 {
     return db::createThreadInitializer(connectionParams()->serverType());
@@ -12,6 +12,7 @@
 #include "query_results.h"
 #include "connection_parameters.h"
 #include "exception.h"
+#include "prepared_statement.h"
 #include "table_structure_parser.h"
 #include "view_structure_parser.h"
 #include "routine_structure_parser.h"
@@ -27,6 +28,9 @@ namespace meow {
 
 namespace threads {
 class DbThread;
+class CompletionIndexTask;
+class SchemaCacheValidationTask;
+class TablesStatusTask;
 }
 
 namespace db {
@@ -43,6 +47,7 @@ class RoutineEditor;
 class TriggerEditor;
 class DataBaseEditor;
 class TableEnginesFetcher;
+class TableStructuresFetcher;
 class EntityFilter;
 class QueryDataEditor;
 class ViewEntity;
@@ -50,6 +55,12 @@ class RoutineEntity;
 class TriggerEntity;
 class DbThreadInitializer;
 class ConnectionQueryKiller;
+class ConnectionPool;
+class PreparedStatementCache;
+class BulkLoader;
+class CompletionIndex;
+class SchemaCache;
+struct TableStatus;
 
 using QueryPtr = std::shared_ptr<Query>;
 using ConnectionQueryKillerPtr = std::shared_ptr<ConnectionQueryKiller>;
@@ -82,6 +93,10 @@ public:
     QStringList getRow(const QString & SQL);
     QList<QStringList> getRows(const QString & SQL);
     QueryPtr getResults(const QString & SQL); // H: GetResults(SQL: String):
+    // Results of independent statements in their order, nullptr for a failed
+    // one (its error goes to errors if set)
+    std::vector<QueryPtr> getPipelinedResults(const QStringList & SQLs,
+                                              QStringList * errors = nullptr);
     QStringList allDatabases(bool refresh = false);
     QStringList databases(bool refresh = false);
     void setDatabases(const QStringList & databases);
@@ -90,6 +105,23 @@ public:
                                           bool refresh = false);
     bool deleteAllCachedEntitiesInDatabase(const QString & dbName);
 
+    // Signal of database entities changes, empty if not supported.
+    // For SchemaCacheValidationTask, it is not read before fetching entities
+    QString schemaFingerprint(const QString & dbName);
+
+    // Keeps entities on disk for next connects: they are shown at once and
+    // checked in background (main connection only, not pooled ones)
+    void enableSchemaCache();
+    void clearSchemaCache(); // on user refresh
+
+    // Stats of tables listed without them, see fullTableStatus()
+    QList<TableStatus> fetchTablesStatus(const QString & dbName,
+                                         const QStringList & tables);
+    // Fetches stats of cached tables of database listed without them by
+    // batches in background on idle pooled connection, tables stay without
+    // stats if there is no pool
+    void fetchTablesStatusLater(const QString & dbName);
+
     QString quoteIdentifier(const char * identifier,
                                    bool alwaysQuote = true,
                                    QChar glue = QChar::Null) const;
@@ -118,6 +150,14 @@ public:
     virtual QueryResults query(
             const QString & SQL,
             bool storeResult = false) = 0; // H: add LogCategory
+    // Returns result that fetches rows on NativeQueryResult::fetchMore(),
+    // connection is busy until all rows are fetched. Buffered by default.
+    virtual QueryResults queryStreamed(const QString & SQL);
+    // Executes independent statements, failed one doesn't stop next ones and
+    // leaves its error in errors. Connections override it to send all of them
+    // at once, one by one by default.
+    virtual std::vector<QueryResults> queryPipelined(const QStringList & SQLs,
+                                                     QStringList * errors);
     virtual void setDatabase(const QString & database) = 0;
     virtual db::ulonglong getRowCount(const TableEntity * table) = 0;
     virtual QString escapeString(const QString & str,
@@ -147,6 +187,18 @@ public:
         return _connectionIdOnServer;
     }
     virtual ConnectionQueryKillerPtr createQueryKiller() const;
+    // Loader of many rows into table columns, INSERTs if nothing faster
+    virtual std::unique_ptr<BulkLoader> createBulkLoader(
+            const TableEntity * table,
+            const QStringList & columns);
+
+    // Prepared before or new one, nullptr if not supported.
+    // Params are marked in SQL with paramPlaceholder()
+    PreparedStatementPtr prepareCached(const QString & SQL);
+    virtual QString paramPlaceholder(int index) const { // index from 0
+        Q_UNUSED(index);
+        return QString("?");
+    }
 
     virtual bool emptyEntityInDB(Entity * entity);
     virtual QStringList informationSchemaObjects();
@@ -156,6 +208,11 @@ public:
 
     ITableStructureParser * tableStructureParser();
     void parseTableStructure(TableEntity * table, bool refresh = false);
+    // Structures of many tables of database at once if connection can read
+    // them from catalog, otherwise table by table
+    void parseTableStructures(const QString & dbName,
+                              const QList<TableEntity *> & tables,
+                              bool refresh = false);
     void parseViewStructure(ViewEntity * view, bool refresh = false);
     void parseRoutineStructure(RoutineEntity * routine, bool refresh = false);
     void parseTriggerStructure(TriggerEntity * trigger, bool refresh = false);
@@ -183,12 +240,31 @@ public:
     // TODO: rename to activeDatabaseChanged
     Q_SIGNAL void databaseChanged(const QString & database);
 
+    // Cached entities of database were outdated and are replaced in cache
+    Q_SIGNAL void databaseEntitiesRefreshed(const QString & database);
+    // Some of cached tables of database got their stats
+    Q_SIGNAL void tablesStatusFetched(const QString & database);
+
     QLatin1Char getIdentQuote() const { return _identifierQuote; }
 
     threads::Mutex * mutex() { return &_mutex; }
     threads::DbThread * thread();
     std::unique_ptr<DbThreadInitializer> createThreadInitializer() const;
 
+    // nullptr if connection params don't allow extra connections
+    ConnectionPool * pool();
+
+    // true for connections of ConnectionPool, see ConnectionOpenTask
+    void setIsPooled(bool pooled) { _isPooled = pooled; }
+    bool isPooled() const { return _isPooled; }
+
+    // Names for autocompletion, filled in background on pooled connection
+    // since the first call (only databases if there is no pool)
+    std::shared_ptr<CompletionIndex> completionIndex();
+    // Fills index again a bit later, current one is used until then.
+    // Called on change of database, entities reload and DDL
+    void refreshCompletionIndex();
+
 protected:
     threads::Mutex _mutex;
     std::atomic<bool> _active;
@@ -201,9 +277,17 @@ protected:
     QLatin1Char _identifierQuote;
     int64_t _connectionIdOnServer;
     QTimer _keepAliveTimer;
+    QTimer _completionIndexTimer; // delayed refresh or retry of filling
+    QTimer _tablesStatusTimer; // retry while pool is busy
 
     void emitDatabaseChanged(const QString& newName);
     void stopThread();
+    void clearPreparedStatements(); // call before closing native handle
+
+    virtual PreparedStatementPtr prepare(const QString & SQL) {
+        Q_UNUSED(SQL);
+        return nullptr;
+    }
 
     virtual DataBaseEntitiesFetcher * createDbEntitiesFetcher() = 0;
     // TODO: move editors and edit methods to separate class
@@ -217,6 +301,9 @@ protected:
     virtual ConnectionDataTypes * createConnectionDataTypes() = 0;
     virtual ConnectionFeatures * createFeatures();
     virtual ITableStructureParser * createTableStructureParser();
+    virtual TableStructuresFetcher * createTableStructuresFetcher() {
+        return nullptr;
+    }
     virtual SessionVariables * createVariables() { return nullptr; }
     virtual IUserManager * createUserManager() { return nullptr; }
     virtual IUserEditor * createUserEditor() { return nullptr; }
@@ -225,6 +312,20 @@ private:
 
     Q_SLOT void keepAliveTimeout();
 
+    void populateCompletionIndex();
+
+    // Checks database later in background, empty fingerprint if entities
+    // were fetched and only their fingerprint is needed for the cache
+    void validateSchemaCache(const QString & dbName,
+                             const QString & fingerprint);
+    void startSchemaCacheValidation();
+    void onSchemaCacheValidated();
+
+    void startTablesStatusFetching();
+    void onTablesStatusTaskFinished();
+    void applyTablesStatus(const QString & dbName,
+                           const QList<TableStatus> & statusList);
+
     //int _connectionStarted;
     //int _serverUptime;
     ConnectionParameters _connectionParams;
@@ -247,6 +348,21 @@ private:
     std::unique_ptr<IUserManager> _userManager;
     std::unique_ptr<IUserEditor> _userEditor;
     std::unique_ptr<threads::DbThread> _thread;
+    std::unique_ptr<ConnectionPool> _pool;
+    std::shared_ptr<CompletionIndex> _completionIndex;
+    std::shared_ptr<threads::CompletionIndexTask> _completionIndexTask;
+    ConnectionPtr _completionIndexConnection; // busy while index is filled
+    bool _isCompletionIndexOutdated; // while task is running
+    std::unique_ptr<SchemaCache> _schemaCache; // nullptr if disabled
+    QMap<QString, QString> _schemaCacheToValidate; // db name : fingerprint
+    bool _isSchemaCacheValidationPosted;
+    std::shared_ptr<threads::SchemaCacheValidationTask> _schemaCacheTask;
+    ConnectionPtr _schemaCacheConnection; // busy while cache is checked
+    QMap<QString, QStringList> _tablesStatusToFetch; // db name : tables
+    std::shared_ptr<threads::TablesStatusTask> _tablesStatusTask;
+    ConnectionPtr _tablesStatusConnection; // busy while status is fetched
+    bool _isPooled;
+    std::unique_ptr<PreparedStatementCache> _preparedStatements;
 };
 
 } // namespace db
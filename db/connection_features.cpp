@@ -45,7 +45,7 @@ PGConnectionFeatures::PGConnectionFeatures(Connection * connection)
 
 ////////////////////////////////////////////////////////////////////////////////
 
-QtSQLiteConnectionFeatures::QtSQLiteConnectionFeatures(Connection * connection)
+SQLiteConnectionFeatures::SQLiteConnectionFeatures(Connection * connection)
     : ConnectionFeatures(connection)
 {
 
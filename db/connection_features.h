@@ -102,6 +102,10 @@ public:
     virtual bool supportsCancellingQuery() const {
         return true;
     }
+
+    virtual bool supportsPreparedStatements() const {
+        return false;
+    }
 protected:
     Connection * _connection;
 };
@@ -211,6 +215,10 @@ public:
     virtual bool supportsUserManagement() const override {
         return true;
     }
+
+    virtual bool supportsPreparedStatements() const override {
+        return true;
+    }
 };
 
 // -----------------------------------------------------------------------------
@@ -260,15 +268,19 @@ public:
     virtual bool supportsViewingViews() const override {
         return true;
     }
+
+    virtual bool supportsPreparedStatements() const override {
+        return true;
+    }
 };
 
 // -----------------------------------------------------------------------------
 
-class QtSQLiteConnectionFeatures : public ConnectionFeatures
+class SQLiteConnectionFeatures : public ConnectionFeatures
 {
 public:
 
-    explicit QtSQLiteConnectionFeatures(Connection * connection);
+    explicit SQLiteConnectionFeatures(Connection * connection);
 
     virtual bool supportsViewingTablesData() const override {
         return true;
@@ -296,6 +308,10 @@ public:
             return false;
         };
     }
+
+    virtual bool supportsPreparedStatements() const override {
+        return true;
+    }
 };
 
 } // namespace db
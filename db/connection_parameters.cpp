@@ -28,6 +28,7 @@ meow::db::ConnectionParameters::ConnectionParameters(
     _databases(""),
     _loginPrompt(false),
     _isCompressed(false),
+    _fullTableStatus(true),
     _port(0),
     _manager(manager),
     _id(0)
@@ -79,7 +80,8 @@ bool meow::db::ConnectionParameters::operator==(
         && _loginPrompt == other._loginPrompt
         && _port == other._port
         && _sshTunnel == other._sshTunnel
-        && _isCompressed == other._isCompressed;
+        && _isCompressed == other._isCompressed
+        && _fullTableStatus == other._fullTableStatus;
 }
 
 meow::db::ConnectionParameters::operator QString() const
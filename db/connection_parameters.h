@@ -60,7 +60,8 @@ public:
     bool isLoginPrompt() const { return _loginPrompt; }
     bool isCompressed() const { return _isCompressed; }
     quint16 port() const { return _port; }
-    bool fullTableStatus() const { return true; }
+    // false: tables are listed without stats, they are fetched later
+    bool fullTableStatus() const { return _fullTableStatus; }
     unsigned id() const { return _id; }
 
     // setters
@@ -75,6 +76,7 @@ public:
     void addDatabase(const QString & name, bool ignoreIfAll = false);
     void setLoginPrompt(bool loginPrompt) { _loginPrompt = loginPrompt; }
     void setCompressed(bool compressed) { _isCompressed = compressed; }
+    void setFullTableStatus(bool full) { _fullTableStatus = full; }
     void setPort(quint16 port) { _port = port; }
     void setManager(ConnectionParamsManager &manager);
     void setId(unsigned id) { _id = id; }
@@ -113,6 +115,15 @@ public:
         return false;
     }
 
+    bool supportsFullTableStatusOption() const {
+#ifdef WITH_MYSQL
+        if (_serverType == ServerType::MySQL) {
+            return true;
+        }
+#endif
+        return false;
+    }
+
     bool isSSHTunnel() const {
 #ifdef WITH_MYSQL
         if (_networkType == NetworkType::MySQL_SSH_Tunnel) {
@@ -135,6 +146,11 @@ public:
         if (_serverType == ServerType::MySQL) {
             return true;
         }
+#endif
+#ifdef WITH_SQLITE
+        if (_serverType == ServerType::SQLite) {
+            return true; // handles are opened in serialized mode
+        }
 #endif
         return false; // not implemented for other or not supported
     }
@@ -164,6 +180,20 @@ public:
         return meow::db::DEFAULT_KEEP_ALIVE_TIMEOUT;
     }
 
+    // 0 if queries run in main connection only
+    int connectionPoolSize() const {
+        if (!supportsMultithreading() || isSSHTunnel() || isLoginPrompt()) {
+            return 0; // no tunnel per connection, no password prompts
+        }
+#ifdef WITH_SQLITE
+        if (_serverType == ServerType::SQLite
+                && _fileName == QLatin1String(":memory:")) {
+            return 0; // each connection would have own database
+        }
+#endif
+        return meow::db::DEFAULT_CONNECTION_POOL_SIZE;
+    }
+
 private:
     NetworkType _networkType;
     ServerType _serverType;
@@ -175,6 +205,7 @@ private:
     QString _databases;
     bool _loginPrompt;
     bool _isCompressed;
+    bool _fullTableStatus;
     quint16 _port;
     ConnectionParamsManager * _manager;
     unsigned _id;
@@ -108,6 +108,8 @@ void meow::db::ConnectionParamsManager::load()
                             settings.value("isLoginPrompt", loadedParams.isLoginPrompt()).toBool());
                 loadedParams.setCompressed(
                             settings.value("isCompressed", loadedParams.isCompressed()).toBool());
+                loadedParams.setFullTableStatus(
+                            settings.value("fullTableStatus", loadedParams.fullTableStatus()).toBool());
                 loadedParams.setPort(
                             settings.value("port", loadedParams.port()).toInt());
 
@@ -152,6 +154,7 @@ void meow::db::ConnectionParamsManager::saveParams(const ConnectionParameters &
                 settings.setValue("databases", params.databases());
                 settings.setValue("isLoginPrompt", params.isLoginPrompt());
                 settings.setValue("isCompressed", params.isCompressed());
+                settings.setValue("fullTableStatus", params.fullTableStatus());
                 settings.setValue("port", params.port());
 
                 settings.beginGroup("ssh");
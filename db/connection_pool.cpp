@@ -0,0 +1,128 @@
+#include "connection_pool.h"
+#include "connection.h"
+#include "threads/db_thread.h"
+#include "threads/connection_open_task.h"
+#include "threads/helpers.h"
+#include "helpers/logger.h"
+
+namespace meow {
+namespace db {
+
+ConnectionPool::ConnectionPool(Connection * mainConnection, int maxSize)
+    : _mainConnection(mainConnection)
+    , _maxSize(maxSize)
+{
+    Q_ASSERT(_mainConnection != nullptr);
+}
+
+ConnectionPool::~ConnectionPool()
+{
+    // busy connections are alive while their holders need them
+}
+
+ConnectionPtr ConnectionPool::acquire()
+{
+    MEOW_ASSERT_MAIN_THREAD
+
+    ConnectionPtr idle;
+
+    for (const ConnectionPtr & connection : _connections) {
+        if (connection.use_count() == 1 // held by pool only
+                && !_opening.contains(connection.get())
+                // a released holder may have left a cancelled task running
+                && connection->thread()->isIdle()) {
+            idle = connection;
+            break;
+        }
+    }
+
+    prewarm(); // next one is opened while this one is busy
+
+    if (idle) {
+        syncSessionState(idle.get());
+    }
+
+    return idle;
+}
+
+void ConnectionPool::prewarm()
+{
+    MEOW_ASSERT_MAIN_THREAD
+
+    for (const ConnectionPtr & connection : _connections) {
+        if (connection.use_count() == 1) {
+            return; // idle or opening one is spare
+        }
+    }
+
+    if (size() >= _maxSize) {
+        return;
+    }
+
+    ConnectionPtr connection
+        = _mainConnection->connectionParams()->createConnection();
+    connection->setIsPooled(true);
+
+    _connections.push_back(connection);
+    _opening.insert(connection.get());
+
+    auto task = std::make_shared<threads::ConnectionOpenTask>(
+        connection.get(),
+        _mainConnection->characterSet(),
+        _mainConnection->database());
+
+    Connection * opening = connection.get();
+    QObject::connect(task.get(), &threads::ConnectionOpenTask::opened,
+                     _mainConnection, [=](const QString & errorMessage) {
+        onConnectionOpened(opening, errorMessage);
+    });
+
+    connection->thread()->postTask(task);
+}
+
+void ConnectionPool::onConnectionOpened(Connection * connection,
+                                        const QString & errorMessage)
+{
+    MEOW_ASSERT_MAIN_THREAD
+
+    _opening.remove(connection);
+
+    if (errorMessage.isEmpty()) {
+        meowLogCC(Log::Category::Info, _mainConnection)
+            << "Pooled connection opened, total: " << size();
+        return;
+    }
+
+    meowLogCC(Log::Category::Error, _mainConnection)
+        << "Pooled connection failed: " << errorMessage;
+
+    for (auto it = _connections.begin(); it != _connections.end(); ++it) {
+        if (it->get() == connection) {
+            _connections.erase(it); // opened again on next acquire()
+            break;
+        }
+    }
+}
+
+void ConnectionPool::syncSessionState(Connection * pooled)
+{
+    MEOW_ASSERT_MAIN_THREAD
+
+    pooled->ping(true);
+
+    const QString & characterSet = _mainConnection->characterSet();
+    if (!characterSet.isEmpty() && pooled->characterSet() != characterSet) {
+        pooled->setCharacterSet(characterSet);
+    }
+
+    if (pooled->database() != _mainConnection->database()) {
+        pooled->setDatabase(_mainConnection->database());
+    }
+
+    // get id before async query execution to allow
+    // KILL QUERY ID from another thread
+    pooled->connectionIdOnServer();
+}
+
+} // namespace db
+} // namespace meow
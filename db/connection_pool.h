@@ -0,0 +1,56 @@
+#ifndef DB_CONNECTION_POOL_H
+#define DB_CONNECTION_POOL_H
+
+#include <vector>
+#include <QSet>
+#include "connection_parameters.h"
+
+namespace meow {
+namespace db {
+
+class Connection;
+
+// Intent: extra connections of a session to run long data/user queries
+// while main connection stays free for metadata and editing.
+// Connection is in use while anybody except pool holds its ConnectionPtr,
+// release is just dropping the pointer. Connections are opened in their
+// DbThreads ahead of time, one spare connection is kept while pool is not
+// full.
+// Only current database and charset of main connection are applied to
+// pooled ones. Other session state (variables, sql_mode, temporary tables,
+// transactions, locks) lives in the connection that set it, so its user
+// should keep running in the same connection, see UserQuery.
+class ConnectionPool
+{
+public:
+    ConnectionPool(Connection * mainConnection, int maxSize);
+    ~ConnectionPool();
+
+    // Returns idle connection with session state of main connection,
+    // nullptr if all connections are busy or still opening. Throws on error
+    // of idle connection.
+    ConnectionPtr acquire();
+
+    // Starts opening of a connection in background if there is no spare one
+    void prewarm();
+
+    // Applies current database and charset of main connection
+    void syncSessionState(Connection * pooled);
+
+    int size() const { return static_cast<int>(_connections.size()); }
+    int maxSize() const { return _maxSize; }
+
+private:
+    void onConnectionOpened(Connection * connection,
+                            const QString & errorMessage);
+
+    Connection * _mainConnection;
+    const int _maxSize;
+    std::vector<ConnectionPtr> _connections;
+    QSet<Connection *> _opening; // in their DbThreads, not given out
+};
+
+} // namespace db
+} // namespace meow
+
+#endif // DB_CONNECTION_POOL_H
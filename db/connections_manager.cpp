@@ -1,5 +1,6 @@
 #include "connections_manager.h"
 #include "connection.h"
+#include "connection_pool.h"
 #include "db/entity/table_entity.h"
 #include "db/entity/database_entity.h"
 #include "db/entity/view_entity.h"
@@ -58,6 +59,10 @@ ConnectionPtr ConnectionsManager::openDBConnection(db::ConnectionParameters & pa
     ConnectionPtr connection = params.createConnection();
 
     connection->setActive(true);
+    connection->enableSchemaCache();
+    if (connection->pool()) {
+        connection->pool()->prewarm(); // opened in background by first use
+    }
 
     SessionEntityPtr newSession = EntityFactory::createSession(connection, this);
 
@@ -77,6 +82,11 @@ ConnectionPtr ConnectionsManager::openDBConnection(db::ConnectionParameters & pa
             this,
             &meow::db::ConnectionsManager::activeDatabaseChanged);
 
+    QObject::connect(newSession.get(),
+            &meow::db::SessionEntity::databaseEntitiesRefreshed,
+            this,
+            &meow::db::ConnectionsManager::databaseEntitiesRefreshed);
+
     _connections.push_back(newSession);
 
     emit connectionOpened(newSession.get());
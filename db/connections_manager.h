@@ -54,6 +54,7 @@ public:
     Q_SIGNAL void activeSessionChanged();
     Q_SIGNAL void activeSessionRefreshed();
     Q_SIGNAL void activeDatabaseChanged(const QString & database);
+    Q_SIGNAL void databaseEntitiesRefreshed(DataBaseEntity * database);
 
     void createNewEntity(Entity::Type type);
 
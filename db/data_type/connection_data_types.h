@@ -2,9 +2,6 @@
 #define DB_CONNECTION_DATA_TYPES_H
 
 #include <QList>
-#ifdef WITH_QTSQL
-#include <QSqlField>
-#endif
 #include "data_type.h"
 
 namespace meow {
@@ -72,12 +69,6 @@ public:
         );
         return ptr;
     }
-#ifdef WITH_QTSQL
-    virtual DataTypePtr dataTypeFromField(const QSqlField & field) {
-        Q_UNUSED(field)
-        return defaultType();
-    }
-#endif
 
 protected:
     Connection * _connection;
@@ -1,5 +1,6 @@
 #include "sqlite_connection_datatypes.h"
 #include "db/sqlite/sqlite_connection.h"
+#include <sqlite3.h>
 
 namespace meow {
 namespace db {
@@ -72,27 +73,25 @@ const DataTypePtr SQLiteConnectionDataTypes::defaultType() const
     return _map.value(SQLiteTypeAffinity::Text);
 }
 
-DataTypePtr SQLiteConnectionDataTypes::dataTypeFromField(
-    const QSqlField & field)
+DataTypePtr SQLiteConnectionDataTypes::dataTypeFromNative(int fundamentalType)
 {
-    // https://doc.qt.io/qt-5/sql-types.html#qsqlite-sqlite-version-3-data-types
-    // https://doc.qt.io/qt-5/qmetatype.html#Type-enum
+    // https://www.sqlite.org/c3ref/c_blob.html
 
     list(); // init
 
     SQLiteTypeAffinity type = SQLiteTypeAffinity::Text;
 
-    switch (static_cast<QMetaType::Type>(field.type())) {
+    switch (fundamentalType) {
 
-    case QMetaType::Int:
+    case SQLITE_INTEGER:
         type = SQLiteTypeAffinity::Integer;
         break;
 
-    case QMetaType::QByteArray:
+    case SQLITE_BLOB:
         type = SQLiteTypeAffinity::Blob;
         break;
 
-    case QMetaType::Double:
+    case SQLITE_FLOAT:
         type = SQLiteTypeAffinity::Real;
         break;
 
@@ -27,7 +27,8 @@ public:
 
     virtual const DataTypePtr defaultType() const override;
 
-    virtual DataTypePtr dataTypeFromField(const QSqlField & field) override;
+    // fundamentalType is SQLITE_INTEGER, SQLITE_FLOAT etc of value
+    DataTypePtr dataTypeFromNative(int fundamentalType);
 
     SQLiteTypeAffinity affinityByName(const QString & name);
 
@@ -1,21 +1,226 @@
 #include "editable_grid_data.h"
+#include <algorithm>
 
 namespace meow {
 namespace db {
 
-EditableGridData::EditableGridData()
+EditableGridData::EditableGridData(const ColumnarResultStorage * source)
+    : _source(source)
+    , _rowsCount(0)
 {
 
 }
 
+void EditableGridData::clear()
+{
+    _segments.clear();
+    _segmentStarts.clear();
+    _rowsCount = 0;
+    _ownRows.clear();
+    _modifiedSourceRows.clear();
+    _editableRow.reset();
+}
+
 void EditableGridData::reserve(int alloc)
 {
-    _rows.reserve(alloc);
+    _ownRows.reserve(alloc);
 }
 
 void EditableGridData::reserveForAppend(int append)
 {
-    _rows.reserve(_rows.size() + append);
+    _ownRows.reserve(_ownRows.size() + append);
+}
+
+void EditableGridData::appendRow(const GridDataRow & row)
+{
+    _ownRows.append(row);
+    appendSegment(true, _ownRows.size() - 1, 1);
+}
+
+void EditableGridData::appendSourceRows(int firstSourceRow, int count)
+{
+    Q_ASSERT(_source != nullptr);
+    appendSegment(false, firstSourceRow, count);
+}
+
+QString EditableGridData::notModifiedDataAt(int row, int col) const
+{
+    int offset = 0;
+    const Segment & segment = _segments[segmentForRow(row, &offset)];
+
+    if (segment.isOwn) {
+        return _ownRows.at(segment.first + offset).at(col);
+    }
+
+    int sourceRow = segment.first + offset;
+    auto it = _modifiedSourceRows.constFind(sourceRow);
+    if (it != _modifiedSourceRows.constEnd()) {
+        return it->at(col);
+    }
+
+    return _source->cell(static_cast<db::ulonglong>(sourceRow),
+                         static_cast<std::size_t>(col));
+}
+
+int EditableGridData::sourceRowAt(int row) const
+{
+    int offset = 0;
+    const Segment & segment = _segments[segmentForRow(row, &offset)];
+
+    if (segment.isOwn) {
+        return -1;
+    }
+
+    int sourceRow = segment.first + offset;
+    if (_modifiedSourceRows.contains(sourceRow)) {
+        return -1;
+    }
+
+    return sourceRow;
+}
+
+bool EditableGridData::deleteRow(int row)
+{
+    _editableRow.reset();
+
+    std::size_t index = splitAt(row);
+    splitAt(row + 1);
+
+    const Segment & segment = _segments[index];
+    if (segment.isOwn) {
+        _ownRows[segment.first] = GridDataRow(); // free data, keep indices
+    } else {
+        _modifiedSourceRows.remove(segment.first);
+    }
+
+    _segments.erase(_segments.begin() + static_cast<long>(index));
+    --_rowsCount;
+    updateSegmentStarts();
+
+    return true;
+}
+
+int EditableGridData::insertRow(int newRowNumber, const GridDataRow & data)
+{
+    if (newRowNumber > rowsCount()) {
+        newRowNumber = rowsCount();
+    }
+
+    std::size_t index = splitAt(newRowNumber);
+
+    _ownRows.append(data);
+    Segment segment = { true, _ownRows.size() - 1, 1 };
+    _segments.insert(_segments.begin() + static_cast<long>(index), segment);
+    ++_rowsCount;
+    updateSegmentStarts();
+
+    createUpdateRow(newRowNumber);
+    _editableRow->isInserted = true;
+
+    return newRowNumber;
+}
+
+GridDataRow EditableGridData::rowData(int row) const
+{
+    int offset = 0;
+    const Segment & segment = _segments[segmentForRow(row, &offset)];
+
+    if (segment.isOwn) {
+        return _ownRows.at(segment.first + offset);
+    }
+
+    int sourceRow = segment.first + offset;
+    auto it = _modifiedSourceRows.constFind(sourceRow);
+    if (it != _modifiedSourceRows.constEnd()) {
+        return *it;
+    }
+
+    std::size_t columnCount = _source->columnCount();
+    GridDataRow data;
+    data.reserve(static_cast<int>(columnCount));
+    for (std::size_t col = 0; col < columnCount; ++col) {
+        data.append(_source->cell(static_cast<db::ulonglong>(sourceRow), col));
+    }
+    return data;
+}
+
+void EditableGridData::setRowData(int row, const GridDataRow & data)
+{
+    int offset = 0;
+    const Segment & segment = _segments[segmentForRow(row, &offset)];
+
+    if (segment.isOwn) {
+        _ownRows[segment.first + offset] = data;
+    } else {
+        _modifiedSourceRows.insert(segment.first + offset, data);
+    }
+}
+
+std::size_t EditableGridData::segmentForRow(int row, int * offset) const
+{
+    Q_ASSERT(row >= 0 && row < _rowsCount);
+
+    auto it = std::upper_bound(_segmentStarts.begin(),
+                               _segmentStarts.end(),
+                               row);
+    std::size_t index = static_cast<std::size_t>(
+        it - _segmentStarts.begin()) - 1;
+
+    *offset = row - _segmentStarts[index];
+    return index;
+}
+
+std::size_t EditableGridData::splitAt(int row)
+{
+    if (row >= _rowsCount) {
+        return _segments.size();
+    }
+
+    int offset = 0;
+    std::size_t index = segmentForRow(row, &offset);
+    if (offset == 0) {
+        return index;
+    }
+
+    Segment tail = _segments[index];
+    tail.first += offset;
+    tail.count -= offset;
+    _segments[index].count = offset;
+    _segments.insert(_segments.begin() + static_cast<long>(index) + 1, tail);
+    updateSegmentStarts();
+
+    return index + 1;
+}
+
+void EditableGridData::appendSegment(bool isOwn, int first, int count)
+{
+    if (count <= 0) {
+        return;
+    }
+
+    if (!_segments.empty()) {
+        Segment & last = _segments.back();
+        if (last.isOwn == isOwn && last.first + last.count == first) {
+            last.count += count;
+            _rowsCount += count;
+            return;
+        }
+    }
+
+    Segment segment = { isOwn, first, count };
+    _segments.push_back(segment);
+    _segmentStarts.push_back(_rowsCount);
+    _rowsCount += count;
+}
+
+void EditableGridData::updateSegmentStarts()
+{
+    _segmentStarts.resize(_segments.size());
+    int start = 0;
+    for (std::size_t i = 0; i < _segments.size(); ++i) {
+        _segmentStarts[i] = start;
+        start += _segments[i].count;
+    }
 }
 
 } // namespace db
@@ -3,8 +3,11 @@
 
 #include <QStringList>
 #include <QVariant>
+#include <QHash>
 #include <memory>
+#include <vector>
 #include <QDebug>
+#include "columnar_result_storage.h"
 
 namespace meow {
 namespace db {
@@ -26,36 +29,41 @@ public:
     bool isInserted; // but not saved // TODO: rename?
 };
 
-// Intent: data container for editing in grid/table form
+// Intent: data container for editing in grid/table form.
+// Works as overlay over not modified rows of source storage: keeps only own
+// (appended/inserted) rows and modified source rows, so start of editing
+// costs nothing and memory grows with edits only.
 class EditableGridData
 {
 public:
-    EditableGridData();
+    explicit EditableGridData(const ColumnarResultStorage * source = nullptr);
 
-    void clear() { _rows.clear(); }
+    void clear();
     void reserve(int alloc);
     void reserveForAppend(int append);
 
-    inline void appendRow(const GridDataRow & row) {
-        _rows.append(row);
-    }
+    void appendRow(const GridDataRow & row);
+
+    // shows source rows [firstSourceRow, firstSourceRow + count) at the end
+    void appendSourceRows(int firstSourceRow, int count);
 
     inline int rowsCount() const {
-        return _rows.size();
+        return _rowsCount;
     }
 
-    inline const QString & dataAt(int row, int col) const {
+    inline QString dataAt(int row, int col) const {
 
         if (_editableRow && _editableRow->rowNumber == row) {
             return _editableRow->data.at(col);
         }
 
-        return _rows.at(row).at(col);
+        return notModifiedDataAt(row, col);
     }
 
-    const QString & notModifiedDataAt(int row, int col) const {
-        return _rows.at(row).at(col);
-    }
+    QString notModifiedDataAt(int row, int col) const;
+
+    // row of source shown at row, -1 if it is own or modified one
+    int sourceRowAt(int row) const;
 
     bool setData(int row, int col, const QVariant &value) {
 
@@ -89,7 +97,7 @@ public:
         if (!isModified()) return -1;
 
         int editableRowNumber = _editableRow->rowNumber;
-        _rows[_editableRow->rowNumber] = _editableRow->data;
+        setRowData(editableRowNumber, _editableRow->data);
         _editableRow.reset();
 
         return editableRowNumber;
@@ -99,22 +107,9 @@ public:
         return _editableRow.get();
     }
 
-    bool deleteRow(int row) {
-        _editableRow.reset();
-        _rows.removeAt(row);
-        return true;
-    }
-
-    int insertRow(int newRowNumber, const GridDataRow & data) {
-        _rows.insert(newRowNumber, data);
-        if (newRowNumber > (rowsCount() - 1)) {
-            newRowNumber = rowsCount() - 1;
-        }
-        createUpdateRow(newRowNumber);
-        _editableRow->isInserted = true;
+    bool deleteRow(int row);
 
-        return newRowNumber;
-    }
+    int insertRow(int newRowNumber, const GridDataRow & data);
 
     bool isRowInserted(int rowNumber) {
         return _editableRow
@@ -124,6 +119,14 @@ public:
 
 private:
 
+    // Continuous visible rows taken either from source or own rows
+    struct Segment
+    {
+        bool isOwn;
+        int first; // index of first row in source or own rows
+        int count;
+    };
+
     bool isSameData(const QString & str1, const QString & str2) {
         if (str1 == str2) {
             if (str1.isNull() != str2.isNull()) {
@@ -138,13 +141,26 @@ private:
     void createUpdateRow(int rowNumber) {
         if (!_editableRow || _editableRow->rowNumber != rowNumber) {
             _editableRow = std::make_shared<EditableGridDataRow>(
-                _rows[rowNumber],
+                rowData(rowNumber),
                 rowNumber
             );
         }
     }
 
-    QList<GridDataRow> _rows;
+    GridDataRow rowData(int row) const;
+    void setRowData(int row, const GridDataRow & data);
+
+    std::size_t segmentForRow(int row, int * offset) const;
+    std::size_t splitAt(int row); // returns index of segment starting at row
+    void appendSegment(bool isOwn, int first, int count);
+    void updateSegmentStarts();
+
+    const ColumnarResultStorage * _source;
+    std::vector<Segment> _segments;
+    std::vector<int> _segmentStarts; // first visible row of each segment
+    int _rowsCount;
+    QList<GridDataRow> _ownRows;
+    QHash<int, GridDataRow> _modifiedSourceRows; // source row -> data
     std::shared_ptr<EditableGridDataRow> _editableRow;
 };
 
@@ -84,6 +84,9 @@ void DataBaseEntity::initEntitiesIfNeed()
         }
 
         _entitiesWereInit = true;
+
+        // if tables were listed without stats
+        connection()->fetchTablesStatusLater(_dbName);
     }
 }
 
@@ -98,6 +101,12 @@ void DataBaseEntity::clearChildren()
     _entitiesWereInit = false;
 }
 
+void DataBaseEntity::reloadChildren()
+{
+    _entities.clear();
+    _entitiesWereInit = false;
+}
+
 int DataBaseEntity::indexOf(Entity * entity)
 {
     initEntitiesIfNeed();
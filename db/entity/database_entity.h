@@ -33,6 +33,9 @@ public:
 
     bool childrenFetched() const;
     void clearChildren();
+    // Takes entities from connection's cache again, e.g. after they
+    // were replaced with fresh ones
+    void reloadChildren();
 
     int indexOf(Entity * entity);
 
@@ -1,4 +1,5 @@
 #include "entities_fetcher.h"
+#include "table_entity.h"
 
 namespace meow {
 namespace db {
@@ -9,5 +10,20 @@ DataBaseEntitiesFetcher::DataBaseEntitiesFetcher(Connection * connection)
 
 }
 
+QString DataBaseEntitiesFetcher::fingerprint(const QString & dbName)
+{
+    Q_UNUSED(dbName);
+    return QString();
+}
+
+QList<TableStatus> DataBaseEntitiesFetcher::fetchTablesStatus(
+        const QString & dbName,
+        const QStringList & tables)
+{
+    Q_UNUSED(dbName);
+    Q_UNUSED(tables);
+    return QList<TableStatus>();
+}
+
 } // namespace db
 } // namespace meow
@@ -2,12 +2,14 @@
 #define DATABASE_ENTITIES_FETCHER_H
 
 #include <QString>
+#include <QStringList>
 #include "db/entity/entity.h"
 
 namespace meow {
 namespace db {
 
 class Connection;
+struct TableStatus;
 
 class DataBaseEntitiesFetcher
 {
@@ -15,6 +17,14 @@ public:
     explicit DataBaseEntitiesFetcher(Connection * connection);
     virtual ~DataBaseEntitiesFetcher() {}
     virtual QList<EntityPtr> run(const QString & dbName) = 0;
+    // Signal of database entities (and their structures) changes, e.g.
+    // counts, latest change times and checksums of definitions, empty if
+    // not supported or failed.
+    // Is read in background only, see SchemaCacheValidationTask
+    virtual QString fingerprint(const QString & dbName);
+    // Stats of tables that were listed without them, empty if not supported
+    virtual QList<TableStatus> fetchTablesStatus(const QString & dbName,
+                                                 const QStringList & tables);
 protected:  
     Connection * _connection;
 };
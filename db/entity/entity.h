@@ -78,6 +78,11 @@ public:
     void setUpdated(const QDateTime & updated) { _updated = updated; }
 
     QString createCode(bool refresh = false);
+    // Without query, empty if it was not fetched yet
+    QString cachedCreateCode() const { return _createCodeCached.second; }
+    void setCreateCode(const QString & code) {
+        _createCodeCached = std::make_pair(true, code);
+    }
 
     EntityPtr retain() {
         // should be safe if ctor is not public and EntityFabric always returns
@@ -18,7 +18,10 @@ SessionEntity::SessionEntity(const std::shared_ptr<Connection> & connection,
      _databases(),
      _databasesWereInit(false)
 {
-
+    connect(_connection.get(), &Connection::databaseEntitiesRefreshed,
+            this, &SessionEntity::onDatabaseEntitiesRefreshed);
+    connect(_connection.get(), &Connection::tablesStatusFetched,
+            this, &SessionEntity::onTablesStatusFetched);
 }
 
 SessionEntity::~SessionEntity()
@@ -98,16 +101,35 @@ void SessionEntity::clearAllDatabaseEntities()
 
 void SessionEntity::refreshAllEntities()
 {
+    _connection->clearSchemaCache(); // user wants data from server
     clearAllDatabaseEntities();
     initDatabasesListIfNeed();
 }
 
+void SessionEntity::onDatabaseEntitiesRefreshed(const QString & name)
+{
+    DataBaseEntity * database = databaseByName(name);
+    if (database && database->childrenFetched()) {
+        database->reloadChildren();
+        emit databaseEntitiesRefreshed(database);
+    }
+}
+
+void SessionEntity::onTablesStatusFetched(const QString & name)
+{
+    DataBaseEntity * database = databaseByName(name);
+    if (database && database->childrenFetched()) {
+        emit tablesStatusFetched(database);
+    }
+}
+
 void SessionEntity::editEntityInDB(EntityInDatabase * entity,
                                    EntityInDatabase * newData)
 {
     bool changed = connection()->editEntityInDB(entity, newData);
     if (changed) {
         entity->copyDataFrom(newData);
+        _connection->refreshCompletionIndex();
         emit entityEdited(entity);
     }
 }
@@ -117,6 +139,7 @@ bool SessionEntity::insertEntityToDB(EntityInDatabase * entity)
     if (connection()->insertEntityToDB(entity)) {
         entity->setIsNew(false);
         addEntity(entity);
+        _connection->refreshCompletionIndex();
         emit entityInserted(entity->retain());
         return true;
     }
@@ -126,18 +149,27 @@ bool SessionEntity::insertEntityToDB(EntityInDatabase * entity)
 bool SessionEntity::dropEntityInDB(EntityInDatabase * entity)
 {
     // Listening: Behemoth - Bartzabel
-    return connection()->dropEntityInDB(entity);
+    if (connection()->dropEntityInDB(entity)) {
+        _connection->refreshCompletionIndex();
+        return true;
+    }
+    return false;
 }
 
 bool SessionEntity::dropDatabase(DataBaseEntity * database)
 {
-    return connection()->dropDatabase(database);
+    if (connection()->dropDatabase(database)) {
+        _connection->refreshCompletionIndex();
+        return true;
+    }
+    return false;
 }
 
 void SessionEntity::createDatabase(const QString & name,
                                    const QString & collation)
 {
     _connection->createDatabase(name, collation);
+    _connection->refreshCompletionIndex();
 
     if (_connection->connectionParams()->isAllDatabases()) {
         appendCreatedDatabase(name);
@@ -158,6 +190,7 @@ bool SessionEntity::editDatabase(DataBaseEntity * database,
     bool changed = _connection->editDatabase(database, newName, newCollation);
 
     if (changed) {
+        _connection->refreshCompletionIndex();
         //removeEntity(database); // nope: remove later
         if (moveToExisting) {
             DataBaseEntity * database = databaseByName(newName);
@@ -77,12 +77,19 @@ public:
 
     Q_SIGNAL void databaseInserted(const DataBaseEntityPtr & database);
     Q_SIGNAL void databaseRemoved(const DataBaseEntityPtr & database);
+    // Entities of fetched database were replaced with fresh ones (children
+    // of database are reloaded already)
+    Q_SIGNAL void databaseEntitiesRefreshed(DataBaseEntity * database);
+    // Some tables of database got stats fetched in background
+    Q_SIGNAL void tablesStatusFetched(DataBaseEntity * database);
 
 private:
     ConnectionsManager * connectionsManager() const;
     void initDatabasesListIfNeed();
 
     void clearAllDatabaseEntities();
+    void onDatabaseEntitiesRefreshed(const QString & name);
+    void onTablesStatusFetched(const QString & name);
 
     void addEntity(Entity * entity);
     void appendCreatedDatabase(
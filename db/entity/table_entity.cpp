@@ -14,6 +14,7 @@ TableEntity::TableEntity(const QString & tableName, DataBaseEntity * parent)
      _rowsCount(0),
      _dataSize(0),
      _version(0),
+     _isStatusFetched(true),
      _structure(nullptr)
 {
 
@@ -63,6 +64,18 @@ DataBaseEntity * TableEntity::database() const
     return static_cast<DataBaseEntity *>(parent());
 }
 
+void TableEntity::setStatus(const TableStatus & status)
+{
+    _engineStr = status.engine;
+    _collation = status.collation;
+    _rowsCount = status.rowsCount;
+    _dataSize = status.dataSize;
+    _version = status.version;
+    setCreated(status.created);
+    setUpdated(status.updated);
+    _isStatusFetched = true;
+}
+
 TableEntityPtr TableEntity::deepCopy() const
 {
     TableEntityPtr copy = EntityFactory::createTable(_tableName, database());
@@ -87,6 +100,7 @@ void TableEntity::copyDataFrom(const Entity * data)
     this->_rowsCount = table->_rowsCount;
     this->_dataSize  = table->_dataSize;
     this->_version   = table->_version;
+    this->_isStatusFetched = table->_isStatusFetched;
 
     delete this->_structure;
     this->_structure = nullptr;
@@ -13,6 +13,19 @@ class DataBaseEntity;
 class TableEntity;
 using TableEntityPtr = std::shared_ptr<TableEntity>;
 
+// Stats of table that server may compute slowly for many tables
+struct TableStatus
+{
+    QString name;
+    QString engine;
+    QString collation;
+    db::ulonglong rowsCount = 0;
+    db::ulonglong dataSize = 0;
+    db::ulonglong version = 0;
+    QDateTime created;
+    QDateTime updated;
+};
+
 class TableEntity : public EntityInDatabase
 {
 private: // use EntityFactory for instantiation
@@ -46,6 +59,11 @@ public:
     db::ulonglong version() const { return _version; }
     void setVersion(db::ulonglong version) { _version = version; }
 
+    // false if table was listed without stats
+    bool isStatusFetched() const { return _isStatusFetched; }
+    void setStatusFetched(bool fetched) { _isStatusFetched = fetched; }
+    void setStatus(const TableStatus & status);
+
     db::TableStructure * structure() const;
     bool hasStructure() const;
 
@@ -64,6 +82,7 @@ private:
     db::ulonglong _rowsCount;
     db::ulonglong _dataSize;
     db::ulonglong _version;
+    bool _isStatusFetched;
 
     mutable db::TableStructure * _structure; // TODO: unique_ptr
 };
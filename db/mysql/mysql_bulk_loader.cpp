@@ -0,0 +1,208 @@
+#include "mysql_bulk_loader.h"
+#include <algorithm>
+#include <cstring>
+#include <QRegularExpression>
+#include "helpers/logger.h"
+
+// https://dev.mysql.com/doc/c-api/5.7/en/mysql-set-local-infile-handler.html
+
+namespace meow {
+namespace db {
+
+namespace {
+
+struct LocalInfileData
+{
+    const QByteArray * data;
+    int offset;
+};
+
+int localInfileInit(void ** ptr, const char * filename, void * userdata)
+{
+    Q_UNUSED(filename); // name in statement is a placeholder
+    LocalInfileData * infile = static_cast<LocalInfileData *>(userdata);
+    infile->offset = 0;
+    *ptr = infile;
+    return 0;
+}
+
+int localInfileRead(void * ptr, char * buf, unsigned int bufLength)
+{
+    LocalInfileData * infile = static_cast<LocalInfileData *>(ptr);
+    int count = std::min(static_cast<int>(bufLength),
+                         infile->data->size() - infile->offset);
+    std::memcpy(buf, infile->data->constData() + infile->offset,
+                static_cast<std::size_t>(count));
+    infile->offset += count;
+    return count; // 0 - end of data
+}
+
+void localInfileEnd(void * ptr)
+{
+    Q_UNUSED(ptr);
+}
+
+int localInfileError(void * ptr, char * errorMsg, unsigned int errorMsgLength)
+{
+    Q_UNUSED(ptr);
+    qstrncpy(errorMsg, "Failed to read data of bulk load", errorMsgLength);
+    return 2000; // CR_UNKNOWN_ERROR
+}
+
+} // namespace
+
+MySQLBulkLoader::MySQLBulkLoader(MySQLConnection * connection,
+                                 MYSQL * handle,
+                                 const QString & quotedTable,
+                                 const QStringList & columns)
+    : BulkLoader(connection, quotedTable, columns)
+    , _mysqlConnection(connection)
+    , _handle(handle)
+    , _useInserts(false)
+{
+    Q_ASSERT(_handle != nullptr);
+}
+
+void MySQLBulkLoader::begin()
+{
+    // client always sends CLIENT_LOCAL_FILES, but server may refuse
+    try {
+        _useInserts = _connection->getCell("SELECT @@GLOBAL.local_infile")
+                .toInt() == 0;
+    } catch(meow::db::Exception & ex) {
+        Q_UNUSED(ex);
+        _useInserts = true;
+    }
+
+    if (_useInserts) {
+        meowLogCC(Log::Category::Info, _connection)
+            << "Server has local_infile disabled, rows are loaded by INSERTs";
+    }
+
+    BulkLoader::begin();
+}
+
+void MySQLBulkLoader::addRow(const QStringList & values)
+{
+    if (_useInserts) {
+        BulkLoader::addRow(values);
+    } else {
+        appendTextRow(values);
+    }
+}
+
+BulkLoader::FlushResult MySQLBulkLoader::flush()
+{
+    if (_useInserts) {
+        return BulkLoader::flush();
+    }
+
+    if (_bufferedRowsCount == 0) {
+        return {};
+    }
+
+    QString characterSet;
+    if (_connection->isUnicode()) {
+        characterSet = _connection->serverVersionInt() >= 50503
+                ? "utf8mb4" : "utf8";
+    } else {
+        characterSet = _connection->characterSet();
+    }
+
+    QString SQL = "LOAD DATA LOCAL INFILE 'meow_bulk_load' INTO TABLE "
+            + _quotedTable
+            + (characterSet.isEmpty()
+               ? QString() : " CHARACTER SET " + characterSet)
+            + " FIELDS TERMINATED BY '\\t' ESCAPED BY '\\\\'"
+              " LINES TERMINATED BY '\\n'"
+              " (" + quotedColumns() + ")";
+
+    QByteArray data = _connection->isUnicode()
+            ? _buffer.toUtf8() : _buffer.toLatin1();
+    clearBuffer();
+
+    // Records: 3  Deleted: 0  Skipped: 1  Warnings: 2
+    QString info = loadLocalData(SQL, data);
+
+    static const QRegularExpression infoRegexp(
+        "Skipped:\\s*(\\d+)\\s+Warnings:\\s*(\\d+)");
+    QRegularExpressionMatch match = infoRegexp.match(info);
+
+    // LOCAL implies IGNORE: duplicates are skipped with a warning each,
+    // bad values are converted with a warning
+    FlushResult result;
+    if (match.hasMatch()) {
+        db::ulonglong warningsCount = match.captured(2).toULongLong();
+        result.rejectedCount = match.captured(1).toULongLong();
+        result.warningsCount = warningsCount
+                - std::min(warningsCount, result.rejectedCount);
+    }
+
+    if (result.rejectedCount + result.warningsCount > 0) {
+        // only first @@max_error_count of them, just to show
+        result.issues = fetchWarnings();
+    }
+
+    return result;
+}
+
+QString MySQLBulkLoader::loadLocalData(const QString & SQL,
+                                       const QByteArray & data)
+{
+    threads::MutexLocker locker(_connection->mutex()); // protects _handle
+
+    meowLogCC(Log::Category::SQL, _connection) << SQL;
+
+    LocalInfileData infile = { &data, 0 };
+
+    mysql_set_local_infile_handler(_handle,
+                                   localInfileInit,
+                                   localInfileRead,
+                                   localInfileEnd,
+                                   localInfileError,
+                                   &infile);
+
+    QByteArray nativeSQL = _connection->isUnicode()
+            ? SQL.toUtf8() : SQL.toLatin1();
+
+    int queryStatus = mysql_real_query(_handle,
+                                       nativeSQL.constData(),
+                                       nativeSQL.size());
+
+    mysql_set_local_infile_default(_handle);
+
+    if (queryStatus != 0) {
+        QString error = _mysqlConnection->getLastError();
+        meowLogCC(Log::Category::Error, _connection)
+            << "Bulk load failed: " << error;
+        throw db::Exception(error);
+    }
+
+    const char * info = mysql_info(_handle);
+    return info ? QString(info) : QString();
+}
+
+std::vector<BulkLoader::Issue> MySQLBulkLoader::fetchWarnings()
+{
+    std::vector<Issue> issues;
+
+    // Level, Code, Message
+    QList<QStringList> warnings = _connection->getRows("SHOW WARNINGS");
+
+    static const QRegularExpression rowRegexp(" at row (\\d+)");
+
+    for (const QStringList & warning : warnings) {
+        Issue issue;
+        issue.message = warning.value(2);
+        QRegularExpressionMatch match = rowRegexp.match(issue.message);
+        issue.row = match.hasMatch() ? match.captured(1).toInt() - 1 : -1;
+        // duplicates are skipped, bad values are converted
+        issue.isRejected = warning.value(1).toInt() == 1062; // ER_DUP_ENTRY
+        issues.push_back(issue);
+    }
+
+    return issues;
+}
+
+} // namespace db
+} // namespace meow
@@ -0,0 +1,38 @@
+#ifndef DB_MYSQL_BULK_LOADER_H
+#define DB_MYSQL_BULK_LOADER_H
+
+#include "db/bulk_loader.h"
+#include "mysql_connection.h"
+
+namespace meow {
+namespace db {
+
+// Intent: loads portions with LOAD DATA LOCAL INFILE, data is read from
+// memory by own infile handler, so no temporary files are written.
+// Falls back to INSERTs when server has local_infile disabled.
+class MySQLBulkLoader : public BulkLoader
+{
+public:
+    MySQLBulkLoader(MySQLConnection * connection,
+                    MYSQL * handle,
+                    const QString & quotedTable,
+                    const QStringList & columns);
+
+    virtual void begin() override;
+    virtual void addRow(const QStringList & values) override;
+    virtual FlushResult flush() override;
+
+private:
+    // returns mysql_info() of statement
+    QString loadLocalData(const QString & SQL, const QByteArray & data);
+    std::vector<Issue> fetchWarnings();
+
+    MySQLConnection * _mysqlConnection;
+    MYSQL * _handle;
+    bool _useInserts;
+};
+
+} // namespace db
+} // namespace meow
+
+#endif // DB_MYSQL_BULK_LOADER_H
@@ -1,5 +1,6 @@
 #include "mysql_connection.h"
 #include "mysql_connection_query_killer.h"
+#include "mysql_bulk_loader.h"
 #include "db/query.h"
 #include "mysql_entities_fetcher.h"
 #include "mysql_query_data_fetcher.h"
@@ -8,8 +9,11 @@
 #include "db/database_editor.h"
 #include "mysql_collation_fetcher.h"
 #include "mysql_table_engines_fetcher.h"
+#include "mysql_table_structures_fetcher.h"
 #include "db/entity/mysql_entity_filter.h"
 #include "mysql_query_result.h"
+#include "mysql_streamed_query_result.h"
+#include "mysql_prepared_statement.h"
 #include "helpers/logger.h"
 #include "mysql_database_editor.h"
 #include "db/data_type/mysql_connection_data_types.h"
@@ -68,7 +72,7 @@ MySQLConnection::~MySQLConnection()
 void MySQLConnection::setActive(bool active) // override
 {
 
-    MEOW_ASSERT_MAIN_THREAD
+    MEOW_ASSERT_MAIN_THREAD_OR_POOLED(this)
 
     threads::MutexLocker locker(mutex()); // protects _handle
 
@@ -98,51 +102,12 @@ void MySQLConnection::setActive(bool active) // override
             port = _sshTunnel->params().localPort();
         }
 
-        _handle = mysql_init(nullptr); // TODO: valgrind says it leaks?
-        // TODO _handle== NULL
-
-        // TODO: H: SSL, named pipe
-
-        unsigned long clientFlags =
-                  CLIENT_LOCAL_FILES
-                | CLIENT_INTERACTIVE
-                | CLIENT_PROTOCOL_41
-                | CLIENT_MULTI_STATEMENTS;
-
-        // TODO: H: flags SSL
-        // TODO: H: MYSQL_PLUGIN_DIR
-
-        QByteArray hostBytes = hostName.toLatin1();
-        QByteArray userBytes = params->userName().toLatin1();
-        QByteArray pswdBytes = params->password().toLatin1();
-
-        const char * host = hostBytes.constData();
-        const char * user = userBytes.constData();
-        const char * pswd = pswdBytes.constData();
-
         meowLogDebugC(this) << "Connecting: " << *params;
 
-        if (connectionParams()->isCompressed()) {
-            mysql_options(_handle, MYSQL_OPT_COMPRESS, nullptr);
-#if LIBMYSQL_VERSION_ID > 80000 // available since mysql 8.0
-            mysql_options(_handle, MYSQL_OPT_COMPRESSION_ALGORITHMS, "zlib,zstd");
-#endif
-        }
+        QString error;
+        _handle = connectHandle(hostName, port, &error);
 
-        MYSQL * connectedHandle = mysql_real_connect(
-            _handle,
-            host,
-            user,
-            pswd,
-            nullptr, // db
-            port,
-            nullptr, // unix_socket
-            clientFlags
-        );
-
-        if (connectedHandle == nullptr) {
-
-            QString error = getLastError();
+        if (_handle == nullptr) {
 
             meowLogCC(Log::Category::Error, this) << "Connect failed: " << error;
             _sshTunnel.reset();
@@ -196,6 +161,7 @@ void MySQLConnection::setActive(bool active) // override
 
         doAfterConnect();
     } else if (!active && _handle != nullptr) {
+        clearPreparedStatements();
         mysql_close(_handle);
         _active = false;
         // H: ClearCache(False);
@@ -216,7 +182,7 @@ QString MySQLConnection::getLastError() // override
 
 QString MySQLConnection::fetchCharacterSet() // override
 {
-    MEOW_ASSERT_MAIN_THREAD
+    MEOW_ASSERT_MAIN_THREAD_OR_POOLED(this)
 
     const char * charSet = mysql_character_set_name(_handle);
 
@@ -232,7 +198,7 @@ QString MySQLConnection::fetchCharacterSet() // override
 
 void MySQLConnection::setCharacterSet(const QString & characterSet) // override
 {
-    MEOW_ASSERT_MAIN_THREAD
+    MEOW_ASSERT_MAIN_THREAD_OR_POOLED(this)
 
     // H:   FStatementNum := 0
 
@@ -252,7 +218,7 @@ void MySQLConnection::setCharacterSet(const QString & characterSet) // override
 
 bool MySQLConnection::ping(bool reconnect) // override
 {
-    MEOW_ASSERT_MAIN_THREAD
+    MEOW_ASSERT_MAIN_THREAD_OR_POOLED(this)
 
     if (mutex()->tryLock() == false) {
         // Don't ping if we are busy in another thread
@@ -336,6 +302,179 @@ QueryResults MySQLConnection::query(const QString & SQL,
 
     // TODO: H: if QueryResult = nil then DetectUSEQuery(SQL);
 
+    fetchQueryResults(queryResult, storeResult, results);
+
+    // H:     FResultCount := Length(FLastRawResults);
+
+    meowLogDebugC(this) << "Query rows found/affected: " << results.rowsFound()
+                        << "/" << results.rowsAffected();
+
+    return results;
+}
+
+QueryResults MySQLConnection::queryStreamed(const QString & SQL)
+{
+    threads::MutexLocker locker(mutex());
+
+    meowLogCC(Log::Category::SQL, this) << SQL;
+
+    QueryResults results;
+
+    if (threads::isCurrentThreadMain()) {
+        ping(true);
+    }
+
+    QByteArray nativeSQL;
+
+    if (isUnicode()) {
+        nativeSQL = SQL.toUtf8();
+    } else {
+        nativeSQL = SQL.toLatin1();
+    }
+
+    QElapsedTimer elapsedTimer;
+
+    elapsedTimer.start();
+    int queryStatus = mysql_real_query(_handle,
+                                       nativeSQL.constData(),
+                                       nativeSQL.size());
+    results.incExecDuration(std::chrono::milliseconds(elapsedTimer.elapsed()));
+
+    if (queryStatus != 0) {
+        QString error = getLastError();
+        meowLogCC(Log::Category::Error, this) << "Query failed: " << error;
+        throw db::Exception(error);
+    }
+
+    results.setWarningsCount(mysql_warning_count(_handle));
+
+    // rows are not read here, but on MySQLStreamedQueryResult::fetchMore()
+    MYSQL_RES * queryResult = mysql_use_result(_handle);
+
+    if (queryResult == nullptr) {
+        if (mysql_field_count(_handle) != 0) {
+            QString error = getLastError();
+            meowLogCC(Log::Category::Error, this) << "Query (use) failed: "
+                                                  << error;
+            throw db::Exception(error);
+        }
+        // no result set, nothing to stream
+        fetchQueryResults(nullptr, true, results);
+        return results;
+    }
+
+    // result keeps connection locked until all rows are fetched
+    auto result = std::make_shared<MySQLStreamedQueryResult>(this);
+    result->init(queryResult, _handle);
+    results << result;
+
+    return results;
+}
+
+MYSQL * MySQLConnection::connectHandle(const QString & hostName,
+                                       unsigned int port,
+                                       QString * error) const
+{
+    MYSQL * handle = mysql_init(nullptr); // TODO: valgrind says it leaks?
+    if (handle == nullptr) {
+        *error = QObject::tr("Not enough memory to connect");
+        return nullptr;
+    }
+
+    // TODO: H: SSL, named pipe
+
+    unsigned long clientFlags =
+              CLIENT_LOCAL_FILES
+            | CLIENT_INTERACTIVE
+            | CLIENT_PROTOCOL_41
+            | CLIENT_MULTI_STATEMENTS;
+
+    // TODO: H: flags SSL
+    // TODO: H: MYSQL_PLUGIN_DIR
+
+    const ConnectionParameters * params = connectionParams();
+
+    QByteArray hostBytes = hostName.toUtf8();
+    QByteArray userBytes = params->userName().toUtf8();
+    QByteArray pswdBytes = params->password().toUtf8();
+
+    if (params->isCompressed()) {
+        mysql_options(handle, MYSQL_OPT_COMPRESS, nullptr);
+#if LIBMYSQL_VERSION_ID > 80000 // available since mysql 8.0
+        mysql_options(handle, MYSQL_OPT_COMPRESSION_ALGORITHMS, "zlib,zstd");
+#endif
+    }
+
+    if (mysql_real_connect(handle,
+                           hostBytes.constData(),
+                           userBytes.constData(),
+                           pswdBytes.constData(),
+                           nullptr, // db
+                           port,
+                           nullptr, // unix_socket
+                           clientFlags) == nullptr) {
+        *error = QString(mysql_error(handle));
+        mysql_close(handle);
+        return nullptr;
+    }
+
+    return handle;
+}
+
+void MySQLConnection::killQuery(unsigned long connectionId)
+{
+    const ConnectionParameters * params = connectionParams();
+
+    QString hostName = params->hostName();
+    unsigned int port = params->port();
+    if (_sshTunnel) {
+        hostName = "127.0.0.1";
+        port = _sshTunnel->params().localPort();
+    }
+
+    QString error;
+
+    // same options as this connection has, e.g. server may require them
+    MYSQL * handle = connectHandle(hostName, port, &error);
+    if (handle == nullptr) {
+        throw db::Exception(error);
+    }
+
+    QByteArray SQL = QString("KILL QUERY %1").arg(connectionId).toLatin1();
+    meowLogCC(Log::Category::SQL, this) << SQL;
+    if (mysql_real_query(handle, SQL.constData(), SQL.size()) != 0) {
+        error = QString(mysql_error(handle));
+    }
+
+    mysql_close(handle);
+
+    if (!error.isEmpty()) {
+        throw db::Exception(error);
+    }
+}
+
+void MySQLConnection::discardPendingResults()
+{
+    int queryStatus = 0;
+    while ((queryStatus = mysql_next_result(_handle)) == 0) {
+        MYSQL_RES * queryResult = mysql_store_result(_handle);
+        if (queryResult) {
+            mysql_free_result(queryResult);
+        }
+    }
+    if (queryStatus > 0) {
+        meowLogCC(Log::Category::Error, this) << "Query (next) failed: "
+                                              << getLastError();
+    }
+}
+
+void MySQLConnection::fetchQueryResults(MYSQL_RES * queryResult,
+                                        bool storeResult,
+                                        QueryResults & results)
+{
+    int queryStatus = 0;
+    QElapsedTimer elapsedTimer;
+
     while (queryStatus == 0) {
         if (queryResult != nullptr) {
             // Statement returned a result set
@@ -372,12 +511,6 @@ QueryResults MySQLConnection::query(const QString & SQL,
             throw db::Exception(error);
         }
     }
-    // H:     FResultCount := Length(FLastRawResults);
-
-    meowLogDebugC(this) << "Query rows found/affected: " << results.rowsFound()
-                        << "/" << results.rowsAffected();
-
-    return results;
 }
 
 QStringList MySQLConnection::fetchDatabases()
@@ -446,7 +579,7 @@ QString MySQLConnection::unescapeString(const QString & str) const
 
 void MySQLConnection::setDatabase(const QString & database) // override
 {
-    MEOW_ASSERT_MAIN_THREAD
+    MEOW_ASSERT_MAIN_THREAD_OR_POOLED(this)
 
     if (database == _database) {
         return;
@@ -608,15 +741,47 @@ TableEnginesFetcher * MySQLConnection::createTableEnginesFetcher()
     return new MySQLTableEnginesFetcher(this);
 }
 
+TableStructuresFetcher * MySQLConnection::createTableStructuresFetcher()
+{
+    if (serverVersionInt() < 50000) {
+        return nullptr; // no information_schema
+    }
+    return new MySQLTableStructuresFetcher(this);
+}
+
 QString MySQLConnection::limitOnePostfix(bool select) const
 {
     Q_UNUSED(select); // same for SELECT, UPDATE and DELETE
     return "LIMIT 1";
 }
 
+PreparedStatementPtr MySQLConnection::prepare(const QString & SQL)
+{
+    threads::MutexLocker locker(mutex()); // protects _handle
+
+    meowLogDebugC(this) << "Prepare: " << SQL;
+
+    MYSQL_STMT * stmt = mysql_stmt_init(_handle);
+    if (stmt == nullptr) {
+        throw db::Exception(getLastError());
+    }
+
+    QByteArray nativeSQL = isUnicode() ? SQL.toUtf8() : SQL.toLatin1();
+
+    if (mysql_stmt_prepare(stmt, nativeSQL.constData(),
+                           static_cast<unsigned long>(nativeSQL.size())) != 0) {
+        QString error = QString(mysql_stmt_error(stmt));
+        mysql_stmt_close(stmt);
+        meowLogCC(Log::Category::Error, this) << "Prepare failed: " << error;
+        throw db::Exception(error);
+    }
+
+    return std::make_shared<MySQLPreparedStatement>(this, stmt, SQL);
+}
+
 int64_t MySQLConnection::connectionIdOnServer()
 {
-    MEOW_ASSERT_MAIN_THREAD // TODO: do atomic
+    MEOW_ASSERT_MAIN_THREAD_OR_POOLED(this) // TODO: do atomic
     if (_connectionIdOnServer == -1) {
         _connectionIdOnServer = 0; // requesting status to avoid recursion
         _connectionIdOnServer
@@ -631,6 +796,14 @@ ConnectionQueryKillerPtr MySQLConnection::createQueryKiller() const
                 const_cast<MySQLConnection *>(this));
 }
 
+std::unique_ptr<BulkLoader> MySQLConnection::createBulkLoader(
+        const TableEntity * table,
+        const QStringList & columns)
+{
+    return std::unique_ptr<BulkLoader>(
+        new MySQLBulkLoader(this, _handle, quotedFullName(table), columns));
+}
+
 ConnectionDataTypes * MySQLConnection::createConnectionDataTypes()
 {
     return new MySQLConnectionDataTypes(this);
@@ -47,6 +47,16 @@ public:
             const QString & SQL,
             bool storeResult = false) override;
 
+    virtual QueryResults queryStreamed(const QString & SQL) override;
+
+    // Skips rest results of multi-statement query, expects locked mutex
+    void discardPendingResults();
+
+    // KILL QUERY over a short-lived handle to the same server (through
+    // tunnel if any), so it is safe in any thread and while this connection
+    // is locked. Throws on error.
+    void killQuery(unsigned long connectionId);
+
     virtual QString escapeString(const QString & str,
                                  bool processJokerChars = false,
                                  bool doQuote = true) const override;
@@ -85,6 +95,10 @@ public:
 
     virtual ConnectionQueryKillerPtr createQueryKiller() const override;
 
+    virtual std::unique_ptr<BulkLoader> createBulkLoader(
+            const TableEntity * table,
+            const QStringList & columns) override;
+
     MySQLForkType forkType() const { return _forkType; }
     bool isMariaDB() const { return _forkType == MySQLForkType::MariaDB; }
 
@@ -96,6 +110,7 @@ protected:
     virtual DataBaseEditor * createDataBaseEditor() override;
 
     virtual TableEnginesFetcher * createTableEnginesFetcher() override;
+    virtual TableStructuresFetcher * createTableStructuresFetcher() override;
     virtual ConnectionDataTypes * createConnectionDataTypes() override;
 
     virtual ConnectionFeatures * createFeatures() override;   
@@ -103,8 +118,20 @@ protected:
     virtual IUserManager * createUserManager() override;
     virtual IUserEditor * createUserEditor() override;
 
+    virtual PreparedStatementPtr prepare(const QString & SQL) override;
+
 private:
 
+    // New handle connected with options and credentials of params,
+    // nullptr and error if failed
+    MYSQL * connectHandle(const QString & hostName,
+                          unsigned int port,
+                          QString * error) const;
+
+    void fetchQueryResults(MYSQL_RES * queryResult,
+                           bool storeResult,
+                           QueryResults & results);
+
     QString getViewCreateCode(const ViewEntity * view);
 
     MySQLForkType forkTypeFromVersion(const QString & versionString) const;
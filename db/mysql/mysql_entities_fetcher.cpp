@@ -12,6 +12,77 @@
 namespace meow {
 namespace db {
 
+namespace {
+
+// Indices of SHOW TABLE STATUS columns
+struct TableStatusColumns
+{
+    explicit TableStatusColumns(Query * query)
+        : name(query->indexOfColumn("Name"))
+        , engine(query->indexOfColumn("Engine"))
+        , dataLen(query->indexOfColumn("Data_length"))
+        , indexLen(query->indexOfColumn("Index_length"))
+        , rows(query->indexOfColumn("Rows"))
+        , collation(query->indexOfColumn("Collation"))
+        , createTime(query->indexOfColumn("Create_time"))
+        , updateTime(query->indexOfColumn("Update_time"))
+        , version(query->indexOfColumn("Version"))
+    {
+
+    }
+
+    std::size_t name;
+    std::size_t engine;
+    std::size_t dataLen;
+    std::size_t indexLen;
+    std::size_t rows;
+    std::size_t collation;
+    std::size_t createTime;
+    std::size_t updateTime;
+    std::size_t version;
+};
+
+TableStatus readTableStatus(Query * resPtr, const TableStatusColumns & columns)
+{
+    TableStatus status;
+
+    status.name = resPtr->curRowColumn(columns.name);
+    // data size
+    if (!resPtr->isNull(columns.dataLen) && !resPtr->isNull(columns.indexLen)) {
+        auto dataLen = resPtr->curRowColumn(columns.dataLen).toULongLong();
+        auto indexLen = resPtr->curRowColumn(columns.indexLen).toULongLong();
+        status.dataSize = dataLen + indexLen;
+    }
+    // engine
+    status.engine = resPtr->curRowColumn(columns.engine);
+    // rows count
+    if (!resPtr->isNull(columns.rows)) {
+        status.rowsCount = resPtr->curRowColumn(columns.rows).toULongLong();
+    }
+    // collation
+    if (!resPtr->isNull(columns.collation)) {
+        status.collation = resPtr->curRowColumn(columns.collation);
+    }
+    // create time
+    if (!resPtr->isNull(columns.createTime)) {
+        status.created = helpers::parseDateTime(
+            resPtr->curRowColumn(columns.createTime));
+    }
+    // update time
+    if (!resPtr->isNull(columns.updateTime)) {
+        status.updated = helpers::parseDateTime(
+            resPtr->curRowColumn(columns.updateTime));
+    }
+    // version
+    if (!resPtr->isNull(columns.version)) {
+        status.version = resPtr->curRowColumn(columns.version).toULongLong();
+    }
+
+    return status;
+}
+
+} // namespace
+
 MySQLEntitiesFetcher::MySQLEntitiesFetcher(MySQLConnection * connection)
     :DataBaseEntitiesFetcher(connection)
 {
@@ -40,99 +111,151 @@ QList<EntityPtr> MySQLEntitiesFetcher::run(const QString & dbName)
     return list;
 }
 
+QString MySQLEntitiesFetcher::fingerprint(const QString & dbName)
+{
+    if (_connection->serverVersionInt() < 50000) {
+        return QString(); // no information_schema
+    }
+
+    const QString db = _connection->escapeString(dbName);
+
+    // counts, latest times and checksums of definitions: CREATE_TIME
+    // misses in-place ALTER and views (NULL), so columns, indices and view
+    // bodies are summed up too. UPDATE_TIME changes with data too (cache
+    // is refetched a bit more often). Runs in background, see
+    // SchemaCacheValidationTask
+    auto changes = [&db](const QString & aggregates,
+                         const QString & table,
+                         const QString & schemaColumn) {
+        return "(SELECT CONCAT_WS(':', COUNT(*), " + aggregates
+            + ") FROM information_schema." + table
+            + " WHERE " + schemaColumn + " = " + db + ")";
+    };
+    auto checksum = [](const QString & columns) {
+        return "SUM(CRC32(CONCAT_WS(':', " + columns + ")))";
+    };
+
+    QStringList parts;
+    parts << changes("MAX(CREATE_TIME), MAX(UPDATE_TIME)",
+                     "TABLES", "TABLE_SCHEMA")
+          << changes(checksum("TABLE_NAME, COLUMN_NAME, ORDINAL_POSITION,"
+                              " COLUMN_TYPE, IS_NULLABLE, COLUMN_DEFAULT,"
+                              " EXTRA, COLUMN_COMMENT"),
+                     "COLUMNS", "TABLE_SCHEMA")
+          << changes(checksum("TABLE_NAME, INDEX_NAME, SEQ_IN_INDEX,"
+                              " COLUMN_NAME, NON_UNIQUE"),
+                     "STATISTICS", "TABLE_SCHEMA")
+          << changes(checksum("TABLE_NAME, VIEW_DEFINITION"),
+                     "VIEWS", "TABLE_SCHEMA")
+          << changes("MAX(LAST_ALTERED)",
+                     "ROUTINES", "ROUTINE_SCHEMA");
+
+    if (_connection->serverVersionInt() >= 50010) {
+        parts << changes(checksum("TRIGGER_NAME, EVENT_OBJECT_TABLE,"
+                                  " ACTION_STATEMENT"),
+                         "TRIGGERS", "TRIGGER_SCHEMA");
+    }
+
+    try {
+        return _connection->getRow("SELECT " + parts.join(", ")).join(';');
+    } catch(meow::db::Exception & ex) {
+        meowLogCC(Log::Category::Error, _connection)
+                << "Failed to check entities of " << dbName
+                << ": " << ex.message();
+    }
+    return QString();
+}
+
 void MySQLEntitiesFetcher::fetchTablesViews(const QString & dbName,
                                             QList<EntityPtr> * toList)
 {
     bool fullTableStatus = _connection->connectionParams()->fullTableStatus();
 
+    if (!fullTableStatus
+            && (QString::compare(dbName, "INFORMATION_SCHEMA",
+                                 Qt::CaseInsensitive) != 0)) {
+        fetchTablesViewsList(dbName, toList);
+        return;
+    }
+
     QueryPtr queryResults;
 
-    if (fullTableStatus
-            || (QString::compare(dbName, "INFORMATION_SCHEMA",
-                                 Qt::CaseInsensitive) == 0)) {
+    try {
+        queryResults = _connection->getResults(
+                    QString("SHOW TABLE STATUS FROM ") +
+                    _connection->quoteIdentifier(dbName));
+    } catch(meow::db::Exception & ex) {
+        meowLogCC(Log::Category::Error, _connection)
+                << "Failed to fetch tables/views: " << ex.message();
+        return;
+    }
 
-        try {
-            queryResults = _connection->getResults(
-                        QString("SHOW TABLE STATUS FROM ") +
-                        _connection->quoteIdentifier(dbName));
-        } catch(meow::db::Exception & ex) {
-            meowLogCC(Log::Category::Error, _connection)
-                    << "Failed to fetch tables/views: " << ex.message();
-            return;
+    Query * resPtr = queryResults.get();
+
+    if (resPtr) {
+
+        TableStatusColumns columns(resPtr);
+
+        while (resPtr->isEof() == false) {
+
+            bool isView = resPtr->isNull(columns.engine)
+                    && resPtr->isNull(columns.version);
+
+            QString name = resPtr->curRowColumn(columns.name);
+
+            if (isView) {
+                ViewEntityPtr view = EntityFactory::createView(name);
+                toList->append(view);
+            } else {
+                TableEntityPtr table = EntityFactory::createTable(name);
+                table->setStatus(readTableStatus(resPtr, columns));
+                toList->append(table);
+            }
+
+            resPtr->seekNext();
         }
-    } else {
-        Q_ASSERT(false);
-        meowLogDebug() << "Not implemented";
+    }
+}
+
+void MySQLEntitiesFetcher::fetchTablesViewsList(const QString & dbName,
+                                                QList<EntityPtr> * toList)
+{
+    // names and types only: server doesn't compute stats of every table
+    bool hasTypes = _connection->serverVersionInt() >= 50002;
+
+    QueryPtr queryResults;
+
+    try {
+        queryResults = _connection->getResults(
+                    QString(hasTypes ? "SHOW FULL TABLES FROM "
+                                     : "SHOW TABLES FROM ") +
+                    _connection->quoteIdentifier(dbName));
+    } catch(meow::db::Exception & ex) {
+        meowLogCC(Log::Category::Error, _connection)
+                << "Failed to fetch tables/views: " << ex.message();
+        return;
     }
 
     Query * resPtr = queryResults.get();
 
     if (resPtr) {
 
-        std::size_t indexOfName       = resPtr->indexOfColumn("Name");
-        std::size_t indexOfEngine     = resPtr->indexOfColumn("Engine");
-        std::size_t indexOfDataLen    = resPtr->indexOfColumn("Data_length");
-        std::size_t indexOfIndexLen   = resPtr->indexOfColumn("Index_length");
-        std::size_t indexOfRows       = resPtr->indexOfColumn("Rows");
-        std::size_t indexOfCollation  = resPtr->indexOfColumn("Collation");
-        std::size_t indexOfCreateTime = resPtr->indexOfColumn("Create_time");
-        std::size_t indexOfUpdateTime = resPtr->indexOfColumn("Update_time");
-        std::size_t indexOfVersion    = resPtr->indexOfColumn("Version");
+        const std::size_t indexOfName = 0; // Tables_in_<dbName>
+        const std::size_t indexOfType = 1; // Table_type
 
         while (resPtr->isEof() == false) {
 
-            bool isView = resPtr->isNull(indexOfEngine) && resPtr->isNull(indexOfVersion);
-
             QString name = resPtr->curRowColumn(indexOfName);
 
+            bool isView = hasTypes
+                    && resPtr->curRowColumn(indexOfType) == "VIEW";
+
             if (isView) {
                 ViewEntityPtr view = EntityFactory::createView(name);
                 toList->append(view);
             } else {
                 TableEntityPtr table = EntityFactory::createTable(name);
-                // data size
-                if (!resPtr->isNull(indexOfDataLen) && !resPtr->isNull(indexOfIndexLen)) {
-                    auto dataLen = resPtr->curRowColumn(indexOfDataLen).toULongLong();
-                    auto indexLen = resPtr->curRowColumn(indexOfIndexLen).toULongLong();
-                    table->setDataSize(dataLen + indexLen);
-                }
-                // engine
-                table->setEngine(resPtr->curRowColumn(indexOfEngine));
-                // rows count
-                if (!resPtr->isNull(indexOfRows)) {
-                    table->setRowsCount(
-                        resPtr->curRowColumn(indexOfRows).toULongLong()
-                    );
-                }
-                // collation
-                if (!resPtr->isNull(indexOfCollation)) {
-                    table->setCollation(
-                        resPtr->curRowColumn(indexOfCollation)
-                    );
-                }
-                // create time
-                if (!resPtr->isNull(indexOfCreateTime)) {
-                    table->setCreated(
-                        helpers::parseDateTime(
-                            resPtr->curRowColumn(indexOfCreateTime)
-                        )
-                    );
-                }
-                // update time
-                if (!resPtr->isNull(indexOfUpdateTime)) {
-                    table->setUpdated(
-                        helpers::parseDateTime(
-                            resPtr->curRowColumn(indexOfUpdateTime)
-                        )
-                    );
-                }
-                // version
-                if (!resPtr->isNull(indexOfVersion)) {
-                    table->setVersion(
-                        resPtr->curRowColumn(indexOfVersion).toULongLong()
-                    );
-                }
-
+                table->setStatusFetched(false);
                 toList->append(table);
             }
 
@@ -141,6 +264,82 @@ void MySQLEntitiesFetcher::fetchTablesViews(const QString & dbName,
     }
 }
 
+QList<TableStatus> MySQLEntitiesFetcher::fetchTablesStatus(
+        const QString & dbName,
+        const QStringList & tables)
+{
+    QList<TableStatus> statusList;
+
+    if (tables.isEmpty()) {
+        return statusList;
+    }
+
+    auto connection = static_cast<MySQLConnection *>(_connection);
+
+    // SHOW TABLE STATUS ... WHERE reads stats of all tables of database and
+    // filters them after, so it's done per table by exact LIKE on 5.x.
+    // 8.0 data dictionary finds tables by name in information_schema
+    bool isDataDictionary = connection->serverVersionInt() >= 80000
+            && !connection->isMariaDB();
+
+    QStringList queries;
+
+    if (isDataDictionary) {
+        QStringList names;
+        for (const QString & table : tables) {
+            names << _connection->escapeString(table);
+        }
+        // named like columns of SHOW TABLE STATUS
+        queries << "SELECT TABLE_NAME AS `Name`, ENGINE AS `Engine`,"
+                   " VERSION AS `Version`, TABLE_ROWS AS `Rows`,"
+                   " DATA_LENGTH AS `Data_length`,"
+                   " INDEX_LENGTH AS `Index_length`,"
+                   " CREATE_TIME AS `Create_time`,"
+                   " UPDATE_TIME AS `Update_time`,"
+                   " TABLE_COLLATION AS `Collation`"
+                   " FROM information_schema.TABLES"
+                   " WHERE TABLE_SCHEMA = " + _connection->escapeString(dbName)
+                   + " AND TABLE_NAME IN (" + names.join(", ") + ")";
+    } else {
+        const QString from = "SHOW TABLE STATUS FROM "
+                + _connection->quoteIdentifier(dbName) + " LIKE ";
+        for (const QString & table : tables) {
+            QString pattern = table; // name, not wildcards
+            pattern.replace('\\', QLatin1String("\\\\"));
+            pattern.replace('%', QLatin1String("\\%"));
+            pattern.replace('_', QLatin1String("\\_"));
+            queries << from + _connection->escapeString(pattern);
+        }
+    }
+
+    for (const QString & SQL : queries) {
+
+        QueryPtr queryResults;
+
+        try {
+            queryResults = _connection->getResults(SQL);
+        } catch(meow::db::Exception & ex) {
+            meowLogCC(Log::Category::Error, _connection)
+                    << "Failed to fetch tables status: " << ex.message();
+            return statusList;
+        }
+
+        Query * resPtr = queryResults.get();
+
+        if (resPtr) {
+
+            TableStatusColumns columns(resPtr);
+
+            while (resPtr->isEof() == false) {
+                statusList.append(readTableStatus(resPtr, columns));
+                resPtr->seekNext();
+            }
+        }
+    }
+
+    return statusList;
+}
+
 void MySQLEntitiesFetcher::fetchStoredFunctions(const QString & dbName,
                                                 QList<EntityPtr> * toList)
 {
@@ -13,9 +13,15 @@ class MySQLEntitiesFetcher : public DataBaseEntitiesFetcher
 public:
     MySQLEntitiesFetcher(MySQLConnection * connection);
     virtual QList<EntityPtr> run(const QString & dbName) override;
+    virtual QString fingerprint(const QString & dbName) override;
+    virtual QList<TableStatus> fetchTablesStatus(
+            const QString & dbName,
+            const QStringList & tables) override;
 private:
     void fetchTablesViews(const QString & dbName,
                           QList<EntityPtr> * toList);
+    void fetchTablesViewsList(const QString & dbName,
+                              QList<EntityPtr> * toList);
     void fetchStoredFunctions(const QString & dbName,
                           QList<EntityPtr> * toList);
     void fetchStoredProcedures(const QString & dbName,
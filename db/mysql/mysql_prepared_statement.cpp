@@ -0,0 +1,94 @@
+#include "mysql_prepared_statement.h"
+#include <cstring>
+#include <vector>
+#include "helpers/logger.h"
+
+// https://dev.mysql.com/doc/c-api/5.7/en/c-api-prepared-statement-interface.html
+
+namespace meow {
+namespace db {
+
+MySQLPreparedStatement::MySQLPreparedStatement(MySQLConnection * connection,
+                                               MYSQL_STMT * stmt,
+                                               const QString & SQL)
+    : PreparedStatement(SQL)
+    , _connection(connection)
+    , _stmt(stmt)
+    , _rowsAffected(0)
+{
+    Q_ASSERT(_stmt != nullptr);
+}
+
+MySQLPreparedStatement::~MySQLPreparedStatement()
+{
+    threads::MutexLocker locker(_connection->mutex());
+    mysql_stmt_close(_stmt);
+}
+
+QStringList MySQLPreparedStatement::execute(const QStringList & params)
+{
+    threads::MutexLocker locker(_connection->mutex());
+
+    meowLogCC(Log::Category::SQL, _connection) << SQL();
+
+    std::size_t paramCount = static_cast<std::size_t>(params.size());
+
+    if (mysql_stmt_param_count(_stmt) != paramCount) {
+        throw db::Exception(
+            QString("Prepared statement expects %1 params, got %2")
+                .arg(mysql_stmt_param_count(_stmt))
+                .arg(paramCount));
+    }
+
+    // values must live until execution
+    std::vector<QByteArray> values(paramCount);
+    std::vector<MYSQL_BIND> binds(paramCount);
+
+    for (std::size_t i = 0; i < paramCount; ++i) {
+        const QString & param = params[static_cast<int>(i)];
+        MYSQL_BIND & bind = binds[i];
+        memset(&bind, 0, sizeof(MYSQL_BIND));
+        if (param.isNull()) {
+            bind.buffer_type = MYSQL_TYPE_NULL;
+        } else {
+            // server converts string to column type
+            values[i] = _connection->isUnicode()
+                    ? param.toUtf8() : param.toLatin1();
+            bind.buffer_type = MYSQL_TYPE_STRING;
+            bind.buffer = values[i].data();
+            bind.buffer_length = static_cast<unsigned long>(values[i].size());
+        }
+    }
+
+    if (paramCount > 0 && mysql_stmt_bind_param(_stmt, binds.data()) != 0) {
+        QString error = lastError();
+        meowLogCC(Log::Category::Error, _connection)
+            << "Statement bind failed: " << error;
+        throw db::Exception(error);
+    }
+
+    if (mysql_stmt_execute(_stmt) != 0) {
+        QString error = lastError();
+        meowLogCC(Log::Category::Error, _connection)
+            << "Statement failed: " << error;
+        throw db::Exception(error);
+    }
+
+    _rowsAffected = mysql_stmt_affected_rows(_stmt);
+
+    if (mysql_stmt_field_count(_stmt) > 0) {
+        // no DML returns rows in MySQL, just release the connection
+        mysql_stmt_store_result(_stmt);
+        mysql_stmt_free_result(_stmt);
+    }
+
+    return QStringList();
+}
+
+QString MySQLPreparedStatement::lastError() const
+{
+    return QString(mysql_stmt_error(_stmt));
+}
+
+} // namespace db
+} // namespace meow
@@ -0,0 +1,36 @@
+#ifndef DB_MYSQL_PREPARED_STATEMENT_H
+#define DB_MYSQL_PREPARED_STATEMENT_H
+
+#include "db/prepared_statement.h"
+#include "mysql_connection.h"
+
+namespace meow {
+namespace db {
+
+// Intent: mysql_stmt_* statement, params are sent via binary protocol
+class MySQLPreparedStatement : public PreparedStatement
+{
+public:
+    MySQLPreparedStatement(MySQLConnection * connection,
+                           MYSQL_STMT * stmt,
+                           const QString & SQL);
+    virtual ~MySQLPreparedStatement() override;
+
+    virtual QStringList execute(const QStringList & params) override;
+
+    virtual db::ulonglong rowsAffected() const override {
+        return _rowsAffected;
+    }
+
+private:
+    QString lastError() const;
+
+    MySQLConnection * _connection;
+    MYSQL_STMT * _stmt;
+    db::ulonglong _rowsAffected;
+};
+
+} // namespace db
+} // namespace meow
+
+#endif // DB_MYSQL_PREPARED_STATEMENT_H
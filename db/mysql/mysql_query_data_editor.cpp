@@ -10,9 +10,10 @@ namespace db {
 void MySQLQueryDataEditor::insert(
         QueryData * data,
         const QStringList & columns,
-        const QStringList & values)
+        const QStringList & values,
+        const QStringList * params)
 {
-    QueryDataEditor::insert(data, columns, values);
+    QueryDataEditor::insert(data, columns, values, params);
 
     EditableGridData * editableData = data->query()->editableData();
 
@@ -12,7 +12,8 @@ class MySQLQueryDataEditor : public QueryDataEditor
 protected:
     virtual void insert(QueryData * data,
                 const QStringList & columns,
-                const QStringList & values) override;
+                const QStringList & values,
+                const QStringList * params) override;
 
 };
 
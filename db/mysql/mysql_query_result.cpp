@@ -10,7 +10,6 @@ namespace db {
 MySQLQueryResult::MySQLQueryResult(Connection * connection)
     : NativeQueryResult(connection)
     , _res(nullptr)
-    , _curRow(nullptr)
     , _columnsParsed(false)
 {
 
@@ -18,16 +17,21 @@ MySQLQueryResult::MySQLQueryResult(Connection * connection)
 
 void MySQLQueryResult::init(MYSQL_RES * res)
 {
-    Q_ASSERT( res != nullptr);
-    Q_ASSERT(_res == nullptr);
+    initColumns(res);
 
-    _res = res;
+    // decode all rows once, then cells are served from storage
+    ColumnarResultStorage::Batch batch(
+        columnCount(), static_cast<std::size_t>(mysql_num_rows(_res)));
 
-    _recordCount = nativeRowsCount();
+    MYSQL_ROW rowData;
+    while ((rowData = mysql_fetch_row(_res))) {
+        appendRowTo(batch, rowData, mysql_fetch_lengths(_res));
+    }
 
-    clearColumnData();
+    _storage.addBatch(std::move(batch));
+    freeNative();
 
-    addColumnData(_res);
+    _recordCount = nativeRowsCount();
 
     if (isEditing()) {
         prepareResultForEditing(this);
@@ -36,10 +40,23 @@ void MySQLQueryResult::init(MYSQL_RES * res)
     seekFirst();
 }
 
+void MySQLQueryResult::initColumns(MYSQL_RES * res)
+{
+    Q_ASSERT( res != nullptr);
+    Q_ASSERT(_res == nullptr);
+
+    _res = res;
+
+    clearColumnData();
+
+    addColumnData(_res);
+
+    _storage.setColumnCount(columnCount());
+}
+
 void MySQLQueryResult::clearColumnData()
 {
     _columns.clear();
-    _columnLengths.clear();
     _columnIndexes.clear();
     _columnsParsed = false;
 }
@@ -53,7 +70,6 @@ void MySQLQueryResult::addColumnData(MYSQL_RES * result)
 
     unsigned int numFields = mysql_num_fields(result);
 
-    _columnLengths.resize(numFields);
     // TODO: skip columns parsing when we don't need them (e.g. sample queries)
 
     _columns.resize(numFields);
@@ -76,94 +92,6 @@ void MySQLQueryResult::addColumnData(MYSQL_RES * result)
     _columnsParsed = true;
 }
 
-bool MySQLQueryResult::hasData() const
-{
-    return _res != nullptr || NativeQueryResult::hasData();
-}
-
-void MySQLQueryResult::seekRecNo(db::ulonglong value)
-{
-    if (value == _curRecNo) {
-        return;
-    }
-
-    if (value >= recordCount()) {
-        _curRecNo = recordCount();
-        _eof = true;
-        return;
-    }
-
-    if (isEditing() == false) {
-
-        std::vector<MYSQL_RES *> resultList = this->resultList();
-
-        db::ulonglong numRows = 0;
-        for (auto curResPtr : resultList) {
-            numRows += curResPtr->row_count;
-            if (value < numRows) {
-                // TODO: using unsigned with "-" is risky
-                db::ulonglong wantedLocalRecNo
-                        = curResPtr->row_count - (numRows - value);
-                // H: Do not seek if FCurrentRow points to the previous row
-                // of the wanted row
-                if (wantedLocalRecNo == 0
-                        || (_curRecNo+1 != value)
-                        || _curRow == nullptr) {
-                    // TODO: it does not seems we need 3rd condition?
-                    mysql_data_seek(curResPtr, wantedLocalRecNo);
-                }
-
-                _curRow = mysql_fetch_row(curResPtr);
-
-                // H: Remember length of column contents.
-                // Important for Col() so contents
-                // of cells with #0 chars are not cut off
-                unsigned long * lengths = mysql_fetch_lengths(curResPtr);
-
-                for (size_t i=0; i<_columnLengths.size(); ++i) {
-                    _columnLengths[i] = lengths[i];
-                }
-
-                break;
-            }
-        }
-    }
-
-    _curRecNo = value;
-    _eof = false;
-}
-
-QString MySQLQueryResult::curRowColumn(std::size_t index, bool ignoreErrors)
-{
-    if (index < columnCount()) {
-
-        if (isEditing()) {
-            return _editableData->dataAt(_curRecNo, index);
-        }
-
-        return rowDataToString(_curRow, index, _columnLengths[index]);
-
-    } else if (!ignoreErrors) {
-        throw db::Exception(QString(
-            "Column #%1 not available. Query returned %2 columns and %3 rows.")
-            .arg(index).arg(columnCount()).arg(recordCount()
-        ));
-    }
-
-    return QString();
-}
-
-bool MySQLQueryResult::isNull(std::size_t index)
-{
-    throwOnInvalidColumnIndex(index);
-
-    if (isEditing()) {
-        return _editableData->dataAt(_curRecNo, index).isNull();
-    }
-
-    return _curRow[index] == nullptr;
-}
-
 bool MySQLQueryResult::columnIsPrimaryKeyPart(std::size_t index) const
 {
     // faster than in base class and works for any query
@@ -187,79 +115,27 @@ bool MySQLQueryResult::columnIsAutoIncrement(std::size_t index) const
     return (column(index).flags & AUTO_INCREMENT_FLAG) > 0;
 }
 
-std::vector<MYSQL_RES *> MySQLQueryResult::resultList() const
-{
-    // TODO: optimize/cache resultList?
-    std::vector<MYSQL_RES *> resultList;
-    resultList.reserve(_appendedResults.size() + 1);
-    if (_res) {
-        resultList.push_back(_res);
-    }
-
-    for (const QueryResultPt & appendedResult : _appendedResults) {
-        resultList.push_back(
-            static_cast<MySQLQueryResult *>(appendedResult.get())
-                    ->nativePtr()
-        );
-    }
-    return resultList;
-}
-
-QString MySQLQueryResult::rowDataToString(MYSQL_ROW row,
-                        std::size_t col,
-                        unsigned long dataLen)
+void MySQLQueryResult::appendRowTo(ColumnarResultStorage::Batch & batch,
+                                   MYSQL_ROW row,
+                                   unsigned long * lengths) const
 {
-    QString result;
-
-    DataTypeCategoryIndex typeCategory = column(col).dataType->categoryIndex;
-    if (typeCategory == DataTypeCategoryIndex::Binary
-        || typeCategory == DataTypeCategoryIndex::Spatial) {
-        result = QString::fromLatin1(row[col], dataLen);
-    } else {
-        // TODO: non-unicode support?
-        result = QString::fromUtf8(row[col], dataLen);
-    }
-
-    return result;
-}
-
-void MySQLQueryResult::prepareResultForEditing(MYSQL_RES * result)
-{
-    // it seems that copying all data is simplest way as we need to
-    // insert/delete rows at top/in the middle of data as well
-    // TODO: heidi works other way, maybe it's faster and/or takes less memory
-
-    db::ulonglong numRows = result->row_count;
-    unsigned int numCols = mysql_num_fields(result);
-
-    _editableData->reserveForAppend(numRows);
-
-    mysql_data_seek(result, 0);
-
-    MYSQL_ROW rowDataRaw;
-    while ((rowDataRaw = mysql_fetch_row(result))) {
-        GridDataRow rowData;
-        rowData.reserve(numCols);
-
-        unsigned long * lengths = mysql_fetch_lengths(result);
-
-        for (unsigned col = 0; col < numCols; ++col) {
-            rowData.append(
-                rowDataToString(rowDataRaw, col, lengths[col])
-            );
+    // H: use lengths, so contents of cells with #0 chars are not cut off
+    std::size_t numCols = columnCount();
+    for (std::size_t col = 0; col < numCols; ++col) {
+        if (row[col] == nullptr) {
+            batch.appendNull(col);
+            continue;
+        }
+        int dataLen = static_cast<int>(lengths[col]);
+        const DataTypePtr & dataType = column(col).dataType;
+        // BIT is integer category but comes as raw bytes, keep them
+        if (dataType->categoryIndex == DataTypeCategoryIndex::Binary
+            || dataType->categoryIndex == DataTypeCategoryIndex::Spatial
+            || dataType->index == DataTypeIndex::Bit) {
+            batch.appendLatin1(col, row[col], dataLen);
+        } else {
+            batch.appendUtf8(col, row[col], dataLen);
         }
-
-        _editableData->appendRow(rowData);
-    }
-}
-
-
-void MySQLQueryResult::prepareResultForEditing(NativeQueryResult * result)
-{
-    MySQLQueryResult * mysqlResult = static_cast<MySQLQueryResult *>(result);
-    if (mysqlResult->nativePtr()) {
-        prepareResultForEditing(mysqlResult->nativePtr());
-        mysqlResult->freeNative(); // we just copied all data
     }
 }
 
@@ -12,7 +12,7 @@
 namespace meow {
 namespace db {
 
-// Wraps and owns MYSQL_RES ptr
+// Decodes MYSQL_RES rows into storage and frees it
 class MySQLQueryResult : public NativeQueryResult
 {
 public:
@@ -25,29 +25,17 @@ public:
     }
 
     virtual db::ulonglong nativeRowsCount() const override {
-        return static_cast<db::ulonglong>(_res->row_count);
+        return _storage.rowCount();
     }
 
-    virtual bool hasData() const override;
-
-    virtual void seekRecNo(db::ulonglong value) override;
-
-    virtual QString curRowColumn(std::size_t index,
-                                 bool ignoreErrors = false) override;
-
-    virtual bool isNull(std::size_t index) override;
-
     virtual bool columnIsPrimaryKeyPart(std::size_t index) const override;
     virtual bool columnIsUniqueKeyPart(std::size_t index) const override;
     virtual bool columnIsIndexKeyPart(std::size_t index) const override;
     virtual bool columnIsAutoIncrement(std::size_t index) const override;
 
-
-    MYSQL_RES * nativePtr() const { return _res; }
-
 protected:
-    virtual void prepareResultForEditing(NativeQueryResult * result) override;
-private:
+
+    void initColumns(MYSQL_RES * res);
 
     void freeNative() {
         if (_res) {
@@ -56,21 +44,16 @@ private:
         }
     }
 
-    QString rowDataToString(MYSQL_ROW row,
-                            std::size_t col,
-                            unsigned long dataLen);
+    void appendRowTo(ColumnarResultStorage::Batch & batch,
+                     MYSQL_ROW row,
+                     unsigned long * lengths) const;
 
-    void prepareResultForEditing(MYSQL_RES * result);
+    MYSQL_RES * _res;
+private:
 
     void clearColumnData();
     void addColumnData(MYSQL_RES * result);
 
-
-    std::vector<MYSQL_RES *> resultList() const;
-
-    MYSQL_RES * _res;
-    MYSQL_ROW _curRow;
-    std::vector<unsigned int> _columnLengths; // FColumnLengths
     bool _columnsParsed;
 };
 
@@ -0,0 +1,210 @@
+#include "mysql_streamed_query_result.h"
+#include "mysql_connection.h"
+#include "db/exception.h"
+#include "helpers/logger.h"
+
+namespace meow {
+namespace db {
+
+MySQLStreamedQueryResult::MySQLStreamedQueryResult(MySQLConnection * connection)
+    : MySQLQueryResult(connection)
+    , _mysqlConnection(connection)
+    , _handle(nullptr)
+    , _connectionId(0)
+    , _fetchingThread(nullptr)
+    , _maxBufferSize(DATA_STREAM_MAX_BUFFER_SIZE)
+    , _isFetching(false)
+    , _abortRequested(false)
+    , _isFetchLimited(false)
+    , _isKilled(false)
+    , _isAllReceived(false)
+{
+
+}
+
+MySQLStreamedQueryResult::~MySQLStreamedQueryResult()
+{
+    finishFetching();
+}
+
+void MySQLStreamedQueryResult::init(MYSQL_RES * res, MYSQL * handle)
+{
+    Q_ASSERT(handle != nullptr);
+
+    // no other queries are possible until result is read out
+    _mysqlConnection->mutex()->lock();
+    _fetchingThread = QThread::currentThread();
+    _handle = handle;
+    _connectionId = mysql_thread_id(handle);
+    _isFetching = true;
+
+    initColumns(res);
+
+    _recordCount = 0;
+
+    seekFirst();
+}
+
+QString MySQLStreamedQueryResult::curRowColumn(std::size_t index,
+                                               bool ignoreErrors)
+{
+    QMutexLocker locker(&_rowsMutex);
+    return MySQLQueryResult::curRowColumn(index, ignoreErrors);
+}
+
+bool MySQLStreamedQueryResult::isNull(std::size_t index)
+{
+    QMutexLocker locker(&_rowsMutex);
+    return MySQLQueryResult::isNull(index);
+}
+
+bool MySQLStreamedQueryResult::curRowInteger(std::size_t index, qint64 * value)
+{
+    QMutexLocker locker(&_rowsMutex);
+    return MySQLQueryResult::curRowInteger(index, value);
+}
+
+bool MySQLStreamedQueryResult::curRowFloat(std::size_t index, double * value)
+{
+    QMutexLocker locker(&_rowsMutex);
+    return MySQLQueryResult::curRowFloat(index, value);
+}
+
+db::ulonglong MySQLStreamedQueryResult::fetchMore(db::ulonglong maxRows)
+{
+    if (!_isFetching) {
+        return 0;
+    }
+
+    ColumnarResultStorage::Batch batch(columnCount());
+
+    std::size_t bufferSize = 0;
+    {
+        QMutexLocker locker(&_rowsMutex);
+        bufferSize = _storage.dataSize();
+    }
+
+    bool finished = false;
+
+    while (batch.rowCount() < maxRows) {
+
+        if (_abortRequested) {
+            finished = true;
+            break;
+        }
+
+        MYSQL_ROW rowData = mysql_fetch_row(_res);
+        if (rowData == nullptr) { // no more rows or error
+            finished = true;
+            _isAllReceived = true;
+            break;
+        }
+
+        appendRowTo(batch, rowData, mysql_fetch_lengths(_res));
+
+        if (bufferSize + batch.dataSize() >= _maxBufferSize) {
+            _isFetchLimited = true;
+            finished = true;
+            break;
+        }
+    }
+
+    std::size_t fetchedCount = batch.rowCount();
+
+    if (fetchedCount > 0) {
+        QMutexLocker locker(&_rowsMutex);
+        _storage.addBatch(std::move(batch));
+        _recordCount += fetchedCount;
+    }
+
+    if (finished) {
+        QString error;
+        if (!_abortRequested && !_isFetchLimited
+                && mysql_errno(_handle) != 0) {
+            error = _mysqlConnection->getLastError();
+        }
+        if (_isFetchLimited) {
+            meowLogCC(Log::Category::Info, _mysqlConnection)
+                << "Result buffer limit is reached, rows fetched: "
+                << recordCount();
+        }
+        finishFetching();
+        if (!error.isEmpty()) {
+            meowLogCC(Log::Category::Error, _mysqlConnection)
+                << "Query (fetch) failed: " << error;
+            throw db::Exception(error);
+        }
+    }
+
+    return fetchedCount;
+}
+
+void MySQLStreamedQueryResult::abortFetching()
+{
+    _abortRequested = true; // before kill: fetch error is expected then
+    // connection can't run other query meanwhile, see finishFetching()
+    QMutexLocker locker(&_rowsMutex);
+    if (_isFetching) {
+        killQuery();
+    }
+}
+
+void MySQLStreamedQueryResult::clearFetchedRows()
+{
+    QMutexLocker locker(&_rowsMutex);
+    MySQLQueryResult::clearFetchedRows();
+}
+
+void MySQLStreamedQueryResult::finishFetching()
+{
+    if (!_isFetching) {
+        return;
+    }
+
+    // recursive mutex is unlocked by the thread that locked it only
+    Q_ASSERT(QThread::currentThread() == _fetchingThread);
+
+    if (!_isAllReceived) {
+        killQuery(); // libmysql reads all the rest rows on free otherwise
+    }
+
+    freeNative(); // skips unread rows
+    _mysqlConnection->discardPendingResults();
+
+    {
+        QMutexLocker locker(&_rowsMutex);
+        _isFetching = false;
+    }
+    _mysqlConnection->mutex()->unlock();
+}
+
+void MySQLStreamedQueryResult::killQuery()
+{
+    if (_mysqlConnection->serverVersionInt() < 50000) {
+        return; // no KILL QUERY
+    }
+
+    bool wasKilled = false;
+    if (!_isKilled.compare_exchange_strong(wasKilled, true)) {
+        return; // once, e.g. on abort and then on free
+    }
+
+    try {
+        _mysqlConnection->killQuery(_connectionId);
+    } catch(meow::db::Exception & ex) {
+        meowLogCC(Log::Category::Error, _mysqlConnection)
+            << "Failed to cancel query: " << ex.message();
+    }
+}
+
+void MySQLStreamedQueryResult::prepareResultForEditing(
+        NativeQueryResult * result)
+{
+    Q_ASSERT(!_isFetching);
+
+    QMutexLocker locker(&_rowsMutex);
+    MySQLQueryResult::prepareResultForEditing(result);
+}
+
+} // namespace db
+} // namespace meow
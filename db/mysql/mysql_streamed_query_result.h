@@ -0,0 +1,73 @@
+#ifndef DB_MYSQL_STREAMED_QUERY_RESULT_H
+#define DB_MYSQL_STREAMED_QUERY_RESULT_H
+
+#include <atomic>
+#include <QMutex>
+#include <QThread>
+#include "mysql_query_result.h"
+
+namespace meow {
+namespace db {
+
+class MySQLConnection;
+
+// Intent: result of mysql_use_result(), receives rows on fetchMore() and
+// decodes them into storage batch by batch. Connection stays locked until
+// all rows are fetched, fetching is aborted or buffer size limit is reached.
+// Fetching should be finished in the thread that executed the query.
+class MySQLStreamedQueryResult : public MySQLQueryResult
+{
+public:
+    explicit MySQLStreamedQueryResult(MySQLConnection * connection);
+
+    virtual ~MySQLStreamedQueryResult() override;
+
+    void init(MYSQL_RES * res, MYSQL * handle);
+
+    virtual db::ulonglong nativeRowsCount() const override {
+        return _recordCount;
+    }
+
+    virtual QString curRowColumn(std::size_t index,
+                                 bool ignoreErrors = false) override;
+
+    virtual bool isNull(std::size_t index) override;
+
+    virtual bool curRowInteger(std::size_t index, qint64 * value) override;
+    virtual bool curRowFloat(std::size_t index, double * value) override;
+
+    virtual bool isFetching() const override { return _isFetching; }
+    virtual db::ulonglong fetchMore(db::ulonglong maxRows) override;
+    // kills query on server at once, so neither waiting for next rows
+    // nor freeing result reads the rest of them
+    virtual void abortFetching() override;
+    virtual bool isFetchLimited() const override { return _isFetchLimited; }
+    virtual void clearFetchedRows() override;
+
+    void setMaxBufferSize(db::ulonglong size) { _maxBufferSize = size; }
+
+protected:
+    virtual void prepareResultForEditing(NativeQueryResult * result) override;
+
+private:
+
+    void finishFetching();
+    void killQuery();
+
+    MySQLConnection * _mysqlConnection;
+    MYSQL * _handle;
+    unsigned long _connectionId; // on server, to kill unfinished query
+    QThread * _fetchingThread; // holds connection mutex
+    mutable QMutex _rowsMutex; // rows are appended and read in diff threads
+    db::ulonglong _maxBufferSize;
+    std::atomic<bool> _isFetching;
+    std::atomic<bool> _abortRequested;
+    std::atomic<bool> _isFetchLimited;
+    std::atomic<bool> _isKilled;
+    bool _isAllReceived;
+};
+
+} // namespace db
+} // namespace meow
+
+#endif // DB_MYSQL_STREAMED_QUERY_RESULT_H
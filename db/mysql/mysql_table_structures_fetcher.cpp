@@ -0,0 +1,341 @@
+#include "mysql_table_structures_fetcher.h"
+#include <QMap>
+#include <QPair>
+#include <vector>
+#include "db/mysql/mysql_connection.h"
+#include "db/query.h"
+#include "db/entity/table_entity.h"
+#include "db/table_structure_parser.h"
+
+namespace meow {
+namespace db {
+
+MySQLTableStructuresFetcher::MySQLTableStructuresFetcher(
+        MySQLConnection * connection)
+    : TableStructuresFetcher(connection)
+    , _mysqlConnection(connection)
+{
+
+}
+
+void MySQLTableStructuresFetcher::run(const QString & dbName,
+                                      const QList<TableEntity *> & tables)
+{
+    Tables tablesByName;
+
+    for (TableEntity * table : tables) {
+        TableStructure * structure = table->structure();
+        structure->clearColumns();
+        structure->removeAllIndicies();
+        qDeleteAll(structure->foreignKeys());
+        structure->foreignKeys().clear();
+        tablesByName.insert(table->name(), table);
+    }
+
+    fetchTableOptions(dbName, tablesByName); // keep first: collations
+    fetchColumns(dbName, tablesByName); // before keys
+    fetchIndicies(dbName, tablesByName);
+    fetchForeignKeys(dbName, tablesByName);
+}
+
+void MySQLTableStructuresFetcher::fetchTableOptions(const QString & dbName,
+                                                    const Tables & tables)
+{
+    QueryPtr results = _connection->getResults(
+        "SELECT TABLE_NAME, ENGINE, TABLE_COLLATION, TABLE_COMMENT,"
+        " AUTO_INCREMENT, CREATE_OPTIONS"
+        " FROM information_schema.TABLES"
+        " WHERE TABLE_SCHEMA = " + _connection->escapeString(dbName));
+
+    while (results->isEof() == false) {
+        TableEntity * table = tables.value(results->curRowColumn(0), nullptr);
+        if (table) {
+            TableStructure * structure = table->structure();
+
+            table->setEngine(results->curRowColumn(1));
+            if (!results->isNull(2)) {
+                table->setCollation(results->curRowColumn(2));
+            }
+            structure->setComment(results->curRowColumn(3));
+            structure->setAutoInc(results->curRowColumn(4).toULongLong());
+
+            // like in create code, only options set explicitly:
+            // row_format=DYNAMIC checksum=1 max_rows=100
+            db::ulonglong avgRowLen = 0;
+            db::ulonglong maxRows = 0;
+            QString rowFormatStr;
+            bool isCheckSum = false;
+
+            const QStringList options = results->curRowColumn(5)
+                    .split(' ', QString::SkipEmptyParts);
+            for (const QString & option : options) {
+                QString optName = option.section('=', 0, 0).toUpper();
+                QString optValue = option.section('=', 1);
+                if (optName == "AVG_ROW_LENGTH") {
+                    avgRowLen = optValue.toULongLong();
+                } else if (optName == "ROW_FORMAT") {
+                    rowFormatStr = optValue;
+                } else if (optName == "CHECKSUM") {
+                    isCheckSum = optValue == "1";
+                } else if (optName == "MAX_ROWS") {
+                    maxRows = optValue.toULongLong();
+                }
+            }
+
+            structure->setAvgRowLen(avgRowLen);
+            structure->setRowFormat(rowFormatStr);
+            structure->setCheckSum(isCheckSum);
+            structure->setMaxRows(maxRows);
+        }
+        results->seekNext();
+    }
+}
+
+void MySQLTableStructuresFetcher::fetchColumns(const QString & dbName,
+                                               const Tables & tables)
+{
+    QueryPtr results = _connection->getResults(
+        "SELECT TABLE_NAME, COLUMN_NAME, COLUMN_TYPE, IS_NULLABLE,"
+        " COLUMN_DEFAULT, EXTRA, CHARACTER_SET_NAME, COLLATION_NAME,"
+        " COLUMN_COMMENT"
+        " FROM information_schema.COLUMNS"
+        " WHERE TABLE_SCHEMA = " + _connection->escapeString(dbName)
+        + " ORDER BY TABLE_NAME, ORDINAL_POSITION");
+
+    ITableStructureParser * parser = _connection->tableStructureParser();
+
+    while (results->isEof() == false) {
+        TableEntity * table = tables.value(results->curRowColumn(0), nullptr);
+        if (table) {
+            TableColumn * column = new TableColumn();
+
+            column->setName(results->curRowColumn(1));
+
+            // int(10) unsigned zerofill
+            QString columnType = results->curRowColumn(2);
+            column->setDataType(parser->extractDataTypeByName(columnType));
+            column->setLengthSet(parser->extractLengthSet(columnType));
+            column->setIsUnsigned(
+                columnType.contains("unsigned", Qt::CaseInsensitive));
+            column->setIsZeroFill(
+                columnType.contains("zerofill", Qt::CaseInsensitive));
+
+            // create code has them only if differ from table ones
+            QString collation = results->curRowColumn(7);
+            if (!results->isNull(7) && collation != table->collation()) {
+                column->setCharset(results->curRowColumn(6));
+                column->setCollation(collation);
+            }
+
+            column->setAllowNull(results->curRowColumn(3) == "YES");
+
+            parseDefault(results->curRowColumn(4),
+                         results->isNull(4),
+                         results->curRowColumn(5),
+                         column);
+
+            column->setComment(results->curRowColumn(8));
+
+            table->structure()->appendColumn(column);
+        }
+        results->seekNext();
+    }
+}
+
+void MySQLTableStructuresFetcher::fetchIndicies(const QString & dbName,
+                                                const Tables & tables)
+{
+    QueryPtr results = _connection->getResults(
+        "SELECT TABLE_NAME, INDEX_NAME, NON_UNIQUE, SEQ_IN_INDEX,"
+        " COLUMN_NAME, INDEX_TYPE"
+        " FROM information_schema.STATISTICS"
+        " WHERE TABLE_SCHEMA = " + _connection->escapeString(dbName));
+
+    struct IndexRecord
+    {
+        TableEntity * table;
+        QString name;
+        TableIndexClass indexClass;
+        QString indexType;
+        QMap<int, QString> columns; // by position in index
+    };
+
+    // rows go in order of indicies creation, but columns may be mixed
+    std::vector<IndexRecord> records;
+    QHash<QPair<TableEntity *, QString>, std::size_t> recordByName;
+
+    while (results->isEof() == false) {
+        TableEntity * table = tables.value(results->curRowColumn(0), nullptr);
+        if (table) {
+            QString name = results->curRowColumn(1);
+            auto key = qMakePair(table, name);
+            auto it = recordByName.constFind(key);
+            std::size_t recordIndex;
+            if (it == recordByName.constEnd()) {
+                QString indexType = results->curRowColumn(5);
+                IndexRecord record;
+                record.table = table;
+                record.name = name;
+                if (name == "PRIMARY") {
+                    record.indexClass = TableIndexClass::PrimaryKey;
+                } else if (indexType == "FULLTEXT") {
+                    record.indexClass = TableIndexClass::FullText;
+                } else if (indexType == "SPATIAL") {
+                    record.indexClass = TableIndexClass::Spatial;
+                } else if (results->curRowColumn(2) == "0") {
+                    record.indexClass = TableIndexClass::Unique;
+                } else {
+                    record.indexClass = TableIndexClass::Key;
+                }
+                record.indexType = indexType;
+                recordIndex = records.size();
+                records.push_back(record);
+                recordByName.insert(key, recordIndex);
+            } else {
+                recordIndex = it.value();
+            }
+            records[recordIndex].columns.insert(
+                results->curRowColumn(3).toInt(),
+                results->curRowColumn(4));
+        }
+        results->seekNext();
+    }
+
+    // primary key goes first in create code
+    for (bool isPrimary : {true, false}) {
+        for (const IndexRecord & record : records) {
+            if ((record.indexClass == TableIndexClass::PrimaryKey)
+                    != isPrimary) {
+                continue;
+            }
+            TableIndex * index = new TableIndex(record.table);
+            index->setName(record.name);
+            index->setClassType(record.indexClass);
+            index->setIndexType(record.indexType);
+            for (const QString & columnName : record.columns) {
+                index->addColumn(columnName);
+            }
+            record.table->structure()->appendIndex(index);
+        }
+    }
+}
+
+void MySQLTableStructuresFetcher::fetchForeignKeys(const QString & dbName,
+                                                   const Tables & tables)
+{
+    const QString db = _connection->escapeString(dbName);
+
+    // rules are known since 5.1.10
+    bool hasRules = _connection->serverVersionInt() >= 50110;
+
+    QString SQL = QString(
+        "SELECT k.TABLE_NAME, k.CONSTRAINT_NAME, k.COLUMN_NAME,"
+        " k.REFERENCED_TABLE_SCHEMA, k.REFERENCED_TABLE_NAME,"
+        " k.REFERENCED_COLUMN_NAME, %1"
+        " FROM information_schema.KEY_COLUMN_USAGE k %2"
+        " WHERE k.TABLE_SCHEMA = %3 AND k.REFERENCED_TABLE_NAME IS NOT NULL"
+        " ORDER BY k.TABLE_NAME, k.CONSTRAINT_NAME, k.ORDINAL_POSITION")
+        .arg(hasRules ? "r.UPDATE_RULE, r.DELETE_RULE" : "NULL, NULL")
+        .arg(hasRules ? "JOIN information_schema.REFERENTIAL_CONSTRAINTS r"
+                        " ON r.CONSTRAINT_SCHEMA = k.CONSTRAINT_SCHEMA"
+                        " AND r.CONSTRAINT_NAME = k.CONSTRAINT_NAME"
+                        " AND r.TABLE_NAME = k.TABLE_NAME"
+                      : "")
+        .arg(db);
+
+    QueryPtr results = _connection->getResults(SQL);
+
+    const QChar quote = _connection->getIdentQuote();
+
+    TableEntity * prevTable = nullptr;
+    QString prevName;
+    ForeignKey * fKey = nullptr;
+    QStringList columnNames;
+
+    auto setColumns = [&]() {
+        if (fKey) {
+            fKey->setColumns(columnNames);
+        }
+        columnNames.clear();
+    };
+
+    while (results->isEof() == false) {
+        TableEntity * table = tables.value(results->curRowColumn(0), nullptr);
+        if (table) {
+            QString name = results->curRowColumn(1);
+            if (table != prevTable || name != prevName) {
+                setColumns();
+
+                QString refTable = results->curRowColumn(4);
+                if (results->curRowColumn(3) != dbName) {
+                    // same as create code parser gives
+                    refTable = results->curRowColumn(3)
+                            + quote + '.' + quote + refTable;
+                }
+
+                fKey = new ForeignKey(table);
+                fKey->setName(name);
+                fKey->setReferenceTableName(refTable);
+                fKey->setOnUpdate(results->curRowColumn(6));
+                fKey->setOnDelete(results->curRowColumn(7));
+                table->structure()->foreignKeys().append(fKey);
+
+                prevTable = table;
+                prevName = name;
+            }
+            columnNames << results->curRowColumn(2);
+            fKey->referenceColumns() << results->curRowColumn(5);
+        }
+        results->seekNext();
+    }
+
+    setColumns();
+}
+
+void MySQLTableStructuresFetcher::parseDefault(const QString & defaultValue,
+                                               bool isNullDefault,
+                                               const QString & extra,
+                                               TableColumn * column) const
+{
+    if (extra.contains("auto_increment", Qt::CaseInsensitive)) {
+        column->setDefaultType(ColumnDefaultType::AutoInc);
+        return;
+    }
+
+    bool isOnUpdateCurTs = extra.contains("on update", Qt::CaseInsensitive);
+
+    // MariaDB 10.2.7 quotes literals and returns NULL default as text
+    bool isQuoted = _mysqlConnection->isMariaDB()
+            && _connection->serverVersionInt() >= 100207;
+
+    if (isNullDefault || (isQuoted && defaultValue == "NULL")) {
+        if (column->isAllowNull()) {
+            column->setDefaultType(isOnUpdateCurTs
+                                   ? ColumnDefaultType::NullUpdateTS
+                                   : ColumnDefaultType::Null);
+        }
+        return;
+    }
+
+    if (defaultValue.startsWith("CURRENT_TIMESTAMP", Qt::CaseInsensitive)) {
+        column->setDefaultType(isOnUpdateCurTs
+                               ? ColumnDefaultType::CurTSUpdateTS
+                               : ColumnDefaultType::CurTS);
+        return;
+    }
+
+    QString defaultText = defaultValue;
+    if (isQuoted && defaultText.length() >= 2
+            && defaultText.startsWith('\'') && defaultText.endsWith('\'')) {
+        defaultText = defaultText.mid(1, defaultText.length() - 2)
+                .replace("''", "'");
+    }
+
+    column->setDefaultText(defaultText);
+    column->setDefaultType(isOnUpdateCurTs
+                           ? ColumnDefaultType::TextUpdateTS
+                           : ColumnDefaultType::Text);
+}
+
+} // namespace db
+} // namespace meow
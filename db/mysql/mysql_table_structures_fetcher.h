@@ -0,0 +1,40 @@
+#ifndef DB_MYSQL_TABLE_STRUCTURES_FETCHER_H
+#define DB_MYSQL_TABLE_STRUCTURES_FETCHER_H
+
+#include <QHash>
+#include "db/table_structures_fetcher.h"
+
+namespace meow {
+namespace db {
+
+class MySQLConnection;
+class TableColumn;
+
+// Intent: reads structures of tables from information_schema: one query
+// per TABLES, COLUMNS, STATISTICS and KEY_COLUMN_USAGE for whole database
+class MySQLTableStructuresFetcher : public TableStructuresFetcher
+{
+public:
+    explicit MySQLTableStructuresFetcher(MySQLConnection * connection);
+    virtual void run(const QString & dbName,
+                     const QList<TableEntity *> & tables) override;
+private:
+    using Tables = QHash<QString, TableEntity *>; // by name
+
+    void fetchTableOptions(const QString & dbName, const Tables & tables);
+    void fetchColumns(const QString & dbName, const Tables & tables);
+    void fetchIndicies(const QString & dbName, const Tables & tables);
+    void fetchForeignKeys(const QString & dbName, const Tables & tables);
+
+    void parseDefault(const QString & defaultValue,
+                      bool isNullDefault,
+                      const QString & extra,
+                      TableColumn * column) const;
+
+    MySQLConnection * _mysqlConnection;
+};
+
+} // namespace db
+} // namespace meow
+
+#endif // DB_MYSQL_TABLE_STRUCTURES_FETCHER_H
@@ -36,7 +36,78 @@ void NativeQueryResult::seekNext()
 
 db::ulonglong NativeQueryResult::recordCount() const
 {
-    return isEditing() ? _editableData->rowsCount() : _recordCount;
+    return isEditing() ? _editableData->rowsCount() : _recordCount.load();
+}
+
+void NativeQueryResult::seekRecNo(db::ulonglong value)
+{
+    if (value >= recordCount()) {
+        _curRecNo = recordCount();
+        _eof = true;
+        return;
+    }
+
+    _curRecNo = value;
+    _eof = false;
+}
+
+void NativeQueryResult::clearFetchedRows()
+{
+    Q_ASSERT(!isEditing());
+
+    _storage.clear();
+    _recordCount = 0;
+    _curRecNo = -1;
+    _eof = false;
+}
+
+QString NativeQueryResult::curRowColumn(std::size_t index, bool ignoreErrors)
+{
+    if (index < columnCount()) {
+
+        if (isEditing()) {
+            return _editableData->dataAt(_curRecNo, index);
+        }
+
+        return _storage.cell(_curRecNo, index);
+
+    } else if (!ignoreErrors) {
+        throw db::Exception(QString(
+            "Column #%1 not available. Query returned %2 columns and %3 rows.")
+            .arg(index).arg(columnCount()).arg(recordCount()
+        ));
+    }
+
+    return QString();
+}
+
+bool NativeQueryResult::isNull(std::size_t index)
+{
+    throwOnInvalidColumnIndex(index);
+
+    if (isEditing()) {
+        return _editableData->dataAt(_curRecNo, index).isNull();
+    }
+
+    return _storage.isNull(_curRecNo, index);
+}
+
+bool NativeQueryResult::curRowInteger(std::size_t index, qint64 * value)
+{
+    if (isEditing() || index >= columnCount()
+            || _curRecNo >= _storage.rowCount()) {
+        return false; // edited values are text
+    }
+    return _storage.integerValue(_curRecNo, index, value);
+}
+
+bool NativeQueryResult::curRowFloat(std::size_t index, double * value)
+{
+    if (isEditing() || index >= columnCount()
+            || _curRecNo >= _storage.rowCount()) {
+        return false;
+    }
+    return _storage.floatValue(_curRecNo, index, value);
 }
 
 QString NativeQueryResult::curRowColumn(const QString & colName,
@@ -114,7 +185,7 @@ bool NativeQueryResult::prepareEditing()
     if (_editableData) {
         return true;
     }
-    _editableData = new EditableGridData();
+    _editableData = new EditableGridData(&_storage);
 
     prepareResultForEditing(this);
 
@@ -125,6 +196,22 @@ bool NativeQueryResult::prepareEditing()
     return false;
 }
 
+void NativeQueryResult::prepareResultForEditing(NativeQueryResult * result)
+{
+    // rows are not copied, editable data keeps only modifications over them
+
+    if (result != this) { // keep all rows in one storage
+        db::ulonglong firstRow = _storage.rowCount();
+        db::ulonglong numRows = result->_storage.rowCount();
+        _storage.append(std::move(result->_storage));
+        _editableData->appendSourceRows(static_cast<int>(firstRow),
+                                        static_cast<int>(numRows));
+    } else {
+        _editableData->appendSourceRows(0,
+            static_cast<int>(_storage.rowCount()));
+    }
+}
+
 QStringList NativeQueryResult::keyColumns() const
 {
     // TODO: cache?
@@ -251,6 +338,10 @@ void NativeQueryResult::appendResultData(const QueryResultPt &result)
 {
     if (isEditing()) {
         prepareResultForEditing(result.get());
+    } else if (_storage.columnCount() > 0) {
+        // keep all rows in one storage for direct access
+        _recordCount += result->recordCount();
+        _storage.append(std::move(result->_storage));
     } else {
         _appendedResults.push_back(result);
         _recordCount += result->recordCount();
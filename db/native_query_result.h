@@ -1,11 +1,13 @@
 #ifndef DB_NATIVE_QUERY_RESULT_INTERFACE_H
 #define DB_NATIVE_QUERY_RESULT_INTERFACE_H
 
+#include <atomic>
 #include <memory>
 #include <vector>
 #include <QMap>
 #include <QStringList>
 #include "query_column.h"
+#include "columnar_result_storage.h"
 #include "db/common.h"
 
 namespace meow {
@@ -57,10 +59,10 @@ public:
         return _columns[index];
     }
 
-    virtual void seekRecNo(db::ulonglong value) = 0; // H: SetRecNo
+    virtual void seekRecNo(db::ulonglong value); // H: SetRecNo
 
     virtual QString curRowColumn(std::size_t index,
-                                 bool ignoreErrors = false) = 0;
+                                 bool ignoreErrors = false);
 
     QString curRowColumn(const QString & colName,
                          bool ignoreErrors = false);
@@ -69,11 +71,54 @@ public:
 
     QMap<QString, QString> curRowAsObject();
 
+    // bytes taken by decoded rows, 0 if rows are not kept in storage
+    std::size_t dataSize() const { return _storage.dataSize(); }
+
+    // Rows of storage (not edited ones) may be released to limit memory and
+    // be replaced later with rows of another result of the same query,
+    // released rows read as NULL. See ColumnarResultStorage::releaseRows()
+    bool canReleaseRows() const {
+        return _storage.columnCount() > 0 && _appendedResults.empty();
+    }
+    db::ulonglong storedRowCount() const { return _storage.rowCount(); }
+    void releaseRows(db::ulonglong firstRow, db::ulonglong count) {
+        _storage.releaseRows(firstRow, count);
+    }
+    // result must have no more rows than are released at firstRow
+    void replaceRows(db::ulonglong firstRow, const QueryResultPt & result) {
+        _storage.replaceRows(firstRow, std::move(result->_storage));
+    }
+    bool isRowReleased(db::ulonglong row) const {
+        return row < _storage.rowCount() && _storage.isRowReleased(row);
+    }
+
     virtual bool hasData() const {
-        return !_appendedResults.empty();
+        return _recordCount > 0 || !_appendedResults.empty();
     }
 
-    virtual bool isNull(std::size_t index) = 0; // TODO: add by name mthd
+    virtual bool isNull(std::size_t index); // TODO: add by name mthd
+
+    // typed value of number decoded from binary result, false if cell has
+    // only text
+    virtual bool curRowInteger(std::size_t index, qint64 * value);
+    virtual bool curRowFloat(std::size_t index, double * value);
+
+    // Streamed results (see Connection::queryStreamed) receive rows in
+    // portions, rows are fetched in the thread that executed the query
+    // while other threads may read already fetched ones.
+    virtual bool isFetching() const { return false; }
+    // returns count of fetched rows, 0 if nothing left
+    virtual db::ulonglong fetchMore(db::ulonglong maxRows) {
+        Q_UNUSED(maxRows);
+        return 0;
+    }
+    // thread-safe, stops fetching on next fetchMore()
+    virtual void abortFetching() {}
+    // true if fetching was stopped before all rows were received
+    virtual bool isFetchLimited() const { return false; }
+    // drops rows fetched so far, so long reads like exports don't keep all
+    // of them; next fetched rows are numbered from 0
+    virtual void clearFetchedRows();
 
     // true if was already prepared
     bool prepareEditing();
@@ -112,11 +157,11 @@ public:
 
 protected:
 
-    virtual void prepareResultForEditing(NativeQueryResult * result) = 0;
+    virtual void prepareResultForEditing(NativeQueryResult * result);
 
     void throwOnInvalidColumnIndex(std::size_t index);
 
-    db::ulonglong _recordCount;
+    std::atomic<db::ulonglong> _recordCount;
     db::ulonglong _curRecNo; // H: FRecNo
     std::vector<QueryColumn> _columns;
     QMap<QString, std::size_t> _columnIndexes; // Column name -> column index
@@ -125,6 +170,9 @@ protected:
     Connection * _connection;
     Entity * _entity;
     std::vector<QueryResultPt> _appendedResults;
+    // decoded rows, used by default implementation of row access, unused
+    // when columnCount() is 0
+    ColumnarResultStorage _storage;
 };
 
 
@@ -0,0 +1,413 @@
+#include "pg_binary_format.h"
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace meow {
+namespace db {
+
+namespace {
+
+// see pg_type.dat
+const Oid BOOL_OID = 16;
+const Oid BYTEA_OID = 17;
+const Oid CHAR_OID = 18;
+const Oid NAME_OID = 19;
+const Oid INT8_OID = 20;
+const Oid INT2_OID = 21;
+const Oid INT4_OID = 23;
+const Oid TEXT_OID = 25;
+const Oid OID_OID = 26;
+const Oid JSON_OID = 114;
+const Oid XML_OID = 142;
+const Oid FLOAT4_OID = 700;
+const Oid FLOAT8_OID = 701;
+const Oid BPCHAR_OID = 1042;
+const Oid VARCHAR_OID = 1043;
+const Oid DATE_OID = 1082;
+const Oid TIME_OID = 1083;
+const Oid TIMESTAMP_OID = 1114;
+const Oid NUMERIC_OID = 1700;
+const Oid UUID_OID = 2950;
+
+const quint16 NUMERIC_NEG = 0x4000;
+const quint16 NUMERIC_NAN = 0xC000;
+const quint16 NUMERIC_PINF = 0xD000;
+const quint16 NUMERIC_NINF = 0xF000;
+const int NUMERIC_DIGITS_PER_WORD = 4; // base 10000
+
+const qint64 USECS_PER_DAY = 86400000000LL;
+const qint64 USECS_PER_SEC = 1000000LL;
+const int POSTGRES_EPOCH_JDATE = 2451545; // 2000-01-01
+
+inline quint16 readUInt16(const char * data)
+{
+    const unsigned char * p = reinterpret_cast<const unsigned char *>(data);
+    return static_cast<quint16>((p[0] << 8) | p[1]);
+}
+
+inline quint32 readUInt32(const char * data)
+{
+    const unsigned char * p = reinterpret_cast<const unsigned char *>(data);
+    return (static_cast<quint32>(p[0]) << 24)
+         | (static_cast<quint32>(p[1]) << 16)
+         | (static_cast<quint32>(p[2]) << 8)
+         | static_cast<quint32>(p[3]);
+}
+
+inline quint64 readUInt64(const char * data)
+{
+    return (static_cast<quint64>(readUInt32(data)) << 32)
+         | readUInt32(data + 4);
+}
+
+// j2date() of PostgreSQL
+void julianToDate(int julianDay, int * year, int * month, int * day)
+{
+    unsigned int julian = static_cast<unsigned int>(julianDay) + 32044;
+    unsigned int quad = julian / 146097;
+    unsigned int extra = (julian - quad * 146097) * 4 + 3;
+    julian += 60 + quad * 3 + extra / 146097;
+    quad = julian / 1461;
+    julian -= quad * 1461;
+    int y = static_cast<int>(julian * 4 / 1461);
+    julian = ((y != 0) ? ((julian + 305) % 365) : ((julian + 306) % 366))
+            + 123;
+    y += static_cast<int>(quad * 4);
+    *year = y - 4800;
+    quad = julian * 2141 / 65536;
+    *day = static_cast<int>(julian - 7834 * quad / 256);
+    *month = static_cast<int>((quad + 10) % 12) + 1;
+}
+
+QString dateText(int daysSinceEpoch, bool * isBC)
+{
+    int year, month, day;
+    julianToDate(daysSinceEpoch + POSTGRES_EPOCH_JDATE, &year, &month, &day);
+    *isBC = year <= 0;
+    if (*isBC) {
+        year = 1 - year;
+    }
+    return QString("%1-%2-%3")
+            .arg(year, 4, 10, QLatin1Char('0'))
+            .arg(month, 2, 10, QLatin1Char('0'))
+            .arg(day, 2, 10, QLatin1Char('0'));
+}
+
+QString timeText(qint64 usecs) // since midnight
+{
+    qint64 secs = usecs / USECS_PER_SEC;
+    int fraction = static_cast<int>(usecs % USECS_PER_SEC);
+
+    QString text = QString("%1:%2:%3")
+            .arg(secs / 3600, 2, 10, QLatin1Char('0'))
+            .arg((secs / 60) % 60, 2, 10, QLatin1Char('0'))
+            .arg(secs % 60, 2, 10, QLatin1Char('0'));
+
+    if (fraction != 0) { // trailing zeros are not shown
+        QString fractionText = QString("%1").arg(fraction, 6, 10,
+                                                 QLatin1Char('0'));
+        int size = fractionText.size();
+        while (fractionText[size - 1] == QLatin1Char('0')) {
+            --size;
+        }
+        text += QLatin1Char('.') + fractionText.leftRef(size);
+    }
+
+    return text;
+}
+
+void appendNumeric(ColumnarResultStorage::Batch & batch,
+                   std::size_t column,
+                   const char * data)
+{
+    int wordsCount = static_cast<qint16>(readUInt16(data));
+    int weight = static_cast<qint16>(readUInt16(data + 2));
+    quint16 sign = readUInt16(data + 4);
+    int scale = static_cast<qint16>(readUInt16(data + 6));
+    const char * words = data + 8;
+
+    auto word = [=](int index) -> int {
+        return (index >= 0 && index < wordsCount)
+                ? static_cast<int>(readUInt16(words + index * 2)) : 0;
+    };
+
+    if (sign == NUMERIC_NAN) {
+        batch.appendFloat(column, QStringLiteral("NaN"),
+                          std::numeric_limits<double>::quiet_NaN());
+        return;
+    }
+    if (sign == NUMERIC_PINF || sign == NUMERIC_NINF) {
+        bool isPositive = sign == NUMERIC_PINF;
+        batch.appendFloat(column,
+                          isPositive ? QStringLiteral("Infinity")
+                                     : QStringLiteral("-Infinity"),
+                          isPositive ? std::numeric_limits<double>::infinity()
+                                     : -std::numeric_limits<double>::infinity());
+        return;
+    }
+
+    // get_str_from_var() of PostgreSQL
+    QString text;
+    text.reserve((weight + 1) * NUMERIC_DIGITS_PER_WORD + scale + 3);
+
+    if (sign == NUMERIC_NEG) {
+        text += QLatin1Char('-');
+    }
+
+    int index = 0;
+    if (weight < 0) {
+        index = weight + 1;
+        text += QLatin1Char('0');
+    } else {
+        for (index = 0; index <= weight; ++index) {
+            int digits = word(index);
+            bool isPut = index > 0;
+            for (int divider = 1000; divider > 1; divider /= 10) {
+                int digit = digits / divider;
+                digits -= digit * divider;
+                isPut = isPut || digit > 0;
+                if (isPut) {
+                    text += QLatin1Char(static_cast<char>('0' + digit));
+                }
+            }
+            text += QLatin1Char(static_cast<char>('0' + digits));
+        }
+    }
+
+    if (scale > 0) {
+        text += QLatin1Char('.');
+        int end = text.size() + scale;
+        for (int i = 0; i < scale; i += NUMERIC_DIGITS_PER_WORD, ++index) {
+            text += QString("%1").arg(word(index), NUMERIC_DIGITS_PER_WORD,
+                                      10, QLatin1Char('0'));
+        }
+        text.truncate(end);
+    }
+
+    double value = 0.0;
+    for (int i = 0; i < wordsCount; ++i) {
+        value += word(i) * std::pow(10000.0, weight - i);
+    }
+    if (sign == NUMERIC_NEG) {
+        value = -value;
+    }
+
+    batch.appendFloat(column, text, value);
+}
+
+QString floatText(float value)
+{
+    if (std::isnan(value)) {
+        return QStringLiteral("NaN");
+    }
+    if (std::isinf(value)) {
+        return value > 0 ? QStringLiteral("Infinity")
+                         : QStringLiteral("-Infinity");
+    }
+    // shortest text that reads back to the same float
+    QString text;
+    for (int precision = 6; precision <= 9; ++precision) {
+        text = QString::number(static_cast<double>(value), 'g', precision);
+        if (text.toFloat() == value) {
+            break;
+        }
+    }
+    return text;
+}
+
+} // namespace
+
+bool PGBinaryFormat::isDecodable(Oid type)
+{
+    switch (type) {
+    case BOOL_OID:
+    case BYTEA_OID:
+    case CHAR_OID:
+    case NAME_OID:
+    case INT8_OID:
+    case INT2_OID:
+    case INT4_OID:
+    case TEXT_OID:
+    case OID_OID:
+    case JSON_OID:
+    case XML_OID:
+    case FLOAT4_OID:
+    case FLOAT8_OID:
+    case BPCHAR_OID:
+    case VARCHAR_OID:
+    case DATE_OID:
+    case TIME_OID:
+    case TIMESTAMP_OID:
+    case NUMERIC_OID:
+    case UUID_OID:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool PGBinaryFormat::isBinaryParam(Oid type)
+{
+    // text of bytea is hex and would be doubled, parsed again by server
+    return type == BYTEA_OID;
+}
+
+QByteArray PGBinaryFormat::binaryParam(Oid type, const QString & text)
+{
+    Q_ASSERT(isBinaryParam(type));
+    Q_UNUSED(type);
+
+    if (text.startsWith(QLatin1String("\\x"))) {
+        return QByteArray::fromHex(text.mid(2).toLatin1());
+    }
+    return text.toUtf8(); // typed in as is
+}
+
+bool PGBinaryFormat::canDecodeAll(const PGresult * description)
+{
+    int fieldsCount = PQnfields(description);
+    if (fieldsCount == 0) {
+        return false;
+    }
+    for (int i = 0; i < fieldsCount; ++i) {
+        if (!isDecodable(PQftype(description, i))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void PGBinaryFormat::appendValue(ColumnarResultStorage::Batch & batch,
+                                 std::size_t column,
+                                 Oid type,
+                                 const char * data,
+                                 int length)
+{
+    switch (type) {
+
+    case INT2_OID:
+        batch.appendInteger(column, static_cast<qint16>(readUInt16(data)));
+        break;
+
+    case INT4_OID:
+        batch.appendInteger(column, static_cast<qint32>(readUInt32(data)));
+        break;
+
+    case INT8_OID:
+        batch.appendInteger(column, static_cast<qint64>(readUInt64(data)));
+        break;
+
+    case OID_OID:
+        batch.appendInteger(column, static_cast<qint64>(readUInt32(data)));
+        break;
+
+    case BOOL_OID: {
+        bool value = data[0] != 0;
+        batch.appendInteger(column,
+                            value ? QStringLiteral("t") : QStringLiteral("f"),
+                            value ? 1 : 0);
+        break;
+    }
+
+    case FLOAT4_OID: {
+        quint32 bits = readUInt32(data);
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        batch.appendFloat(column, floatText(value), value);
+        break;
+    }
+
+    case FLOAT8_OID: {
+        quint64 bits = readUInt64(data);
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        batch.appendFloat(column, value);
+        break;
+    }
+
+    case NUMERIC_OID:
+        appendNumeric(batch, column, data);
+        break;
+
+    case DATE_OID: {
+        qint32 days = static_cast<qint32>(readUInt32(data));
+        if (days == std::numeric_limits<qint32>::max()) {
+            batch.appendInteger(column, QStringLiteral("infinity"), days);
+        } else if (days == std::numeric_limits<qint32>::min()) {
+            batch.appendInteger(column, QStringLiteral("-infinity"), days);
+        } else {
+            bool isBC = false;
+            QString text = dateText(days, &isBC);
+            if (isBC) {
+                text += QLatin1String(" BC");
+            }
+            batch.appendInteger(column, text, days);
+        }
+        break;
+    }
+
+    case TIME_OID:
+        batch.appendInteger(column,
+                            timeText(static_cast<qint64>(readUInt64(data))),
+                            static_cast<qint64>(readUInt64(data)));
+        break;
+
+    case TIMESTAMP_OID: {
+        qint64 usecs = static_cast<qint64>(readUInt64(data));
+        if (usecs == std::numeric_limits<qint64>::max()) {
+            batch.appendInteger(column, QStringLiteral("infinity"), usecs);
+        } else if (usecs == std::numeric_limits<qint64>::min()) {
+            batch.appendInteger(column, QStringLiteral("-infinity"), usecs);
+        } else {
+            qint64 days = usecs / USECS_PER_DAY;
+            qint64 time = usecs % USECS_PER_DAY;
+            if (time < 0) { // before 2000-01-01
+                time += USECS_PER_DAY;
+                --days;
+            }
+            bool isBC = false;
+            QString text = dateText(static_cast<int>(days), &isBC)
+                    + QLatin1Char(' ') + timeText(time);
+            if (isBC) {
+                text += QLatin1String(" BC");
+            }
+            batch.appendInteger(column, text, usecs);
+        }
+        break;
+    }
+
+    case UUID_OID: {
+        static const char hex[] = "0123456789abcdef";
+        char text[36];
+        int pos = 0;
+        for (int i = 0; i < 16; ++i) {
+            if (i == 4 || i == 6 || i == 8 || i == 10) {
+                text[pos++] = '-';
+            }
+            unsigned char byte = static_cast<unsigned char>(data[i]);
+            text[pos++] = hex[byte >> 4];
+            text[pos++] = hex[byte & 0x0F];
+        }
+        batch.appendLatin1(column, text, pos);
+        break;
+    }
+
+    case BYTEA_OID: {
+        // same \x hex text as in text format, but half the traffic
+        QByteArray text;
+        text.reserve(length * 2 + 2);
+        text += "\\x";
+        text += QByteArray::fromRawData(data, length).toHex();
+        batch.appendLatin1(column, text.constData(), text.size());
+        break;
+    }
+
+    default: // text types, binary is the same as text
+        batch.appendUtf8(column, data, length);
+        break;
+    }
+}
+
+} // namespace db
+} // namespace meow
@@ -0,0 +1,38 @@
+#ifndef DB_PG_BINARY_FORMAT_H
+#define DB_PG_BINARY_FORMAT_H
+
+#include <libpq-fe.h>
+#include "db/columnar_result_storage.h"
+
+namespace meow {
+namespace db {
+
+// Intent: decodes cells of PostgreSQL binary result format into storage.
+// Cells get the same text as in text format (ISO DateStyle), numbers also
+// keep typed values. Binary format is requested for all columns of result,
+// so it is used only if every column type is known here.
+class PGBinaryFormat
+{
+public:
+    static bool isDecodable(Oid type);
+
+    // true if all columns of described statement are decodable
+    static bool canDecodeAll(const PGresult * description);
+
+    // true if param of type is sent in binary format
+    static bool isBinaryParam(Oid type);
+
+    // raw bytes of param given as text of result, e.g. \x0a0b for bytea
+    static QByteArray binaryParam(Oid type, const QString & text);
+
+    static void appendValue(ColumnarResultStorage::Batch & batch,
+                            std::size_t column,
+                            Oid type,
+                            const char * data,
+                            int length);
+};
+
+} // namespace db
+} // namespace meow
+
+#endif // DB_PG_BINARY_FORMAT_H
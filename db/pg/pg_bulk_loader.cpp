@@ -0,0 +1,86 @@
+#include "pg_bulk_loader.h"
+#include "pg_connection.h"
+#include "helpers/logger.h"
+
+// https://www.postgresql.org/docs/current/libpq-copy.html
+
+namespace meow {
+namespace db {
+
+PGBulkLoader::PGBulkLoader(PGConnection * connection,
+                           PGconn * handle,
+                           const QString & quotedTable,
+                           const QStringList & columns)
+    : BulkLoader(connection, quotedTable, columns)
+    , _handle(handle)
+{
+    Q_ASSERT(_handle != nullptr);
+}
+
+void PGBulkLoader::addRow(const QStringList & values)
+{
+    appendTextRow(values);
+}
+
+BulkLoader::FlushResult PGBulkLoader::flush()
+{
+    if (_bufferedRowsCount == 0) {
+        return {};
+    }
+
+    QString SQL = "COPY " + _quotedTable + " (" + quotedColumns()
+            + ") FROM STDIN";
+
+    QByteArray data = _connection->isUnicode()
+            ? _buffer.toUtf8() : _buffer.toLatin1();
+    clearBuffer();
+
+    threads::MutexLocker locker(_connection->mutex()); // protects _handle
+
+    meowLogCC(Log::Category::SQL, _connection) << SQL;
+
+    QByteArray nativeSQL = SQL.toUtf8();
+
+    PGresult * res = PQexec(_handle, nativeSQL.constData());
+    if (PQresultStatus(res) != PGRES_COPY_IN) {
+        QString error = resultError(res);
+        PQclear(res);
+        meowLogCC(Log::Category::Error, _connection)
+            << "Bulk load failed: " << error;
+        throw db::Exception(error);
+    }
+    PQclear(res);
+
+    // blocking connection: calls return when data is queued
+    bool isSent = PQputCopyData(_handle, data.constData(), data.size()) == 1;
+    PQputCopyEnd(_handle, isSent ? nullptr : "Failed to send data");
+
+    // COPY is all or nothing, first bad row fails whole portion
+    QString error;
+    while ((res = PQgetResult(_handle)) != nullptr) {
+        if (PQresultStatus(res) != PGRES_COMMAND_OK && error.isEmpty()) {
+            error = resultError(res);
+        }
+        PQclear(res);
+    }
+
+    if (!error.isEmpty()) {
+        meowLogCC(Log::Category::Error, _connection)
+            << "Bulk load failed: " << error;
+        throw db::Exception(error);
+    }
+
+    return {};
+}
+
+QString PGBulkLoader::resultError(PGresult * res) const
+{
+    QString error = QString::fromUtf8(PQresultErrorMessage(res)).trimmed();
+    if (error.isEmpty()) {
+        error = QString::fromUtf8(PQerrorMessage(_handle)).trimmed();
+    }
+    return error;
+}
+
+} // namespace db
+} // namespace meow
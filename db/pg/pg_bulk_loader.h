@@ -0,0 +1,33 @@
+#ifndef DB_PG_BULK_LOADER_H
+#define DB_PG_BULK_LOADER_H
+
+#include <libpq-fe.h>
+#include "db/bulk_loader.h"
+
+namespace meow {
+namespace db {
+
+class PGConnection;
+
+// Intent: loads portions with COPY ... FROM STDIN in text format
+class PGBulkLoader : public BulkLoader
+{
+public:
+    PGBulkLoader(PGConnection * connection,
+                 PGconn * handle,
+                 const QString & quotedTable,
+                 const QStringList & columns);
+
+    virtual void addRow(const QStringList & values) override;
+    virtual FlushResult flush() override;
+
+private:
+    QString resultError(PGresult * res) const;
+
+    PGconn * _handle;
+};
+
+} // namespace db
+} // namespace meow
+
+#endif // DB_PG_BULK_LOADER_H
@@ -2,6 +2,10 @@
 #include "pg_connection_query_killer.h"
 #include "helpers/logger.h"
 #include "pg_query_result.h"
+#include "pg_streamed_query_result.h"
+#include "pg_binary_format.h"
+#include "pg_prepared_statement.h"
+#include "pg_bulk_loader.h"
 #include "db/query.h"
 #include "pg_query_data_editor.h"
 #include "db/data_type/pg_connection_data_types.h"
@@ -11,8 +15,10 @@
 #include "db/entity/database_entity.h"
 #include "pg_entity_create_code_generator.h"
 #include "ssh/ssh_tunnel_factory.h"
+#include "app/app.h"
 
 #include <QElapsedTimer>
+#include <QRegularExpression>
 #include <QDebug>
 
 namespace meow {
@@ -23,8 +29,10 @@ static const int PG_SEND_QUERY_STATUS_SUCCESS = 1;
 PGConnection::PGConnection(const ConnectionParameters & params)
     : Connection(params)
     , _handle(nullptr)
+    , _cancel(nullptr)
     , _sshTunnel(nullptr)
     , _currentPort(0)
+    , _preparedStatementsCount(0)
 {
 
     _identifierQuote = QLatin1Char('"');
@@ -83,6 +91,7 @@ void PGConnection::setActive(bool active)
             throw db::Exception(error);
         } else {
             _active = true;
+            _cancel = PQgetCancel(_handle);
             meowLogDebugC(this) << "Connected";
 
             _serverVersionString = getCell("SELECT VERSION()");
@@ -102,8 +111,13 @@ void PGConnection::setActive(bool active)
         }
     // !active
     } else if (_handle != nullptr) {
-        PQfinish(_handle);
         _active = false;
+        clearPreparedStatements(); // no DEALLOCATE when inactive
+        if (_cancel) {
+            PQfreeCancel(_cancel);
+            _cancel = nullptr;
+        }
+        PQfinish(_handle);
         _handle = nullptr;
         _sshTunnel.reset();
         meowLogDebugC(this) << "Closed";
@@ -185,6 +199,8 @@ QueryResults PGConnection::query(
         const QString & SQL,
         bool storeResult)
 {
+    threads::MutexLocker locker(mutex()); // protects _handle
+
     meowLogCC(Log::Category::SQL, this) << SQL;
 
     ping(true);
@@ -220,51 +236,334 @@ QueryResults PGConnection::query(
 
     while (queryResult->nativePtr() != nullptr) {
 
-        ExecStatusType resultStatus = PQresultStatus(queryResult->nativePtr());
+        addQueryResult(queryResult, storeResult, results);
 
-        if (resultStatus == PGRES_TUPLES_OK) { // got data
+        // next query
+        elapsedTimer.start();
+        queryResult = std::make_shared<PGQueryResult>(this);
+        queryResult->init(PQgetResult(_handle), _handle);
+        results.incExecDuration(
+                std::chrono::milliseconds(elapsedTimer.elapsed()));
+    }
 
-            results.incRowsFound(static_cast<db::ulonglong>(
-                        PQntuples(queryResult->nativePtr())));
+    meowLogDebugC(this) << "Query rows found/affected: " << results.rowsFound()
+                        << "/" << results.rowsAffected();
 
-            // TODO: affected is 0 for INSERT ... RETURNING *
+    return results;
+}
 
-            if (storeResult) {
-                results << queryResult;
-            }
+QueryResults PGConnection::queryStreamed(const QString & SQL)
+{
+    threads::MutexLocker locker(mutex()); // protects _handle
 
-        } else if (resultStatus == PGRES_COMMAND_OK) { // no data but ok
+    meowLogCC(Log::Category::SQL, this) << SQL;
 
-            auto affected =
-                QString::fromUtf8( PQcmdTuples(queryResult->nativePtr()) );
-            results.incRowsAffected(
-                    static_cast<db::ulonglong>(affected.toInt())
-            );
+    ping(true);
 
-        } else { // something went wrong
+    QueryResults results;
 
-            queryResult->clearAll();
-            results.clear();
-            QString error = getLastError();
-            meowLogCC(Log::Category::Error, this) << "Query (next) failed: "
-                                                  << error;
-            throw db::Exception(error);
+    QByteArray nativeSQL;
+
+    if (isUnicode()) {
+        nativeSQL = SQL.toUtf8();
+    } else {
+        nativeSQL = SQL.toLatin1();
+    }
+
+    QElapsedTimer elapsedTimer;
+
+    int sendQueryStatus = 0;
+
+    // cancel of unread rows aborts transaction, so it's fine only if none
+    // is open before query and no statement before SELECT opens one
+    bool canCancelUnreadRows = PQtransactionStatus(_handle) == PQTRANS_IDLE;
+
+    if (meow::app()->settings()->dataFetching()->receiveBinaryResults()) {
+        sendQueryStatus = sendQueryBinaryIfDecodable(nativeSQL);
+    } else {
+        sendQueryStatus = PQsendQuery(_handle, nativeSQL.constData());
+    }
+
+    if (sendQueryStatus != PG_SEND_QUERY_STATUS_SUCCESS) {
+        QString error = getLastError();
+        meowLogCC(Log::Category::Error, this) << "Query failed: " << error;
+        throw db::Exception(error);
+    }
+
+    // rows are not buffered by libpq, but come in portions
+    // on PGStreamedQueryResult::fetchMore()
+#ifdef LIBPQ_HAS_CHUNK_MODE
+    int rowsModeStatus = PQsetChunkedRowsMode(_handle, DATA_ROWS_PER_STEP);
+#else
+    int rowsModeStatus = PQsetSingleRowMode(_handle);
+#endif
+    if (rowsModeStatus != 1) {
+        meowLogDebugC(this) << "Rows mode is not set, result is buffered";
+    }
+
+    elapsedTimer.start();
+    PGresult * res = PQgetResult(_handle);
+    results.incExecDuration(
+            std::chrono::milliseconds(elapsedTimer.elapsed()));
+
+    while (res != nullptr) {
+
+        if (PGStreamedQueryResult::isRowsPortion(PQresultStatus(res))) {
+            // result keeps connection locked until all rows are fetched,
+            // results of next statements are skipped
+            auto result = std::make_shared<PGStreamedQueryResult>(this);
+            result->setCancelUnreadRows(canCancelUnreadRows);
+            result->init(res, _handle);
+            results << result;
+            return results;
         }
 
-        // next query
+        // empty result set, not a SELECT or an error
+        auto queryResult = std::make_shared<PGQueryResult>(this);
+        queryResult->init(res, _handle);
+        addQueryResult(queryResult, true, results);
+        canCancelUnreadRows = false; // e.g. BEGIN
+
         elapsedTimer.start();
-        queryResult = std::make_shared<PGQueryResult>(this);
-        queryResult->init(PQgetResult(_handle), _handle);
+        res = PQgetResult(_handle);
         results.incExecDuration(
                 std::chrono::milliseconds(elapsedTimer.elapsed()));
     }
 
-    meowLogDebugC(this) << "Query rows found/affected: " << results.rowsFound()
-                        << "/" << results.rowsAffected();
-
     return results;
 }
 
+std::vector<QueryResults> PGConnection::queryPipelined(
+        const QStringList & SQLs,
+        QStringList * errors)
+{
+#ifdef LIBPQ_HAS_PIPELINING
+    threads::MutexLocker locker(mutex()); // protects _handle
+
+    ping(true);
+
+    if (SQLs.size() < 2 || PQenterPipelineMode(_handle) != 1) {
+        return Connection::queryPipelined(SQLs, errors);
+    }
+
+    std::vector<QueryResults> resultsList(static_cast<std::size_t>(SQLs.size()));
+    errors->clear();
+
+    QElapsedTimer elapsedTimer;
+    elapsedTimer.start();
+
+    // sync after each statement makes it a separate implicit transaction,
+    // so an error doesn't abort the rest of pipeline
+    int sentCount = 0;
+    QString sendError;
+    for (const QString & SQL : SQLs) {
+
+        meowLogCC(Log::Category::SQL, this) << SQL;
+
+        QByteArray nativeSQL = isUnicode() ? SQL.toUtf8() : SQL.toLatin1();
+
+        int sendQueryStatus = PQsendQueryParams(_handle,
+                                                nativeSQL.constData(),
+                                                0, nullptr, nullptr,
+                                                nullptr, nullptr, 0);
+        if (sendQueryStatus != PG_SEND_QUERY_STATUS_SUCCESS
+                || PQpipelineSync(_handle) != 1) {
+            sendError = getLastError();
+            meowLogCC(Log::Category::Error, this) << "Query failed: "
+                                                  << sendError;
+            break;
+        }
+        ++sentCount;
+    }
+
+    for (int i = 0; i < sentCount; ++i) {
+
+        QueryResults & results = resultsList[static_cast<std::size_t>(i)];
+        QString error;
+
+        // results of statement end with nullptr, then comes its sync
+        PGresult * res = PQgetResult(_handle);
+        while (res != nullptr) {
+            ExecStatusType status = PQresultStatus(res);
+            if (status == PGRES_TUPLES_OK || status == PGRES_COMMAND_OK) {
+                auto queryResult = std::make_shared<PGQueryResult>(this);
+                queryResult->init(res, _handle);
+                addQueryResult(queryResult, true, results);
+            } else {
+                error = QString::fromUtf8(PQresultErrorMessage(res)).trimmed();
+                PQclear(res);
+                meowLogCC(Log::Category::Error, this)
+                        << "Query (pipelined) failed: " << error;
+            }
+            res = PQgetResult(_handle);
+        }
+
+        res = PQgetResult(_handle);
+        Q_ASSERT(res == nullptr || PQresultStatus(res) == PGRES_PIPELINE_SYNC);
+        PQclear(res);
+
+        results.incExecDuration(
+                std::chrono::milliseconds(elapsedTimer.restart()));
+
+        if (!error.isEmpty()) {
+            results.clear();
+        }
+        errors->append(error);
+    }
+
+    for (int i = sentCount; i < SQLs.size(); ++i) {
+        errors->append(sendError);
+    }
+
+    if (PQexitPipelineMode(_handle) != 1) {
+        meowLogCC(Log::Category::Error, this) << "Failed to exit pipeline: "
+                                              << getLastError();
+    }
+
+    return resultsList;
+#else
+    return Connection::queryPipelined(SQLs, errors);
+#endif
+}
+
+int PGConnection::sendQueryBinaryIfDecodable(const QByteArray & nativeSQL)
+{
+    // binary format can be requested only for the whole result of single
+    // statement in extended protocol, so column types are checked first;
+    // that costs a round trip, worth it for selects only
+    static const QRegularExpression singleSelect(
+        "^\\s*(SELECT|WITH|VALUES|TABLE)\\b[^;]*;?\\s*$",
+        QRegularExpression::CaseInsensitiveOption);
+
+    if (!singleSelect.match(QString::fromUtf8(nativeSQL)).hasMatch()) {
+        return PQsendQuery(_handle, nativeSQL.constData());
+    }
+
+    bool isBinary = false;
+    if (!prepareUnnamed(nativeSQL, &isBinary)) {
+        if (PQtransactionStatus(_handle) == PQTRANS_INERROR) {
+            return 0; // failed prepare aborted transaction, show its error
+        }
+        // e.g. statements that can't be prepared, server tells the rest
+        return PQsendQuery(_handle, nativeSQL.constData());
+    }
+
+    return PQsendQueryPrepared(_handle, "", 0, nullptr, nullptr, nullptr,
+                               isBinary ? 1 : 0);
+}
+
+bool PGConnection::prepareUnnamed(const QByteArray & nativeSQL,
+                                  bool * canDecodeAll)
+{
+    *canDecodeAll = false;
+
+#ifdef LIBPQ_HAS_PIPELINING
+    if (PQenterPipelineMode(_handle) == 1) {
+        // prepare and describe go in one round trip
+        bool isSent = PQsendPrepare(_handle, "", nativeSQL.constData(),
+                                    0, nullptr) == 1
+                && PQsendDescribePrepared(_handle, "") == 1
+                && PQpipelineSync(_handle) == 1;
+
+        bool isPrepared = false;
+        if (isSent) {
+            // result and nullptr of each command, then sync
+            PGresult * res = PQgetResult(_handle);
+            isPrepared = PQresultStatus(res) == PGRES_COMMAND_OK;
+            PQclear(res);
+            PQclear(PQgetResult(_handle));
+
+            res = PQgetResult(_handle);
+            *canDecodeAll = isPrepared
+                    && PQresultStatus(res) == PGRES_COMMAND_OK
+                    && PGBinaryFormat::canDecodeAll(res);
+            PQclear(res);
+            PQclear(PQgetResult(_handle));
+
+            res = PQgetResult(_handle);
+            Q_ASSERT(res == nullptr
+                     || PQresultStatus(res) == PGRES_PIPELINE_SYNC);
+            PQclear(res);
+        }
+
+        if (PQexitPipelineMode(_handle) != 1) {
+            meowLogCC(Log::Category::Error, this)
+                << "Failed to exit pipeline: " << getLastError();
+        }
+        return isPrepared;
+    }
+#endif
+
+    PGresult * res = PQprepare(_handle, "", nativeSQL.constData(), 0, nullptr);
+    bool isPrepared = PQresultStatus(res) == PGRES_COMMAND_OK;
+    PQclear(res);
+    if (!isPrepared) {
+        return false; // error is in PQerrorMessage
+    }
+
+    res = PQdescribePrepared(_handle, "");
+    *canDecodeAll = PQresultStatus(res) == PGRES_COMMAND_OK
+            && PGBinaryFormat::canDecodeAll(res);
+    PQclear(res);
+
+    return true;
+}
+
+void PGConnection::addQueryResult(
+        const std::shared_ptr<PGQueryResult> & queryResult,
+        bool storeResult,
+        QueryResults & results)
+{
+    ExecStatusType resultStatus = PQresultStatus(queryResult->nativePtr());
+
+    if (resultStatus == PGRES_TUPLES_OK) { // got data
+
+        results.incRowsFound(static_cast<db::ulonglong>(
+                    PQntuples(queryResult->nativePtr())));
+
+        // TODO: affected is 0 for INSERT ... RETURNING *
+
+        if (storeResult) {
+            results << queryResult;
+        }
+
+        queryResult->freeNative(); // rows are already decoded
+
+    } else if (resultStatus == PGRES_COMMAND_OK) { // no data but ok
+
+        auto affected =
+            QString::fromUtf8( PQcmdTuples(queryResult->nativePtr()) );
+        results.incRowsAffected(
+                static_cast<db::ulonglong>(affected.toInt())
+        );
+
+    } else { // something went wrong
+
+        queryResult->clearAll();
+        results.clear();
+        QString error = getLastError();
+        meowLogCC(Log::Category::Error, this) << "Query (next) failed: "
+                                              << error;
+        throw db::Exception(error);
+    }
+}
+
+bool PGConnection::cancelQuery()
+{
+    if (_cancel == nullptr) {
+        return false;
+    }
+
+    char error[256];
+    if (PQcancel(_cancel, error, sizeof(error)) == 0) {
+        meowLogCC(Log::Category::Error, this) << "Cancel failed: "
+                                              << QString::fromUtf8(error);
+        return false;
+    }
+
+    return true;
+}
+
 QString PGConnection::escapeString(const QString & str,
                              bool processJokerChars,
                              bool doQuote) const
@@ -487,12 +786,60 @@ int64_t PGConnection::connectionIdOnServer()
     return _connectionIdOnServer;
 }
 
+PreparedStatementPtr PGConnection::prepare(const QString & SQL)
+{
+    meowLogDebugC(this) << "Prepare: " << SQL;
+
+    QString name = QString("meow_stmt_%1").arg(++_preparedStatementsCount);
+
+    QByteArray nativeName = name.toUtf8();
+    QByteArray nativeSQL = SQL.toUtf8();
+
+    PGresult * res = PQprepare(_handle,
+                               nativeName.constData(),
+                               nativeSQL.constData(),
+                               0, // param types are inferred
+                               nullptr);
+
+    if (PQresultStatus(res) != PGRES_COMMAND_OK) {
+        QString error = QString::fromUtf8(PQresultErrorMessage(res)).trimmed();
+        PQclear(res);
+        meowLogCC(Log::Category::Error, this) << "Prepare failed: " << error;
+        throw db::Exception(error);
+    }
+
+    PQclear(res);
+
+    // to know which params to bind in binary
+    std::vector<Oid> paramTypes;
+    res = PQdescribePrepared(_handle, nativeName.constData());
+    if (PQresultStatus(res) == PGRES_COMMAND_OK) {
+        int paramCount = PQnparams(res);
+        paramTypes.reserve(static_cast<std::size_t>(paramCount));
+        for (int i = 0; i < paramCount; ++i) {
+            paramTypes.push_back(PQparamtype(res, i));
+        }
+    } // else all are bound as text
+    PQclear(res);
+
+    return std::make_shared<PGPreparedStatement>(
+        this, _handle, name, SQL, paramTypes);
+}
+
 ConnectionQueryKillerPtr PGConnection::createQueryKiller() const
 {
     return std::make_shared<PGConnectionQueryKiller>(
                 const_cast<PGConnection *>(this));
 }
 
+std::unique_ptr<BulkLoader> PGConnection::createBulkLoader(
+        const TableEntity * table,
+        const QStringList & columns)
+{
+    return std::unique_ptr<BulkLoader>(
+        new PGBulkLoader(this, _handle, quotedFullName(table), columns));
+}
+
 DataBaseEntitiesFetcher * PGConnection::createDbEntitiesFetcher()
 {
     return new PGEntitiesFetcher(this);
@@ -11,6 +11,8 @@ namespace ssh { class ISSHTunnel; }
 
 namespace db {
 
+class PGQueryResult;
+
 class PGConnection : public Connection
 {
 public:
@@ -34,6 +36,18 @@ public:
             const QString & SQL,
             bool storeResult = false) override;
 
+    virtual QueryResults queryStreamed(const QString & SQL) override;
+
+    // Sends all statements (single one each) in pipeline mode and reads
+    // results after, one round-trip instead of one per statement
+    virtual std::vector<QueryResults> queryPipelined(
+            const QStringList & SQLs,
+            QStringList * errors) override;
+
+    // Asks server to cancel running query of this connection without
+    // helper connection, thread-safe
+    bool cancelQuery();
+
     virtual QString escapeString(const QString & str,
                                  bool processJokerChars = false,
                                  bool doQuote = true) const override;
@@ -72,6 +86,14 @@ public:
 
     virtual ConnectionQueryKillerPtr createQueryKiller() const override;
 
+    virtual std::unique_ptr<BulkLoader> createBulkLoader(
+            const TableEntity * table,
+            const QStringList & columns) override;
+
+    virtual QString paramPlaceholder(int index) const override {
+        return QString("$%1").arg(index + 1);
+    }
+
 protected:
     virtual DataBaseEntitiesFetcher * createDbEntitiesFetcher() override;
 
@@ -84,8 +106,22 @@ protected:
 
     virtual ConnectionFeatures * createFeatures() override;
 
+    virtual PreparedStatementPtr prepare(const QString & SQL) override;
+
 private:
 
+    // Sends single SELECT with binary result format if all its columns
+    // can be decoded, anything else as text; returns status of send call
+    int sendQueryBinaryIfDecodable(const QByteArray & nativeSQL);
+    // Prepares unnamed statement, false if failed
+    bool prepareUnnamed(const QByteArray & nativeSQL, bool * canDecodeAll);
+
+    // Adds received result (not a portion of rows) to results, throws
+    // if it is an error
+    void addQueryResult(const std::shared_ptr<PGQueryResult> & queryResult,
+                        bool storeResult,
+                        QueryResults & results);
+
     QString connectionInfo() const;
     
     QString escapeConnectionParam(const QString & param) const;
@@ -93,10 +129,12 @@ private:
     inline QString qu(const char * identifier) const;
 
     PGconn * _handle;
+    PGcancel * _cancel;
     std::shared_ptr<ssh::ISSHTunnel> _sshTunnel;
 
     QString _currentHostName;
     quint16 _currentPort;
+    int _preparedStatementsCount; // for unique names
 };
 
 } // namespace db
@@ -1,5 +1,5 @@
 #include "pg_connection_query_killer.h"
-#include "db/connection.h"
+#include "pg_connection.h"
 
 namespace meow {
 namespace db {
@@ -10,6 +10,15 @@ PGConnectionQueryKiller::PGConnectionQueryKiller(Connection * connection)
 
 }
 
+void PGConnectionQueryKiller::run()
+{
+    // cancel request of libpq needs no login and works mid-stream
+    if (static_cast<PGConnection *>(_connection)->cancelQuery()) {
+        return;
+    }
+    ConnectionQueryKiller::run(); // pg_cancel_backend() on helper connection
+}
+
 QString PGConnectionQueryKiller::killQueryStatement() const
 {
     // TODO: not tested
@@ -11,6 +11,8 @@ class PGConnectionQueryKiller : public ConnectionQueryKiller
 public:
     explicit PGConnectionQueryKiller(Connection * connection);
 
+    virtual void run() override;
+
 protected:
     virtual QString killQueryStatement() const override;
 };
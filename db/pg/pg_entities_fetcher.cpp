@@ -22,14 +22,70 @@ QList<EntityPtr> PGEntitiesFetcher::run(const QString & dbName)
 
     QList<EntityPtr> list;
 
-    fetchTablesViews(dbName, &list);
-    fetchStoredFunctions(dbName, &list);
+    // independent, so sent at once
+    QStringList errors;
+    std::vector<QueryPtr> queries = _connection->getPipelinedResults({
+        SQLToSelectTablesViews(dbName),
+        SQLToSelectStoredFunctions(dbName)
+    }, &errors);
+
+    if (queries[0]) {
+        parseTablesViews(queries[0].get(), &list);
+    } else {
+        meowLogCC(Log::Category::Error, _connection)
+                << "Failed to fetch tables/views: " << errors[0];
+    }
+
+    if (queries[1]) {
+        parseStoredFunctions(queries[1].get(), &list);
+    } else {
+        meowLogCC(Log::Category::Error, _connection)
+                << "Failed to fetch stored functions: " << errors[1];
+    }
 
     return list;
 }
 
-void PGEntitiesFetcher::fetchTablesViews(const QString & dbName,
-                                         QList<EntityPtr> * toList)
+QString PGEntitiesFetcher::fingerprint(const QString & dbName)
+{
+    const QString schema = _connection->escapeString(dbName);
+
+    // every change of catalog row gives it a new xmin, so count and sum of
+    // xmins of schema's relations, columns, defaults, constraints and
+    // functions
+    auto checksum = [&schema](const QString & from, const QString & alias) {
+        return "(SELECT COUNT(*) || ':' || COALESCE(SUM(" + alias
+            + ".xmin::text::bigint), 0) FROM " + from
+            + " WHERE n.nspname = " + schema + ")";
+    };
+
+    const QString classes = "pg_catalog.pg_class c "
+        "JOIN pg_catalog.pg_namespace n ON n.oid = c.relnamespace";
+
+    QStringList parts;
+    parts << checksum(classes, "c")
+          << checksum("pg_catalog.pg_attribute a "
+                      "JOIN " + classes + " ON c.oid = a.attrelid", "a")
+          << checksum("pg_catalog.pg_attrdef d "
+                      "JOIN " + classes + " ON c.oid = d.adrelid", "d")
+          << checksum("pg_catalog.pg_constraint k "
+                      "JOIN pg_catalog.pg_namespace n "
+                      "ON n.oid = k.connamespace", "k")
+          << checksum("pg_catalog.pg_proc p "
+                      "JOIN pg_catalog.pg_namespace n "
+                      "ON n.oid = p.pronamespace", "p");
+
+    try {
+        return _connection->getRow("SELECT " + parts.join(", ")).join(';');
+    } catch(meow::db::Exception & ex) {
+        meowLogCC(Log::Category::Error, _connection)
+                << "Failed to check entities of " << dbName
+                << ": " << ex.message();
+    }
+    return QString();
+}
+
+QString PGEntitiesFetcher::SQLToSelectTablesViews(const QString & dbName) const
 {
     QString schemaTable;
     if (_connection->serverVersionInt() >= 70300) {
@@ -62,18 +118,12 @@ void PGEntitiesFetcher::fetchTablesViews(const QString & dbName,
     + "WHERE t." + qu("table_schema") + "=" + _connection->escapeString(dbName)
     + " ORDER BY t.table_name";
 
-    QueryPtr queryResults;
-
-    try {
-        queryResults = _connection->getResults(SQL);
-    } catch(meow::db::Exception & ex) {
-        meowLogCC(Log::Category::Error, _connection)
-                << "Failed to fetch tables/views: " << ex.message();
-        return;
-    }
-
-    Query * resPtr = queryResults.get();
+    return SQL;
+}
 
+void PGEntitiesFetcher::parseTablesViews(Query * resPtr,
+                                         QList<EntityPtr> * toList)
+{
     std::size_t indexOfName = resPtr->indexOfColumn("table_name");
     std::size_t indexOfRows = resPtr->indexOfColumn("reltuples");
     std::size_t indexOfDataLen = resPtr->indexOfColumn("data_length");
@@ -110,11 +160,9 @@ void PGEntitiesFetcher::fetchTablesViews(const QString & dbName,
     }
 }
 
-void PGEntitiesFetcher::fetchStoredFunctions(const QString & dbName,
-                                             QList<EntityPtr> * toList)
+QString PGEntitiesFetcher::SQLToSelectStoredFunctions(
+        const QString & dbName) const
 {
-    QueryPtr queryResults;
-
     const QString pDot = qu("p") + ".";
     const QString nDot = qu("n") + ".";
     const QString cDot = qu("pg_catalog") + ".";
@@ -128,16 +176,12 @@ void PGEntitiesFetcher::fetchStoredFunctions(const QString & dbName,
     + " = " + _connection->escapeString(dbName)
     + " ORDER BY " + pDot + qu("proname");
 
-    try {
-        queryResults = _connection->getResults(SQL);
-    } catch (meow::db::Exception & ex) {
-        meowLogCC(Log::Category::Error, _connection)
-                << "Failed to fetch stored functions: " << ex.message();
-        return;
-    }
-
-    Query * resPtr = queryResults.get();
+    return SQL;
+}
 
+void PGEntitiesFetcher::parseStoredFunctions(Query * resPtr,
+                                             QList<EntityPtr> * toList)
+{
     std::size_t indexOfName     = resPtr->indexOfColumn("proname");
     std::size_t indexOfArgTypes  = resPtr->indexOfColumn("proargtypes");
     Q_UNUSED(indexOfArgTypes); // TODO
@@ -7,6 +7,7 @@ namespace meow {
 namespace db {
 
 class PGConnection;
+class Query;
 
 class PGEntitiesFetcher : public DataBaseEntitiesFetcher
 {
@@ -14,12 +15,13 @@ public:
     PGEntitiesFetcher(PGConnection * connection);
 
     virtual QList<EntityPtr> run(const QString & dbName) override;
+    virtual QString fingerprint(const QString & dbName) override;
 private:
-    void fetchTablesViews(const QString & dbName,
-                          QList<EntityPtr> * toList);
+    QString SQLToSelectTablesViews(const QString & dbName) const;
+    void parseTablesViews(Query * resPtr, QList<EntityPtr> * toList);
 
-    void fetchStoredFunctions(const QString & dbName,
-                              QList<EntityPtr> * toList);
+    QString SQLToSelectStoredFunctions(const QString & dbName) const;
+    void parseStoredFunctions(Query * resPtr, QList<EntityPtr> * toList);
 
     inline QString qu(const char * identifier) const;
 };
@@ -43,8 +43,21 @@ QString PGEntityCreateCodeGenerator::run(const TableEntity * table)
 
     QString SQL = "CREATE TABLE " + _connection->quoteIdentifier(table->name());
 
-    QString columnsSQL = createColumnsSQL(table->name());
-    QString keysSQL = createKeysSQL(table->name());
+    // independent, so sent at once
+    QStringList errors;
+    std::vector<QueryPtr> queries = _connection->getPipelinedResults({
+        SQLToSelectColumnsInfo(table->name()),
+        SQLToSelectKeysInfo(table->name())
+    }, &errors);
+
+    for (int i = 0; i < errors.size(); ++i) {
+        if (!errors[i].isEmpty()) {
+            throw db::Exception(errors[i]);
+        }
+    }
+
+    QString columnsSQL = createColumnsSQL(queries[0].get());
+    QString keysSQL = createKeysSQL(queries[1].get());
 
     SQL += " (";
 
@@ -82,11 +95,8 @@ QString PGEntityCreateCodeGenerator::run(const ViewEntity * view)
     return SQL;
 }
 
-QString PGEntityCreateCodeGenerator::createColumnsSQL(const QString & tableName)
+QString PGEntityCreateCodeGenerator::createColumnsSQL(Query * columnsQuery)
 {
-    QueryPtr columnsQuery = _connection->getResults(
-            SQLToSelectColumnsInfo(tableName));
-
     QString SQL;
 
     std::size_t indexOfCharMaxLen
@@ -212,11 +222,8 @@ QString PGEntityCreateCodeGenerator::SQLToSelectKeysInfo(
     return SQL;
 }
 
-QString PGEntityCreateCodeGenerator::createKeysSQL(const QString & tableName)
+QString PGEntityCreateCodeGenerator::createKeysSQL(Query * keysQuery)
 {
-    QueryPtr keysQuery = _connection->getResults(
-            SQLToSelectKeysInfo(tableName));
-
     QString SQL;
 
     QString constraintName;
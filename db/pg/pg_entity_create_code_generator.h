@@ -10,6 +10,7 @@ class PGConnection;
 class Entity;
 class TableEntity;
 class ViewEntity;
+class Query;
 
 class PGEntityCreateCodeGenerator
 {
@@ -22,10 +23,10 @@ private:
     QString run(const ViewEntity * view);
 
     QString SQLToSelectColumnsInfo(const QString & tableName);
-    QString createColumnsSQL(const QString & tableName);
+    QString createColumnsSQL(Query * columnsQuery);
 
     QString SQLToSelectKeysInfo(const QString & tableName);
-    QString createKeysSQL(const QString & tableName);
+    QString createKeysSQL(Query * keysQuery);
 
     PGConnection * _connection;
 };
@@ -0,0 +1,109 @@
+#include "pg_prepared_statement.h"
+#include <vector>
+#include "pg_connection.h"
+#include "pg_binary_format.h"
+#include "helpers/logger.h"
+
+// https://www.postgresql.org/docs/current/libpq-exec.html
+
+namespace meow {
+namespace db {
+
+PGPreparedStatement::PGPreparedStatement(PGConnection * connection,
+                                         PGconn * handle,
+                                         const QString & name,
+                                         const QString & SQL,
+                                         const std::vector<Oid> & paramTypes)
+    : PreparedStatement(SQL)
+    , _connection(connection)
+    , _handle(handle)
+    , _name(name.toUtf8())
+    , _paramTypes(paramTypes)
+    , _rowsAffected(0)
+{
+    Q_ASSERT(_handle != nullptr);
+}
+
+PGPreparedStatement::~PGPreparedStatement()
+{
+    threads::MutexLocker locker(_connection->mutex()); // protects _handle
+    if (!_connection->active()) {
+        return; // server frees statements of closed session
+    }
+    QByteArray deallocateSQL = "DEALLOCATE " + _name;
+    PQclear(PQexec(_handle, deallocateSQL.constData()));
+}
+
+QStringList PGPreparedStatement::execute(const QStringList & params)
+{
+    threads::MutexLocker locker(_connection->mutex()); // protects _handle
+
+    meowLogCC(Log::Category::SQL, _connection) << SQL();
+
+    int paramCount = params.size();
+
+    // text format, server parses values by param types it inferred;
+    // bytes go in binary to avoid hex text of double size
+    std::vector<QByteArray> values(static_cast<std::size_t>(paramCount));
+    std::vector<const char *> valuePtrs(static_cast<std::size_t>(paramCount));
+    std::vector<int> lengths(static_cast<std::size_t>(paramCount), 0);
+    std::vector<int> formats(static_cast<std::size_t>(paramCount), 0);
+
+    for (int i = 0; i < paramCount; ++i) {
+        std::size_t index = static_cast<std::size_t>(i);
+        if (params[i].isNull()) {
+            valuePtrs[index] = nullptr; // NULL
+            continue;
+        }
+        Oid type = index < _paramTypes.size() ? _paramTypes[index] : 0;
+        if (PGBinaryFormat::isBinaryParam(type)) {
+            values[index] = PGBinaryFormat::binaryParam(type, params[i]);
+            formats[index] = 1;
+        } else {
+            values[index] = params[i].toUtf8();
+        }
+        valuePtrs[index] = values[index].constData();
+        lengths[index] = values[index].size(); // ignored for text
+    }
+
+    PGresult * res = PQexecPrepared(_handle,
+                                    _name.constData(),
+                                    paramCount,
+                                    valuePtrs.data(),
+                                    lengths.data(),
+                                    formats.data(),
+                                    0); // text result
+
+    ExecStatusType status = PQresultStatus(res);
+
+    if (status != PGRES_COMMAND_OK && status != PGRES_TUPLES_OK) {
+        QString error = QString::fromUtf8(PQresultErrorMessage(res)).trimmed();
+        PQclear(res);
+        meowLogCC(Log::Category::Error, _connection)
+            << "Statement failed: " << error;
+        throw db::Exception(error);
+    }
+
+    _rowsAffected = QString::fromUtf8(PQcmdTuples(res)).toULongLong();
+
+    QStringList firstRow;
+    if (status == PGRES_TUPLES_OK && PQntuples(res) > 0) {
+        int columnCount = PQnfields(res);
+        firstRow.reserve(columnCount);
+        for (int c = 0; c < columnCount; ++c) {
+            if (PQgetisnull(res, 0, c)) {
+                firstRow << QString();
+            } else {
+                firstRow << QString::fromUtf8(PQgetvalue(res, 0, c),
+                                              PQgetlength(res, 0, c));
+            }
+        }
+    }
+
+    PQclear(res);
+
+    return firstRow;
+}
+
+} // namespace db
+} // namespace meow
@@ -0,0 +1,41 @@
+#ifndef DB_PG_PREPARED_STATEMENT_H
+#define DB_PG_PREPARED_STATEMENT_H
+
+#include <vector>
+#include <libpq-fe.h>
+#include "db/prepared_statement.h"
+
+namespace meow {
+namespace db {
+
+class PGConnection;
+
+// Intent: named statement of PQprepare(), executed with PQexecPrepared()
+class PGPreparedStatement : public PreparedStatement
+{
+public:
+    PGPreparedStatement(PGConnection * connection,
+                        PGconn * handle,
+                        const QString & name,
+                        const QString & SQL,
+                        const std::vector<Oid> & paramTypes);
+    virtual ~PGPreparedStatement() override;
+
+    virtual QStringList execute(const QStringList & params) override;
+
+    virtual db::ulonglong rowsAffected() const override {
+        return _rowsAffected;
+    }
+
+private:
+    PGConnection * _connection;
+    PGconn * _handle;
+    const QByteArray _name;
+    const std::vector<Oid> _paramTypes; // as inferred by server
+    db::ulonglong _rowsAffected;
+};
+
+} // namespace db
+} // namespace meow
+
+#endif // DB_PG_PREPARED_STATEMENT_H
@@ -8,10 +8,41 @@
 namespace meow {
 namespace db {
 
+void PGQueryDataEditor::update(
+        QueryData * data,
+        const QStringList & assignments,
+        QStringList * params)
+{
+    Connection * connection = data->query()->connection();
+
+    QStringList columnNames = connection->quoteIdentifiers(
+        data->query()->columnOrgNames());
+
+    QString updateSQL = QString("UPDATE %1 SET %2 WHERE %3 RETURNING %4")
+        .arg(db::quotedFullName(data->query()->entity()))
+        .arg(assignments.join(", "))
+        .arg(data->whereForCurRow(true, params))
+        .arg(columnNames.join(", "));
+
+    // update and get new values in the same round-trip
+    QStringList newRowData = execute(connection, updateSQL, params, true);
+
+    EditableGridDataRow * row = data->query()->editableData()->editableRow();
+
+    if (newRowData.size() != row->data.size()) {
+        return; // reloaded with select
+    }
+
+    row->data = newRowData;
+
+    _modificationsLoaded = true; // avoid extra select
+}
+
 void PGQueryDataEditor::insert(
         QueryData * data,
         const QStringList & columns,
-        const QStringList & values)
+        const QStringList & values,
+        const QStringList * params)
 {
     Connection * connection = data->query()->connection();
 
@@ -23,7 +54,7 @@ void PGQueryDataEditor::insert(
         .arg(values.join(", "));
 
     // insert and get the whole new row, PG is cool
-    QStringList newRowData = connection->getRow(insertSQL);
+    QStringList newRowData = execute(connection, insertSQL, params, true);
 
     editableData->editableRow()->isInserted = false;
 
@@ -14,9 +14,14 @@ class PGQueryDataEditor : public QueryDataEditor
     }
 
 protected:
+    virtual void update(QueryData * data,
+                        const QStringList & assignments,
+                        QStringList * params) override;
+
     virtual void insert(QueryData * data,
                 const QStringList & columns,
-                const QStringList & values) override;
+                const QStringList & values,
+                const QStringList * params) override;
 private:
     bool _modificationsLoaded = false;
 };
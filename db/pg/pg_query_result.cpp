@@ -2,6 +2,7 @@
 #include "db/editable_grid_data.h"
 #include "db/data_type/pg_connection_data_types.h"
 #include "db/pg/pg_connection.h"
+#include "db/pg/pg_binary_format.h"
 
 namespace meow {
 namespace db {
@@ -13,140 +14,28 @@ void PGQueryResult::init(PGresult * result, PGconn * connectionHandle)
     _res = result;
     _connectionHandle = connectionHandle;
 
-    _recordCount = nativeRowsCount();
-
     clearColumnData();
 
     addColumnData(_res);
 
-    if (isEditing()) {
-        prepareResultForEditing(this);
-    }
-
-    seekFirst();
-}
-
-bool PGQueryResult::hasData() const
-{
-    return _res != nullptr || NativeQueryResult::hasData();
-}
-
-void PGQueryResult::seekRecNo(db::ulonglong value)
-{
-    if (value == _curRecNo) {
-        return;
-    }
-
-    if (value >= recordCount()) {
-        _curRecNo = recordCount();
-        _eof = true;
-        return;
-    }
-
-    if (isEditing() == false) {
-
-        std::vector<PGresult *> resultList = this->resultList();
-
-        db::ulonglong numRows = 0;
-        for (PGresult * result : resultList) {
+    _storage.setColumnCount(columnCount());
 
-            db::ulonglong resultNumRows = PQntuples(result);
-            numRows += resultNumRows;
-
-            if (numRows > value) {
-                _currentResult = result;
-                // TODO: using unsigned with "-" is risky
-                _curRecNoLocal = resultNumRows - (numRows - value);
-
-                for (size_t i=0; i<_columnLengths.size(); ++i) {
-                    _columnLengths[i] = static_cast<unsigned int>(
-                        PQgetlength(
-                            _currentResult,
-                            static_cast<int>(_curRecNoLocal),
-                            static_cast<int>(i)
-                        )
-                    );
-                }
-
-                break;
-            }
-        }
+    if (PQresultStatus(_res) == PGRES_TUPLES_OK) {
+        decodeRows(_res);
     }
 
-    _curRecNo = value;
-    _eof = false;
-}
-
-QString PGQueryResult::curRowColumn(std::size_t index,
-                                    bool ignoreErrors)
-{
-    // TODO: hide this check for release builds?
-    if (index < columnCount()) {
-
-        if (isEditing()) {
-            return _editableData->dataAt(_curRecNo, index);
-        }
-
-
-        return rowDataToString(_currentResult,
-                               static_cast<int>(_curRecNoLocal),
-                               static_cast<int>(index),
-                               static_cast<int>(_columnLengths[index]));
-
-    } else if (!ignoreErrors) {
-        throw db::Exception(QString(
-            "Column #%1 not available. Query returned %2 columns and %3 rows.")
-            .arg(index).arg(columnCount()).arg(recordCount()
-        ));
-    }
-
-    return QString();
-}
-
-bool PGQueryResult::isNull(std::size_t index)
-{
-    throwOnInvalidColumnIndex(index);
+    _recordCount = nativeRowsCount();
 
     if (isEditing()) {
-        return _editableData->dataAt(_curRecNo, index).isNull();
+        prepareResultForEditing(this);
     }
 
-    return PQgetisnull(
-        _currentResult,
-        static_cast<int>(_curRecNoLocal),
-        static_cast<int>(index)
-    ) == 1;
-}
-
-void PGQueryResult::prepareResultForEditing(NativeQueryResult * result)
-{
-    PGresult * nativeRes = static_cast<PGQueryResult *>(result)->nativePtr();
-
-    int numRows = PQntuples(nativeRes);
-    int numCols = PQnfields(nativeRes);
-
-    _editableData->reserveForAppend(numRows);
-
-    for (int row = 0; row < numRows; ++row) {
-        GridDataRow rowData;
-        rowData.reserve(numCols);
-
-        for (int col = 0; col < numCols; ++col) {
-
-            int cellLength = PQgetlength(nativeRes, row, col);
-            rowData.append(
-                rowDataToString(nativeRes, row, col, cellLength)
-            );
-        }
-
-        _editableData->appendRow(rowData);
-    }
+    seekFirst();
 }
 
 void PGQueryResult::clearColumnData()
 {
     _columns.clear();
-    _columnLengths.clear();
     _columnIndexes.clear();
     _columnsParsed = false;
 }
@@ -160,7 +49,6 @@ void PGQueryResult::addColumnData(PGresult * result)
 
     unsigned int numFields = static_cast<unsigned int>(PQnfields(result));
 
-    _columnLengths.resize(numFields);
     // TODO: skip columns parsing when we don't need them (e.g. sample queries)
 
     _columns.resize(numFields);
@@ -182,24 +70,6 @@ void PGQueryResult::addColumnData(PGresult * result)
     _columnsParsed = true;
 }
 
-std::vector<PGresult *> PGQueryResult::resultList() const
-{
-    // TODO: optimize/cache resultList?
-    std::vector<PGresult *> resultList;
-    resultList.reserve(_appendedResults.size() + 1);
-    if (_res) {
-        resultList.push_back(_res);
-    }
-
-    for (const QueryResultPt & appendedResult : _appendedResults) {
-        resultList.push_back(
-            static_cast<PGQueryResult *>(appendedResult.get())
-                    ->nativePtr()
-        );
-    }
-    return resultList;
-}
-
 void PGQueryResult::clearAll() {
     while (_res != nullptr) {
         PQclear(_res);
@@ -207,35 +77,51 @@ void PGQueryResult::clearAll() {
     }
 }
 
-QString PGQueryResult::rowDataToString(PGresult * result,
-                        int row,
-                        int col,
-                        int dataLen)
+void PGQueryResult::decodeRows(PGresult * result)
 {
+    ColumnarResultStorage::Batch batch(
+                static_cast<std::size_t>(PQnfields(result)),
+                static_cast<std::size_t>(PQntuples(result)));
 
-    // PQgetvalue() returns "" for NULL values, so we need this:
-    if (PQgetisnull(result, row, col)) {
-        return QString(); // Null str
-    }
+    appendRowsTo(batch, result);
 
-    QString str;
-
-    auto typeCategory = column(col).dataType->categoryIndex;
-    if (typeCategory == DataTypeCategoryIndex::Binary
-        || typeCategory == DataTypeCategoryIndex::Spatial) {
-        str = QString::fromLatin1(
-                    PQgetvalue(result, row, col),
-                    dataLen);
-    // } else if (bool) { // TODO
-
-    } else {
-        // TODO: non-unicode support?
-        str = QString::fromUtf8(
-                    PQgetvalue(result, row, col),
-                    dataLen);
-    }
+    _storage.addBatch(std::move(batch));
+}
+
+void PGQueryResult::appendRowsTo(ColumnarResultStorage::Batch & batch,
+                                 PGresult * result) const
+{
+    int numRows = PQntuples(result);
+    int numCols = PQnfields(result);
+
+    for (int row = 0; row < numRows; ++row) {
+        for (int col = 0; col < numCols; ++col) {
+
+            // PQgetvalue() returns "" for NULL values, so we need this:
+            if (PQgetisnull(result, row, col)) {
+                batch.appendNull(col);
+                continue;
+            }
 
-    return str;
+            const char * data = PQgetvalue(result, row, col);
+            int dataLen = PQgetlength(result, row, col);
+
+            if (PQfformat(result, col) == 1) { // binary
+                PGBinaryFormat::appendValue(batch, col, PQftype(result, col),
+                                            data, dataLen);
+                continue;
+            }
+
+            auto typeCategory = column(col).dataType->categoryIndex;
+            if (typeCategory == DataTypeCategoryIndex::Binary
+                || typeCategory == DataTypeCategoryIndex::Spatial) {
+                batch.appendLatin1(col, data, dataLen);
+            // } else if (bool) { // TODO
+            } else {
+                batch.appendUtf8(col, data, dataLen);
+            }
+        }
+    }
 }
 
 } // namespace db
@@ -8,14 +8,13 @@
 namespace meow {
 namespace db {
 
-// Wraps and owns PGresult ptr
+// Wraps and owns PGresult ptr, decodes its rows into storage
 class PGQueryResult : public NativeQueryResult
 {
 public:
     PGQueryResult(Connection * connection) :
         NativeQueryResult(connection),
         _res(nullptr),
-        _currentResult(nullptr),
         _connectionHandle(nullptr),
         _columnsParsed(false)
     {
@@ -29,25 +28,14 @@ public:
     }
 
     virtual db::ulonglong nativeRowsCount() const override {
-        return static_cast<db::ulonglong>(PQntuples(_res));
+        return _storage.rowCount();
     }
 
-    virtual bool hasData() const override;
-
-    virtual void seekRecNo(db::ulonglong value) override;
-
-    virtual QString curRowColumn(std::size_t index,
-                                 bool ignoreErrors = false) override;
-
-    virtual bool isNull(std::size_t index) override;
-
     void clearAll();
 
     PGresult * nativePtr() const { return _res; }
-protected:
-    virtual void prepareResultForEditing(NativeQueryResult * result) override;
-private:
 
+    // all rows are in storage after init(), native is kept for status only
     void freeNative() {
         if (_res) {
             PQclear(_res);
@@ -55,20 +43,20 @@ private:
         }
     }
 
+protected:
+
     void clearColumnData();
     void addColumnData(PGresult * res);
-    std::vector<PGresult *> resultList() const;
-    QString rowDataToString(PGresult * result,
-                            int row,
-                            int col,
-                            int dataLen);
+    void appendRowsTo(ColumnarResultStorage::Batch & batch,
+                      PGresult * result) const;
+
+private:
+
+    void decodeRows(PGresult * result);
 
     PGresult * _res;
-    PGresult * _currentResult;
     PGconn * _connectionHandle;
-    std::vector<unsigned int> _columnLengths;
     bool _columnsParsed;
-    db::ulonglong _curRecNoLocal;
 };
 
 using PGQueryResultPtr = std::shared_ptr<PGQueryResult>;
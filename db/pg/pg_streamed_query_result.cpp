@@ -0,0 +1,215 @@
+#include "pg_streamed_query_result.h"
+#include "pg_connection.h"
+#include "db/connection_query_killer.h"
+#include "db/exception.h"
+#include "helpers/logger.h"
+
+namespace meow {
+namespace db {
+
+PGStreamedQueryResult::PGStreamedQueryResult(PGConnection * connection)
+    : PGQueryResult(connection)
+    , _pgConnection(connection)
+    , _handle(nullptr)
+    , _pendingRes(nullptr)
+    , _maxBufferSize(DATA_STREAM_MAX_BUFFER_SIZE)
+    , _isAllReceived(false)
+    , _cancelUnreadRows(false)
+    , _isFetching(false)
+    , _abortRequested(false)
+    , _isFetchLimited(false)
+{
+
+}
+
+PGStreamedQueryResult::~PGStreamedQueryResult()
+{
+    finishFetching();
+}
+
+bool PGStreamedQueryResult::isRowsPortion(ExecStatusType status)
+{
+#ifdef LIBPQ_HAS_CHUNK_MODE
+    if (status == PGRES_TUPLES_CHUNK) {
+        return true;
+    }
+#endif
+    return status == PGRES_SINGLE_TUPLE;
+}
+
+void PGStreamedQueryResult::init(PGresult * res, PGconn * handle)
+{
+    Q_ASSERT(res != nullptr && handle != nullptr);
+
+    // no other queries are possible until result is read out
+    _pgConnection->mutex()->lock();
+    _handle = handle;
+    _isFetching = true;
+
+    clearColumnData();
+    addColumnData(res);
+    _storage.setColumnCount(columnCount());
+
+    _pendingRes = res; // decoded on first fetchMore()
+
+    _recordCount = 0;
+
+    seekFirst();
+}
+
+QString PGStreamedQueryResult::curRowColumn(std::size_t index,
+                                            bool ignoreErrors)
+{
+    QMutexLocker locker(&_rowsMutex);
+    return PGQueryResult::curRowColumn(index, ignoreErrors);
+}
+
+bool PGStreamedQueryResult::isNull(std::size_t index)
+{
+    QMutexLocker locker(&_rowsMutex);
+    return PGQueryResult::isNull(index);
+}
+
+bool PGStreamedQueryResult::curRowInteger(std::size_t index, qint64 * value)
+{
+    QMutexLocker locker(&_rowsMutex);
+    return PGQueryResult::curRowInteger(index, value);
+}
+
+bool PGStreamedQueryResult::curRowFloat(std::size_t index, double * value)
+{
+    QMutexLocker locker(&_rowsMutex);
+    return PGQueryResult::curRowFloat(index, value);
+}
+
+db::ulonglong PGStreamedQueryResult::fetchMore(db::ulonglong maxRows)
+{
+    if (!_isFetching) {
+        return 0;
+    }
+
+    ColumnarResultStorage::Batch batch(columnCount());
+
+    std::size_t bufferSize = 0;
+    {
+        QMutexLocker locker(&_rowsMutex);
+        bufferSize = _storage.dataSize();
+    }
+
+    bool finished = false;
+    QString error;
+
+    while (batch.rowCount() < maxRows) {
+
+        if (_abortRequested) {
+            finished = true;
+            break;
+        }
+
+        PGresult * res = _pendingRes ? _pendingRes : PQgetResult(_handle);
+        _pendingRes = nullptr;
+
+        if (res == nullptr) { // no more results
+            _isAllReceived = true;
+            finished = true;
+            break;
+        }
+
+        ExecStatusType status = PQresultStatus(res);
+
+        if (isRowsPortion(status)) {
+            appendRowsTo(batch, res);
+            PQclear(res);
+        } else if (status == PGRES_TUPLES_OK) { // zero-row end of result set
+            PQclear(res);
+            _isAllReceived = true;
+            finished = true;
+            break;
+        } else {
+            PQclear(res);
+            _isAllReceived = true; // server has stopped sending rows
+            error = _pgConnection->getLastError();
+            finished = true;
+            break;
+        }
+
+        if (bufferSize + batch.dataSize() >= _maxBufferSize) {
+            _isFetchLimited = true;
+            finished = true;
+            break;
+        }
+    }
+
+    std::size_t fetchedCount = batch.rowCount();
+
+    if (fetchedCount > 0) {
+        QMutexLocker locker(&_rowsMutex);
+        _storage.addBatch(std::move(batch));
+        _recordCount += fetchedCount;
+    }
+
+    if (finished) {
+        if (_isFetchLimited) {
+            meowLogCC(Log::Category::Info, _pgConnection)
+                << "Result buffer limit is reached, rows fetched: "
+                << recordCount();
+        }
+        finishFetching();
+        if (!error.isEmpty()) {
+            meowLogCC(Log::Category::Error, _pgConnection)
+                << "Query (fetch) failed: " << error;
+            throw db::Exception(error);
+        }
+    }
+
+    return fetchedCount;
+}
+
+void PGStreamedQueryResult::clearFetchedRows()
+{
+    QMutexLocker locker(&_rowsMutex);
+    PGQueryResult::clearFetchedRows();
+}
+
+void PGStreamedQueryResult::finishFetching()
+{
+    if (!_isFetching) {
+        return;
+    }
+
+    if (_pendingRes) {
+        PQclear(_pendingRes);
+        _pendingRes = nullptr;
+    }
+
+    if (!_isAllReceived && _cancelUnreadRows) {
+        // server would send all the rest otherwise
+        try {
+            _pgConnection->createQueryKiller()->run();
+        } catch(meow::db::Exception & ex) {
+            meowLogCC(Log::Category::Error, _pgConnection)
+                << "Failed to cancel query: " << ex.message();
+        }
+    }
+
+    // skips unread rows and results of next statements
+    PGresult * res = nullptr;
+    while ((res = PQgetResult(_handle)) != nullptr) {
+        PQclear(res);
+    }
+
+    _isFetching = false;
+    _pgConnection->mutex()->unlock();
+}
+
+void PGStreamedQueryResult::prepareResultForEditing(
+        NativeQueryResult * result)
+{
+    Q_ASSERT(!_isFetching);
+
+    QMutexLocker locker(&_rowsMutex);
+    PGQueryResult::prepareResultForEditing(result);
+}
+
+} // namespace db
+} // namespace meow
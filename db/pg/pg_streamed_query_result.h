@@ -0,0 +1,74 @@
+#ifndef DB_PG_STREAMED_QUERY_RESULT_H
+#define DB_PG_STREAMED_QUERY_RESULT_H
+
+#include <atomic>
+#include <QMutex>
+#include "pg_query_result.h"
+
+namespace meow {
+namespace db {
+
+class PGConnection;
+
+// Intent: result of query in single-row (or chunked rows) mode, receives
+// rows on fetchMore() and decodes them into storage batch by batch, so
+// libpq never buffers the whole result. Connection stays locked until all
+// rows are fetched, fetching is aborted or buffer size limit is reached.
+class PGStreamedQueryResult : public PGQueryResult
+{
+public:
+    explicit PGStreamedQueryResult(PGConnection * connection);
+
+    virtual ~PGStreamedQueryResult() override;
+
+    // res is the first portion of rows
+    void init(PGresult * res, PGconn * handle);
+
+    virtual db::ulonglong nativeRowsCount() const override {
+        return _recordCount;
+    }
+
+    virtual QString curRowColumn(std::size_t index,
+                                 bool ignoreErrors = false) override;
+
+    virtual bool isNull(std::size_t index) override;
+
+    virtual bool curRowInteger(std::size_t index, qint64 * value) override;
+    virtual bool curRowFloat(std::size_t index, double * value) override;
+
+    virtual bool isFetching() const override { return _isFetching; }
+    virtual db::ulonglong fetchMore(db::ulonglong maxRows) override;
+    virtual void abortFetching() override { _abortRequested = true; }
+    virtual bool isFetchLimited() const override { return _isFetchLimited; }
+    virtual void clearFetchedRows() override;
+
+    void setMaxBufferSize(db::ulonglong size) { _maxBufferSize = size; }
+    // false to read unread rows out instead of cancelling the query, as
+    // cancel aborts transaction block the query runs in
+    void setCancelUnreadRows(bool cancel) { _cancelUnreadRows = cancel; }
+
+    static bool isRowsPortion(ExecStatusType status);
+
+protected:
+    virtual void prepareResultForEditing(NativeQueryResult * result) override;
+
+private:
+
+    void finishFetching();
+
+    PGConnection * _pgConnection;
+    PGconn * _handle;
+    PGresult * _pendingRes; // received, but not decoded yet
+    mutable QMutex _rowsMutex; // rows are appended and read in diff threads
+    db::ulonglong _maxBufferSize;
+    bool _isAllReceived;
+    bool _cancelUnreadRows;
+    std::atomic<bool> _isFetching;
+    std::atomic<bool> _abortRequested;
+    std::atomic<bool> _isFetchLimited;
+};
+
+} // namespace db
+} // namespace meow
+
+#endif // DB_PG_STREAMED_QUERY_RESULT_H
@@ -0,0 +1,36 @@
+#ifndef DB_PREPARED_STATEMENT_H
+#define DB_PREPARED_STATEMENT_H
+
+#include <memory>
+#include <QStringList>
+#include "common.h"
+
+namespace meow {
+namespace db {
+
+// Intent: statement parsed by server once and executed many times,
+// params are sent apart from SQL and need no escaping.
+class PreparedStatement
+{
+public:
+    explicit PreparedStatement(const QString & SQL) : _SQL(SQL) {}
+    virtual ~PreparedStatement() {}
+
+    // Binds params in placeholders order, null QString is bound as NULL.
+    // Returns first row of result if any (e.g. INSERT ... RETURNING)
+    virtual QStringList execute(const QStringList & params) = 0;
+
+    virtual db::ulonglong rowsAffected() const = 0;
+
+    const QString & SQL() const { return _SQL; }
+
+private:
+    const QString _SQL;
+};
+
+using PreparedStatementPtr = std::shared_ptr<PreparedStatement>;
+
+} // namespace db
+} // namespace meow
+
+#endif // DB_PREPARED_STATEMENT_H
@@ -0,0 +1,47 @@
+#include "prepared_statement_cache.h"
+
+namespace meow {
+namespace db {
+
+PreparedStatementCache::PreparedStatementCache(std::size_t maxSize)
+    : _maxSize(maxSize)
+{
+    Q_ASSERT(_maxSize > 0);
+}
+
+PreparedStatementPtr PreparedStatementCache::get(const QString & SQL)
+{
+    auto it = _statementsBySQL.find(SQL);
+    if (it == _statementsBySQL.end()) {
+        return nullptr;
+    }
+    // move to front, iterators stay valid
+    _statements.splice(_statements.begin(), _statements, it.value());
+    return _statements.front();
+}
+
+void PreparedStatementCache::put(const PreparedStatementPtr & statement)
+{
+    auto it = _statementsBySQL.find(statement->SQL());
+    if (it != _statementsBySQL.end()) {
+        _statements.erase(it.value());
+        _statementsBySQL.erase(it);
+    }
+
+    _statements.push_front(statement);
+    _statementsBySQL.insert(statement->SQL(), _statements.begin());
+
+    while (_statements.size() > _maxSize) {
+        _statementsBySQL.remove(_statements.back()->SQL());
+        _statements.pop_back(); // closed unless still used outside
+    }
+}
+
+void PreparedStatementCache::clear()
+{
+    _statementsBySQL.clear();
+    _statements.clear();
+}
+
+} // namespace db
+} // namespace meow
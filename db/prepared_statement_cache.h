@@ -0,0 +1,35 @@
+#ifndef DB_PREPARED_STATEMENT_CACHE_H
+#define DB_PREPARED_STATEMENT_CACHE_H
+
+#include <list>
+#include <QHash>
+#include "prepared_statement.h"
+
+namespace meow {
+namespace db {
+
+// Intent: keeps last used prepared statements of connection by their SQL,
+// least recently used statement is closed when cache is full
+class PreparedStatementCache
+{
+public:
+    explicit PreparedStatementCache(std::size_t maxSize);
+
+    PreparedStatementPtr get(const QString & SQL); // nullptr if none
+    void put(const PreparedStatementPtr & statement);
+    void clear();
+
+    std::size_t size() const { return _statements.size(); }
+
+private:
+    using StatementsList = std::list<PreparedStatementPtr>;
+
+    const std::size_t _maxSize;
+    StatementsList _statements; // most recently used first
+    QHash<QString, StatementsList::iterator> _statementsBySQL;
+};
+
+} // namespace db
+} // namespace meow
+
+#endif // DB_PREPARED_STATEMENT_CACHE_H
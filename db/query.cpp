@@ -14,7 +14,8 @@ Query::Query(Connection * connection)
      _execDuration(std::chrono::milliseconds(0)),
      _networkDuration(std::chrono::milliseconds(0)),
      _connection(connection),
-     _entity(nullptr)
+     _entity(nullptr),
+     _streamed(false)
 {
 
 }
@@ -33,8 +34,15 @@ void Query::execute(bool appendData)
 {
     // TODO appendData for isEditing() is broken
 
-    QueryResults results = connection()->query(this->SQL(), true);
+    QueryResults results = _streamed
+            ? connection()->queryStreamed(this->SQL())
+            : connection()->query(this->SQL(), true);
 
+    setResults(results, appendData);
+}
+
+void Query::setResults(QueryResults & results, bool appendData)
+{
     if (_entity) {
         for (QueryResultPt & result : results.list()) {
             result->setEntity(_entity);
@@ -75,6 +83,41 @@ void Query::execute(bool appendData)
     }
 }
 
+void Query::appendData(const Query & other)
+{
+    Q_ASSERT(!other.isFetching());
+
+    _rowsFound += other._rowsFound.load();
+    _rowsAffected += other._rowsAffected;
+    _warningsCount += other._warningsCount;
+    _execDuration += other._execDuration;
+    _networkDuration += other._networkDuration;
+
+    if (!other._currentResult) {
+        return;
+    }
+
+    if (_currentResult) {
+        _currentResult->appendResultData(other._currentResult);
+    } else {
+        _resultList = other._resultList;
+        _currentResult = other._currentResult;
+        for (QueryResultPt & result : _resultList) {
+            result->setEntity(_entity);
+        }
+    }
+}
+
+db::ulonglong Query::fetchMore(db::ulonglong maxRows)
+{
+    if (!_currentResult) {
+        return 0;
+    }
+
+    db::ulonglong fetchedCount = _currentResult->fetchMore(maxRows);
+    _rowsFound += fetchedCount;
+    return fetchedCount;
+}
 
 } // namespace db
 } // namespace meow
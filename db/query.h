@@ -1,6 +1,7 @@
 #ifndef DB_QUERY_H
 #define DB_QUERY_H
 
+#include <atomic>
 #include <vector>
 #include <chrono>
 #include <QStringList>
@@ -9,6 +10,7 @@
 #include "common.h"
 #include "query_column.h"
 #include "native_query_result.h"
+#include "query_results.h"
 
 namespace meow {
 namespace db {
@@ -64,6 +66,37 @@ public:
     // H: procedure Execute(AddResult: Boolean=False; UseRawResult: Integer=-1); virtual; abstract;
     void execute(bool appendData = false);
 
+    // Takes results of SQL executed elsewhere, e.g. in a pipeline
+    void setResults(QueryResults & results, bool appendData = false);
+
+    // Streamed query receives rows of current result with fetchMore()
+    void setStreamed(bool streamed) { _streamed = streamed; }
+    bool isStreamed() const { return _streamed; }
+
+    inline bool isFetching() const {
+        if (!_currentResult) return false;
+        return _currentResult->isFetching();
+    }
+    db::ulonglong fetchMore(db::ulonglong maxRows);
+
+    // appends rows of current result of other query, e.g. next data page
+    void appendData(const Query & other);
+    inline void abortFetching() {
+        if (_currentResult) {
+            _currentResult->abortFetching();
+        }
+    }
+    // drops fetched rows of current result to read the next ones
+    inline void clearFetchedRows() {
+        if (_currentResult) {
+            _currentResult->clearFetchedRows();
+        }
+    }
+    inline bool isFetchLimited() const {
+        if (!_currentResult) return false;
+        return _currentResult->isFetchLimited();
+    }
+
     inline bool hasResult() {
         return _resultList.empty() == false;
     }
@@ -174,7 +207,8 @@ public:
 
 protected:
 
-    db::ulonglong _rowsFound;
+    // grows in DbThread while rows are fetched, read in main one
+    std::atomic<db::ulonglong> _rowsFound;
     db::ulonglong _rowsAffected;
     db::ulonglong _warningsCount;
     std::chrono::milliseconds _execDuration;
@@ -184,6 +218,7 @@ private:
     QString _SQL;
     Connection * _connection;
     Entity * _entity;
+    bool _streamed;
 
     std::vector<QueryResultPt> _resultList;
     QueryResultPt _currentResult;
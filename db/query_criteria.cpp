@@ -6,7 +6,8 @@ namespace db {
 QueryCriteria::QueryCriteria()
     :quotedDbAndTableName(""),
      limit(0),
-     offset(0)
+     offset(0),
+     noLimit(false)
 {
     select << "*";
 }
@@ -24,7 +24,18 @@ public:
     QString where;
     db::ulonglong limit;
     db::ulonglong offset;
+    bool noLimit; // all rows, e.g. for export; limit and offset are ignored
     QVector<SortColumn> sortColumns;
+
+    // Keyset (seek) pagination: when set and sort is compatible, rows are
+    // loaded after lastKeyValues of keyColumns instead of skipping offset
+    QStringList keyColumns;
+    QStringList lastKeyValues; // raw values of last loaded row
+
+    // When set, only rows with keys in [rangeFirst, rangeLast] are selected
+    // (in sort order, without limit), e.g. to load a page again
+    QStringList rangeFirstKeyValues;
+    QStringList rangeLastKeyValues;
 };
 
 } // namespace db
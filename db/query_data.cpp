@@ -21,6 +21,12 @@ int QueryData::rowCount() const
     return 0;
 }
 
+bool QueryData::isFetching() const
+{
+    return _queryPtr && _queryPtr->resultCount() > 0
+            && currentResult()->isFetching();
+}
+
 int QueryData::columnCount() const
 {
     if (_queryPtr && _queryPtr->resultCount() > 0) {
@@ -180,6 +186,20 @@ bool QueryData::isNullAt(int row, int column) const
     return currentResult()->isNull(static_cast<std::size_t>(column));
 }
 
+bool QueryData::integerDataAt(int row, int column, qint64 * value) const
+{
+    currentResult()->seekRecNo(static_cast<std::size_t>(row));
+    return currentResult()->curRowInteger(static_cast<std::size_t>(column),
+                                          value);
+}
+
+bool QueryData::floatDataAt(int row, int column, double * value) const
+{
+    currentResult()->seekRecNo(static_cast<std::size_t>(row));
+    return currentResult()->curRowFloat(static_cast<std::size_t>(column),
+                                        value);
+}
+
 bool QueryData::setData(int row, int col, const QVariant &value)
 {
     setCurrentRowNumber(row);
@@ -192,6 +212,9 @@ bool QueryData::setData(int row, int col, const QVariant &value)
 
 void QueryData::prepareEditing()
 {
+    if (isFetching()) {
+        return; // rows are still being added in another thread
+    }
     if (_queryPtr && _queryPtr->resultCount()) {
         currentResult()->prepareEditing();
         emit editingPrepared();
@@ -366,7 +389,8 @@ int QueryData::duplicateCurrentRowWithKeys()
     return newRowIndex;
 }
 
-QString QueryData::whereForCurRow(bool beforeModifications) const
+QString QueryData::whereForCurRow(bool beforeModifications,
+                                  QStringList * params) const
 {
     QStringList whereList;
 
@@ -423,10 +447,17 @@ QString QueryData::whereForCurRow(bool beforeModifications) const
                 break;
             // TODO: other types
             default:
-                whereVal = currentResult()->connection()->escapeString(value);
+                whereVal = params ? value
+                    : currentResult()->connection()->escapeString(value);
                 break;
             }
 
+            if (params) {
+                *params << whereVal;
+                whereVal = currentResult()->connection()->paramPlaceholder(
+                            params->size() - 1);
+            }
+
             whereVal = '=' + whereVal;
         }
 
@@ -41,10 +41,14 @@ public:
     }
 
     int rowCount() const;
+    bool isFetching() const;
     int columnCount() const;
     QString displayDataAt(int row, int column) const;
     QVariant editDataAt(int row, int column) const;
     bool isNullAt(int row, int column) const;
+    // typed numbers, false if cell is NULL or has only text
+    bool integerDataAt(int row, int column, qint64 * value) const;
+    bool floatDataAt(int row, int column, double * value) const;
     QString columnName(int index) const;
     db::DataTypeCategoryIndex columnDataTypeCategory(int index) const;
     db::DataTypePtr dataTypeForColumn(int column) const;
@@ -76,7 +80,9 @@ public:
         return query->editableData()->isRowInserted(rowNumber);
     }
 
-    QString whereForCurRow(bool beforeModifications = false) const;
+    // Values go to params with connection's placeholders in WHERE if set
+    QString whereForCurRow(bool beforeModifications = false,
+                           QStringList * params = nullptr) const;
     QString whereForRow(int row) {
         setCurrentRowNumber(row);
         return whereForCurRow();
@@ -87,6 +93,7 @@ public:
     int currentRowNumber() const { return _curRowNumber; }
 
     Q_SIGNAL void editingPrepared();
+    Q_SIGNAL void rowsFetched(); // more rows of streamed query received
 
 private:
 
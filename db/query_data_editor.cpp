@@ -23,6 +23,12 @@ bool QueryDataEditor::applyModificationsInDB(QueryData * data)
     QStringList insertValuesList;
     Connection * connection = data->query()->connection();
 
+    // same SQL for all rows with the same modified columns, parsed once
+    QStringList paramsList;
+    QStringList * params
+        = connection->features()->supportsPreparedStatements()
+            ? &paramsList : nullptr;
+
     EditableGridData * editableData = data->query()->editableData();
     Q_ASSERT(editableData);
 
@@ -43,13 +49,8 @@ bool QueryDataEditor::applyModificationsInDB(QueryData * data)
             continue; // not modified
         }
 
-        QString valInDB;
-        if (newValue.isNull()) {
-            valInDB = "NULL";
-        } else {
-            // TODO: bit/spatial/temporal preprocessing
-            valInDB = connection->escapeString(newValue);
-        }
+        // TODO: bit/spatial/temporal preprocessing
+        QString valInDB = bindValue(connection, newValue, params);
 
         QString columnName = connection->quoteIdentifier(
                     data->query()->column(c).orgName);
@@ -63,30 +64,39 @@ bool QueryDataEditor::applyModificationsInDB(QueryData * data)
     }
 
     if (!updateDataList.isEmpty()) {
-        QString updateSQL = QString("UPDATE %1 SET %2 WHERE %3 %4")
-                .arg(db::quotedFullName(data->query()->entity()))
-                .arg(updateDataList.join(", "))
-                .arg(data->whereForCurRow(true))
-                .arg(connection->limitOnePostfix(false));
-
-        // TODO: use "RETURNING *" for PG and avoid selecting result?
-
-        connection->query(updateSQL.trimmed());
+        update(data, updateDataList, params);
         // TODO check rows affected
         return true;
     } else if (!insertColumnsList.isEmpty()) {
 
-        insert(data, insertColumnsList, insertValuesList);
+        insert(data, insertColumnsList, insertValuesList, params);
         return true;
     }
 
     return false;
 }
 
+void QueryDataEditor::update(
+        QueryData * data,
+        const QStringList & assignments,
+        QStringList * params)
+{
+    Connection * connection = data->query()->connection();
+
+    QString updateSQL = QString("UPDATE %1 SET %2 WHERE %3 %4")
+            .arg(db::quotedFullName(data->query()->entity()))
+            .arg(assignments.join(", "))
+            .arg(data->whereForCurRow(true, params))
+            .arg(connection->limitOnePostfix(false));
+
+    execute(connection, updateSQL.trimmed(), params);
+}
+
 void QueryDataEditor::insert(
         QueryData * data,
         const QStringList & columns,
-        const QStringList & values)
+        const QStringList & values,
+        const QStringList * params)
 {
     // some default behavior, not so bad
 
@@ -99,7 +109,7 @@ void QueryDataEditor::insert(
         .arg(columns.join(", "))
         .arg(values.join(", "));
 
-    connection->query(insertSQL);
+    execute(connection, insertSQL, params);
 
     editableData->editableRow()->isInserted = false;
 }
@@ -111,15 +121,52 @@ void QueryDataEditor::deleteCurrentRow(QueryData * data)
 
     Connection * connection = data->query()->connection();
 
+    QStringList paramsList;
+    QStringList * params
+        = connection->features()->supportsPreparedStatements()
+            ? &paramsList : nullptr;
+
     QString deleteSQL = QString("DELETE FROM %1 WHERE %2 %3")
             .arg(db::quotedFullName(data->query()->entity()))
-            .arg(data->whereForCurRow(true))
+            .arg(data->whereForCurRow(true, params))
             .arg(connection->limitOnePostfix(false));
 
-    connection->query(deleteSQL.trimmed());
+    execute(connection, deleteSQL.trimmed(), params);
 
     // TODO check rows affected
 }
 
+QString QueryDataEditor::bindValue(Connection * connection,
+                                   const QString & value,
+                                   QStringList * params) const
+{
+    if (params) {
+        *params << value; // null is bound as NULL
+        return connection->paramPlaceholder(params->size() - 1);
+    }
+    if (value.isNull()) {
+        return QString("NULL");
+    }
+    return connection->escapeString(value);
+}
+
+QStringList QueryDataEditor::execute(Connection * connection,
+                                     const QString & SQL,
+                                     const QStringList * params,
+                                     bool getRow)
+{
+    if (params) {
+        PreparedStatementPtr statement = connection->prepareCached(SQL);
+        Q_ASSERT(statement != nullptr);
+        return statement->execute(*params);
+    }
+
+    if (getRow) {
+        return connection->getRow(SQL);
+    }
+    connection->query(SQL);
+    return QStringList();
+}
+
 } // namespace db
 } // namespace meow
@@ -7,6 +7,7 @@ namespace meow {
 namespace db {
 
 class QueryData;
+class Connection;
 
 class QueryDataEditor
 {
@@ -21,9 +22,29 @@ public:
     void deleteCurrentRow(QueryData * data);
 
 protected:
+    // assignments have placeholders of params if params are set,
+    // params of WHERE are appended
+    virtual void update(QueryData * data,
+                        const QStringList & assignments,
+                        QStringList * params);
+
+    // values have placeholders of params if params are set
     virtual void insert(QueryData * data,
                 const QStringList & columns,
-                const QStringList & values);
+                const QStringList & values,
+                const QStringList * params);
+
+    // Placeholder if params are set (value is added), escaped value otherwise
+    QString bindValue(Connection * connection,
+                      const QString & value,
+                      QStringList * params) const;
+
+    // Runs SQL as cached prepared statement if params are set,
+    // returns first row of result if asked
+    QStringList execute(Connection * connection,
+                        const QString & SQL,
+                        const QStringList * params,
+                        bool getRow = false);
 };
 
 } // namespace db
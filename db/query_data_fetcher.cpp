@@ -37,11 +37,97 @@ QueryDataFetcher::partLoadColumns(TableEntity * table)
     return partLoadColumns;
 }
 
-void QueryDataFetcher::run(
-        QueryCriteria * queryCriteria,
-        QueryData * toData)
+QStringList QueryDataFetcher::seekKeyColumns(TableEntity * table)
+{
+    QList<TableIndex *> & indicies = table->structure()->indicies();
+
+    TableIndex * key = nullptr;
+    for (TableIndex * index : indicies) {
+        if (index->isPrimaryKey() && index->columnsCount() > 0) {
+            key = index;
+            break;
+        }
+    }
+
+    if (key == nullptr) {
+        QList<meow::db::TableColumn *> partColumns = partLoadColumns(table);
+        for (TableIndex * index : indicies) {
+            if (!index->isUniqueKey() || index->columnsCount() == 0
+                    || index->hasColumnsWithAllowNull()) {
+                continue;
+            }
+            bool isFullyLoaded = true; // LEFT()-ed values can't be compared
+            for (const meow::db::TableColumn * column : partColumns) {
+                if (index->hasColumn(column->name())) {
+                    isFullyLoaded = false;
+                    break;
+                }
+            }
+            if (isFullyLoaded) {
+                key = index;
+                break;
+            }
+        }
+    }
+
+    return key ? key->columnNames() : QStringList();
+}
+
+bool QueryDataFetcher::canSeekByKey(QueryCriteria * queryCriteria,
+                                    bool * isAsc) const
+{
+    const QStringList & keyColumns = queryCriteria->keyColumns;
+
+    if (keyColumns.isEmpty()) {
+        return false;
+    }
+
+    *isAsc = true;
+
+    if (queryCriteria->sortColumns.isEmpty()) {
+        return true; // sort by key
+    }
+
+    // sort must be exactly by key columns in one direction
+    if (queryCriteria->sortColumns.size() != keyColumns.size()) {
+        return false;
+    }
+
+    *isAsc = queryCriteria->sortColumns.front().isAsc;
+
+    for (int i = 0; i < keyColumns.size(); ++i) {
+        const QueryCriteria::SortColumn & sort = queryCriteria->sortColumns[i];
+        if (sort.columnName != keyColumns[i] || sort.isAsc != *isAsc) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+QString QueryDataFetcher::seekCondition(const QStringList & keyColumns,
+                                        const QStringList & lastKeyValues,
+                                        bool isAsc) const
 {
+    QStringList columns;
+    QStringList values;
+    for (int i = 0; i < keyColumns.size(); ++i) {
+        columns << _connection->quoteIdentifier(keyColumns[i]);
+        values << _connection->escapeString(lastKeyValues[i]);
+    }
+
+    QString op = isAsc ? " > " : " < ";
 
+    if (columns.size() == 1) {
+        return columns.front() + op + values.front();
+    }
+
+    // row value comparison uses the index in MySQL 5.7+, PG and SQLite
+    return "(" + columns.join(", ") + ")" + op + "(" + values.join(", ") + ")";
+}
+
+QString QueryDataFetcher::selectSQL(QueryCriteria * queryCriteria)
+{
     QString selectList = queryCriteria->select.join(", ");
     if (selectList.isEmpty()) {
         selectList = "*";
@@ -49,11 +135,52 @@ void QueryDataFetcher::run(
     QString select = selectList
             + " FROM " + queryCriteria->quotedDbAndTableName;
 
-    if (!queryCriteria->where.isEmpty()) {
-        select += " WHERE " + queryCriteria->where;
+    // Seek to the rows after the last loaded one by key instead of OFFSET
+    // which makes server to read and skip all previous rows
+    bool isSeekAsc = true;
+    bool seekByKey = canSeekByKey(queryCriteria, &isSeekAsc);
+    db::ulonglong offset = queryCriteria->offset;
+
+    QString where = queryCriteria->where;
+
+    int keyCount = queryCriteria->keyColumns.size();
+
+    if (seekByKey && queryCriteria->rangeFirstKeyValues.size() == keyCount
+        && queryCriteria->rangeLastKeyValues.size() == keyCount) {
+        // neither before the first nor after the last
+        QString condition = "NOT (" + seekCondition(
+                                queryCriteria->keyColumns,
+                                queryCriteria->rangeFirstKeyValues,
+                                !isSeekAsc)
+                + ") AND NOT (" + seekCondition(
+                                queryCriteria->keyColumns,
+                                queryCriteria->rangeLastKeyValues,
+                                isSeekAsc) + ")";
+        where = where.isEmpty()
+                ? condition : "(" + where + ") AND " + condition;
+        offset = 0;
+    } else if (seekByKey && offset > 0
+        && queryCriteria->lastKeyValues.size() == keyCount) {
+        QString condition = seekCondition(queryCriteria->keyColumns,
+                                          queryCriteria->lastKeyValues,
+                                          isSeekAsc);
+        where = where.isEmpty()
+                ? condition : "(" + where + ") AND " + condition;
+        offset = 0;
+    }
+
+    if (!where.isEmpty()) {
+        select += " WHERE " + where;
     }
 
-    if (!queryCriteria->sortColumns.isEmpty()) {
+    if (seekByKey && queryCriteria->sortColumns.isEmpty()) {
+        // keep the order of pages stable
+        QStringList sortStatements;
+        for (const QString & keyColumn : queryCriteria->keyColumns) {
+            sortStatements << _connection->quoteIdentifier(keyColumn);
+        }
+        select += " ORDER BY " + sortStatements.join(", ");
+    } else if (!queryCriteria->sortColumns.isEmpty()) {
 
         QStringList sortStatements;
 
@@ -71,9 +198,20 @@ void QueryDataFetcher::run(
         select += " ORDER BY " + sortStatements.join(", ");
     }
 
-    select = _connection->applyQueryLimit("SELECT", select,
-                                          queryCriteria->limit,
-                                          queryCriteria->offset);
+    if (queryCriteria->noLimit) {
+        return "SELECT " + select;
+    }
+
+    return _connection->applyQueryLimit("SELECT", select,
+                                        queryCriteria->limit,
+                                        offset);
+}
+
+void QueryDataFetcher::run(
+        QueryCriteria * queryCriteria,
+        QueryData * toData)
+{
+    QString select = selectSQL(queryCriteria);
 
     Query * query = toData->query();
     if (query == nullptr) {
@@ -22,6 +22,8 @@ public:
     virtual void run(QueryCriteria * queryCriteria,
                      QueryData * toData);
 
+    QString selectSQL(QueryCriteria * queryCriteria);
+
     virtual QStringList selectList(TableEntity * table) {
         Q_UNUSED(table);
         QStringList select;
@@ -29,10 +31,20 @@ public:
         return select;
     }
 
+    // PK or NOT NULL UNIQUE key columns, empty if rows can't be sought by key
+    QStringList seekKeyColumns(TableEntity * table);
+
+    // true if rows are sorted by key columns only
+    bool canSeekByKey(QueryCriteria * queryCriteria, bool * isAsc) const;
+
 protected:
 
     QList<meow::db::TableColumn *> partLoadColumns(TableEntity * table);
 
+    virtual QString seekCondition(const QStringList & keyColumns,
+                                  const QStringList & lastKeyValues,
+                                  bool isAsc) const;
+
     Connection * _connection;
 };
 
@@ -0,0 +1,321 @@
+#include "schema_cache.h"
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include "connection_parameters.h"
+#include "db/entity/entity_factory.h"
+#include "db/entity/table_entity.h"
+#include "helpers/logger.h"
+
+namespace meow {
+namespace db {
+
+namespace {
+
+const quint32 SCHEMA_CACHE_MAGIC = 0x4D534348; // "MSCH"
+
+void writeEntity(QDataStream & stream, const SchemaCache::EntityRecord & entity)
+{
+    stream << static_cast<qint32>(entity.type)
+           << entity.name
+           << entity.created
+           << entity.updated
+           << entity.createCode
+           << entity.engine
+           << entity.collation
+           << static_cast<quint64>(entity.rowsCount)
+           << static_cast<quint64>(entity.dataSize)
+           << static_cast<quint64>(entity.version)
+           << entity.isStatusFetched;
+}
+
+void readEntity(QDataStream & stream, SchemaCache::EntityRecord * entity)
+{
+    qint32 type = 0;
+    quint64 rowsCount = 0;
+    quint64 dataSize = 0;
+    quint64 version = 0;
+    stream >> type
+           >> entity->name
+           >> entity->created
+           >> entity->updated
+           >> entity->createCode
+           >> entity->engine
+           >> entity->collation
+           >> rowsCount
+           >> dataSize
+           >> version
+           >> entity->isStatusFetched;
+    entity->type = static_cast<Entity::Type>(type);
+    entity->rowsCount = rowsCount;
+    entity->dataSize = dataSize;
+    entity->version = version;
+}
+
+bool isEntityInDatabase(Entity::Type type)
+{
+    return type == Entity::Type::Table
+        || type == Entity::Type::View
+        || type == Entity::Type::Function
+        || type == Entity::Type::Procedure
+        || type == Entity::Type::Trigger;
+}
+
+} // namespace
+
+SchemaCache::SchemaCache(const ConnectionParameters & params)
+    : _isModified(false)
+{
+    // one file per server and account, session may be renamed
+    QByteArray sessionKey = QString("%1\n%2\n%3\n%4\n%5")
+            .arg(static_cast<int>(params.serverType()))
+            .arg(params.hostName())
+            .arg(params.port())
+            .arg(params.userName())
+            .arg(params.fileName())
+            .toUtf8();
+    QString hash = QCryptographicHash::hash(sessionKey,
+                                            QCryptographicHash::Sha1).toHex();
+
+    _fileName = cachePath() + QDir::separator() + hash + ".cache";
+
+    load();
+}
+
+bool SchemaCache::database(const QString & dbName,
+                           DatabaseRecord * record) const
+{
+    auto it = _databases.constFind(dbName);
+    if (it == _databases.constEnd()) {
+        return false;
+    }
+    *record = it.value();
+    return true;
+}
+
+QString SchemaCache::fingerprint(const QString & dbName) const
+{
+    auto it = _databases.constFind(dbName);
+    if (it == _databases.constEnd()) {
+        return QString();
+    }
+    return it.value().fingerprint;
+}
+
+void SchemaCache::setDatabase(const QString & dbName,
+                              const DatabaseRecord & record)
+{
+    Q_ASSERT(!record.fingerprint.isEmpty());
+    _databases.insert(dbName, record);
+    _isModified = true;
+}
+
+void SchemaCache::updateEntities(const QString & dbName,
+                                 const std::vector<EntityRecord> & entities)
+{
+    auto it = _databases.find(dbName);
+    if (it != _databases.end()) {
+        it.value().entities = entities;
+        _isModified = true;
+    }
+}
+
+void SchemaCache::removeDatabase(const QString & dbName)
+{
+    if (_databases.remove(dbName) > 0) {
+        _isModified = true;
+    }
+}
+
+void SchemaCache::clear()
+{
+    if (!_databases.isEmpty()) {
+        _databases.clear();
+        _isModified = true;
+    }
+}
+
+bool SchemaCache::save()
+{
+    if (!_isModified) {
+        return true;
+    }
+
+    QDir dir;
+    if (!dir.exists(cachePath())) {
+        dir.mkpath(cachePath());
+    }
+
+    // written aside and renamed, so a crash never leaves half of file
+    QSaveFile file(_fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        meowLogC(Log::Category::Error) << "Failed to open schema cache file "
+                                       << "for write: " << _fileName;
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    stream << SCHEMA_CACHE_MAGIC
+           << static_cast<qint32>(SCHEMA_CACHE_VERSION)
+           << static_cast<qint32>(_databases.size());
+
+    for (auto it = _databases.constBegin(); it != _databases.constEnd(); ++it) {
+        const DatabaseRecord & record = it.value();
+        stream << it.key()
+               << record.fingerprint
+               << static_cast<qint32>(record.entities.size());
+        for (const EntityRecord & entity : record.entities) {
+            writeEntity(stream, entity);
+        }
+    }
+
+    if (!file.commit()) {
+        meowLogC(Log::Category::Error) << "Failed to write schema cache file: "
+                                       << _fileName;
+        return false;
+    }
+
+    _isModified = false;
+    return true;
+}
+
+std::vector<SchemaCache::EntityRecord> SchemaCache::toRecords(
+        const QList<EntityPtr> & entities)
+{
+    std::vector<EntityRecord> records;
+    records.reserve(static_cast<std::size_t>(entities.size()));
+
+    for (const EntityPtr & entity : entities) {
+        if (!isEntityInDatabase(entity->type())) {
+            continue;
+        }
+
+        EntityRecord record;
+        record.type = entity->type();
+        record.name = entity->name();
+        record.created = entity->created();
+        record.updated = entity->updated();
+        record.createCode = entity->cachedCreateCode();
+
+        if (entity->type() == Entity::Type::Table) {
+            auto table = static_cast<TableEntity *>(entity.get());
+            record.engine = table->engineStr();
+            record.collation = table->collation();
+            record.rowsCount = table->rowsCount(); // no query
+            record.dataSize = table->dataSize();
+            record.version = table->version();
+            record.isStatusFetched = table->isStatusFetched();
+        }
+
+        records.push_back(record);
+    }
+
+    return records;
+}
+
+QList<EntityPtr> SchemaCache::toEntities(
+        const std::vector<EntityRecord> & records)
+{
+    QList<EntityPtr> entities;
+    entities.reserve(static_cast<int>(records.size()));
+
+    for (const EntityRecord & record : records) {
+
+        std::shared_ptr<EntityInDatabase> entity
+            = EntityFactory::createEntityInDatabase(record.name, record.type);
+
+        entity->setCreated(record.created);
+        entity->setUpdated(record.updated);
+        if (!record.createCode.isEmpty()) {
+            entity->setCreateCode(record.createCode);
+        }
+
+        if (record.type == Entity::Type::Table) {
+            auto table = static_cast<TableEntity *>(entity.get());
+            table->setEngine(record.engine);
+            table->setCollation(record.collation);
+            table->setRowsCount(record.rowsCount);
+            table->setDataSize(record.dataSize);
+            table->setVersion(record.version);
+            table->setStatusFetched(record.isStatusFetched);
+        }
+
+        entities.append(entity);
+    }
+
+    return entities;
+}
+
+bool SchemaCache::load()
+{
+    QFile file(_fileName);
+    if (!file.exists()) {
+        return false;
+    }
+    if (!file.open(QIODevice::ReadOnly)) {
+        meowLogC(Log::Category::Error) << "Failed to open schema cache file: "
+                                       << _fileName;
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    quint32 magic = 0;
+    qint32 version = 0;
+    qint32 databasesCount = 0;
+    stream >> magic >> version >> databasesCount;
+
+    if (magic != SCHEMA_CACHE_MAGIC || version != SCHEMA_CACHE_VERSION) {
+        return false; // other format, will be rewritten
+    }
+
+    QMap<QString, DatabaseRecord> databases;
+
+    for (qint32 i = 0; i < databasesCount
+                       && stream.status() == QDataStream::Ok; ++i) {
+        QString dbName;
+        DatabaseRecord record;
+        qint32 entitiesCount = 0;
+        stream >> dbName >> record.fingerprint >> entitiesCount;
+        if (entitiesCount < 0) {
+            break;
+        }
+        record.entities.reserve(static_cast<std::size_t>(entitiesCount));
+        for (qint32 k = 0; k < entitiesCount
+                           && stream.status() == QDataStream::Ok; ++k) {
+            EntityRecord entity;
+            readEntity(stream, &entity);
+            if (isEntityInDatabase(entity.type)) {
+                record.entities.push_back(entity);
+            }
+        }
+        databases.insert(dbName, record);
+    }
+
+    if (stream.status() != QDataStream::Ok) {
+        meowLogC(Log::Category::Error) << "Schema cache file is broken: "
+                                       << _fileName;
+        return false;
+    }
+
+    _databases.swap(databases);
+    return true;
+}
+
+QString SchemaCache::cachePath()
+{
+    QString rootLocation = QStandardPaths::writableLocation(
+                QStandardPaths::CacheLocation);
+    return rootLocation + QDir::separator()
+            + QCoreApplication::applicationName() + "SchemaCache";
+}
+
+} // namespace db
+} // namespace meow
@@ -0,0 +1,77 @@
+#ifndef DB_SCHEMA_CACHE_H
+#define DB_SCHEMA_CACHE_H
+
+#include <vector>
+#include <QDateTime>
+#include <QMap>
+#include <QString>
+#include "common.h"
+#include "db/entity/entity.h"
+
+namespace meow {
+namespace db {
+
+class ConnectionParameters;
+
+// Intent: entities of session databases saved on disk between runs, so
+// tree is shown at once after connect and only databases with changed
+// fingerprint are fetched again. Keeps create codes to parse structures
+// without server. Main thread only.
+class SchemaCache
+{
+public:
+
+    struct EntityRecord
+    {
+        Entity::Type type = Entity::Type::None;
+        QString name;
+        QDateTime created;
+        QDateTime updated;
+        QString createCode; // empty if was not fetched
+        // tables only
+        QString engine;
+        QString collation;
+        db::ulonglong rowsCount = 0;
+        db::ulonglong dataSize = 0;
+        db::ulonglong version = 0;
+        bool isStatusFetched = true;
+    };
+
+    struct DatabaseRecord
+    {
+        QString fingerprint; // of server state entities were fetched at
+        std::vector<EntityRecord> entities;
+    };
+
+    explicit SchemaCache(const ConnectionParameters & params);
+
+    bool database(const QString & dbName, DatabaseRecord * record) const;
+    QString fingerprint(const QString & dbName) const; // empty if no database
+    void setDatabase(const QString & dbName, const DatabaseRecord & record);
+    // Replaces entities of cached database only, e.g. to keep create codes
+    // fetched later, keeps fingerprint
+    void updateEntities(const QString & dbName,
+                        const std::vector<EntityRecord> & entities);
+    void removeDatabase(const QString & dbName);
+    void clear();
+
+    bool save(); // if there are changes
+
+    static std::vector<EntityRecord> toRecords(
+            const QList<EntityPtr> & entities);
+    static QList<EntityPtr> toEntities(
+            const std::vector<EntityRecord> & records);
+
+private:
+    bool load();
+    static QString cachePath();
+
+    QString _fileName;
+    QMap<QString, DatabaseRecord> _databases;
+    bool _isModified;
+};
+
+} // namespace db
+} // namespace meow
+
+#endif // DB_SCHEMA_CACHE_H
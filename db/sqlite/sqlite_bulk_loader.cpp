@@ -0,0 +1,67 @@
+#include "sqlite_bulk_loader.h"
+#include "sqlite_connection.h"
+#include "sqlite_prepared_statement.h"
+#include "helpers/logger.h"
+
+namespace meow {
+namespace db {
+
+SQLiteBulkLoader::SQLiteBulkLoader(SQLiteConnection * connection,
+                                   const QString & quotedTable,
+                                   const QStringList & columns)
+    : BulkLoader(connection, quotedTable, columns)
+{
+
+}
+
+void SQLiteBulkLoader::addRow(const QStringList & values)
+{
+    _rows.push_back(values);
+    ++_bufferedRowsCount;
+}
+
+BulkLoader::FlushResult SQLiteBulkLoader::flush()
+{
+    if (_rows.empty()) {
+        return {};
+    }
+
+    if (!_insert) {
+        QStringList placeholders;
+        for (int i = 0; i < _columns.size(); ++i) {
+            placeholders << _connection->paramPlaceholder(i);
+        }
+        QString SQL = "INSERT INTO " + _quotedTable + " (" + quotedColumns()
+                + ") VALUES (" + placeholders.join(", ") + ")";
+
+        meowLogCC(Log::Category::SQL, _connection) << SQL;
+
+        _insert = _connection->prepareCached(SQL); // throws on error
+        std::static_pointer_cast<SQLitePreparedStatement>(_insert)
+                ->setSQLLogged(false); // once, not per row
+    }
+
+    FlushResult result;
+
+    for (std::size_t row = 0; row < _rows.size(); ++row) {
+        try {
+            // null QString is bound as NULL
+            _insert->execute(_rows[row]);
+        } catch (db::Exception & ex) {
+            Issue issue;
+            issue.row = static_cast<int>(row);
+            issue.message = ex.message();
+            issue.isRejected = true;
+            result.issues.push_back(issue);
+            ++result.rejectedCount;
+        }
+    }
+
+    _rows.clear();
+    clearBuffer();
+
+    return result;
+}
+
+} // namespace db
+} // namespace meow
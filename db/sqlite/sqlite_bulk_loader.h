@@ -0,0 +1,32 @@
+#ifndef DB_SQLITE_BULK_LOADER_H
+#define DB_SQLITE_BULK_LOADER_H
+
+#include "db/bulk_loader.h"
+#include "db/prepared_statement.h"
+
+namespace meow {
+namespace db {
+
+class SQLiteConnection;
+
+// Intent: SQLite has no bulk protocol, but prepared INSERT executed per row
+// inside transaction is as fast as it gets. Failed rows are rejected alone.
+class SQLiteBulkLoader : public BulkLoader
+{
+public:
+    SQLiteBulkLoader(SQLiteConnection * connection,
+                     const QString & quotedTable,
+                     const QStringList & columns);
+
+    virtual void addRow(const QStringList & values) override;
+    virtual FlushResult flush() override;
+
+private:
+    PreparedStatementPtr _insert;
+    std::vector<QStringList> _rows;
+};
+
+} // namespace db
+} // namespace meow
+
+#endif // DB_SQLITE_BULK_LOADER_H
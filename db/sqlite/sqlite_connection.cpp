@@ -1,14 +1,20 @@
 #include "sqlite_connection.h"
-#include "db/qtsql/qtsql_query_result.h"
+#include "sqlite_query_result.h"
+#include "sqlite_streamed_query_result.h"
+#include "sqlite_prepared_statement.h"
 #include "helpers/logger.h"
 #include "sqlite_entities_fetcher.h"
 #include "db/data_type/sqlite_connection_datatypes.h"
 #include "db/query_data_fetcher.h"
 #include "db/entity/table_entity.h"
 #include "sqlite_table_structure_parser.h"
+#include "sqlite_bulk_loader.h"
 
-// https://doc.qt.io/qt-5/sql-programming.html
-// https://code.qt.io/cgit/qt/qtbase.git/tree/examples/sql/sqlbrowser/browser.cpp?h=5.14
+#include <QElapsedTimer>
+#include <QCoreApplication>
+
+// https://www.sqlite.org/cintro.html
+// https://www.sqlite.org/wal.html
 
 
 namespace meow {
@@ -16,12 +22,12 @@ namespace db {
 
 SQLiteConnection::SQLiteConnection(const ConnectionParameters & params)
     : Connection(params)
+    , _handle(nullptr)
+    , _readHandle(nullptr)
+    , _readMutex(!params.supportsMultithreading(),
+                 params.supportsMultithreading())
 {
     // Listening: Stormlord - Leviathan
-
-    // TODO: QtSQL has multithreading limitations
-
-    _handle = QSqlDatabase::addDatabase("QSQLITE", params.sessionName());
 }
 
 SQLiteConnection::~SQLiteConnection()
@@ -39,11 +45,6 @@ SQLiteConnection::~SQLiteConnection()
 
         setActive(false);
     }
-
-    // https://doc.qt.io/qt-5/qsqldatabase.html#removeDatabase
-    _handle = QSqlDatabase();
-
-    QSqlDatabase::removeDatabase(connectionParams()->sessionName());
 }
 
 void SQLiteConnection::setActive(bool active)
@@ -51,25 +52,34 @@ void SQLiteConnection::setActive(bool active)
     if (active) {
         doBeforeConnect();
 
-        _handle.setDatabaseName(connectionParams()->fileName());
-
         meowLogDebugC(this) << "Connecting: " << *connectionParams();
 
-        if (_handle.open()) {
-            _active = true;
-            meowLogDebugC(this) << "Connected";
+        _handle = openHandle(SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+
+        _active = true;
+        meowLogDebugC(this) << "Connected";
+
+        setIsUnicode(true);
+
+        if (isFileDatabase()) {
+            // readers and writer don't block each other, setting persists
+            try {
+                QString mode = getCell("PRAGMA journal_mode=WAL");
+                if (mode.compare("wal", Qt::CaseInsensitive) == 0) {
+                    openReadHandle();
+                } else {
+                    meowLogDebugC(this) << "Journal mode: " << mode;
+                }
+            } catch (db::Exception & exc) {
+                meowLogCC(Log::Category::Error, this)
+                        << "WAL mode is not enabled: " << exc.message();
+            }
+        }
 
-            setIsUnicode(true);
+        doAfterConnect();
 
-            doAfterConnect();
-        } else {
-            QString error = getLastError();
-            meowLogCC(Log::Category::Error, this) << "Connect failed: "
-                                                  << error;
-            throw db::Exception(error);
-        }
     } else {     // !active
-        _handle.close();
+        closeHandles();
         _active = false;
         meowLogDebugC(this) << "Closed";
     }
@@ -88,7 +98,10 @@ QStringList SQLiteConnection::fetchDatabases()
 
 QString SQLiteConnection::getLastError()
 {
-    return _handle.lastError().text();
+    if (_handle == nullptr) {
+        return QString();
+    }
+    return QString::fromUtf8(sqlite3_errmsg(_handle));
 }
 
 QString SQLiteConnection::fetchCharacterSet()
@@ -105,38 +118,60 @@ QueryResults SQLiteConnection::query(
         const QString & SQL,
         bool storeResult)
 {
-    meowLogCC(Log::Category::SQL, this) << SQL;
+    threads::MutexLocker locker(mutex()); // protects _handle
 
-    // Some DBs like SQLite can't execute multiple sentences at once
-    QStringList SQLs = SQL.split(";", QString::SkipEmptyParts);
+    meowLogCC(Log::Category::SQL, this) << SQL;
 
     QueryResults results;
 
-    QElapsedTimer elapsedTimer;
+    // statements are parsed one by one with sqlite3_prepare_v3(),
+    // its tail points to the next one
+    const QByteArray nativeSQL = SQL.toUtf8();
+    const char * tail = nativeSQL.constData();
+    const char * end = tail + nativeSQL.size();
 
-    for (const QString & SQL : SQLs) {
+    QElapsedTimer elapsedTimer;
 
-        QSqlQuery * query = new QSqlQuery(_handle);
+    while (tail < end) {
 
         elapsedTimer.start();
 
-        if (query->exec(SQL) == false) {
-            QString error = query->lastError().text();
+        sqlite3_stmt * statement = nullptr;
+        int prepareResult = sqlite3_prepare_v3(
+                    _handle, tail, static_cast<int>(end - tail),
+                    0, &statement, &tail);
+
+        if (prepareResult != SQLITE_OK) {
+            QString error = getLastError();
             meowLogCC(Log::Category::Error, this) << "Query failed: " << error;
-            delete query;
             throw db::Exception(error);
         }
 
+        if (statement == nullptr) { // comment or whitespace
+            continue;
+        }
+
+        int totalChangesBefore = sqlite3_total_changes(_handle);
+
+        auto queryResult = std::make_shared<SQLiteQueryResult>(this);
+        try {
+            queryResult->init(statement, sqlite3_step(statement));
+        } catch (db::Exception & exc) {
+            sqlite3_finalize(statement);
+            meowLogCC(Log::Category::Error, this) << "Query failed: "
+                                                  << exc.message();
+            throw;
+        }
+        sqlite3_finalize(statement);
+
         results.incExecDuration(
                 std::chrono::milliseconds(elapsedTimer.elapsed()));
 
-        auto queryResult = std::make_shared<QtSQLQueryResult>(this);
-        queryResult->init(query, &_handle);
-
-        results.incRowsAffected(query->numRowsAffected());
+        results.incRowsAffected(static_cast<db::ulonglong>(
+                sqlite3_total_changes(_handle) - totalChangesBefore));
         results.incRowsFound(queryResult->recordCount());
 
-        if (storeResult && queryResult->recordCount() > 0) {
+        if (storeResult && queryResult->columnCount() > 0) {
             results << queryResult;
         }
     }
@@ -147,6 +182,162 @@ QueryResults SQLiteConnection::query(
     return results;
 }
 
+QueryResults SQLiteConnection::queryStreamed(const QString & SQL)
+{
+    const QByteArray nativeSQL = SQL.toUtf8();
+
+    sqlite3_stmt * statement = prepareOnReadHandle(nativeSQL);
+    threads::Mutex * handleMutex = &_readMutex;
+
+    if (statement == nullptr) {
+
+        threads::MutexLocker locker(mutex()); // protects _handle
+
+        const char * tail = nullptr;
+        int prepareResult = sqlite3_prepare_v3(
+                    _handle, nativeSQL.constData(), nativeSQL.size(),
+                    0, &statement, &tail);
+
+        bool isSingle = (prepareResult == SQLITE_OK && statement != nullptr
+                && QByteArray(tail).trimmed().isEmpty());
+        if (!isSingle) {
+            sqlite3_finalize(statement);
+            return query(SQL, true); // buffered, errors are thrown there
+        }
+
+        handleMutex = mutex();
+    }
+
+    meowLogCC(Log::Category::SQL, this) << SQL;
+
+    threads::MutexLocker locker(handleMutex);
+
+    QueryResults results;
+
+    QElapsedTimer elapsedTimer;
+    elapsedTimer.start();
+
+    // rows are computed on SQLiteStreamedQueryResult::fetchMore()
+    int stepResult = sqlite3_step(statement);
+
+    results.incExecDuration(
+            std::chrono::milliseconds(elapsedTimer.elapsed()));
+
+    if (stepResult != SQLITE_ROW && stepResult != SQLITE_DONE) {
+        QString error = QString::fromUtf8(
+                    sqlite3_errmsg(sqlite3_db_handle(statement)));
+        sqlite3_finalize(statement);
+        meowLogCC(Log::Category::Error, this) << "Query failed: " << error;
+        throw db::Exception(error);
+    }
+
+    if (sqlite3_column_count(statement) == 0) { // not a SELECT
+        results.incRowsAffected(static_cast<db::ulonglong>(
+                sqlite3_changes(sqlite3_db_handle(statement))));
+        sqlite3_finalize(statement);
+        return results;
+    }
+
+    // result keeps handle locked until all rows are fetched
+    auto result = std::make_shared<SQLiteStreamedQueryResult>(this);
+    result->init(statement, stepResult, handleMutex);
+    results << result;
+
+    return results;
+}
+
+sqlite3_stmt * SQLiteConnection::prepareOnReadHandle(
+        const QByteArray & nativeSQL)
+{
+    threads::MutexLocker locker(&_readMutex); // protects _readHandle
+
+    if (_readHandle == nullptr) {
+        return nullptr;
+    }
+
+    // reader doesn't see uncommitted changes of main handle
+    if (sqlite3_get_autocommit(_handle) == 0) {
+        return nullptr;
+    }
+
+    QByteArray firstWord = nativeSQL.trimmed().left(6).toUpper();
+    if (!firstWord.startsWith("SELECT") && !firstWord.startsWith("WITH")) {
+        return nullptr; // BEGIN or PRAGMA are "readonly" too
+    }
+
+    sqlite3_stmt * statement = nullptr;
+    const char * tail = nullptr;
+    int prepareResult = sqlite3_prepare_v3(
+                _readHandle, nativeSQL.constData(), nativeSQL.size(),
+                0, &statement, &tail);
+
+    // e.g. temp tables of main handle are not visible here
+    if (prepareResult != SQLITE_OK || statement == nullptr
+            || !sqlite3_stmt_readonly(statement)
+            || !QByteArray(tail).trimmed().isEmpty()) {
+        sqlite3_finalize(statement);
+        return nullptr;
+    }
+
+    return statement;
+}
+
+sqlite3 * SQLiteConnection::openHandle(int flags)
+{
+    QByteArray fileName = connectionParams()->fileName().toUtf8();
+
+    sqlite3 * handle = nullptr;
+
+    // handles are shared with db thread, so serialized mode
+    int openResult = sqlite3_open_v2(fileName.constData(), &handle,
+                                     flags | SQLITE_OPEN_FULLMUTEX,
+                                     nullptr);
+
+    if (openResult != SQLITE_OK) {
+        QString error = handle
+                ? QString::fromUtf8(sqlite3_errmsg(handle))
+                : QString::fromUtf8(sqlite3_errstr(openResult));
+        sqlite3_close_v2(handle);
+        meowLogCC(Log::Category::Error, this) << "Connect failed: " << error;
+        throw db::Exception(error);
+    }
+
+    sqlite3_busy_timeout(handle, FILE_DB_BUSY_TIMEOUT);
+
+    return handle;
+}
+
+void SQLiteConnection::openReadHandle()
+{
+    sqlite3 * readHandle = openHandle(SQLITE_OPEN_READONLY);
+
+    threads::MutexLocker locker(&_readMutex);
+    _readHandle = readHandle;
+}
+
+void SQLiteConnection::closeHandles()
+{
+    clearPreparedStatements(); // finalized before close
+
+    {
+        threads::MutexLocker locker(&_readMutex);
+        sqlite3_close_v2(_readHandle);
+        _readHandle = nullptr;
+    }
+
+    threads::MutexLocker locker(mutex());
+    sqlite3_close_v2(_handle); // closes once unfinalized statements are done
+    _handle = nullptr;
+}
+
+bool SQLiteConnection::isFileDatabase() const
+{
+    const QString & fileName = connectionParams()->fileName();
+    return !fileName.isEmpty()
+            && fileName != QLatin1String(":memory:")
+            && !fileName.contains(QLatin1String("mode=memory"));
+}
+
 QString SQLiteConnection::escapeString(const QString & str,
                              bool processJokerChars,
                              bool doQuote) const
@@ -388,7 +579,7 @@ ConnectionDataTypes * SQLiteConnection::createConnectionDataTypes()
 
 ConnectionFeatures * SQLiteConnection::createFeatures()
 {
-    return new QtSQLiteConnectionFeatures(this);
+    return new SQLiteConnectionFeatures(this);
 }
 
 ITableStructureParser * SQLiteConnection::createTableStructureParser()
@@ -396,5 +587,41 @@ ITableStructureParser * SQLiteConnection::createTableStructureParser()
     return new SQLiteTableStructureParser(this);
 }
 
+PreparedStatementPtr SQLiteConnection::prepare(const QString & SQL)
+{
+    threads::MutexLocker locker(mutex()); // protects _handle
+
+    meowLogDebugC(this) << "Prepare: " << SQL;
+
+    QByteArray nativeSQL = SQL.toUtf8();
+
+    sqlite3_stmt * stmt = nullptr;
+
+    // persistent: statement is cached and used many times
+    int prepareResult = sqlite3_prepare_v3(_handle,
+                                           nativeSQL.constData(),
+                                           nativeSQL.size(),
+                                           SQLITE_PREPARE_PERSISTENT,
+                                           &stmt,
+                                           nullptr);
+
+    if (prepareResult != SQLITE_OK || stmt == nullptr) {
+        QString error = getLastError();
+        sqlite3_finalize(stmt);
+        meowLogCC(Log::Category::Error, this) << "Prepare failed: " << error;
+        throw db::Exception(error);
+    }
+
+    return std::make_shared<SQLitePreparedStatement>(this, stmt, SQL);
+}
+
+std::unique_ptr<BulkLoader> SQLiteConnection::createBulkLoader(
+        const TableEntity * table,
+        const QStringList & columns)
+{
+    return std::unique_ptr<BulkLoader>(
+        new SQLiteBulkLoader(this, quotedFullName(table), columns));
+}
+
 } // namespace db
 } // namespace meow
@@ -2,7 +2,7 @@
 #define DB_QTSQL_CONNECTION_H
 
 #include "db/connection.h"
-#include <QtSql>
+#include <sqlite3.h>
 #include "db/entity/entity_filter.h"
 
 namespace meow {
@@ -32,6 +32,10 @@ public:
             const QString & SQL,
             bool storeResult = false) override;
 
+    // Single read-only statement goes to read handle when possible,
+    // so it doesn't wait for writes of main handle
+    virtual QueryResults queryStreamed(const QString & SQL) override;
+
     virtual QString escapeString(const QString & str,
                                  bool processJokerChars = false,
                                  bool doQuote = true) const override;
@@ -72,7 +76,9 @@ public:
 
     virtual int64_t connectionIdOnServer() override;
 
-    const QSqlDatabase * handle() const { return &_handle; }
+    virtual std::unique_ptr<BulkLoader> createBulkLoader(
+            const TableEntity * table,
+            const QStringList & columns) override;
 
 protected:
     virtual DataBaseEntitiesFetcher * createDbEntitiesFetcher() override;
@@ -88,10 +94,25 @@ protected:
 
     virtual ITableStructureParser * createTableStructureParser() override;
 
+    virtual PreparedStatementPtr prepare(const QString & SQL) override;
+
 private:
 
-    QSqlDatabase _handle;
+    sqlite3 * openHandle(int flags);
+    void openReadHandle();
+    void closeHandles();
+
+    // false for in-memory and temporary databases, each handle has own one
+    bool isFileDatabase() const;
+
+    // Prepared statement on read handle if statement can run there,
+    // nullptr otherwise
+    sqlite3_stmt * prepareOnReadHandle(const QByteArray & nativeSQL);
 
+    sqlite3 * _handle;
+    // WAL lets reader work while main handle writes
+    sqlite3 * _readHandle;
+    threads::Mutex _readMutex; // protects _readHandle
 };
 
 } // namespace db
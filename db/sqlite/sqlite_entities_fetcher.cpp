@@ -4,8 +4,9 @@
 #include "db/entity/table_entity.h"
 #include "db/entity/view_entity.h"
 #include "db/entity/entity_factory.h"
+#include "helpers/logger.h"
 
-// https://www.sqlite.org/cli.html
+// https://www.sqlite.org/schematab.html
 
 namespace meow {
 namespace db {
@@ -18,34 +19,46 @@ SQLiteEntitiesFetcher::SQLiteEntitiesFetcher(SQLiteConnection * connection)
 
 QList<EntityPtr> SQLiteEntitiesFetcher::run(const QString & dbName)
 {
-
-    // TODO: manually?
-    //SELECT name FROM sqlite_master
-    //WHERE type IN ('table','view') AND name NOT LIKE 'sqlite_%'
-    //ORDER BY 1
-
     Q_UNUSED(dbName);
 
     QList<EntityPtr> list;
 
-    const SQLiteConnection * conn = static_cast<SQLiteConnection *>(_connection);
+    // tables of main and temp schemas incl. internal sqlite_*, as before
+    QString SQL = "SELECT `name`, `type` FROM `sqlite_master`"
+                  " WHERE `type` IN ('table', 'view')"
+                  " UNION ALL"
+                  " SELECT `name`, `type` FROM `sqlite_temp_master`"
+                  " WHERE `type` IN ('table', 'view')";
+
+    QueryPtr queryResults;
+
+    try {
+        queryResults = _connection->getResults(SQL);
+    } catch (meow::db::Exception & ex) {
+        meowLogCC(Log::Category::Error, _connection)
+                << "Failed to fetch tables/views: " << ex.message();
+        return list;
+    }
 
-    QStringList tables = conn->handle()->tables(QSql::Tables);
+    Query * resPtr = queryResults.get();
 
-    for (const QString & tableName : tables) {
-        TableEntityPtr table = EntityFactory::createTable(tableName);
+    while (resPtr->isEof() == false) {
 
-        // TODO: table->setRowsCount
-        // TODO: table->setDataSize
+        QString name = resPtr->curRowColumn(0);
 
-        list.append(table);
-    }
+        if (resPtr->curRowColumn(1) == "view") {
+            ViewEntityPtr view = EntityFactory::createView(name);
+            list.append(view);
+        } else {
+            TableEntityPtr table = EntityFactory::createTable(name);
+
+            // TODO: table->setRowsCount
+            // TODO: table->setDataSize
 
-    QStringList views = conn->handle()->tables(QSql::Views);
+            list.append(table);
+        }
 
-    for (const QString & viewName : views) {
-        ViewEntityPtr view = EntityFactory::createView(viewName);
-        list.append(view);
+        resPtr->seekNext();
     }
 
     // TODO: triggers
@@ -0,0 +1,112 @@
+#include "sqlite_prepared_statement.h"
+#include <vector>
+#include "sqlite_connection.h"
+#include "helpers/logger.h"
+
+// https://www.sqlite.org/c3ref/stmt.html
+
+namespace meow {
+namespace db {
+
+SQLitePreparedStatement::SQLitePreparedStatement(SQLiteConnection * connection,
+                                                 sqlite3_stmt * stmt,
+                                                 const QString & SQL)
+    : PreparedStatement(SQL)
+    , _connection(connection)
+    , _stmt(stmt)
+    , _rowsAffected(0)
+    , _isSQLLogged(true)
+{
+    Q_ASSERT(_stmt != nullptr);
+}
+
+SQLitePreparedStatement::~SQLitePreparedStatement()
+{
+    threads::MutexLocker locker(_connection->mutex());
+    sqlite3_finalize(_stmt);
+}
+
+QStringList SQLitePreparedStatement::execute(const QStringList & params)
+{
+    threads::MutexLocker locker(_connection->mutex());
+
+    if (_isSQLLogged) {
+        meowLogCC(Log::Category::SQL, _connection) << SQL();
+    }
+
+    int paramCount = params.size();
+
+    if (sqlite3_bind_parameter_count(_stmt) != paramCount) {
+        throw db::Exception(
+            QString("Prepared statement expects %1 params, got %2")
+                .arg(sqlite3_bind_parameter_count(_stmt))
+                .arg(paramCount));
+    }
+
+    sqlite3_reset(_stmt);
+
+    // text values, column affinity converts them to column type
+    for (int i = 0; i < paramCount; ++i) {
+        const QString & param = params[i];
+        int bindResult = SQLITE_OK;
+        if (param.isNull()) {
+            bindResult = sqlite3_bind_null(_stmt, i + 1);
+        } else {
+            QByteArray value = param.toUtf8();
+            bindResult = sqlite3_bind_text(_stmt, i + 1,
+                                           value.constData(), value.size(),
+                                           SQLITE_TRANSIENT);
+        }
+        if (bindResult != SQLITE_OK) {
+            QString error = lastError();
+            meowLogCC(Log::Category::Error, _connection)
+                << "Statement bind failed: " << error;
+            throw db::Exception(error);
+        }
+    }
+
+    QStringList firstRow;
+
+    int stepResult = sqlite3_step(_stmt);
+
+    if (stepResult == SQLITE_ROW) { // e.g. INSERT ... RETURNING
+        int columnCount = sqlite3_column_count(_stmt);
+        firstRow.reserve(columnCount);
+        for (int c = 0; c < columnCount; ++c) {
+            if (sqlite3_column_type(_stmt, c) == SQLITE_NULL) {
+                firstRow << QString();
+            } else {
+                const char * data = reinterpret_cast<const char *>(
+                            sqlite3_column_text(_stmt, c));
+                firstRow << QString::fromUtf8(data,
+                                              sqlite3_column_bytes(_stmt, c));
+            }
+        }
+        // DML is completed by stepping till the end
+        while ((stepResult = sqlite3_step(_stmt)) == SQLITE_ROW) {}
+    }
+
+    if (stepResult != SQLITE_DONE) {
+        QString error = lastError();
+        sqlite3_reset(_stmt);
+        meowLogCC(Log::Category::Error, _connection)
+            << "Statement failed: " << error;
+        throw db::Exception(error);
+    }
+
+    // changes() keeps count of the last DML, SELECTs don't reset it
+    _rowsAffected = sqlite3_stmt_readonly(_stmt) ? 0
+        : static_cast<db::ulonglong>(sqlite3_changes(sqlite3_db_handle(_stmt)));
+
+    sqlite3_reset(_stmt); // releases locks of statement
+
+    return firstRow;
+}
+
+QString SQLitePreparedStatement::lastError() const
+{
+    return QString::fromUtf8(sqlite3_errmsg(sqlite3_db_handle(_stmt)));
+}
+
+} // namespace db
+} // namespace meow
@@ -0,0 +1,43 @@
+#ifndef DB_SQLITE_PREPARED_STATEMENT_H
+#define DB_SQLITE_PREPARED_STATEMENT_H
+
+#include <sqlite3.h>
+#include "db/prepared_statement.h"
+
+namespace meow {
+namespace db {
+
+class SQLiteConnection;
+
+// Intent: sqlite3_stmt of sqlite3_prepare_v3(), reset and rebound for
+// every execution
+class SQLitePreparedStatement : public PreparedStatement
+{
+public:
+    SQLitePreparedStatement(SQLiteConnection * connection,
+                            sqlite3_stmt * stmt,
+                            const QString & SQL);
+    virtual ~SQLitePreparedStatement() override;
+
+    virtual QStringList execute(const QStringList & params) override;
+
+    virtual db::ulonglong rowsAffected() const override {
+        return _rowsAffected;
+    }
+
+    // e.g. off for rows of bulk load
+    void setSQLLogged(bool logged) { _isSQLLogged = logged; }
+
+private:
+    QString lastError() const;
+
+    SQLiteConnection * _connection;
+    sqlite3_stmt * _stmt;
+    db::ulonglong _rowsAffected;
+    bool _isSQLLogged;
+};
+
+} // namespace db
+} // namespace meow
+
+#endif // DB_SQLITE_PREPARED_STATEMENT_H
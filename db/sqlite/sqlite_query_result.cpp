@@ -0,0 +1,142 @@
+#include "sqlite_query_result.h"
+#include "sqlite_connection.h"
+#include "db/data_type/sqlite_connection_datatypes.h"
+#include "db/exception.h"
+
+// https://www.sqlite.org/c3ref/column_blob.html
+
+namespace meow {
+namespace db {
+
+SQLiteQueryResult::SQLiteQueryResult(SQLiteConnection * connection)
+    : NativeQueryResult(connection)
+    , _columnsParsed(false)
+{
+
+}
+
+void SQLiteQueryResult::init(sqlite3_stmt * statement, int stepResult)
+{
+    Q_ASSERT(statement != nullptr);
+
+    clearColumnData();
+
+    addColumnData(statement, stepResult == SQLITE_ROW);
+
+    _storage.setColumnCount(columnCount());
+
+    ColumnarResultStorage::Batch batch(columnCount());
+
+    int result = stepResult;
+    while (result == SQLITE_ROW) {
+        appendCurrentRowTo(batch, statement);
+        result = sqlite3_step(statement);
+    }
+
+    if (result != SQLITE_DONE) {
+        throw db::Exception(lastError(statement));
+    }
+
+    _storage.addBatch(std::move(batch));
+
+    _recordCount = nativeRowsCount();
+
+    if (isEditing()) {
+        prepareResultForEditing(this);
+    }
+
+    seekFirst();
+}
+
+void SQLiteQueryResult::clearColumnData()
+{
+    _columns.clear();
+    _columnIndexes.clear();
+    _columnsParsed = false;
+}
+
+void SQLiteQueryResult::addColumnData(sqlite3_stmt * statement, bool hasRow)
+{
+    if (_columnsParsed) return;
+
+    auto types = static_cast<SQLiteConnectionDataTypes *>(
+                connection()->dataTypes());
+
+    int numFields = sqlite3_column_count(statement);
+
+    _columns.resize(static_cast<std::size_t>(numFields));
+
+    for (int i = 0; i < numFields; ++i) {
+        QueryColumn & column = _columns[static_cast<std::size_t>(i)];
+        QString fieldName = QString::fromUtf8(sqlite3_column_name(statement, i));
+        column.name = fieldName;  // TODO: origin name needs COLUMN_METADATA
+        column.orgName = fieldName;
+        _columnIndexes.insert(fieldName, static_cast<std::size_t>(i));
+
+        const char * declaredType = sqlite3_column_decltype(statement, i);
+        if (declaredType != nullptr) { // table column
+            column.dataType = types->dataTypeByName(
+                        QString::fromUtf8(declaredType));
+        } else if (hasRow) { // expression
+            column.dataType = types->dataTypeFromNative(
+                        sqlite3_column_type(statement, i));
+        } else {
+            column.dataType = types->defaultType();
+        }
+    }
+
+    _columnsParsed = true;
+}
+
+void SQLiteQueryResult::appendCurrentRowTo(
+        ColumnarResultStorage::Batch & batch,
+        sqlite3_stmt * statement) const
+{
+    int numCols = static_cast<int>(columnCount());
+
+    for (int col = 0; col < numCols; ++col) {
+
+        std::size_t index = static_cast<std::size_t>(col);
+
+        // values keep their storage class, not the declared type
+        switch (sqlite3_column_type(statement, col)) {
+
+        case SQLITE_NULL:
+            batch.appendNull(index);
+            break;
+
+        case SQLITE_INTEGER:
+            batch.appendInteger(index, sqlite3_column_int64(statement, col));
+            break;
+
+        case SQLITE_FLOAT:
+            batch.appendFloat(index, sqlite3_column_double(statement, col));
+            break;
+
+        case SQLITE_BLOB: {
+            const char * data = static_cast<const char *>(
+                        sqlite3_column_blob(statement, col));
+            batch.appendLatin1(index, data,
+                               sqlite3_column_bytes(statement, col));
+            break;
+        }
+
+        default: { // text
+            const char * data = reinterpret_cast<const char *>(
+                        sqlite3_column_text(statement, col));
+            batch.appendUtf8(index, data,
+                             sqlite3_column_bytes(statement, col));
+            break;
+        }
+
+        }
+    }
+}
+
+QString SQLiteQueryResult::lastError(sqlite3_stmt * statement)
+{
+    return QString::fromUtf8(sqlite3_errmsg(sqlite3_db_handle(statement)));
+}
+
+} // namespace db
+} // namespace meow
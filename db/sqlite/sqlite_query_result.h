@@ -0,0 +1,44 @@
+#ifndef DB_SQLITE_QUERY_RESULT_H
+#define DB_SQLITE_QUERY_RESULT_H
+
+#include <sqlite3.h>
+#include "db/native_query_result.h"
+#include "db/common.h"
+
+namespace meow {
+namespace db {
+
+class SQLiteConnection;
+
+// Steps prepared statement till the end and decodes its rows into storage,
+// statement is owned by caller
+class SQLiteQueryResult : public NativeQueryResult
+{
+public:
+    explicit SQLiteQueryResult(SQLiteConnection * connection);
+
+    // stepResult is result of the first sqlite3_step() of statement
+    void init(sqlite3_stmt * statement, int stepResult);
+
+    virtual db::ulonglong nativeRowsCount() const override {
+        return _storage.rowCount();
+    }
+
+protected:
+
+    void clearColumnData();
+    // types of expressions are taken from values of current row if any
+    void addColumnData(sqlite3_stmt * statement, bool hasRow);
+    void appendCurrentRowTo(ColumnarResultStorage::Batch & batch,
+                            sqlite3_stmt * statement) const;
+
+    static QString lastError(sqlite3_stmt * statement);
+
+private:
+    bool _columnsParsed;
+};
+
+} // namespace db
+} // namespace meow
+
+#endif // DB_SQLITE_QUERY_RESULT_H
@@ -0,0 +1,181 @@
+#include "sqlite_streamed_query_result.h"
+#include "sqlite_connection.h"
+#include "db/exception.h"
+#include "helpers/logger.h"
+
+namespace meow {
+namespace db {
+
+SQLiteStreamedQueryResult::SQLiteStreamedQueryResult(
+        SQLiteConnection * connection)
+    : SQLiteQueryResult(connection)
+    , _sqliteConnection(connection)
+    , _statement(nullptr)
+    , _handleMutex(nullptr)
+    , _hasPendingRow(false)
+    , _maxBufferSize(DATA_STREAM_MAX_BUFFER_SIZE)
+    , _isFetching(false)
+    , _abortRequested(false)
+    , _isFetchLimited(false)
+{
+
+}
+
+SQLiteStreamedQueryResult::~SQLiteStreamedQueryResult()
+{
+    finishFetching();
+}
+
+void SQLiteStreamedQueryResult::init(sqlite3_stmt * statement,
+                                     int stepResult,
+                                     threads::Mutex * handleMutex)
+{
+    Q_ASSERT(statement != nullptr && handleMutex != nullptr);
+
+    // no other queries are possible until statement is reset
+    handleMutex->lock();
+    _handleMutex = handleMutex;
+    _statement = statement;
+    _isFetching = true;
+
+    _hasPendingRow = (stepResult == SQLITE_ROW);
+
+    clearColumnData();
+    addColumnData(statement, _hasPendingRow);
+    _storage.setColumnCount(columnCount());
+
+    _recordCount = 0;
+
+    seekFirst();
+}
+
+QString SQLiteStreamedQueryResult::curRowColumn(std::size_t index,
+                                                bool ignoreErrors)
+{
+    QMutexLocker locker(&_rowsMutex);
+    return SQLiteQueryResult::curRowColumn(index, ignoreErrors);
+}
+
+bool SQLiteStreamedQueryResult::isNull(std::size_t index)
+{
+    QMutexLocker locker(&_rowsMutex);
+    return SQLiteQueryResult::isNull(index);
+}
+
+bool SQLiteStreamedQueryResult::curRowInteger(std::size_t index,
+                                              qint64 * value)
+{
+    QMutexLocker locker(&_rowsMutex);
+    return SQLiteQueryResult::curRowInteger(index, value);
+}
+
+bool SQLiteStreamedQueryResult::curRowFloat(std::size_t index, double * value)
+{
+    QMutexLocker locker(&_rowsMutex);
+    return SQLiteQueryResult::curRowFloat(index, value);
+}
+
+db::ulonglong SQLiteStreamedQueryResult::fetchMore(db::ulonglong maxRows)
+{
+    if (!_isFetching) {
+        return 0;
+    }
+
+    ColumnarResultStorage::Batch batch(columnCount());
+
+    std::size_t bufferSize = 0;
+    {
+        QMutexLocker locker(&_rowsMutex);
+        bufferSize = _storage.dataSize();
+    }
+
+    bool finished = false;
+    QString error;
+
+    while (batch.rowCount() < maxRows) {
+
+        if (_abortRequested) {
+            finished = true;
+            break;
+        }
+
+        int stepResult = SQLITE_ROW;
+        if (_hasPendingRow) {
+            _hasPendingRow = false;
+        } else {
+            stepResult = sqlite3_step(_statement);
+        }
+
+        if (stepResult == SQLITE_DONE) {
+            finished = true;
+            break;
+        } else if (stepResult != SQLITE_ROW) {
+            error = lastError(_statement);
+            finished = true;
+            break;
+        }
+
+        appendCurrentRowTo(batch, _statement);
+
+        if (bufferSize + batch.dataSize() >= _maxBufferSize) {
+            _isFetchLimited = true;
+            finished = true;
+            break;
+        }
+    }
+
+    std::size_t fetchedCount = batch.rowCount();
+
+    if (fetchedCount > 0) {
+        QMutexLocker locker(&_rowsMutex);
+        _storage.addBatch(std::move(batch));
+        _recordCount += fetchedCount;
+    }
+
+    if (finished) {
+        if (_isFetchLimited) {
+            meowLogCC(Log::Category::Info, _sqliteConnection)
+                << "Result buffer limit is reached, rows fetched: "
+                << recordCount();
+        }
+        finishFetching();
+        if (!error.isEmpty()) {
+            meowLogCC(Log::Category::Error, _sqliteConnection)
+                << "Query (fetch) failed: " << error;
+            throw db::Exception(error);
+        }
+    }
+
+    return fetchedCount;
+}
+
+void SQLiteStreamedQueryResult::clearFetchedRows()
+{
+    QMutexLocker locker(&_rowsMutex);
+    SQLiteQueryResult::clearFetchedRows();
+}
+
+void SQLiteStreamedQueryResult::finishFetching()
+{
+    if (!_isFetching) {
+        return;
+    }
+
+    sqlite3_finalize(_statement); // unread rows are just not computed
+    _statement = nullptr;
+
+    _isFetching = false;
+    _handleMutex->unlock();
+}
+
+void SQLiteStreamedQueryResult::prepareResultForEditing(
+        NativeQueryResult * result)
+{
+    Q_ASSERT(!_isFetching);
+
+    QMutexLocker locker(&_rowsMutex);
+    SQLiteQueryResult::prepareResultForEditing(result);
+}
+
+} // namespace db
+} // namespace meow
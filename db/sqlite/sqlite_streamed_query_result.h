@@ -0,0 +1,69 @@
+#ifndef DB_SQLITE_STREAMED_QUERY_RESULT_H
+#define DB_SQLITE_STREAMED_QUERY_RESULT_H
+
+#include <atomic>
+#include <QMutex>
+#include "sqlite_query_result.h"
+#include "threads/mutex.h"
+
+namespace meow {
+namespace db {
+
+// Intent: owns prepared statement and steps it on fetchMore(), decoding
+// rows into storage batch by batch. Handle of statement stays locked until
+// all rows are fetched, fetching is aborted or buffer size limit is reached.
+class SQLiteStreamedQueryResult : public SQLiteQueryResult
+{
+public:
+    explicit SQLiteStreamedQueryResult(SQLiteConnection * connection);
+
+    virtual ~SQLiteStreamedQueryResult() override;
+
+    // stepResult is SQLITE_ROW or SQLITE_DONE of the first sqlite3_step(),
+    // handleMutex protects handle of statement
+    void init(sqlite3_stmt * statement,
+              int stepResult,
+              threads::Mutex * handleMutex);
+
+    virtual db::ulonglong nativeRowsCount() const override {
+        return _recordCount;
+    }
+
+    virtual QString curRowColumn(std::size_t index,
+                                 bool ignoreErrors = false) override;
+
+    virtual bool isNull(std::size_t index) override;
+
+    virtual bool curRowInteger(std::size_t index, qint64 * value) override;
+    virtual bool curRowFloat(std::size_t index, double * value) override;
+
+    virtual bool isFetching() const override { return _isFetching; }
+    virtual db::ulonglong fetchMore(db::ulonglong maxRows) override;
+    virtual void abortFetching() override { _abortRequested = true; }
+    virtual bool isFetchLimited() const override { return _isFetchLimited; }
+    virtual void clearFetchedRows() override;
+
+    void setMaxBufferSize(db::ulonglong size) { _maxBufferSize = size; }
+
+protected:
+    virtual void prepareResultForEditing(NativeQueryResult * result) override;
+
+private:
+
+    void finishFetching();
+
+    SQLiteConnection * _sqliteConnection;
+    sqlite3_stmt * _statement;
+    threads::Mutex * _handleMutex;
+    bool _hasPendingRow; // stepped, but not decoded yet
+    mutable QMutex _rowsMutex; // rows are appended and read in diff threads
+    db::ulonglong _maxBufferSize;
+    std::atomic<bool> _isFetching;
+    std::atomic<bool> _abortRequested;
+    std::atomic<bool> _isFetchLimited;
+};
+
+} // namespace db
+} // namespace meow
+
+#endif // DB_SQLITE_STREAMED_QUERY_RESULT_H
@@ -0,0 +1,15 @@
+#include "table_structures_fetcher.h"
+
+namespace meow {
+namespace db {
+
+TableStructuresFetcher::TableStructuresFetcher(Connection * connection)
+    :_connection(connection)
+{
+
+}
+
+TableStructuresFetcher::~TableStructuresFetcher() {}
+
+} // namespace db
+} // namespace meow
@@ -0,0 +1,30 @@
+#ifndef DB_TABLE_STRUCTURES_FETCHER_H
+#define DB_TABLE_STRUCTURES_FETCHER_H
+
+#include <QList>
+#include <QString>
+
+namespace meow {
+namespace db {
+
+class Connection;
+class TableEntity;
+
+// Intent: builds structures of many tables of database at once from a few
+// catalog queries, instead of fetching and parsing create code per table
+class TableStructuresFetcher
+{
+public:
+    explicit TableStructuresFetcher(Connection * connection);
+    virtual ~TableStructuresFetcher();
+    // Replaces structures of tables of dbName, throws on query error
+    virtual void run(const QString & dbName,
+                     const QList<TableEntity *> & tables) = 0;
+protected:
+    Connection * _connection;
+};
+
+} // namespace db
+} // namespace meow
+
+#endif // DB_TABLE_STRUCTURES_FETCHER_H
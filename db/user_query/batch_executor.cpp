@@ -1,5 +1,7 @@
 #include "batch_executor.h"
+#include <QRegularExpression>
 #include "db/query.h"
+#include "sentence_splitter.h"
 #include "helpers/logger.h"
 
 namespace meow {
@@ -12,96 +14,386 @@ BatchExecutor::BatchExecutor()
     , _queryTotalCount(0)
     , _queryFailedCount(0)
     , _isAborted(false)
+    , _nextParallelIndex(0)
+    , _parallelReportedCount(0)
+    , _parallelWorkersRunning(0)
+    , _parallelStarted(false)
+    , _parallelStopped(false)
+    , _isParallelReporting(false)
 {
 
 }
 
 bool BatchExecutor::run(Connection * connection, const QStringList & queries)
 {
-    {
-        QMutexLocker locker(&_mutex);
-        _results.clear();
-        _error = db::Exception();
-        _failed = false;
-        _isAborted = false;
+    reset(queries.size());
+    _isScript = false;
 
-        _currentQueryIndex = 0;
-        _queryTotalCount = queries.size();
-        _queryFailedCount = 0;
-        _querySuccessCount = 0;
+    if (!_parallelConnections.isEmpty()) {
+        // workers are waiting, so go parallel even if there is nothing to
+        // share: they just find no queries left
+        runParallel(connection, queries);
+        return !_failed;
     }
 
+    for (int i = 0; i < queries.size(); ++i) {
+        {
+            QMutexLocker locker(&_mutex);
+            _currentQueryIndex = i;
+        }
+        if (!runQuery(connection, queries[i])) {
+            break;
+        }
+    }
+
+    return !_failed;
+}
+
+bool BatchExecutor::runScript(Connection * connection,
+                              SentenceSplitter * splitter)
+{
+    reset(0);
+    _isScript = true; // may be a dump of thousands of INSERTs
+
+    SentenceRef sentence;
+    for (int i = 0; splitter->next(&sentence); ++i) {
+        {
+            // total is known only when the whole script is split
+            QMutexLocker locker(&_mutex);
+            _currentQueryIndex = i;
+            _queryTotalCount = i + 1;
+        }
+        if (!runQuery(connection, sentence.text.toString())) {
+            break;
+        }
+    }
+
+    return !_failed;
+}
+
+void BatchExecutor::reset(int queryTotalCount)
+{
+    QMutexLocker locker(&_mutex);
+    _results.clear();
+    _droppedTotals = QueryTotals();
+    _error = db::Exception();
+    _failed = false;
+    _isAborted = false;
+
+    _currentQueryIndex = 0;
+    _queryTotalCount = queryTotalCount;
+    _queryFailedCount = 0;
+    _querySuccessCount = 0;
+}
+
+bool BatchExecutor::runQuery(Connection * connection, const QString & SQL)
+{
     bool doBreak = false;
+    int queryIndex = _currentQueryIndex;
 
-    for (const QString & SQL : queries) {
+    db::QueryPtr query = connection->createQuery();
+    query->setSQL(SQL);
+    query->setStreamed(_streamResults && isStreamable(SQL));
+
+    {
+        QMutexLocker locker(&_mutex);
+        _results.insert(queryIndex, query);
+    }
 
-        db::QueryPtr query = connection->createQuery();
-        query->setSQL(SQL);
+    emit beforeQueryExecution(_currentQueryIndex, _queryTotalCount);
 
+    try {
+        query->execute();
+        if (query->isFetching()) {
+            // first portion is shown while the rest is being received
+            query->fetchMore(DATA_ROWS_PER_STEP);
+        }
         {
+            // no inc if above raises
             QMutexLocker locker(&_mutex);
-            _results.push_back(query);
+            ++_querySuccessCount;
         }
+    } catch(meow::db::Exception & ex) {
+        {
+            QMutexLocker locker(&_mutex);
+            ++_queryFailedCount;
+        }
+        doBreak = onQueryError(ex);
+    }
 
-        emit beforeQueryExecution(_currentQueryIndex, _queryTotalCount);
+    emit afterQueryExecution(_currentQueryIndex, _queryTotalCount);
 
+    if (query->isFetching()) {
         try {
-            query->execute();
-            {
-                // no inc if above raises
-                QMutexLocker locker(&_mutex);
-                ++_querySuccessCount;
-            }
+            fetchRestRows(query);
         } catch(meow::db::Exception & ex) {
             {
                 QMutexLocker locker(&_mutex);
+                --_querySuccessCount;
                 ++_queryFailedCount;
             }
-            if (_stopOnError || (_currentQueryIndex == _queryTotalCount - 1)) {
-                // TODO: not sure we should have || cond above
-                {
-                    QMutexLocker locker(&_mutex);
-                    _failed = true;
-                    _error = ex;
-                }
-                doBreak = true;
+            doBreak = onQueryError(ex);
+        }
+    }
+
+    if (_isScript && !query->hasResult()) {
+        // nothing to show, don't keep it till the end of script
+        QMutexLocker locker(&_mutex);
+        _droppedTotals.rowsFound += query->rowsFound();
+        _droppedTotals.rowsAffected += query->rowsAffected();
+        _droppedTotals.warningsCount += query->warningsCount();
+        _droppedTotals.execDuration += query->execDuration();
+        _droppedTotals.networkDuration += query->networkDuration();
+        _results.remove(queryIndex);
+    }
+
+    if (_isAborted) {
+        doBreak = true;
+    }
+
+    return !doBreak;
+}
+
+void BatchExecutor::abort()
+{
+    _isAborted = true;
+    QMutexLocker locker(&_parallelMutex);
+    _parallelStateChanged.wakeAll(); // workers waiting for run()
+}
+
+bool BatchExecutor::canRunInParallel(const QStringList & queries)
+{
+    for (const QString & SQL : queries) {
+        if (!isReadOnly(SQL)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool BatchExecutor::isReadOnly(const QString & SQL)
+{
+    static const QRegularExpression readOnlyStart(
+        "^\\s*(SELECT|SHOW|DESC|DESCRIBE|EXPLAIN)\\b",
+        QRegularExpression::CaseInsensitiveOption);
+
+    // writes, locks and anything depending on session state
+    static const QRegularExpression sessionDependent(
+        "\\bINTO\\b|\\bFOR\\s+(UPDATE|SHARE)\\b|\\bLOCK\\s+IN\\b|@"
+        "|\\b(GET_LOCK|RELEASE_LOCK|LAST_INSERT_ID|FOUND_ROWS|ROW_COUNT)\\b",
+        QRegularExpression::CaseInsensitiveOption);
+
+    return readOnlyStart.match(SQL).hasMatch()
+            && !sessionDependent.match(SQL).hasMatch();
+}
+
+bool BatchExecutor::changesSessionState(const QString & SQL)
+{
+    // at start of any statement of script
+    static const QRegularExpression sessionStatement(
+        "(^|;)\\s*(SET|USE|BEGIN|START\\s+TRANSACTION|SAVEPOINT|PREPARE"
+        "|LOCK\\s+TABLES?|CREATE\\s+((GLOBAL|LOCAL)\\s+)?TEMP(ORARY)?)\\b"
+        "|\\bINTO\\s+@",
+        QRegularExpression::CaseInsensitiveOption
+        | QRegularExpression::MultilineOption);
+
+    return sessionStatement.match(SQL).hasMatch();
+}
+
+bool BatchExecutor::changesSchema(const QString & SQL)
+{
+    static const QRegularExpression ddlStatement(
+        "(^|;)\\s*(CREATE|ALTER|DROP|RENAME)\\b",
+        QRegularExpression::CaseInsensitiveOption
+        | QRegularExpression::MultilineOption);
+
+    return ddlStatement.match(SQL).hasMatch();
+}
+
+void BatchExecutor::runParallel(Connection * connection,
+                                const QStringList & queries)
+{
+    {
+        QMutexLocker locker(&_parallelMutex);
+        _parallelSQL = queries;
+        _parallelQueries.assign(static_cast<std::size_t>(queries.size()),
+                                ParallelQuery());
+        _nextParallelIndex = 0;
+        _parallelReportedCount = 0;
+        _parallelStopped = false;
+        _isParallelReporting = false;
+        _parallelStarted = true;
+        _parallelStateChanged.wakeAll();
+    }
+
+    // current thread is a worker too
+    runParallelQueries(connection);
+
+    QMutexLocker locker(&_parallelMutex);
+    while (_parallelWorkersRunning > 0) {
+        _parallelStateChanged.wait(&_parallelMutex);
+    }
+    _parallelQueries.clear(); // reported ones are kept in results
+}
+
+void BatchExecutor::runParallelWorker(Connection * connection)
+{
+    {
+        // queries are shared once run() starts in its thread
+        QMutexLocker locker(&_parallelMutex);
+        while (!_parallelStarted && !_isAborted) {
+            _parallelStateChanged.wait(&_parallelMutex);
+        }
+        if (!_parallelStarted) {
+            return;
+        }
+    }
+
+    runParallelQueries(connection);
+}
+
+void BatchExecutor::finishParallelWorker()
+{
+    QMutexLocker locker(&_parallelMutex);
+    --_parallelWorkersRunning;
+    _parallelStateChanged.wakeAll();
+}
+
+void BatchExecutor::runParallelQueries(Connection * connection)
+{
+    while (!_isAborted) {
+
+        int index;
+        QString SQL;
+        {
+            QMutexLocker locker(&_parallelMutex);
+            if (_parallelStopped || _nextParallelIndex >= _parallelSQL.size()) {
+                break;
             }
+            index = _nextParallelIndex++;
+            SQL = _parallelSQL[index];
         }
 
-        emit afterQueryExecution(_currentQueryIndex, _queryTotalCount);
+        ParallelQuery parallelQuery;
+        parallelQuery.query = connection->createQuery();
+        parallelQuery.query->setSQL(SQL);
 
-        if (_isAborted) {
-            doBreak = true;
+        try {
+            // buffered, rows are read by other threads
+            parallelQuery.query->execute();
+        } catch(meow::db::Exception & ex) {
+            parallelQuery.error = ex;
+            parallelQuery.isFailed = true;
         }
+        parallelQuery.isExecuted = true;
 
-        if (doBreak) break;
+        {
+            QMutexLocker locker(&_parallelMutex);
+            _parallelQueries[static_cast<std::size_t>(index)] = parallelQuery;
+        }
+
+        reportParallelQueries();
+    }
+}
+
+void BatchExecutor::reportParallelQueries()
+{
+    QMutexLocker locker(&_parallelMutex);
+
+    // one reporter at a time to keep original order, it rechecks under
+    // lock so queries stored meanwhile are reported by it
+    if (_isParallelReporting) {
+        return;
+    }
+    _isParallelReporting = true;
+
+    while (!_parallelStopped
+           && _parallelReportedCount < _parallelSQL.size()
+           && _parallelQueries[
+               static_cast<std::size_t>(_parallelReportedCount)].isExecuted) {
+
+        int index = _parallelReportedCount++;
+        ParallelQuery parallelQuery
+            = _parallelQueries[static_cast<std::size_t>(index)];
+
+        locker.unlock();
 
         {
-            QMutexLocker locker(&_mutex);
-            if (_currentQueryIndex < (_queryTotalCount - 1)) {
-                ++_currentQueryIndex;
+            QMutexLocker resultsLocker(&_mutex);
+            _currentQueryIndex = index;
+            _results.insert(index, parallelQuery.query);
+            if (parallelQuery.isFailed) {
+                ++_queryFailedCount;
+            } else {
+                ++_querySuccessCount;
             }
         }
+
+        // both signals in original order, listeners see one query at a time
+        emit beforeQueryExecution(index, _queryTotalCount);
+
+        bool doBreak = parallelQuery.isFailed
+                && onQueryError(parallelQuery.error);
+
+        emit afterQueryExecution(index, _queryTotalCount);
+
+        locker.relock();
+
+        if (doBreak) {
+            _parallelStopped = true; // later results are dropped
+        }
     }
 
-    return !_failed;
+    _isParallelReporting = false;
 }
 
-void BatchExecutor::abort()
+bool BatchExecutor::isStreamable(const QString & SQL) const
 {
-    _isAborted = true;
+    // only plain selects, e.g. CALL may return multiple results
+    QString trimmedSQL = SQL.trimmed();
+    return trimmedSQL.startsWith(QLatin1String("SELECT"), Qt::CaseInsensitive)
+        || trimmedSQL.startsWith(QLatin1String("WITH"), Qt::CaseInsensitive);
+}
+
+void BatchExecutor::fetchRestRows(const db::QueryPtr & query)
+{
+    while (query->isFetching()) {
+        if (_isAborted) {
+            query->abortFetching();
+        }
+        if (query->fetchMore(DATA_ROWS_PER_STEP * 10) > 0) {
+            emit afterRowsFetched(_currentQueryIndex);
+        }
+    }
+    if (query->isFetchLimited()) {
+        meowLogC(Log::Category::Info)
+            << QObject::tr("Only first %1 rows are shown due to memory limit")
+               .arg(query->recordCount());
+    }
+}
+
+bool BatchExecutor::onQueryError(const db::Exception & ex)
+{
+    if (_stopOnError || (_currentQueryIndex == _queryTotalCount - 1)) {
+        // TODO: not sure we should have || cond above
+        QMutexLocker locker(&_mutex);
+        _failed = true;
+        _error = ex;
+        return true;
+    }
+    return false;
 }
 
 db::QueryPtr BatchExecutor::resultAt(int queryIndex) const
 {
     QMutexLocker locker(&_mutex);
-    return _results.at(queryIndex);
+    return _results.value(queryIndex);
 }
 
 db::ulonglong BatchExecutor::rowsFound() const
 {
-    int sumRowsFound = 0;
     QMutexLocker locker(&_mutex);
+    db::ulonglong sumRowsFound = _droppedTotals.rowsFound;
     for (const db::QueryPtr & query : _results) {
         sumRowsFound += query->rowsFound();
     }
@@ -110,8 +402,8 @@ db::ulonglong BatchExecutor::rowsFound() const
 
 db::ulonglong BatchExecutor::rowsAffected() const
 {
-    int sumRowsAffected = 0;
     QMutexLocker locker(&_mutex);
+    db::ulonglong sumRowsAffected = _droppedTotals.rowsAffected;
     for (const db::QueryPtr & query : _results) {
         sumRowsAffected += query->rowsAffected();
     }
@@ -120,8 +412,8 @@ db::ulonglong BatchExecutor::rowsAffected() const
 
 db::ulonglong BatchExecutor::warningsCount() const
 {
-    int sumWarningsCount = 0;
     QMutexLocker locker(&_mutex);
+    db::ulonglong sumWarningsCount = _droppedTotals.warningsCount;
     for (const db::QueryPtr & query : _results) {
         sumWarningsCount += query->warningsCount();
     }
@@ -130,8 +422,8 @@ db::ulonglong BatchExecutor::warningsCount() const
 
 std::chrono::milliseconds BatchExecutor::execDuration() const
 {
-    std::chrono::milliseconds sumDuration = std::chrono::milliseconds(0);
     QMutexLocker locker(&_mutex);
+    std::chrono::milliseconds sumDuration = _droppedTotals.execDuration;
     for (const db::QueryPtr & query : _results) {
         sumDuration += query->execDuration();
     }
@@ -140,8 +432,8 @@ std::chrono::milliseconds BatchExecutor::execDuration() const
 
 std::chrono::milliseconds BatchExecutor::networkDuration() const
 {
-    std::chrono::milliseconds sumDuration = std::chrono::milliseconds(0);
     QMutexLocker locker(&_mutex);
+    std::chrono::milliseconds sumDuration = _droppedTotals.networkDuration;
     for (const db::QueryPtr & query : _results) {
         sumDuration += query->networkDuration();
     }
@@ -2,9 +2,12 @@
 #define DB_USER_QUERY_BATCH_EXECUTOR_H
 
 #include <atomic>
+#include <vector>
 #include <QStringList>
 #include <QList>
+#include <QMap>
 #include <QObject>
+#include <QWaitCondition>
 #include "db/connection.h"
 
 namespace meow {
@@ -12,6 +15,8 @@ namespace db {
 
 namespace user_query {
 
+class SentenceSplitter;
+
 // Thread-safe executor of queries that reports result on the go
 class BatchExecutor : public QObject
 {
@@ -19,8 +24,13 @@ class BatchExecutor : public QObject
 public:
     BatchExecutor();
     bool run(Connection * connection, const QStringList & queries);
+    // Splits script while running, the first query starts without waiting
+    // for the rest to be split; total count grows on the go. Only queries
+    // with result sets are kept, the rest are just counted
+    bool runScript(Connection * connection, SentenceSplitter * splitter);
     void abort();
 
+    // nullptr if query is not kept, see runScript()
     db::QueryPtr resultAt(int queryIndex) const;
     const db::Exception & error() const {
         QMutexLocker locker(&_mutex);
@@ -36,6 +46,29 @@ public:
     bool isStopOnError() const {
         return _stopOnError;
     }
+    // SELECTs return first rows asap and fetch the rest after
+    void setStreamResults(bool stream) {
+        _streamResults = stream;
+    }
+    // Extra connections to run read-only queries in parallel, results
+    // are reported in original order. Empty to run one by one.
+    // Each one must call runParallelWorker() in own thread.
+    void setParallelConnections(const QList<Connection *> & connections) {
+        QMutexLocker locker(&_parallelMutex);
+        _parallelConnections = connections;
+        _parallelWorkersRunning = connections.size();
+    }
+    // Takes queries of run() until none left, run() waits for all workers
+    void runParallelWorker(Connection * connection);
+    // Once per parallel connection, when its worker is done or dropped
+    void finishParallelWorker();
+    // true if queries are independent of each other and of session state
+    static bool canRunInParallel(const QStringList & queries);
+    // true if SQL (query or script) sets variables, modes, temporary
+    // tables, transactions or locks that live in connection session
+    static bool changesSessionState(const QString & SQL);
+    // true if SQL (query or script) creates, alters or drops objects
+    static bool changesSchema(const QString & SQL);
     int currentQueryIndex() const {
         QMutexLocker locker(&_mutex);
         return _currentQueryIndex;
@@ -62,9 +95,44 @@ public:
 
     Q_SIGNAL void beforeQueryExecution(int queryIndex, int totalCount);
     Q_SIGNAL void afterQueryExecution(int queryIndex, int totalCount);
+    Q_SIGNAL void afterRowsFetched(int queryIndex);
 
 private:
-    QList<db::QueryPtr> _results;
+
+    // of queries not kept in results
+    struct QueryTotals
+    {
+        db::ulonglong rowsFound = 0;
+        db::ulonglong rowsAffected = 0;
+        db::ulonglong warningsCount = 0;
+        std::chrono::milliseconds execDuration{0};
+        std::chrono::milliseconds networkDuration{0};
+    };
+
+    struct ParallelQuery
+    {
+        db::QueryPtr query;
+        db::Exception error;
+        bool isExecuted = false;
+        bool isFailed = false;
+    };
+
+    void reset(int queryTotalCount);
+    // returns false if batch should be stopped
+    bool runQuery(Connection * connection, const QString & SQL);
+
+    void runParallel(Connection * connection, const QStringList & queries);
+    void runParallelQueries(Connection * connection);
+    void reportParallelQueries();
+
+    static bool isReadOnly(const QString & SQL);
+    bool isStreamable(const QString & SQL) const;
+    void fetchRestRows(const db::QueryPtr & query);
+    bool onQueryError(const db::Exception & ex);
+
+    QMap<int, db::QueryPtr> _results; // by query index
+    QueryTotals _droppedTotals;
+    bool _isScript = false;
     db::Exception _error;
     bool _failed;
     int _currentQueryIndex;
@@ -72,8 +140,21 @@ private:
     int _queryFailedCount;
     int _querySuccessCount;
     bool _stopOnError = true;
+    bool _streamResults = false;
     std::atomic<bool> _isAborted;
 
+    QList<Connection *> _parallelConnections;
+    QStringList _parallelSQL;
+    std::vector<ParallelQuery> _parallelQueries;
+    int _nextParallelIndex;
+    int _parallelReportedCount;
+    int _parallelWorkersRunning;
+    bool _parallelStarted;
+    bool _parallelStopped;
+    bool _isParallelReporting;
+    QMutex _parallelMutex; // guards parallel state, never held in emit
+    QWaitCondition _parallelStateChanged;
+
     mutable QMutex _mutex;
 };
 
@@ -0,0 +1,331 @@
+#include "sentence_splitter.h"
+#include <algorithm>
+#include <QIODevice>
+#include <QTextCodec>
+#include "db/common.h"
+
+namespace meow {
+namespace db {
+namespace user_query {
+
+namespace {
+
+const char DELIMITER_KEYWORD[] = "DELIMITER";
+const int DELIMITER_KEYWORD_LEN = sizeof(DELIMITER_KEYWORD) - 1;
+
+// Bit per char from '"' to '`' that may start a string or a comment,
+// so plain text is skipped with one compare and shift per char
+const ushort SPECIAL_CHARS_BASE = '"';
+const quint64 SPECIAL_CHARS_MASK = (1ULL << ('"' - SPECIAL_CHARS_BASE))
+                                 | (1ULL << ('#' - SPECIAL_CHARS_BASE))
+                                 | (1ULL << ('\'' - SPECIAL_CHARS_BASE))
+                                 | (1ULL << ('-' - SPECIAL_CHARS_BASE))
+                                 | (1ULL << ('/' - SPECIAL_CHARS_BASE))
+                                 | (1ULL << ('`' - SPECIAL_CHARS_BASE));
+
+inline bool isSpecialChar(ushort c)
+{
+    unsigned offset = static_cast<unsigned>(c) - SPECIAL_CHARS_BASE;
+    return offset < 64 && ((SPECIAL_CHARS_MASK >> offset) & 1) != 0;
+}
+
+} // namespace
+
+SentenceSplitter::SentenceSplitter(const QString & SQL,
+                                   const QString & delimiter)
+    : _buffer(SQL) // shared, not copied
+    , _bufferPosition(0)
+    , _scanIndex(0)
+    , _sentenceStart(0)
+    , _isSentenceStartChecked(false)
+    , _isEnd(true)
+    , _state(State::Text)
+    , _delimiter(delimiter)
+    , _device(nullptr)
+{
+    Q_ASSERT(!_delimiter.isEmpty());
+}
+
+SentenceSplitter::SentenceSplitter(QIODevice * device,
+                                   const QString & delimiter)
+    : _bufferPosition(0)
+    , _scanIndex(0)
+    , _sentenceStart(0)
+    , _isSentenceStartChecked(false)
+    , _isEnd(false)
+    , _state(State::Text)
+    , _delimiter(delimiter)
+    , _device(device)
+    , _decoder(QTextCodec::codecForName("UTF-8")->makeDecoder())
+{
+    Q_ASSERT(!_delimiter.isEmpty());
+    Q_ASSERT(_device != nullptr);
+}
+
+SentenceSplitter::~SentenceSplitter()
+{
+
+}
+
+bool SentenceSplitter::next(SentenceRef * sentence)
+{
+    forever {
+
+        if (!_isSentenceStartChecked && !skipDelimiterCommand()) {
+            readChunk();
+            continue;
+        }
+
+        int end = 0;
+        int nextStart = 0;
+        if (!scanToSentenceEnd(&end, &nextStart)) {
+            readChunk();
+            continue;
+        }
+
+        int begin = _sentenceStart;
+        _sentenceStart = nextStart;
+        _isSentenceStartChecked = false;
+
+        setSentenceRef(begin, end, sentence);
+        if (!sentence->text.isEmpty()) {
+            return true;
+        }
+        if (_isEnd && _sentenceStart >= _buffer.size()) {
+            return false;
+        }
+    }
+}
+
+bool SentenceSplitter::scanToSentenceEnd(int * end, int * nextStart)
+{
+    const QChar * data = _buffer.constData();
+    const int len = _buffer.size();
+    const int delimLen = _delimiter.size();
+    const ushort delimFirst = _delimiter.at(0).unicode();
+
+    int i = _scanIndex;
+
+    while (i < len) {
+
+        switch (_state) {
+
+        case State::Text: {
+            while (i < len) {
+                ushort c = data[i].unicode();
+                if (c == delimFirst || isSpecialChar(c)) {
+                    break;
+                }
+                ++i;
+            }
+            if (i == len) {
+                break;
+            }
+
+            ushort c = data[i].unicode();
+
+            if (c == delimFirst) {
+                if (i + delimLen > len && !_isEnd) {
+                    _scanIndex = i;
+                    return false;
+                }
+                if (i + delimLen <= len
+                        && QStringRef(&_buffer, i, delimLen) == _delimiter) {
+                    *end = i;
+                    *nextStart = i + delimLen;
+                    _scanIndex = *nextStart;
+                    return true;
+                }
+            }
+
+            if (c == '-' || c == '/') {
+                if (i + 1 == len && !_isEnd) {
+                    _scanIndex = i;
+                    return false;
+                }
+                ushort nextChar = (i + 1 < len) ? data[i + 1].unicode() : 0;
+                if (c == '-' && nextChar == '-') {
+                    // TODO "--" requires space after?
+                    _state = State::LineComment;
+                    i += 2;
+                } else if (c == '/' && nextChar == '*') {
+                    _state = State::BigComment;
+                    i += 2;
+                } else {
+                    ++i;
+                }
+            } else if (c == '#') {
+                _state = State::LineComment;
+                ++i;
+            } else if (c == '\'' || c == '"' || c == '`') {
+                _state = State::String;
+                _encloser = data[i];
+                ++i;
+            } else {
+                ++i; // delimiter's first char only
+            }
+            break;
+        }
+
+        case State::String: {
+            const ushort encloser = _encloser.unicode();
+            while (i < len
+                   && data[i].unicode() != encloser
+                   && data[i].unicode() != '\\') {
+                ++i;
+            }
+            if (i == len) {
+                break;
+            }
+            if (data[i].unicode() == '\\') {
+                if (i + 1 == len && !_isEnd) {
+                    _scanIndex = i;
+                    return false;
+                }
+                i = std::min(i + 2, len); // skip escaped char
+            } else {
+                _state = State::Text; // '' is closed and opened again
+                ++i;
+            }
+            break;
+        }
+
+        case State::LineComment: {
+            int lineEnd = _buffer.indexOf(QChar::LineFeed, i);
+            if (lineEnd == -1) {
+                i = len;
+            } else {
+                _state = State::Text;
+                i = lineEnd + 1;
+            }
+            break;
+        }
+
+        case State::BigComment: {
+            int commentEnd = _buffer.indexOf(QLatin1String("*/"), i);
+            if (commentEnd == -1) {
+                if (!_isEnd) {
+                    _scanIndex = std::max(i, len - 1); // '*' of next chunk
+                    return false;
+                }
+                i = len;
+            } else {
+                _state = State::Text;
+                i = commentEnd + 2;
+            }
+            break;
+        }
+
+        }
+    }
+
+    _scanIndex = len;
+
+    if (!_isEnd) {
+        return false;
+    }
+
+    // rest of script is the last sentence
+    *end = len;
+    *nextStart = len;
+    return true;
+}
+
+bool SentenceSplitter::skipDelimiterCommand()
+{
+    forever {
+        const int len = _buffer.size();
+
+        int i = _sentenceStart;
+        while (i < len && _buffer.at(i).isSpace()) {
+            ++i;
+        }
+
+        int available = std::min(len - i, DELIMITER_KEYWORD_LEN + 1);
+        bool matches = true;
+        for (int k = 0; k < available && k < DELIMITER_KEYWORD_LEN; ++k) {
+            if (_buffer.at(i + k).toUpper()
+                    != QLatin1Char(DELIMITER_KEYWORD[k])) {
+                matches = false;
+                break;
+            }
+        }
+        if (matches && available > DELIMITER_KEYWORD_LEN) {
+            matches = _buffer.at(i + DELIMITER_KEYWORD_LEN).isSpace();
+        }
+
+        if (matches && available <= DELIMITER_KEYWORD_LEN && _isEnd) {
+            matches = false;
+        }
+
+        if (!matches) {
+            _isSentenceStartChecked = true;
+            return true;
+        }
+
+        if (available <= DELIMITER_KEYWORD_LEN) {
+            return false; // can't tell yet
+        }
+
+        int argsStart = i + DELIMITER_KEYWORD_LEN;
+        int lineEnd = _buffer.indexOf(QChar::LineFeed, argsStart);
+        if (lineEnd == -1) {
+            if (!_isEnd) {
+                return false;
+            }
+            lineEnd = len;
+        }
+
+        // DELIMITER $$ -- new delimiter is the first word
+        QString args = _buffer.mid(argsStart, lineEnd - argsStart).trimmed();
+        int argEnd = 0;
+        while (argEnd < args.length() && !args.at(argEnd).isSpace()) {
+            ++argEnd;
+        }
+        if (argEnd > 0) {
+            _delimiter = args.left(argEnd);
+        }
+
+        _sentenceStart = std::min(lineEnd + 1, len);
+        _scanIndex = _sentenceStart;
+        _state = State::Text;
+    }
+}
+
+void SentenceSplitter::readChunk()
+{
+    Q_ASSERT(!_isEnd);
+
+    if (_sentenceStart > 0) { // only unfinished sentence is kept
+        _buffer.remove(0, _sentenceStart);
+        _bufferPosition += _sentenceStart;
+        _scanIndex -= _sentenceStart;
+        _sentenceStart = 0;
+    }
+
+    QByteArray bytes = _device->read(SQL_SCRIPT_READ_CHUNK_SIZE);
+    if (bytes.isEmpty()) {
+        _isEnd = true;
+        return;
+    }
+
+    _buffer.append(_decoder->toUnicode(bytes));
+}
+
+void SentenceSplitter::setSentenceRef(int begin,
+                                      int end,
+                                      SentenceRef * sentence) const
+{
+    while (begin < end && _buffer.at(begin).isSpace()) {
+        ++begin;
+    }
+    while (end > begin && _buffer.at(end - 1).isSpace()) {
+        --end;
+    }
+    sentence->text = QStringRef(&_buffer, begin, end - begin);
+    sentence->position = _bufferPosition + begin;
+}
+
+} // namespace user_query
+} // namespace db
+} // namespace meow
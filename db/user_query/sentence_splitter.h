@@ -0,0 +1,83 @@
+#ifndef DB_USER_QUERY_SENTENCE_SPLITTER_H
+#define DB_USER_QUERY_SENTENCE_SPLITTER_H
+
+#include <memory>
+#include <QString>
+#include <QStringRef>
+
+class QIODevice;
+class QTextDecoder;
+
+namespace meow {
+namespace db {
+namespace user_query {
+
+// Trimmed sentence inside of splitter's text
+struct SentenceRef
+{
+    QStringRef text; // valid until next call of SentenceSplitter::next()
+    qint64 position = 0; // in whole script
+};
+
+// Intent: splits SQL script into sentences in one pass and on demand,
+// so the first sentence is available before the rest is scanned.
+// Script is either in memory (no copies) or read from device by chunks.
+// DELIMITER commands change delimiter and are not returned as sentences.
+class SentenceSplitter
+{
+public:
+    explicit SentenceSplitter(const QString & SQL,
+                              const QString & delimiter = QString(";"));
+
+    // Reads UTF-8 device by chunks, device should be open and alive
+    explicit SentenceSplitter(QIODevice * device,
+                              const QString & delimiter = QString(";"));
+
+    ~SentenceSplitter();
+
+    // Returns false when there is no more sentences
+    bool next(SentenceRef * sentence);
+
+    QString delimiter() const { return _delimiter; }
+
+private:
+
+    enum class State {
+        Text,
+        String, // 'str', "str" or `identifier`
+        LineComment, // # or --
+        BigComment // /* multi-line */ or /*! conditional comment */
+    };
+
+    // Moves scan position till the end of current sentence, returns false
+    // if more text is needed to find it
+    bool scanToSentenceEnd(int * end, int * nextStart);
+
+    // Applies DELIMITER command at sentence start if any, returns false
+    // if more text is needed to check it
+    bool skipDelimiterCommand();
+
+    // Drops already returned text and appends next chunk of device
+    void readChunk();
+
+    void setSentenceRef(int begin, int end, SentenceRef * sentence) const;
+
+    QString _buffer;
+    qint64 _bufferPosition; // of the first char in whole script
+    int _scanIndex;
+    int _sentenceStart;
+    bool _isSentenceStartChecked; // for DELIMITER
+    bool _isEnd; // all text is in buffer
+    State _state;
+    QChar _encloser;
+    QString _delimiter;
+
+    QIODevice * _device;
+    std::unique_ptr<QTextDecoder> _decoder;
+};
+
+} // namespace user_query
+} // namespace db
+} // namespace meow
+
+#endif // DB_USER_QUERY_SENTENCE_SPLITTER_H
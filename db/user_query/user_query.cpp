@@ -1,10 +1,12 @@
 #include "user_query.h"
 #include "db/connections_manager.h"
+#include "db/connection_pool.h"
 #include "db/query_data.h"
 #include "threads/db_thread.h"
 #include "threads/queries_task.h"
 #include "helpers/logger.h"
 #include "helpers/formatting.h"
+#include "app/app.h"
 #include <QUuid>
 
 namespace meow {
@@ -15,6 +17,8 @@ UserQuery::UserQuery(ConnectionsManager * connectionsManager)
     , _connectionsManager(connectionsManager)
     , _lastRunningConnection(nullptr)
     , _modifiedButNotSaved(false)
+    , _isSessionPinned(false)
+    , _isSchemaChanging(false)
     , _isRunning(false)
 {
 
@@ -35,6 +39,61 @@ void UserQuery::runInCurrentConnection(const QStringList & queries)
 
     MEOW_ASSERT_MAIN_THREAD
 
+    prepareRun();
+
+    if (user_query::BatchExecutor::changesSessionState(queries.join(';'))) {
+        _isSessionPinned = true;
+    }
+    _isSchemaChanging
+        = user_query::BatchExecutor::changesSchema(queries.join(';'));
+
+    threads::DbThread * thread = executionConnection()->thread();
+    _queriesTask = thread->createQueriesTask(queries);
+    _queriesTask->setParallelConnections(acquireParallelConnections(queries));
+
+    postQueriesTask(thread);
+}
+
+void UserQuery::runScriptInCurrentConnection(const QString & script)
+{
+    MEOW_ASSERT_MAIN_THREAD
+
+    prepareRun();
+
+    if (user_query::BatchExecutor::changesSessionState(script)) {
+        _isSessionPinned = true;
+    }
+    _isSchemaChanging = user_query::BatchExecutor::changesSchema(script);
+
+    _parallelConnections.clear(); // queries are unknown until split
+
+    threads::DbThread * thread = executionConnection()->thread();
+    _queriesTask = thread->createScriptTask(script);
+
+    postQueriesTask(thread);
+}
+
+void UserQuery::runScriptFileInCurrentConnection(const QString & filename)
+{
+    MEOW_ASSERT_MAIN_THREAD
+
+    prepareRun();
+
+    // file is read while running, dumps set session variables anyway
+    _isSessionPinned = true;
+    _isSchemaChanging = true; // dumps create tables
+
+    _parallelConnections.clear();
+
+    threads::DbThread * thread = executionConnection()->thread();
+    _queriesTask = thread->createScriptFileTask(filename);
+
+    postQueriesTask(thread);
+}
+
+void UserQuery::prepareRun()
+{
+    Connection * prevConnection = _lastRunningConnection;
     _lastRunningConnection = _connectionsManager->activeConnection();
 
     // do ping in main thread to handle possible reconnection
@@ -48,14 +107,19 @@ void UserQuery::runInCurrentConnection(const QStringList & queries)
         // TODO: process exception?
     }
 
+    acquireExecutionConnection(prevConnection == _lastRunningConnection);
+
     Q_ASSERT(isRunning() == false); // allow 1 query, block outside
 
     setIsRunning(true);
 
     _resultsData.clear();
+}
 
-    threads::DbThread * thread = _lastRunningConnection->thread();
-    _queriesTask = thread->createQueriesTask(queries);
+void UserQuery::postQueriesTask(threads::DbThread * thread)
+{
+    _queriesTask->setStreamResults(
+        meow::app()->settings()->dataFetching()->streamQueryResults());
 
     connect(_queriesTask.get(), &threads::ThreadTask::finished,
             this, &UserQuery::onQueriesFinished); // before post!
@@ -63,7 +127,17 @@ void UserQuery::runInCurrentConnection(const QStringList & queries)
     connect(_queriesTask.get(), &threads::QueriesTask::queryFinished,
             this, &UserQuery::onQueryFinished);
 
+    connect(_queriesTask.get(), &threads::QueriesTask::queryRowsFetched,
+            this, &UserQuery::onQueryRowsFetched);
+
     thread->postTask(_queriesTask);
+
+    // each parallel connection takes queries in its own thread
+    for (const ConnectionPtr & connection : _parallelConnections) {
+        connection->thread()->postTask(
+            std::make_shared<threads::ParallelQueriesTask>(
+                _queriesTask, connection.get()));
+    }
 }
 
 QString UserQuery::lastError() const
@@ -121,6 +195,10 @@ void UserQuery::onQueriesFinished()
 
     setIsRunning(false);
 
+    if (_isSchemaChanging && _lastRunningConnection) {
+        _lastRunningConnection->refreshCompletionIndex();
+    }
+
     emit queriesFinished();
 
     QStringList logStrings;
@@ -173,10 +251,11 @@ void UserQuery::onQueryFinished(int queryIndex, int totalCount)
 {
     MEOW_ASSERT_MAIN_THREAD
 
+    // not kept by script if it has no results
     db::QueryPtr query = _queriesTask->resultAt(queryIndex);
     size_t prevResultsCount = _resultsData.size();
 
-    if (query->hasResult()) {
+    if (query && query->hasResult()) {
         // some queries may return multiple results
         for (size_t i = 0; i < query->resultCount(); ++i) {
             QueryDataPtr queryData(new QueryData());
@@ -187,13 +266,29 @@ void UserQuery::onQueryFinished(int queryIndex, int totalCount)
     }
 
     emit queryFinished(queryIndex, totalCount);
-    if (query->hasResult()) {
+    if (query && query->hasResult()) {
         for (size_t i = 0; i < query->resultCount(); ++i) {
             emit newQueryDataResult(prevResultsCount + i);
         }
     }
 }
 
+void UserQuery::onQueryRowsFetched(int queryIndex)
+{
+    MEOW_ASSERT_MAIN_THREAD
+
+    db::Query * query = _queriesTask->resultAt(queryIndex).get();
+    if (!query) {
+        return;
+    }
+
+    for (const QueryDataPtr & queryData : _resultsData) {
+        if (queryData->query() == query) {
+            emit queryData->rowsFetched();
+        }
+    }
+}
+
 void UserQuery::setIsRunning(bool isRunning)
 {
     bool prev = _isRunning.exchange(isRunning);
@@ -212,11 +307,81 @@ void UserQuery::abort()
 void UserQuery::onConnectionClose(SessionEntity * session)
 {
     if (_lastRunningConnection == session->connection()) {
+        abort(); // parallel workers stop before their connections go
         _lastRunningConnection = nullptr;
+        _executionConnection.reset();
+        _parallelConnections.clear();
+        _isSessionPinned = false;
         emit executionConnectionClosed();
     }
 }
 
+void UserQuery::acquireExecutionConnection(bool sameSession)
+{
+    // main connection stays free for metadata while queries are running
+    ConnectionPool * pool = _lastRunningConnection->pool();
+
+    if (!sameSession) {
+        _isSessionPinned = false;
+    }
+    if (!sameSession || pool == nullptr) {
+        _executionConnection.reset(); // back to pool of prev session
+    }
+    if (pool == nullptr) {
+        return;
+    }
+
+    try {
+        if (_executionConnection) {
+            pool->syncSessionState(_executionConnection.get());
+        } else if (!_isSessionPinned) { // else session is in main connection
+            _executionConnection = pool->acquire(); // nullptr if pool is full
+        }
+    } catch(meow::db::Exception & ex) {
+        meowLogCC(Log::Category::Error, _lastRunningConnection)
+            << "Pooled connection failed: " << ex.message();
+        _executionConnection.reset(); // use main connection
+    }
+}
+
+QList<Connection *> UserQuery::acquireParallelConnections(
+        const QStringList & queries)
+{
+    _parallelConnections.clear(); // prev results are cleared too
+
+    QList<Connection *> connections;
+
+    auto dataFetching = meow::app()->settings()->dataFetching();
+    if (!dataFetching->runReadOnlyQueriesInParallel()
+            || _isSessionPinned // other connections don't see its state
+            || queries.size() < 2
+            || !_lastRunningConnection->features()->supportsMultithreading()
+            || !user_query::BatchExecutor::canRunInParallel(queries)) {
+        return connections;
+    }
+
+    ConnectionPool * pool = _lastRunningConnection->pool();
+    if (pool == nullptr) {
+        return connections;
+    }
+
+    try {
+        while (connections.size() < queries.size() - 1) {
+            ConnectionPtr connection = pool->acquire();
+            if (!connection) {
+                break; // pool is full, run in what we have
+            }
+            _parallelConnections.append(connection);
+            connections.append(connection.get());
+        }
+    } catch(meow::db::Exception & ex) {
+        meowLogCC(Log::Category::Error, _lastRunningConnection)
+            << "Pooled connection failed: " << ex.message();
+    }
+
+    return connections;
+}
+
 QString UserQuery::generateUniqueId() const
 {
     QUuid uid = QUuid::createUuid();
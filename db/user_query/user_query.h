@@ -10,6 +10,7 @@
 namespace meow {
 namespace threads {
 class QueriesTask;
+class DbThread;
 }
 namespace db {
 
@@ -25,6 +26,10 @@ public:
     ~UserQuery() override;
 
     void runInCurrentConnection(const QStringList & queries);
+    // Splits script into queries while running them
+    void runScriptInCurrentConnection(const QString & script);
+    // Reads and runs file by chunks, for scripts too big for editor
+    void runScriptFileInCurrentConnection(const QString & filename);
     QString lastError() const;
 
     int resultsDataCount() const {
@@ -85,6 +90,22 @@ public:
         return _lastRunningConnection;
     }
 
+    // pooled connection of last running one if any, queries run there
+    Connection * executionConnection() const {
+        return _executionConnection ? _executionConnection.get()
+                                    : _lastRunningConnection;
+    }
+
+    // pooled connections running read-only queries in parallel, if any
+    QList<Connection *> parallelConnections() const {
+        MEOW_ASSERT_MAIN_THREAD
+        QList<Connection *> connections;
+        for (const ConnectionPtr & connection : _parallelConnections) {
+            connections.append(connection.get());
+        }
+        return connections;
+    }
+
     Q_SIGNAL void queryFinished(int queryIndex, int totalCount);
     Q_SIGNAL void queriesFinished();
     Q_SIGNAL void newQueryDataResult(int index);
@@ -95,16 +116,27 @@ private:
 
     Q_SLOT void onQueriesFinished();
     Q_SLOT void onQueryFinished(int queryIndex, int totalCount);
+    Q_SLOT void onQueryRowsFetched(int queryIndex);
     Q_SLOT void onConnectionClose(SessionEntity * session);
 
     QString generateUniqueId() const;
+    void prepareRun();
+    void postQueriesTask(threads::DbThread * thread);
+    void acquireExecutionConnection(bool sameSession);
+    QList<Connection *> acquireParallelConnections(const QStringList & queries);
 
     ConnectionsManager * _connectionsManager;
     Connection * _lastRunningConnection;
+    ConnectionPtr _executionConnection;
+    QList<ConnectionPtr> _parallelConnections;
     QVector<QueryDataPtr> _resultsData;
     QString _currentQueryText;
     mutable QString _uniqieId;
     bool _modifiedButNotSaved;
+    // queries changed session state (variables, temporary tables etc), so
+    // next ones run in the same connection, see ConnectionPool
+    bool _isSessionPinned;
+    bool _isSchemaChanging; // completion index is refreshed when finished
     std::shared_ptr<threads::QueriesTask> _queriesTask;
     std::atomic<bool> _isRunning;
 };
@@ -14,18 +14,10 @@ greaterThan(QT_MINOR_VERSION, 4) { # >= 5.5
 CONFIG += WITH_MYSQL
 CONFIG += WITH_POSTGRESQL
 CONFIG += WITH_SQLITE
-CONFIG += WITH_QTSQL
 #CONFIG += WITH_LIBSSH
 
 #CONFIG += WITH_LIBMYSQL_SOURCES #tried to experiment with WASM
 
-WITH_QTSQL {
-    QT += sql
-} else {
-    # sqlite is made on Qt SQL module
-    CONFIG -= WITH_SQLITE
-}
-
 WITH_MYSQL {
     DEFINES += WITH_MYSQL
 }
@@ -38,10 +30,6 @@ WITH_SQLITE {
     DEFINES += WITH_SQLITE
 }
 
-WITH_QTSQL {
-    DEFINES += WITH_QTSQL
-}
-
 WITH_LIBSSH {
     DEFINES += WITH_LIBSSH
 }
@@ -78,17 +66,24 @@ WITH_POSTGRESQL {
     win32:LIBS += -l"$$PWD\third_party\libpq\windows\lib\libpq"
 }
 
+# SQLite
+WITH_SQLITE {
+    LIBS += -lsqlite3 # pkg-config --libs sqlite3
+}
+
 DEFINES += YY_NO_UNISTD_H # fix flex compilation on win
 
 SOURCES += main.cpp\
     app/actions.cpp \
     app/app.cpp \
     app/log.cpp \
+    db/bulk_loader.cpp \
     db/connection.cpp \
     db/connection_parameters.cpp \
     db/connection_features.cpp \
     db/connection_params_manager.cpp \
     db/connections_manager.cpp \
+    db/connection_pool.cpp \
     db/connection_query_killer.cpp \
     db/database_editor.cpp \
     db/data_type/data_type.cpp \
@@ -107,6 +102,9 @@ SOURCES += main.cpp\
     db/exception.cpp \
     db/foreign_key.cpp \
     db/native_query_result.cpp \
+    db/columnar_result_storage.cpp \
+    db/completion_index.cpp \
+    db/schema_cache.cpp \
     db/query.cpp \
     db/query_criteria.cpp \
     db/query_data.cpp \
@@ -120,6 +118,7 @@ SOURCES += main.cpp\
     db/table_index.cpp \
     db/table_structure.cpp \
     db/table_structure_parser.cpp \
+    db/table_structures_fetcher.cpp \
     db/db_thread_initializer.cpp \
     db/trigger_editor.cpp \
     db/trigger_structure_parser.cpp \
@@ -129,6 +128,7 @@ SOURCES += main.cpp\
     db/view_structure_parser.cpp \
     db/user_queries_manager.cpp \
     db/user_query/batch_executor.cpp \
+    db/user_query/sentence_splitter.cpp \
     db/user_query/sentences_parser.cpp \
     db/user_query/user_query.cpp \
     helpers/formatting.cpp \
@@ -141,6 +141,7 @@ SOURCES += main.cpp\
     settings/settings_icons.cpp \
     settings/settings_text.cpp \
     settings/data_editors.cpp \
+    settings/data_fetching.cpp \
     settings/general.cpp \
     settings/queries_storage.cpp \
     settings/query_data_export_storage.cpp \
@@ -148,14 +149,23 @@ SOURCES += main.cpp\
     ssh/openssh_tunnel.cpp \
     ssh/ssh_tunnel_factory.cpp \
     ssh/ssh_tunnel_parameters.cpp \
+    threads/completion_index_task.cpp \
+    threads/connection_open_task.cpp \
+    threads/schema_cache_validation_task.cpp \
+    threads/tables_status_task.cpp \
+    threads/data_export_task.cpp \
+    threads/data_import_task.cpp \
     threads/db_thread.cpp \
+    threads/dump_task.cpp \
     threads/queries_task.cpp \
+    threads/table_data_task.cpp \
     threads/thread_init_task.cpp \
     threads/thread_task.cpp \
     ui/common/checkbox_list_popup.cpp \
     ui/common/data_type_combo_box.cpp \
     ui/common/geometry_helpers.cpp \
     ui/common/sql_editor.cpp \
+    ui/common/sql_keywords.cpp \
     ui/common/sql_log_editor.cpp \
     ui/common/sql_syntax_highlighter.cpp \
     ui/common/table_column_default_editor.cpp \
@@ -239,6 +249,7 @@ SOURCES += main.cpp\
     ui/models/user_privileges_model.cpp \
     ui/models/variables_table_model.cpp \
     ui/models/session_objects_tree_model.cpp \
+    ui/preferences/data_tab.cpp \
     ui/preferences/general_tab.cpp \
     ui/preferences/preferences_dialog.cpp \
     ui/presenters/central_right_host_widget_model.cpp \
@@ -252,6 +263,7 @@ SOURCES += main.cpp\
     ui/presenters/editable_data_context_menu_presenter.cpp \
     ui/presenters/export_database_form.cpp \
     ui/presenters/export_query_presenter.cpp \
+    ui/presenters/import_csv_form.cpp \
     ui/presenters/preferences_presenter.cpp \
     ui/presenters/routine_form.cpp \
     ui/presenters/select_db_object_form.cpp \
@@ -275,14 +287,18 @@ SOURCES += main.cpp\
     ui/session_manager/window.cpp \
     db/editable_grid_data.cpp \
     db/query_data_editor.cpp \
+    db/prepared_statement_cache.cpp \
     ui/common/editable_query_data_table_view.cpp \
     ui/main_window/central_bottom_widget.cpp \
     ui/main_window/central_log_widget.cpp \
-    utils/exporting/mysql_dump_console.cpp \
+    utils/exporting/mysql_dumper.cpp \
     utils/exporting/query_data_exporter.cpp \
     utils/exporting/query_data_export_formats/format.cpp \
     utils/exporting/query_data_export_formats/format_factory.cpp \
-    ui/export_database/export_dialog.cpp
+    utils/importing/csv_importer.cpp \
+    utils/importing/csv_reader.cpp \
+    ui/export_database/export_dialog.cpp \
+    ui/import_csv/import_csv_dialog.cpp
 
 
 HEADERS  +=  app/actions.h \
@@ -290,12 +306,14 @@ HEADERS  +=  app/actions.h \
     app/log.h \
     app/language.h \
     db/collation_fetcher.h \
+    db/bulk_loader.h \
     db/common.h \
     db/connection.h \
     db/connection_parameters.h \
     db/connection_features.h \
     db/connection_params_manager.h \
     db/connections_manager.h \
+    db/connection_pool.h \
     db/connection_query_killer.h \
     db/database_editor.h \
     db/data_type/connection_data_types.h \
@@ -316,6 +334,9 @@ HEADERS  +=  app/actions.h \
     db/exception.h \
     db/foreign_key.h \
     db/native_query_result.h \
+    db/columnar_result_storage.h \
+    db/completion_index.h \
+    db/schema_cache.h \
     db/query_column.h \
     db/query_criteria.h \
     db/query_data_fetcher.h \
@@ -332,6 +353,7 @@ HEADERS  +=  app/actions.h \
     db/table_index.h \
     db/table_structure.h \
     db/table_structure_parser.h \
+    db/table_structures_fetcher.h \
     db/db_thread_initializer.h \
     db/trigger_editor.h \
     db/trigger_structure_parser.h \
@@ -342,6 +364,7 @@ HEADERS  +=  app/actions.h \
     db/user_manager.h \
     db/user_editor_interface.h \
     db/user_query/batch_executor.h \
+    db/user_query/sentence_splitter.h \
     db/user_query/sentences_parser.h \
     db/user_query/user_query.h \
     db/user_queries_manager.h \
@@ -355,6 +378,7 @@ HEADERS  +=  app/actions.h \
     settings/settings_icons.h \
     settings/settings_text.h \
     settings/data_editors.h \
+    settings/data_fetching.h \
     settings/general.h \
     settings/queries_storage.h \
     settings/query_data_export_storage.h \
@@ -364,8 +388,16 @@ HEADERS  +=  app/actions.h \
     ssh/ssh_tunnel_parameters.h \
     threads/helpers.h \
     threads/mutex.h \
+    threads/completion_index_task.h \
+    threads/connection_open_task.h \
+    threads/schema_cache_validation_task.h \
+    threads/tables_status_task.h \
+    threads/data_export_task.h \
+    threads/data_import_task.h \
     threads/db_thread.h \
+    threads/dump_task.h \
     threads/queries_task.h \
+    threads/table_data_task.h \
     threads/thread_init_task.h \
     threads/thread_task.h \
     ui/common/checkbox_list_popup.h \
@@ -373,6 +405,7 @@ HEADERS  +=  app/actions.h \
     ui/common/geometry_helpers.h \
     ui/common/mysql_syntax.h \
     ui/common/sql_editor.h \
+    ui/common/sql_keywords.h \
     ui/common/sql_log_editor.h \
     ui/common/sql_syntax_highlighter.h \
     ui/common/table_column_default_editor.h \
@@ -458,6 +491,7 @@ HEADERS  +=  app/actions.h \
     ui/models/user_privileges_model.h \
     ui/models/variables_table_model.h \
     ui/models/session_objects_tree_model.h \
+    ui/preferences/data_tab.h \
     ui/preferences/general_tab.h \
     ui/preferences/preferences_dialog.h \
     ui/presenters/central_right_host_widget_model.h \
@@ -471,6 +505,7 @@ HEADERS  +=  app/actions.h \
     ui/presenters/editable_data_context_menu_presenter.h \
     ui/presenters/export_database_form.h \
     ui/presenters/export_query_presenter.h \
+    ui/presenters/import_csv_form.h \
     ui/presenters/preferences_presenter.h \
     ui/presenters/routine_form.h \
     ui/presenters/select_db_object_form.h \
@@ -494,10 +529,12 @@ HEADERS  +=  app/actions.h \
     ui/session_manager/window.h \
     db/editable_grid_data.h \
     db/query_data_editor.h \
+    db/prepared_statement.h \
+    db/prepared_statement_cache.h \
     ui/common/editable_query_data_table_view.h \
     ui/main_window/central_bottom_widget.h \
     ui/main_window/central_log_widget.h \
-    utils/exporting/mysql_dump_console.h \
+    utils/exporting/mysql_dumper.h \
     utils/exporting/query_data_exporter.h \
     utils/exporting/query_data_export_formats/format.h \
     utils/exporting/query_data_export_formats/format_csv.h \
@@ -513,7 +550,10 @@ HEADERS  +=  app/actions.h \
     utils/exporting/query_data_export_formats/format_sql_replaces.h \
     utils/exporting/query_data_export_formats/format_wiki.h \
     utils/exporting/query_data_export_formats/format_xml.h \
-    ui/export_database/export_dialog.h
+    utils/importing/csv_importer.h \
+    utils/importing/csv_reader.h \
+    ui/export_database/export_dialog.h \
+    ui/import_csv/import_csv_dialog.h
 
 win32:SOURCES += ssh/plink_ssh_tunnel.cpp
 win32:HEADERS += ssh/plink_ssh_tunnel.h
@@ -524,13 +564,17 @@ WITH_MYSQL {
     db/mysql/mysql_database_editor.cpp \
     db/mysql/mysql_entities_fetcher.cpp \
     db/mysql/mysql_query_result.cpp \
+    db/mysql/mysql_streamed_query_result.cpp \
+    db/mysql/mysql_prepared_statement.cpp \
     db/mysql/mysql_query_data_editor.cpp \
     db/mysql/mysql_collation_fetcher.cpp \
+    db/mysql/mysql_bulk_loader.cpp \
     db/mysql/mysql_connection.cpp \
     db/mysql/mysql_connection_query_killer.cpp \
     db/mysql/mysql_query_data_fetcher.cpp \
     db/mysql/mysql_table_editor.cpp \
     db/mysql/mysql_table_engines_fetcher.cpp \
+    db/mysql/mysql_table_structures_fetcher.cpp \
     db/mysql/mysql_user_manager.cpp \
     db/mysql/mysql_user_editor.cpp \
     db/mysql/mysql_library_initializer.cpp \
@@ -539,19 +583,27 @@ WITH_MYSQL {
 
 WITH_POSTGRESQL {
     SOURCES += db/data_type/pg_connection_data_types.cpp \
+    db/pg/pg_bulk_loader.cpp \
+    db/pg/pg_binary_format.cpp \
     db/pg/pg_connection.cpp \
     db/pg/pg_connection_query_killer.cpp \
     db/pg/pg_entities_fetcher.cpp \
     db/pg/pg_entity_create_code_generator.cpp \
     db/pg/pg_query_result.cpp \
+    db/pg/pg_streamed_query_result.cpp \
+    db/pg/pg_prepared_statement.cpp \
     db/pg/pg_query_data_editor.cpp \
     db/pg/pg_query_data_fetcher.cpp
 }
 
 WITH_SQLITE {
     SOURCES += db/data_type/sqlite_connection_datatypes.cpp \
+    db/sqlite/sqlite_bulk_loader.cpp \
     db/sqlite/sqlite_connection.cpp \
     db/sqlite/sqlite_entities_fetcher.cpp \
+    db/sqlite/sqlite_prepared_statement.cpp \
+    db/sqlite/sqlite_query_result.cpp \
+    db/sqlite/sqlite_streamed_query_result.cpp \
     db/sqlite/sqlite_table_structure_parser.cpp \
     utils/sql_parser/sqlite/sqlite_parser.cpp \
     utils/sql_parser/sqlite/sqlite_bison_parser.cpp \
@@ -559,10 +611,6 @@ WITH_SQLITE {
     utils/sql_parser/sqlite/sqlite_types.cpp \
 }
 
-WITH_QTSQL {
-    SOURCES += db/qtsql/qtsql_query_result.cpp
-}
-
 WITH_MYSQL {
     HEADERS += db/data_type/mysql_data_type.h \
     db/mysql/mysql_query_result.h \
@@ -571,13 +619,17 @@ WITH_MYSQL {
     db/mysql/mysql_database_editor.h \
     db/mysql/mysql_entities_fetcher.h \
     db/mysql/mysql_query_result.h \
+    db/mysql/mysql_streamed_query_result.h \
+    db/mysql/mysql_prepared_statement.h \
     db/mysql/mysql_query_data_editor.h \
     db/mysql/mysql_collation_fetcher.h \
+    db/mysql/mysql_bulk_loader.h \
     db/mysql/mysql_connection.h \
     db/mysql/mysql_connection_query_killer.h \
     db/mysql/mysql_query_data_fetcher.h \
     db/mysql/mysql_table_editor.h \
     db/mysql/mysql_table_engines_fetcher.h \
+    db/mysql/mysql_table_structures_fetcher.h \
     db/mysql/mysql_user_manager.h \
     db/mysql/mysql_user_editor.h \
     db/mysql/mysql_library_initializer.h \
@@ -587,7 +639,11 @@ WITH_MYSQL {
 WITH_POSTGRESQL {
     HEADERS += db/data_type/pg_connection_data_types.h \
     db/data_type/pg_data_type.h \
+    db/pg/pg_binary_format.h \
     db/pg/pg_query_result.h \
+    db/pg/pg_streamed_query_result.h \
+    db/pg/pg_prepared_statement.h \
+    db/pg/pg_bulk_loader.h \
     db/pg/pg_connection.h \
     db/pg/pg_connection_query_killer.h \
     db/pg/pg_entities_fetcher.h \
@@ -598,8 +654,12 @@ WITH_POSTGRESQL {
 
 WITH_SQLITE {
     HEADERS += db/data_type/sqlite_connection_datatypes.cpp \
+    db/sqlite/sqlite_bulk_loader.h \
     db/sqlite/sqlite_connection.h \
     db/sqlite/sqlite_entities_fetcher.h \
+    db/sqlite/sqlite_prepared_statement.h \
+    db/sqlite/sqlite_query_result.h \
+    db/sqlite/sqlite_streamed_query_result.h \
     db/sqlite/sqlite_table_structure_parser.h \
     utils/sql_parser/sqlite/sqlite_parser.h \
     utils/sql_parser/sqlite/sqlite_bison_parser.hpp \
@@ -607,10 +667,6 @@ WITH_SQLITE {
     utils/sql_parser/sqlite/sqlite_types.h
 }
 
-WITH_QTSQL {
-    HEADERS += db/qtsql/qtsql_query_result.h
-}
-
 WITH_MYSQL {
     win32:INCLUDEPATH += "$$PWD\third_party\libmysql\windows\include"
     !WITH_LIBMYSQL_SOURCES:unix:INCLUDEPATH += /usr/include/mysql
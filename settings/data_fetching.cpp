@@ -0,0 +1,78 @@
+#include "data_fetching.h"
+#include <QSettings>
+
+namespace meow {
+namespace settings {
+
+static const char STREAM_QUERY_RESULTS_SETTINGS_KEY[]
+    = "settings/data_fetching/stream_query_results";
+static const char RUN_READ_ONLY_QUERIES_IN_PARALLEL_SETTINGS_KEY[]
+    = "settings/data_fetching/run_read_only_queries_in_parallel";
+static const char RECEIVE_BINARY_RESULTS_SETTINGS_KEY[]
+    = "settings/data_fetching/receive_binary_results";
+static const char LOAD_TABLE_ROWS_ON_SCROLL_SETTINGS_KEY[]
+    = "settings/data_fetching/load_table_rows_on_scroll";
+static const char TABLE_DATA_MAX_BUFFER_SIZE_MB_SETTINGS_KEY[]
+    = "settings/data_fetching/table_data_max_buffer_size_mb";
+
+static const int DEFAULT_TABLE_DATA_MAX_BUFFER_SIZE_MB
+    = static_cast<int>(db::DATA_TABLE_MAX_BUFFER_SIZE / (1024 * 1024));
+
+DataFetching::DataFetching()
+    : _streamQueryResults(false)
+    , _runReadOnlyQueriesInParallel(false)
+    , _receiveBinaryResults(true)
+    , _loadTableRowsOnScroll(true)
+    , _tableDataMaxBufferSizeMB(DEFAULT_TABLE_DATA_MAX_BUFFER_SIZE_MB)
+{
+
+}
+
+void DataFetching::copyDataTo(DataFetching * copy) const
+{
+    copy->_streamQueryResults = this->_streamQueryResults;
+    copy->_runReadOnlyQueriesInParallel = this->_runReadOnlyQueriesInParallel;
+    copy->_receiveBinaryResults = this->_receiveBinaryResults;
+    copy->_loadTableRowsOnScroll = this->_loadTableRowsOnScroll;
+    copy->_tableDataMaxBufferSizeMB = this->_tableDataMaxBufferSizeMB;
+}
+
+void DataFetching::setDataFrom(const DataFetching * source)
+{
+    source->copyDataTo(this);
+}
+
+void DataFetching::save()
+{
+    QSettings settings;
+    settings.setValue(STREAM_QUERY_RESULTS_SETTINGS_KEY, _streamQueryResults);
+    settings.setValue(RUN_READ_ONLY_QUERIES_IN_PARALLEL_SETTINGS_KEY,
+                      _runReadOnlyQueriesInParallel);
+    settings.setValue(RECEIVE_BINARY_RESULTS_SETTINGS_KEY,
+                      _receiveBinaryResults);
+    settings.setValue(LOAD_TABLE_ROWS_ON_SCROLL_SETTINGS_KEY,
+                      _loadTableRowsOnScroll);
+    settings.setValue(TABLE_DATA_MAX_BUFFER_SIZE_MB_SETTINGS_KEY,
+                      _tableDataMaxBufferSizeMB);
+}
+
+void DataFetching::load()
+{
+    QSettings settings;
+    // opt-in: streamed result keeps connection busy until it is read out
+    _streamQueryResults = settings.value(STREAM_QUERY_RESULTS_SETTINGS_KEY,
+                                         false).toBool();
+    // opt-in: each query takes a pooled connection
+    _runReadOnlyQueriesInParallel = settings.value(
+        RUN_READ_ONLY_QUERIES_IN_PARALLEL_SETTINGS_KEY, false).toBool();
+    _receiveBinaryResults = settings.value(
+        RECEIVE_BINARY_RESULTS_SETTINGS_KEY, true).toBool();
+    _loadTableRowsOnScroll = settings.value(
+        LOAD_TABLE_ROWS_ON_SCROLL_SETTINGS_KEY, true).toBool();
+    _tableDataMaxBufferSizeMB = qMax(1, settings.value(
+        TABLE_DATA_MAX_BUFFER_SIZE_MB_SETTINGS_KEY,
+        DEFAULT_TABLE_DATA_MAX_BUFFER_SIZE_MB).toInt());
+}
+
+} // namespace meow
+} // namespace settings
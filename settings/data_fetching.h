@@ -0,0 +1,62 @@
+#ifndef MEOW_SETTINGS_DATA_FETCHING_H
+#define MEOW_SETTINGS_DATA_FETCHING_H
+
+#include "db/common.h"
+
+namespace meow {
+namespace settings {
+
+class DataFetching
+{
+public:
+    DataFetching();
+
+    void copyDataTo(DataFetching * copy) const;
+    void setDataFrom(const DataFetching * source);
+
+    // show first rows of user query while the rest are received
+    bool streamQueryResults() const { return _streamQueryResults; }
+    void setStreamQueryResults(bool stream) { _streamQueryResults = stream; }
+    // receive streamed PostgreSQL results in binary format when all
+    // column types are known, numbers are not parsed from text then
+    bool receiveBinaryResults() const { return _receiveBinaryResults; }
+    void setReceiveBinaryResults(bool binary) {
+        _receiveBinaryResults = binary;
+    }
+    // run batch of independent SELECTs of user query in pooled connections
+    bool runReadOnlyQueriesInParallel() const {
+        return _runReadOnlyQueriesInParallel;
+    }
+    void setRunReadOnlyQueriesInParallel(bool parallel) {
+        _runReadOnlyQueriesInParallel = parallel;
+    }
+    // load next rows of table data when scrolled to the end
+    bool loadTableRowsOnScroll() const { return _loadTableRowsOnScroll; }
+    void setLoadTableRowsOnScroll(bool load) {
+        _loadTableRowsOnScroll = load;
+    }
+    // far pages of table data are released above this size, MB
+    int tableDataMaxBufferSizeMB() const { return _tableDataMaxBufferSizeMB; }
+    void setTableDataMaxBufferSizeMB(int size) {
+        _tableDataMaxBufferSizeMB = size;
+    }
+    db::ulonglong tableDataMaxBufferSize() const { // bytes
+        return static_cast<db::ulonglong>(_tableDataMaxBufferSizeMB)
+                * 1024 * 1024;
+    }
+
+    void load();
+    void save();
+
+private:
+    bool _streamQueryResults;
+    bool _runReadOnlyQueriesInParallel;
+    bool _receiveBinaryResults;
+    bool _loadTableRowsOnScroll;
+    int _tableDataMaxBufferSizeMB;
+};
+
+} // namespace meow
+} // namespace settings
+
+#endif // MEOW_SETTINGS_DATA_FETCHING_H
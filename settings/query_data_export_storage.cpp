@@ -71,6 +71,8 @@ QString optionValueName(Format::OptionsValue option)
         return "line_terminator";
     case Format::OptionsValue::NullValue:
         return "null_value";
+    case Format::OptionsValue::MaxStatementSize:
+        return "max_statement_size";
     default:
         Q_ASSERT(false);
         return QString();
@@ -5,6 +5,7 @@
 #include "settings_geometry.h"
 #include "settings_icons.h"
 #include "data_editors.h"
+#include "data_fetching.h"
 #include "queries_storage.h"
 #include "general.h"
 
@@ -17,26 +18,32 @@ class UserPreferences
 {
 public:
     General * generalSettings() { return &_general; }
+    DataFetching * dataFetchingSettings() { return &_dataFetching; }
     std::unique_ptr<UserPreferences> clone() const {
         auto copy = std::unique_ptr<UserPreferences>(new UserPreferences);
         _general.copyDataTo(copy->generalSettings());
+        _dataFetching.copyDataTo(copy->dataFetchingSettings());
         return copy;
     }
 
     void load() {
         _general.load();
+        _dataFetching.load();
     }
 
     void save() {
         _general.save();
+        _dataFetching.save();
     }
 
     void setDataFrom(UserPreferences * source) {
         _general.setDataFrom(source->generalSettings());
+        _dataFetching.setDataFrom(source->dataFetchingSettings());
     }
 
 private:
     General _general;
+    DataFetching _dataFetching;
 };
 
 class Core
@@ -57,6 +64,9 @@ public:
     Geometry * geometrySettings() { return &_geometry; }
     Icons * icons() { return &_icons; }
     DataEditors * dataEditors() { return &_dataEditors; }
+    DataFetching * dataFetching() {
+        return _userPreferences.dataFetchingSettings();
+    }
     QueriesStorage * queriesStorage() {
         if (_queriesStorage == nullptr) {
             _queriesStorage.reset(new QueriesStorage());
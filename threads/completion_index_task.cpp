@@ -0,0 +1,149 @@
+#include "completion_index_task.h"
+#include "db/completion_index.h"
+#include "db/connection.h"
+#include "db/entity/table_entity.h"
+#include "db/table_structure.h"
+#include "helpers/logger.h"
+
+namespace meow {
+namespace threads {
+
+CompletionIndexTask::CompletionIndexTask(
+        const std::shared_ptr<db::CompletionIndex> & index,
+        db::Connection * connection)
+    : ThreadTask(TaskType::CompletionIndex)
+    , _index(index)
+    , _connection(connection)
+    , _isAborted(false)
+{
+
+}
+
+void CompletionIndexTask::run()
+{
+    try {
+        // pooled connection keeps caches of previous filling
+        QStringList databases = _connection->databases(true);
+        _index->addItems(db::CompletionIndex::Kind::Database, databases);
+
+        // current database is the most likely to be typed
+        QString currentDatabase = _connection->database();
+        if (databases.removeOne(currentDatabase)) {
+            databases.prepend(currentDatabase);
+        }
+
+        QList<db::EntityPtr> currentTables;
+        for (const QString & database : databases) {
+            if (_isAborted) {
+                break;
+            }
+            indexEntities(database,
+                          database == currentDatabase ? &currentTables
+                                                      : nullptr);
+        }
+
+        if (!_isAborted) {
+            indexColumns(currentDatabase, currentTables);
+        }
+    } catch(meow::db::Exception & ex) {
+        meowLogCC(Log::Category::Error, _connection)
+            << "Failed to fill autocompletion: " << ex.message();
+    }
+
+    emit finished();
+}
+
+void CompletionIndexTask::abort()
+{
+    _isAborted = true;
+}
+
+void CompletionIndexTask::indexEntities(const QString & database,
+                                        QList<db::EntityPtr> * tables)
+{
+    QList<db::EntityPtr> entities;
+    try {
+        entities = _connection->getDbEntities(database, true);
+    } catch(meow::db::Exception & ex) {
+        meowLogCC(Log::Category::Error, _connection)
+            << "Failed to read entities of " << database
+            << " for autocompletion: " << ex.message();
+        return;
+    }
+
+    std::vector<db::CompletionIndex::Item> items;
+    items.reserve(static_cast<std::size_t>(entities.size()));
+
+    for (const db::EntityPtr & entity : entities) {
+        db::CompletionIndex::Kind kind;
+        switch (entity->type()) {
+        case db::Entity::Type::Table:
+            kind = db::CompletionIndex::Kind::Table;
+            if (tables) {
+                tables->append(entity);
+            }
+            break;
+        case db::Entity::Type::View:
+            kind = db::CompletionIndex::Kind::View;
+            break;
+        case db::Entity::Type::Function:
+        case db::Entity::Type::Procedure:
+            kind = db::CompletionIndex::Kind::Routine;
+            break;
+        default:
+            continue; // triggers and events are not typed in queries
+        }
+        items.push_back({entity->name(), database, kind});
+    }
+
+    _index->addItems(items);
+}
+
+void CompletionIndexTask::indexColumns(const QString & database,
+                                       const QList<db::EntityPtr> & tables)
+{
+    QList<db::TableEntity *> tableList;
+    for (const db::EntityPtr & entity : tables) {
+        tableList.append(static_cast<db::TableEntity *>(entity.get()));
+    }
+
+    try {
+        // in one pass if server allows
+        _connection->parseTableStructures(database, tableList);
+    } catch(meow::db::Exception & ex) {
+        meowLogCC(Log::Category::Error, _connection)
+            << "Failed to read columns of " << database
+            << " for autocompletion: " << ex.message();
+        return;
+    }
+
+    std::vector<db::CompletionIndex::Item> items;
+    int tablesInPortion = 0;
+
+    for (db::TableEntity * table : tableList) {
+        if (_isAborted) {
+            return;
+        }
+
+        if (!table->hasStructure()) {
+            continue;
+        }
+
+        for (const db::TableColumn * column : table->structure()->columns()) {
+            items.push_back({column->name(),
+                             table->name(),
+                             db::CompletionIndex::Kind::Column});
+        }
+
+        if (++tablesInPortion == db::COMPLETION_TABLES_PER_BATCH) {
+            _index->addItems(items);
+            items.clear();
+            tablesInPortion = 0;
+        }
+    }
+
+    _index->addItems(items);
+}
+
+} // namespace threads
+} // namespace meow
@@ -0,0 +1,49 @@
+#ifndef MEOW_THREADS_COMPLETION_INDEX_TASK_H
+#define MEOW_THREADS_COMPLETION_INDEX_TASK_H
+
+#include <atomic>
+#include <memory>
+#include <QList>
+#include <QString>
+#include "thread_task.h"
+
+namespace meow {
+
+namespace db {
+class Connection;
+class CompletionIndex;
+class Entity;
+using EntityPtr = std::shared_ptr<Entity>;
+}
+
+namespace threads {
+
+// Intent: fills completion index by portions: databases, entities of every
+// database (current one first), then columns of tables of current database.
+// Uses own caches of connection (reloaded on every run), so connection
+// should be a pooled one.
+class CompletionIndexTask : public ThreadTask
+{
+    Q_OBJECT
+public:
+    CompletionIndexTask(const std::shared_ptr<db::CompletionIndex> & index,
+                        db::Connection * connection);
+    void run() override;
+    bool isFailed() const override { return false; } // errors are logged
+    void abort(); // thread-safe, stops on next portion
+
+private:
+    void indexEntities(const QString & database,
+                       QList<db::EntityPtr> * tables);
+    void indexColumns(const QString & database,
+                      const QList<db::EntityPtr> & tables);
+
+    std::shared_ptr<db::CompletionIndex> _index;
+    db::Connection * _connection;
+    std::atomic<bool> _isAborted;
+};
+
+} // namespace threads
+} // namespace meow
+
+#endif // MEOW_THREADS_COMPLETION_INDEX_TASK_H
@@ -0,0 +1,47 @@
+#include "connection_open_task.h"
+#include "db/connection.h"
+
+namespace meow {
+namespace threads {
+
+ConnectionOpenTask::ConnectionOpenTask(db::Connection * connection,
+                                       const QString & characterSet,
+                                       const QString & database)
+    : ThreadTask(TaskType::ConnectionOpen)
+    , _connection(connection)
+    , _characterSet(characterSet)
+    , _database(database)
+    , _failed(false)
+{
+
+}
+
+void ConnectionOpenTask::run()
+{
+    QString errorMessage;
+
+    try {
+        _connection->setActive(true);
+
+        if (!_characterSet.isEmpty()
+                && _connection->characterSet() != _characterSet) {
+            _connection->setCharacterSet(_characterSet);
+        }
+
+        if (_connection->database() != _database) {
+            _connection->setDatabase(_database);
+        }
+
+        // get id now to allow KILL QUERY ID from another thread
+        _connection->connectionIdOnServer();
+    } catch(meow::db::Exception & ex) {
+        _failed = true;
+        errorMessage = ex.message();
+    }
+
+    emit opened(errorMessage);
+    emit finished();
+}
+
+} // namespace threads
+} // namespace meow
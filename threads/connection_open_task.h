@@ -0,0 +1,40 @@
+#ifndef MEOW_THREADS_CONNECTION_OPEN_TASK_H
+#define MEOW_THREADS_CONNECTION_OPEN_TASK_H
+
+#include <QString>
+#include "thread_task.h"
+
+namespace meow {
+
+namespace db {
+class Connection;
+}
+
+namespace threads {
+
+// Intent: opens pooled connection in its own thread, so nobody waits for
+// connect, and applies charset and database of main connection
+class ConnectionOpenTask : public ThreadTask
+{
+    Q_OBJECT
+public:
+    ConnectionOpenTask(db::Connection * connection,
+                       const QString & characterSet,
+                       const QString & database);
+    void run() override;
+    bool isFailed() const override { return _failed; }
+
+    // emitted before finished(), error is empty on success
+    Q_SIGNAL void opened(const QString & errorMessage);
+
+private:
+    db::Connection * _connection;
+    QString _characterSet;
+    QString _database;
+    bool _failed;
+};
+
+} // namespace threads
+} // namespace meow
+
+#endif // MEOW_THREADS_CONNECTION_OPEN_TASK_H
@@ -0,0 +1,162 @@
+#include "data_export_task.h"
+#include <QFile>
+#include <QTextStream>
+#include "db/connection.h"
+#include "db/query_data.h"
+#include "helpers/logger.h"
+
+namespace meow {
+namespace threads {
+
+DataExportTask::DataExportTask(const QString & SQL,
+                               db::Entity * entity,
+                               db::Connection * connection)
+    : ThreadTask(TaskType::DataExport)
+    , _SQL(SQL)
+    , _entity(entity)
+    , _connection(connection)
+    , _encoding("UTF-8")
+    , _rowsCountHint(0)
+    , _exportedRowsCount(0)
+    , _failed(false)
+    , _isAborted(false)
+{
+
+}
+
+void DataExportTask::run()
+{
+    if (_isAborted) { // cancelled while waiting for other tasks
+        emit finished();
+        return;
+    }
+
+    try {
+        exportRows();
+    } catch(meow::db::Exception & ex) {
+        meowLogC(Log::Category::Error)
+            << "Failed to export data: " << ex.message();
+        QMutexLocker locker(&_mutex);
+        _failed = true;
+        _error = ex;
+    }
+
+    {
+        // query is released in its thread, see Query::isFetching()
+        QMutexLocker locker(&_mutex);
+        _query.reset();
+    }
+
+    emit finished();
+    if (isFailed()) {
+        emit failed();
+    }
+}
+
+void DataExportTask::exportRows()
+{
+    Q_ASSERT(_format != nullptr);
+
+    QFile file(_filename);
+    if (!file.open(QFile::WriteOnly | QFile::Truncate)) {
+        throw db::Exception(
+                    QString("Unable to open file `%1`").arg(_filename));
+    }
+
+    QTextStream stream(&file); // buffered, file is written by portions
+    QByteArray codec = _encoding.toUtf8();
+    stream.setCodec(codec.data());
+
+    db::QueryPtr query = _connection->createQuery();
+    query->setSQL(_SQL);
+    query->setEntity(_entity);
+    query->setStreamed(true); // ignored if connection can't stream
+
+    db::QueryData data; // formats read rows of current result from it
+    data.setQueryPtr(query);
+
+    query->execute();
+
+    {
+        QMutexLocker locker(&_mutex);
+        _query = query;
+    }
+    if (_isAborted) {
+        query->abortFetching(); // aborted while executing
+    }
+
+    if (query->isFetching()) {
+        query->fetchMore(db::DATA_ROWS_PER_STEP);
+    }
+
+    _format->setData(&data);
+    _format->setOutputFile(&file);
+    _format->setRowsCount(query->isFetching()
+                          ? _rowsCountHint
+                          : query->recordCount());
+
+    stream << _format->header();
+
+    while (!_isAborted) {
+
+        // fetched rows are numbered from 0 after each clearFetchedRows()
+        int rowCount = data.rowCount();
+        for (int row = 0; row < rowCount && !_isAborted; ++row) {
+            stream << _format->row(row);
+            if (++_exportedRowsCount % db::DATA_ROWS_PER_STEP == 0) {
+                emit rowsExported(_exportedRowsCount);
+            }
+        }
+        emit rowsExported(_exportedRowsCount);
+
+        if (!query->isFetching()) {
+            break;
+        }
+
+        query->clearFetchedRows();
+        query->fetchMore(db::DATA_ROWS_PER_STEP);
+    }
+
+    if (_isAborted) {
+        query->abortFetching(); // no-op if abort() has killed it already
+        stream.flush();
+        file.close();
+        file.remove(); // no half-written files
+        return;
+    }
+
+    stream << _format->footer();
+    stream.flush();
+
+    if (stream.status() != QTextStream::Ok) {
+        throw db::Exception(
+            QString("Failed to write file `%1`: %2")
+                .arg(_filename)
+                .arg(file.errorString()));
+    }
+}
+
+bool DataExportTask::isFailed() const
+{
+    QMutexLocker locker(&_mutex);
+    return _failed;
+}
+
+void DataExportTask::abort()
+{
+    _isAborted = true;
+    QMutexLocker locker(&_mutex);
+    if (_query) {
+        // on server at once, else the rest rows would be read on release
+        _query->abortFetching();
+    }
+}
+
+QString DataExportTask::errorMessage() const
+{
+    QMutexLocker locker(&_mutex);
+    return _error.message();
+}
+
+} // namespace threads
+} // namespace meow
@@ -0,0 +1,71 @@
+#ifndef MEOW_THREADS_DATA_EXPORT_TASK_H
+#define MEOW_THREADS_DATA_EXPORT_TASK_H
+
+#include <atomic>
+#include <QMutex>
+#include "thread_task.h"
+#include "db/common.h"
+#include "db/exception.h"
+#include "db/query.h"
+#include "utils/exporting/query_data_export_formats/format.h"
+
+namespace meow {
+
+namespace db {
+class Connection;
+class Entity;
+}
+
+namespace threads {
+
+// Intent: runs query and writes its rows to file with export format portion
+// by portion as they are received, without any model and without keeping
+// all rows in memory
+class DataExportTask : public ThreadTask
+{
+    Q_OBJECT
+public:
+    DataExportTask(const QString & SQL,
+                   db::Entity * entity,
+                   db::Connection * connection);
+    void run() override;
+    bool isFailed() const override;
+    void abort(); // thread-safe, cancels running query on server
+    bool isAborted() const { return _isAborted; }
+    QString errorMessage() const;
+
+    void setFormat(const utils::exporting::QueryDataExportFormatPtr & format) {
+        _format = format;
+    }
+    void setFilename(const QString & filename) { _filename = filename; }
+    void setEncoding(const QString & encoding) { _encoding = encoding; }
+    // for formats that show count in header, rows count is unknown until
+    // all rows are read
+    void setRowsCountHint(db::ulonglong count) { _rowsCountHint = count; }
+
+    db::ulonglong exportedRowsCount() const { return _exportedRowsCount; }
+
+    Q_SIGNAL void rowsExported(qulonglong count);
+
+private:
+    void exportRows();
+
+    QString _SQL;
+    db::Entity * _entity;
+    db::Connection * _connection;
+    utils::exporting::QueryDataExportFormatPtr _format;
+    QString _filename;
+    QString _encoding;
+    db::ulonglong _rowsCountHint;
+    std::atomic<db::ulonglong> _exportedRowsCount;
+    db::QueryPtr _query; // running one, to abort it from other thread
+    db::Exception _error;
+    bool _failed;
+    std::atomic<bool> _isAborted;
+    mutable QMutex _mutex;
+};
+
+} // namespace threads
+} // namespace meow
+
+#endif // MEOW_THREADS_DATA_EXPORT_TASK_H
@@ -0,0 +1,87 @@
+#include "data_import_task.h"
+#include "db/connection.h"
+#include "utils/importing/csv_importer.h"
+#include "helpers/logger.h"
+
+namespace meow {
+namespace threads {
+
+DataImportTask::DataImportTask(utils::importing::CSVImporter * importer,
+                               db::Connection * connection)
+    : ThreadTask(TaskType::DataImport)
+    , _importer(importer)
+    , _connection(connection)
+    , _failed(false)
+    , _isAborted(false)
+{
+
+}
+
+void DataImportTask::run()
+{
+    if (_isAborted) { // cancelled while waiting for other tasks
+        emit finished();
+        return;
+    }
+
+    try {
+        importRows();
+    } catch(meow::db::Exception & ex) {
+        meowLogC(Log::Category::Error)
+            << "Failed to import data: " << ex.message();
+        try {
+            _importer->rollback();
+        } catch(meow::db::Exception & rollbackEx) {
+            meowLogC(Log::Category::Error)
+                << "Failed to rollback import: " << rollbackEx.message();
+        }
+        QMutexLocker locker(&_mutex);
+        _failed = true;
+        _error = ex;
+    }
+
+    emit finished();
+    if (isFailed()) {
+        emit failed();
+    }
+}
+
+void DataImportTask::importRows()
+{
+    _importer->start(_connection);
+
+    bool hasMore = true;
+    while (hasMore && !_isAborted) {
+        hasMore = _importer->importPortion();
+        emit rowsImported(_importer->importedRowsCount());
+        emit progress(_importer->progressPercent());
+    }
+
+    if (_isAborted) {
+        _importer->rollback(); // table stays untouched
+        return;
+    }
+
+    _importer->commit();
+    emit progress(100);
+}
+
+bool DataImportTask::isFailed() const
+{
+    QMutexLocker locker(&_mutex);
+    return _failed;
+}
+
+void DataImportTask::abort()
+{
+    _isAborted = true;
+}
+
+QString DataImportTask::errorMessage() const
+{
+    QMutexLocker locker(&_mutex);
+    return _error.message();
+}
+
+} // namespace threads
+} // namespace meow
@@ -0,0 +1,55 @@
+#ifndef MEOW_THREADS_DATA_IMPORT_TASK_H
+#define MEOW_THREADS_DATA_IMPORT_TASK_H
+
+#include <atomic>
+#include <QMutex>
+#include "thread_task.h"
+#include "db/common.h"
+#include "db/exception.h"
+
+namespace meow {
+
+namespace db {
+class Connection;
+}
+
+namespace utils {
+namespace importing {
+class CSVImporter;
+}
+}
+
+namespace threads {
+
+// Intent: loads rows of file into table with importer portion by portion,
+// all rows are committed at the end or none if import fails or is aborted
+class DataImportTask : public ThreadTask
+{
+    Q_OBJECT
+public:
+    DataImportTask(utils::importing::CSVImporter * importer,
+                   db::Connection * connection);
+    void run() override;
+    bool isFailed() const override;
+    void abort(); // thread-safe, stops on next portion of rows
+    bool isAborted() const { return _isAborted; }
+    QString errorMessage() const;
+
+    Q_SIGNAL void rowsImported(qulonglong count);
+    Q_SIGNAL void progress(int percent);
+
+private:
+    void importRows();
+
+    utils::importing::CSVImporter * _importer;
+    db::Connection * _connection;
+    db::Exception _error;
+    bool _failed;
+    std::atomic<bool> _isAborted;
+    mutable QMutex _mutex;
+};
+
+} // namespace threads
+} // namespace meow
+
+#endif // MEOW_THREADS_DATA_IMPORT_TASK_H
@@ -1,5 +1,8 @@
 #include "db_thread.h"
 #include "queries_task.h"
+#include "table_data_task.h"
+#include "data_export_task.h"
+#include "data_import_task.h"
 #include "helpers.h"
 #include "thread_init_task.h"
 #include <QTimer>
@@ -16,6 +19,7 @@ DbThread::DbThread(db::Connection * connection)
           ? new QThread
           : nullptr)
     , _initTask(nullptr)
+    , _runningTasks(0)
 {
 
     if (_thread) {
@@ -55,6 +59,39 @@ std::shared_ptr<QueriesTask> DbThread::createQueriesTask(
     return std::make_shared<QueriesTask>(queries, _connection);
 }
 
+std::shared_ptr<QueriesTask> DbThread::createScriptTask(const QString & script)
+{
+    return std::make_shared<QueriesTask>(script, _connection);
+}
+
+std::shared_ptr<QueriesTask> DbThread::createScriptFileTask(
+        const QString & filename)
+{
+    auto task = std::make_shared<QueriesTask>(QString(), _connection);
+    task->setScriptFilename(filename);
+    return task;
+}
+
+std::shared_ptr<TableDataTask> DbThread::createTableDataTask(
+        const QString & SQL,
+        db::Entity * entity)
+{
+    return std::make_shared<TableDataTask>(SQL, entity, _connection);
+}
+
+std::shared_ptr<DataExportTask> DbThread::createDataExportTask(
+        const QString & SQL,
+        db::Entity * entity)
+{
+    return std::make_shared<DataExportTask>(SQL, entity, _connection);
+}
+
+std::shared_ptr<DataImportTask> DbThread::createDataImportTask(
+        utils::importing::CSVImporter * importer)
+{
+    return std::make_shared<DataImportTask>(importer, _connection);
+}
+
 void DbThread::postTask(const std::shared_ptr<ThreadTask> &task)
 {
     MEOW_ASSERT_MAIN_THREAD
@@ -62,6 +99,11 @@ void DbThread::postTask(const std::shared_ptr<ThreadTask> &task)
     if (_thread) {
         _tasks.push_back(task); // own task ref to avoid external removal
         task->moveToThread(_thread);
+        ++_runningTasks;
+        // decrement in the task thread: holders may reuse the connection
+        // from their own finished slots before onTaskFinished() runs
+        connect(task.get(), &threads::ThreadTask::finished,
+                this, [this]() { --_runningTasks; }, Qt::DirectConnection);
         connect(task.get(), &threads::ThreadTask::finished,
                 this, &DbThread::onTaskFinished);
         QMetaObject::invokeMethod(task.get(), "run", Qt::QueuedConnection);
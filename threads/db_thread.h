@@ -5,6 +5,7 @@
 #include <QThread>
 #include <memory>
 #include <list>
+#include <atomic>
 
 namespace meow {
 
@@ -12,12 +13,22 @@ namespace db {
 
 using SQLBatch = QStringList;
 class Connection;
+class Entity;
 
 }
 
+namespace utils {
+namespace importing {
+class CSVImporter;
+}
+}
+
 namespace threads {
 
 class QueriesTask;
+class TableDataTask;
+class DataExportTask;
+class DataImportTask;
 class ThreadTask;
 
 // Intent: executes db tasks for connection
@@ -28,7 +39,18 @@ public:
     DbThread(db::Connection * connection);
     virtual ~DbThread() override;
     std::shared_ptr<QueriesTask> createQueriesTask(const db::SQLBatch & queries);
+    std::shared_ptr<QueriesTask> createScriptTask(const QString & script);
+    std::shared_ptr<QueriesTask> createScriptFileTask(const QString & filename);
+    std::shared_ptr<TableDataTask> createTableDataTask(const QString & SQL,
+                                                       db::Entity * entity);
+    std::shared_ptr<DataExportTask> createDataExportTask(const QString & SQL,
+                                                         db::Entity * entity);
+    std::shared_ptr<DataImportTask> createDataImportTask(
+            utils::importing::CSVImporter * importer);
     void postTask(const std::shared_ptr<ThreadTask> & task);
+    // true when no posted task is running or queued; a cancelled task
+    // counts until its run() returns
+    bool isIdle() const { return _runningTasks == 0; }
     void quit();
     void wait();
 private:
@@ -42,6 +64,7 @@ private:
     QThread * _thread;
     ThreadTask * _initTask;
     std::list<std::shared_ptr<ThreadTask>> _tasks;
+    std::atomic<int> _runningTasks;
 };
 
 } // namespace threads
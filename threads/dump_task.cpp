@@ -0,0 +1,41 @@
+#include "dump_task.h"
+#include "utils/exporting/mysql_dumper.h"
+
+namespace meow {
+namespace threads {
+
+DumpTask::DumpTask(utils::exporting::MySQLDumper * dumper,
+                   Step step,
+                   db::Connection * connection)
+    : ThreadTask(TaskType::Dump)
+    , _dumper(dumper)
+    , _step(step)
+    , _connection(connection)
+{
+
+}
+
+void DumpTask::run()
+{
+    switch (_step) {
+    case Step::Prepare:
+        _dumper->prepare(_connection);
+        break;
+    case Step::Work:
+        _dumper->runWorker(_connection);
+        break;
+    case Step::Finish:
+        _dumper->finish(_connection);
+        break;
+    }
+
+    emit finished();
+}
+
+bool DumpTask::isFailed() const
+{
+    return false; // errors are reported by dumper
+}
+
+} // namespace threads
+} // namespace meow
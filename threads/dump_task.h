@@ -0,0 +1,48 @@
+#ifndef MEOW_THREADS_DUMP_TASK_H
+#define MEOW_THREADS_DUMP_TASK_H
+
+#include "thread_task.h"
+
+namespace meow {
+
+namespace db {
+class Connection;
+}
+
+namespace utils {
+namespace exporting {
+class MySQLDumper;
+}
+}
+
+namespace threads {
+
+// Intent: runs one step of database dump in thread of a dump connection
+class DumpTask : public ThreadTask
+{
+    Q_OBJECT
+public:
+    enum class Step {
+        Prepare, // opens connections, takes snapshot and plans jobs
+        Work, // takes jobs until none left
+        Finish // writes the rest and releases locks
+    };
+
+    DumpTask(utils::exporting::MySQLDumper * dumper,
+             Step step,
+             db::Connection * connection);
+    void run() override;
+    bool isFailed() const override;
+
+    Step step() const { return _step; }
+
+private:
+    utils::exporting::MySQLDumper * _dumper;
+    Step _step;
+    db::Connection * _connection;
+};
+
+} // namespace threads
+} // namespace meow
+
+#endif // MEOW_THREADS_DUMP_TASK_H
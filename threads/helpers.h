@@ -17,4 +17,8 @@ static bool isCurrentThreadMain()
 
 #define MEOW_ASSERT_MAIN_THREAD Q_ASSERT(meow::threads::isCurrentThreadMain());
 
+// pooled connections are also opened and set up in their own threads
+#define MEOW_ASSERT_MAIN_THREAD_OR_POOLED(connection) \
+    Q_ASSERT((connection)->isPooled() || meow::threads::isCurrentThreadMain());
+
 #endif // MEOW_THREADS_HELPERS_H
@@ -1,4 +1,6 @@
 #include "queries_task.h"
+#include <QFile>
+#include "db/user_query/sentence_splitter.h"
 
 
 namespace meow {
@@ -7,10 +9,25 @@ namespace threads {
 QueriesTask::QueriesTask(const db::SQLBatch & queries, db::Connection * connection)
     : ThreadTask(TaskType::Query)
     , _queries(queries)
+    , _isScript(false)
     , _connection(connection)
 {
     connect(&_executor, &db::user_query::BatchExecutor::afterQueryExecution,
             this, &QueriesTask::queryFinished);
+    connect(&_executor, &db::user_query::BatchExecutor::afterRowsFetched,
+            this, &QueriesTask::queryRowsFetched);
+}
+
+QueriesTask::QueriesTask(const QString & script, db::Connection * connection)
+    : ThreadTask(TaskType::Query)
+    , _script(script)
+    , _isScript(true)
+    , _connection(connection)
+{
+    connect(&_executor, &db::user_query::BatchExecutor::afterQueryExecution,
+            this, &QueriesTask::queryFinished);
+    connect(&_executor, &db::user_query::BatchExecutor::afterRowsFetched,
+            this, &QueriesTask::queryRowsFetched);
 }
 
 QueriesTask::~QueriesTask()
@@ -20,7 +37,22 @@ QueriesTask::~QueriesTask()
 
 void QueriesTask::run()
 {
-    _executor.run(_connection, _queries);
+    if (_isScript && !_scriptFilename.isEmpty()) {
+        QFile file(_scriptFilename);
+        if (file.open(QFile::ReadOnly)) {
+            db::user_query::SentenceSplitter splitter(&file);
+            _executor.runScript(_connection, &splitter);
+        } else {
+            _fileError = QObject::tr("Unable to open file `%1`: %2")
+                    .arg(_scriptFilename)
+                    .arg(file.errorString());
+        }
+    } else if (_isScript) {
+        db::user_query::SentenceSplitter splitter(_script);
+        _executor.runScript(_connection, &splitter);
+    } else {
+        _executor.run(_connection, _queries);
+    }
     emit finished();
     if (isFailed()) {
         emit failed();
@@ -29,7 +61,7 @@ void QueriesTask::run()
 
 bool QueriesTask::isFailed() const
 {
-    return _executor.failed();
+    return !_fileError.isEmpty() || _executor.failed();
 }
 
 void QueriesTask::abort()
@@ -39,6 +71,9 @@ void QueriesTask::abort()
 
 QString QueriesTask::errorMessage() const
 {
+    if (!_fileError.isEmpty()) {
+        return _fileError;
+    }
     return _executor.error().message();
 }
 
@@ -92,5 +127,41 @@ std::chrono::milliseconds QueriesTask::networkDuration() const
     return _executor.networkDuration();
 }
 
+ParallelQueriesTask::ParallelQueriesTask(
+        const std::shared_ptr<QueriesTask> & queriesTask,
+        db::Connection * connection)
+    : ThreadTask(TaskType::Query)
+    , _queriesTask(queriesTask)
+    , _connection(connection)
+    , _isFinished(false)
+{
+
+}
+
+ParallelQueriesTask::~ParallelQueriesTask()
+{
+    finish(); // dropped with its thread, don't keep main task waiting
+}
+
+void ParallelQueriesTask::run()
+{
+    _queriesTask->runParallelWorker(_connection);
+    finish();
+    emit finished();
+}
+
+bool ParallelQueriesTask::isFailed() const
+{
+    return false; // errors are reported by main task
+}
+
+void ParallelQueriesTask::finish()
+{
+    if (!_isFinished) {
+        _isFinished = true;
+        _queriesTask->finishParallelWorker();
+    }
+}
+
 } // namespace threads
 } // namespace meow
@@ -1,6 +1,7 @@
 #ifndef MEOW_THREADS_QUERY_TASK_H
 #define MEOW_THREADS_QUERY_TASK_H
 
+#include <memory>
 #include <QStringList>
 #include "thread_task.h"
 #include "db/user_query/batch_executor.h"
@@ -22,10 +23,26 @@ class QueriesTask : public ThreadTask
     Q_OBJECT
 public:
     QueriesTask(const db::SQLBatch & queries, db::Connection * connection);
+    // Script is split into queries while running
+    QueriesTask(const QString & script, db::Connection * connection);
     ~QueriesTask() override;
     void run() override;
     bool isFailed() const override;
     void abort();
+    void setStreamResults(bool stream) { _executor.setStreamResults(stream); }
+    // Script is read from file instead, see SentenceSplitter(QIODevice *)
+    void setScriptFilename(const QString & filename) {
+        _scriptFilename = filename;
+    }
+    void setParallelConnections(const QList<db::Connection *> & connections) {
+        _executor.setParallelConnections(connections);
+    }
+    void runParallelWorker(db::Connection * connection) {
+        _executor.runParallelWorker(connection);
+    }
+    void finishParallelWorker() {
+        _executor.finishParallelWorker();
+    }
     QString errorMessage() const;
 
     int currentResultsCount() const;
@@ -43,13 +60,37 @@ public:
     std::chrono::milliseconds networkDuration() const;
 
     Q_SIGNAL void queryFinished(int queryIndex, int totalCount);
+    Q_SIGNAL void queryRowsFetched(int queryIndex);
 
 private:
     db::SQLBatch _queries;
+    QString _script;
+    QString _scriptFilename;
+    QString _fileError;
+    bool _isScript;
     db::Connection * _connection;
     db::user_query::BatchExecutor _executor;
 };
 
+// Intent: runs queries of QueriesTask in thread of a parallel connection
+class ParallelQueriesTask : public ThreadTask
+{
+    Q_OBJECT
+public:
+    ParallelQueriesTask(const std::shared_ptr<QueriesTask> & queriesTask,
+                        db::Connection * connection);
+    ~ParallelQueriesTask() override;
+    void run() override;
+    bool isFailed() const override;
+
+private:
+    void finish();
+
+    std::shared_ptr<QueriesTask> _queriesTask;
+    db::Connection * _connection;
+    bool _isFinished;
+};
+
 
 } // namespace threads
 } // namespace meow
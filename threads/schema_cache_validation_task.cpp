@@ -0,0 +1,64 @@
+#include "schema_cache_validation_task.h"
+#include "db/connection.h"
+#include "helpers/logger.h"
+
+namespace meow {
+namespace threads {
+
+SchemaCacheValidationTask::SchemaCacheValidationTask(
+        const QMap<QString, QString> & databases,
+        db::Connection * connection,
+        bool fetchOutdated)
+    : ThreadTask(TaskType::SchemaCacheValidation)
+    , _databases(databases)
+    , _connection(connection)
+    , _fetchOutdated(fetchOutdated)
+    , _isAborted(false)
+{
+
+}
+
+void SchemaCacheValidationTask::run()
+{
+    for (auto it = _databases.cbegin(); it != _databases.cend(); ++it) {
+        if (_isAborted) {
+            break;
+        }
+
+        const QString & database = it.key();
+        try {
+            // before entities, so any change in between makes it outdated
+            QString fingerprint = _connection->schemaFingerprint(database);
+            _fingerprints.insert(database, fingerprint);
+
+            if (it.value().isEmpty() // entities were fetched just now
+                    || (!fingerprint.isEmpty() && fingerprint == it.value())
+                    || !_fetchOutdated) {
+                continue;
+            }
+
+            meowLogCC(Log::Category::Info, _connection)
+                << "Cached entities of " << database << " are outdated";
+
+            db::SchemaCache::DatabaseRecord record;
+            record.fingerprint = fingerprint;
+            record.entities = db::SchemaCache::toRecords(
+                _connection->getDbEntities(database, true));
+            _outdated.insert(database, record);
+        } catch(meow::db::Exception & ex) {
+            meowLogCC(Log::Category::Error, _connection)
+                << "Failed to check cached entities of " << database
+                << ": " << ex.message();
+        }
+    }
+
+    emit finished();
+}
+
+void SchemaCacheValidationTask::abort()
+{
+    _isAborted = true;
+}
+
+} // namespace threads
+} // namespace meow
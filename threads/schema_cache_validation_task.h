@@ -0,0 +1,56 @@
+#ifndef MEOW_THREADS_SCHEMA_CACHE_VALIDATION_TASK_H
+#define MEOW_THREADS_SCHEMA_CACHE_VALIDATION_TASK_H
+
+#include <atomic>
+#include <QMap>
+#include <QString>
+#include "thread_task.h"
+#include "db/schema_cache.h"
+
+namespace meow {
+
+namespace db {
+class Connection;
+}
+
+namespace threads {
+
+// Intent: reads fingerprints of databases, compares them with cached ones
+// and fetches entities of changed databases again if fetchOutdated.
+// Fetching uses own caches of connection, so connection should be a pooled
+// one then.
+class SchemaCacheValidationTask : public ThreadTask
+{
+    Q_OBJECT
+public:
+    // databases: name : cached fingerprint, empty if only fresh one is needed
+    SchemaCacheValidationTask(const QMap<QString, QString> & databases,
+                              db::Connection * connection,
+                              bool fetchOutdated);
+    void run() override;
+    bool isFailed() const override { return false; } // errors are logged
+    void abort(); // thread-safe, stops on next database
+
+    const QMap<QString, QString> & databases() const { return _databases; }
+    // name : fresh fingerprint (empty if failed), read after finished()
+    const QMap<QString, QString> & fingerprints() const {
+        return _fingerprints;
+    }
+    // Fresh data of changed databases, read after finished()
+    const QMap<QString, db::SchemaCache::DatabaseRecord> & outdated() const {
+        return _outdated;
+    }
+
+private:
+    QMap<QString, QString> _databases;
+    QMap<QString, QString> _fingerprints;
+    QMap<QString, db::SchemaCache::DatabaseRecord> _outdated;
+    db::Connection * _connection;
+    const bool _fetchOutdated;
+    std::atomic<bool> _isAborted;
+};
+
+} // namespace threads
+} // namespace meow
+
+#endif // MEOW_THREADS_SCHEMA_CACHE_VALIDATION_TASK_H
@@ -0,0 +1,101 @@
+#include "table_data_task.h"
+#include "db/connection.h"
+#include "helpers/logger.h"
+
+namespace meow {
+namespace threads {
+
+TableDataTask::TableDataTask(const QString & SQL,
+                             db::Entity * entity,
+                             db::Connection * connection)
+    : ThreadTask(TaskType::TableData)
+    , _SQL(SQL)
+    , _entity(entity)
+    , _connection(connection)
+    , _failed(false)
+    , _streamResults(false)
+    , _isAborted(false)
+    , _isExecuting(false)
+{
+
+}
+
+void TableDataTask::run()
+{
+    if (_isAborted) { // cancelled while waiting for other tasks
+        emit finished();
+        return;
+    }
+
+    db::QueryPtr query = _connection->createQuery();
+    query->setSQL(_SQL);
+    query->setEntity(_entity);
+    query->setStreamed(_streamResults);
+
+    try {
+        _isExecuting = true;
+        query->execute();
+        _isExecuting = false;
+
+        if (query->isFetching()) {
+            // first portion is shown while the rest is being received
+            query->fetchMore(db::DATA_ROWS_PER_STEP);
+        }
+
+        {
+            QMutexLocker locker(&_mutex);
+            _query = query;
+        }
+
+        emit queryExecuted();
+
+        while (query->isFetching()) {
+            if (_isAborted) {
+                query->abortFetching();
+            }
+            if (query->fetchMore(db::DATA_ROWS_PER_STEP) > 0) {
+                emit rowsReceived();
+            }
+        }
+    } catch(meow::db::Exception & ex) {
+        _isExecuting = false;
+        if (!_isAborted) {
+            meowLogC(Log::Category::Error)
+                << "Failed to load table data: " << ex.message();
+        }
+        QMutexLocker locker(&_mutex);
+        _failed = true;
+        _error = ex;
+    }
+
+    emit finished();
+    if (isFailed()) {
+        emit failed();
+    }
+}
+
+bool TableDataTask::isFailed() const
+{
+    QMutexLocker locker(&_mutex);
+    return _failed;
+}
+
+void TableDataTask::abort()
+{
+    _isAborted = true;
+}
+
+QString TableDataTask::errorMessage() const
+{
+    QMutexLocker locker(&_mutex);
+    return _error.message();
+}
+
+db::QueryPtr TableDataTask::query() const
+{
+    QMutexLocker locker(&_mutex);
+    return _query;
+}
+
+} // namespace threads
+} // namespace meow
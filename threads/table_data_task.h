@@ -0,0 +1,61 @@
+#ifndef MEOW_THREADS_TABLE_DATA_TASK_H
+#define MEOW_THREADS_TABLE_DATA_TASK_H
+
+#include <atomic>
+#include <QMutex>
+#include "thread_task.h"
+#include "db/query.h"
+#include "db/exception.h"
+
+namespace meow {
+
+namespace db {
+class Connection;
+class Entity;
+}
+
+namespace threads {
+
+// Intent: loads rows of table/view data page, reports columns and first rows
+// as soon as query is executed and the rest as they are received
+class TableDataTask : public ThreadTask
+{
+    Q_OBJECT
+public:
+    TableDataTask(const QString & SQL,
+                  db::Entity * entity,
+                  db::Connection * connection);
+    void run() override;
+    bool isFailed() const override;
+    void abort(); // thread-safe, running query should be killed outside
+    bool isAborted() const { return _isAborted; }
+    // true while query runs on server and only killing can stop it
+    bool isExecuting() const { return _isExecuting; }
+    void setStreamResults(bool stream) { _streamResults = stream; }
+    QString errorMessage() const;
+
+    db::Connection * connection() const { return _connection; }
+
+    // available after queryExecuted()
+    db::QueryPtr query() const;
+
+    Q_SIGNAL void queryExecuted();
+    Q_SIGNAL void rowsReceived();
+
+private:
+    QString _SQL;
+    db::Entity * _entity;
+    db::Connection * _connection;
+    db::QueryPtr _query;
+    db::Exception _error;
+    bool _failed;
+    bool _streamResults;
+    std::atomic<bool> _isAborted;
+    std::atomic<bool> _isExecuting;
+    mutable QMutex _mutex;
+};
+
+} // namespace threads
+} // namespace meow
+
+#endif // MEOW_THREADS_TABLE_DATA_TASK_H
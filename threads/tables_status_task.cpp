@@ -0,0 +1,62 @@
+#include "tables_status_task.h"
+#include "db/connection.h"
+#include "helpers/logger.h"
+
+namespace meow {
+namespace threads {
+
+TablesStatusTask::TablesStatusTask(const QString & database,
+                                   const QStringList & tables,
+                                   db::Connection * connection)
+    : ThreadTask(TaskType::TablesStatus)
+    , _database(database)
+    , _tables(tables)
+    , _connection(connection)
+    , _isAborted(false)
+{
+
+}
+
+void TablesStatusTask::run()
+{
+    for (int i = 0; i < _tables.size(); i += db::TABLES_STATUS_PER_BATCH) {
+        if (_isAborted) {
+            break;
+        }
+
+        QList<db::TableStatus> status;
+        try {
+            status = _connection->fetchTablesStatus(
+                _database, _tables.mid(i, db::TABLES_STATUS_PER_BATCH));
+        } catch(meow::db::Exception & ex) {
+            meowLogCC(Log::Category::Error, _connection)
+                << "Failed to fetch tables status of " << _database
+                << ": " << ex.message();
+            break;
+        }
+
+        {
+            QMutexLocker locker(&_mutex);
+            _fetched.append(status);
+        }
+        emit batchFetched();
+    }
+
+    emit finished();
+}
+
+void TablesStatusTask::abort()
+{
+    _isAborted = true;
+}
+
+QList<db::TableStatus> TablesStatusTask::takeFetched()
+{
+    QMutexLocker locker(&_mutex);
+    QList<db::TableStatus> fetched;
+    fetched.swap(_fetched);
+    return fetched;
+}
+
+} // namespace threads
+} // namespace meow
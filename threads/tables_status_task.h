@@ -0,0 +1,51 @@
+#ifndef MEOW_THREADS_TABLES_STATUS_TASK_H
+#define MEOW_THREADS_TABLES_STATUS_TASK_H
+
+#include <atomic>
+#include <QList>
+#include <QMutex>
+#include <QStringList>
+#include "thread_task.h"
+#include "db/entity/table_entity.h"
+
+namespace meow {
+
+namespace db {
+class Connection;
+}
+
+namespace threads {
+
+// Intent: fetches stats of tables listed without them by batches, so first
+// of them are shown soon even if server computes stats slowly
+class TablesStatusTask : public ThreadTask
+{
+    Q_OBJECT
+public:
+    TablesStatusTask(const QString & database,
+                     const QStringList & tables,
+                     db::Connection * connection);
+    void run() override;
+    bool isFailed() const override { return false; } // errors are logged
+    void abort(); // thread-safe, stops on next batch
+
+    const QString & database() const { return _database; }
+
+    // Thread-safe, returns status fetched since previous call
+    QList<db::TableStatus> takeFetched();
+
+    Q_SIGNAL void batchFetched();
+
+private:
+    QString _database;
+    QStringList _tables;
+    db::Connection * _connection;
+    QList<db::TableStatus> _fetched;
+    std::atomic<bool> _isAborted;
+    QMutex _mutex;
+};
+
+} // namespace threads
+} // namespace meow
+
+#endif // MEOW_THREADS_TABLES_STATUS_TASK_H
@@ -9,6 +9,14 @@ namespace threads {
 enum class TaskType
 {
     Query,
+    TableData,
+    DataExport,
+    DataImport,
+    CompletionIndex,
+    SchemaCacheValidation,
+    TablesStatus,
+    ConnectionOpen,
+    Dump,
     InitDBThread
 };
 
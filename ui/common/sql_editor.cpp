@@ -2,6 +2,10 @@
 #include <QtWidgets>
 #include <QFontDatabase>
 #include "sql_syntax_highlighter.h"
+#include "sql_keywords.h"
+#include "app/app.h"
+#include "db/completion_index.h"
+#include "db/connections_manager.h"
 
 namespace meow {
 namespace ui {
@@ -154,10 +158,194 @@ void TextEditor::lineNumberAreaPaintEvent(QPaintEvent *event)
 
 SQLEditor::SQLEditor(QWidget *parent)
     : TextEditor(parent, SyntaxHighligter::SQL)
+    , _completer(nullptr)
+    , _completionModel(nullptr)
+    , _completionWordLength(0)
 {
 
 }
 
+void SQLEditor::setAutocompletionEnabled(bool enabled)
+{
+    if (enabled == (_completer != nullptr)) {
+        return;
+    }
+
+    if (!enabled) {
+        delete _completer;
+        _completer = nullptr;
+        _completionModel = nullptr; // owned by completer
+        return;
+    }
+
+    _completer = new QCompleter(this);
+    _completionModel = new QStringListModel(_completer);
+    _completer->setModel(_completionModel);
+    _completer->setWidget(this);
+    // suggestions are already matched by index
+    _completer->setCompletionMode(QCompleter::UnfilteredPopupCompletion);
+    _completer->setCaseSensitivity(Qt::CaseInsensitive);
+
+    connect(_completer,
+            static_cast<void (QCompleter::*)(const QString &)>(
+                &QCompleter::activated),
+            this,
+            &SQLEditor::insertCompletion);
+}
+
+void SQLEditor::keyPressEvent(QKeyEvent * event)
+{
+    if (_completer && _completer->popup()->isVisible()) {
+        switch (event->key()) {
+        case Qt::Key_Enter:
+        case Qt::Key_Return:
+        case Qt::Key_Escape:
+        case Qt::Key_Tab:
+        case Qt::Key_Backtab:
+            event->ignore(); // popup handles them
+            return;
+        default:
+            break;
+        }
+    }
+
+    bool isShortcut = (event->modifiers() & Qt::ControlModifier)
+            && event->key() == Qt::Key_Space;
+
+    if (!isShortcut) {
+        TextEditor::keyPressEvent(event);
+    }
+
+    if (!_completer || isReadOnly()) {
+        return;
+    }
+
+    // only typing changes the word, not moving cursor or other shortcuts
+    bool isTyped = !event->text().isEmpty()
+            && event->text().at(0).isPrint()
+            && !(event->modifiers() & (Qt::ControlModifier | Qt::AltModifier));
+    bool isErased = event->key() == Qt::Key_Backspace;
+
+    if (!isShortcut && !isTyped && !isErased) {
+        switch (event->key()) {
+        case Qt::Key_Shift:
+        case Qt::Key_Control:
+        case Qt::Key_Alt:
+        case Qt::Key_Meta:
+            break; // may be start of next key
+        default:
+            _completer->popup()->hide(); // cursor left the word
+            break;
+        }
+        return;
+    }
+
+    updateCompletion(isShortcut, event->text() == QLatin1String("."));
+}
+
+void SQLEditor::updateCompletion(bool force, bool afterDot)
+{
+    QString parent;
+    QString word = wordBeforeCursor(&parent);
+
+    bool show = force
+            || word.length() >= 2
+            || (afterDot && !parent.isEmpty());
+
+    QStringList completions;
+    if (show) {
+        completions = completionsFor(word, parent);
+    }
+
+    if (completions.isEmpty()) {
+        _completer->popup()->hide();
+        return;
+    }
+
+    _completionWordLength = word.length();
+    _completionModel->setStringList(completions);
+    _completer->popup()->setCurrentIndex(_completionModel->index(0, 0));
+
+    QRect rect = cursorRect();
+    rect.setWidth(_completer->popup()->sizeHintForColumn(0)
+                  + _completer->popup()->verticalScrollBar()->sizeHint().width());
+    _completer->complete(rect);
+}
+
+void SQLEditor::insertCompletion(const QString & completion)
+{
+    QTextCursor cursor = textCursor();
+    cursor.movePosition(QTextCursor::Left,
+                        QTextCursor::KeepAnchor,
+                        _completionWordLength);
+    cursor.insertText(completion);
+    setTextCursor(cursor);
+}
+
+QString SQLEditor::wordBeforeCursor(QString * parent) const
+{
+    auto isWordChar = [](const QChar & c) {
+        return c.isLetterOrNumber() || c == QLatin1Char('_')
+                || c == QLatin1Char('$');
+    };
+
+    QTextCursor cursor = textCursor();
+    const QString text = cursor.block().text();
+    int end = cursor.positionInBlock();
+
+    int start = end;
+    while (start > 0 && isWordChar(text.at(start - 1))) {
+        --start;
+    }
+
+    // `parent`.word or parent.word
+    if (start > 0 && text.at(start - 1) == QLatin1Char('.')) {
+        int parentEnd = start - 1;
+        int parentStart = parentEnd;
+        if (parentEnd > 0 && text.at(parentEnd - 1) == QLatin1Char('`')) {
+            --parentEnd;
+            parentStart = text.lastIndexOf(QLatin1Char('`'), parentEnd - 1) + 1;
+            if (parentStart == 0) { // no opening quote
+                parentStart = parentEnd;
+            }
+        } else {
+            while (parentStart > 0 && isWordChar(text.at(parentStart - 1))) {
+                --parentStart;
+            }
+        }
+        *parent = text.mid(parentStart, parentEnd - parentStart);
+    }
+
+    return text.mid(start, end - start);
+}
+
+QStringList SQLEditor::completionsFor(const QString & word,
+                                      const QString & parent) const
+{
+    QStringList completions;
+
+    db::Connection * connection
+        = meow::app()->dbConnectionsManager()->activeConnection();
+
+    if (connection && connection->active()) {
+        std::shared_ptr<db::CompletionIndex> index
+            = connection->completionIndex();
+        for (const db::CompletionIndex::Item & item
+             : index->complete(word, parent)) {
+            completions << item.name;
+        }
+    }
+
+    if (parent.isEmpty() && !word.isEmpty()) {
+        completions << SQLKeywords::instance().startingWith(
+                           word, db::COMPLETION_MAX_SUGGESTIONS);
+    }
+
+    completions.removeDuplicates(); // e.g. table and column of same name
+
+    return completions;
+}
+
 } // namespace common
 } // namespace ui
 } // namespace meow
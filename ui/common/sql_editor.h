@@ -12,6 +12,9 @@ class QPaintEvent;
 class QResizeEvent;
 class QSize;
 class QWidget;
+class QCompleter;
+class QKeyEvent;
+class QStringListModel;
 
 namespace meow {
 namespace ui {
@@ -52,9 +55,31 @@ private:
 
 class SQLEditor : public TextEditor
 {
+    Q_OBJECT
+
 public:
     explicit SQLEditor(QWidget * parent = nullptr);
 
+    // Suggests names of active session and keywords while typing,
+    // Ctrl+Space shows suggestions at once
+    void setAutocompletionEnabled(bool enabled);
+
+protected:
+    void keyPressEvent(QKeyEvent * event) override;
+
+private:
+    void updateCompletion(bool force, bool afterDot);
+    void insertCompletion(const QString & completion);
+
+    // Word before cursor, parent is set for qualified name: parent.wo|
+    QString wordBeforeCursor(QString * parent) const;
+
+    QStringList completionsFor(const QString & word,
+                               const QString & parent) const;
+
+    QCompleter * _completer;
+    QStringListModel * _completionModel;
+    int _completionWordLength;
 };
 
 class LineNumberArea : public QWidget
@@ -0,0 +1,97 @@
+#include "sql_keywords.h"
+#include <algorithm>
+#include "mysql_syntax.h"
+
+namespace meow {
+namespace ui {
+namespace common {
+
+const SQLKeywords & SQLKeywords::instance()
+{
+    static const SQLKeywords keywords;
+    return keywords;
+}
+
+SQLKeywords::SQLKeywords()
+    : _maxLength(0)
+{
+    QStringList reservedKeywords = meow::db::common::mySqlReservedKeywords();
+    QStringList boolLiterals = meow::db::common::mySqlBoolLiterals();
+
+    for (const QString & word : boolLiterals) {
+        reservedKeywords.removeOne(word);
+    }
+
+    _entries.reserve(
+        static_cast<std::size_t>(reservedKeywords.size() + boolLiterals.size()));
+
+    for (const QString & word : reservedKeywords) {
+        _entries.push_back({word, SQLWordType::ReservedKeyword});
+    }
+    for (const QString & word : boolLiterals) {
+        _entries.push_back({word, SQLWordType::BoolLiteral});
+    }
+
+    // same order as in lookup, '_' goes differently in upper and lower case
+    std::sort(_entries.begin(), _entries.end(),
+              [](const Entry & a, const Entry & b) {
+        return QString::compare(a.word, b.word, Qt::CaseInsensitive) < 0;
+    });
+
+    for (const Entry & entry : _entries) {
+        _maxLength = std::max(_maxLength, entry.word.length());
+    }
+}
+
+SQLWordType SQLKeywords::typeOf(const QStringRef & word) const
+{
+    if (word.isEmpty() || word.length() > _maxLength) {
+        return SQLWordType::None;
+    }
+
+    auto it = std::lower_bound(_entries.begin(), _entries.end(), word,
+                               [](const Entry & entry, const QStringRef & word) {
+        return word.compare(entry.word, Qt::CaseInsensitive) > 0;
+    });
+
+    if (it != _entries.end()
+            && word.compare(it->word, Qt::CaseInsensitive) == 0) {
+        return it->type;
+    }
+    return SQLWordType::None;
+}
+
+QStringList SQLKeywords::words() const
+{
+    QStringList list;
+    list.reserve(static_cast<int>(_entries.size()));
+    for (const Entry & entry : _entries) {
+        list << entry.word;
+    }
+    return list;
+}
+
+QStringList SQLKeywords::startingWith(const QString & prefix, int limit) const
+{
+    QStringList list;
+    if (prefix.length() > _maxLength) {
+        return list;
+    }
+
+    auto it = std::lower_bound(_entries.begin(), _entries.end(), prefix,
+                               [](const Entry & entry, const QString & prefix) {
+        return QString::compare(entry.word, prefix, Qt::CaseInsensitive) < 0;
+    });
+
+    for (; it != _entries.end() && list.size() < limit; ++it) {
+        if (!it->word.startsWith(prefix, Qt::CaseInsensitive)) {
+            break;
+        }
+        list << it->word;
+    }
+    return list;
+}
+
+} // namespace common
+} // namespace ui
+} // namespace meow
@@ -0,0 +1,52 @@
+#ifndef UI_COMMON_SQL_KEYWORDS_H
+#define UI_COMMON_SQL_KEYWORDS_H
+
+#include <vector>
+#include <QString>
+#include <QStringList>
+#include <QStringRef>
+
+namespace meow {
+namespace ui {
+namespace common {
+
+enum class SQLWordType {
+    None = 0,
+    ReservedKeyword,
+    BoolLiteral // TRUE, FALSE, NULL
+};
+
+// Intent: shared table of SQL keywords sorted once per process for
+// lookups without allocations (words come from mysql_syntax.h)
+class SQLKeywords
+{
+public:
+    static const SQLKeywords & instance();
+
+    // Case-insensitive
+    SQLWordType typeOf(const QStringRef & word) const;
+
+    // All words in upper case, sorted case-insensitively
+    QStringList words() const;
+
+    // Words starting with prefix (case-insensitive) in sorted order
+    QStringList startingWith(const QString & prefix, int limit) const;
+
+private:
+    SQLKeywords();
+
+    struct Entry
+    {
+        QString word;
+        SQLWordType type;
+    };
+
+    std::vector<Entry> _entries;
+    int _maxLength;
+};
+
+} // namespace common
+} // namespace ui
+} // namespace meow
+
+#endif // UI_COMMON_SQL_KEYWORDS_H
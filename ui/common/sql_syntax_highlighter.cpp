@@ -1,5 +1,5 @@
 #include "sql_syntax_highlighter.h"
-#include "mysql_syntax.h"
+#include "sql_keywords.h"
 #include "db/user_query/sentences_parser.h"
 #include <QGuiApplication>
 #include <QPalette>
@@ -29,45 +29,6 @@ SQLSyntaxHighlighter::SQLSyntaxHighlighter(QTextDocument * parent)
     _numericFormat.setForeground(
         isLightTheme ? QColor(153, 0, 85) : QColor(201, 115, 115));
     _functionFormat.setForeground(QColor(221, 74, 104));
-
-    addKeywordsRules();
-}
-
-void SQLSyntaxHighlighter::addKeywordsRules()
-{
-
-    QStringList reservedKeywords = meow::db::common::mySqlReservedKeywords();
-    QStringList boolLiterals = meow::db::common::mySqlBoolLiterals();
-
-    for (const QString &word : boolLiterals) {
-        reservedKeywords.removeOne(word);
-    }
-
-    appendKeywords(reservedKeywords, _reservedKeywordFormat);
-    appendKeywords(boolLiterals,     _boolLiteralsFormat);
-
-    //TODO: this is stupid but better than nothing
-    QString floatPattern(R"([-+]?[0-9]*\.?[0-9]+([eE][-+]?[0-9]+)?)");
-    HighlightingRule rule;
-    rule.pattern = QRegularExpression(QString(R"(\b%1\b)").arg(floatPattern));
-    rule.format = _numericFormat;
-
-    _keywordsRules.append(rule);
-}
-
-void SQLSyntaxHighlighter::appendKeywords(
-    const QStringList & words,
-    const QTextCharFormat & format)
-{
-    HighlightingRule rule;
-
-    for (const QString &keyword : words) {
-        QString pattern = QString(R"(\b%1\b)").arg(keyword);
-        rule.pattern = QRegularExpression
-                (pattern, QRegularExpression::CaseInsensitiveOption);
-        rule.format = format;
-        _keywordsRules.append(rule);
-    }
 }
 
 void SQLSyntaxHighlighter::highlightBlock(const QString &text)
@@ -91,30 +52,11 @@ void SQLSyntaxHighlighter::highlightBlock(const QString &text)
 
         switch (token->type) {
 
-        case uq::SentenceTokenType::Text: {
-
-            QString tokenText = text.mid(token->startIndex, token->len);
-
-            for (const HighlightingRule &rule : _keywordsRules) {
-                QRegularExpressionMatchIterator matchIterator =
-                        rule.pattern.globalMatch(tokenText);
-
-                while (matchIterator.hasNext()) {
-
-                    QRegularExpressionMatch match = matchIterator.next();
-
-                    //if (isQuotedId(tokenText, match)) {
-                    //    continue;
-                    //}
-
-                    setFormat(
-                                match.capturedStart() + token->startIndex,
-                                match.capturedLength(),
-                                rule.format);
-                }
-            }
+        case uq::SentenceTokenType::Text:
+            highlightWords(text,
+                           token->startIndex,
+                           token->startIndex + token->len);
             break;
-        }
 
         case uq::SentenceTokenType::SingleLineComment:
             setFormat(
@@ -153,24 +95,86 @@ void SQLSyntaxHighlighter::highlightBlock(const QString &text)
     }
 }
 
-bool SQLSyntaxHighlighter::isQuotedId( // rm
-        const QString & text,
-        const QRegularExpressionMatch & match) const
+void SQLSyntaxHighlighter::highlightWords(const QString & text,
+                                          int start,
+                                          int end)
 {
-    int startIndex = match.capturedStart();
-    int endIndex = match.capturedEnd();
-
-    if (startIndex > 0) {
-        if (text.at(startIndex-1) == QChar('.')) {
-            return true;
-        } else if (text.at(startIndex-1) == QChar('`')) {
-            if (endIndex < text.length()) {
-                return text.at(endIndex) == QChar('`');
+    const SQLKeywords & keywords = SQLKeywords::instance();
+
+    int i = start;
+    while (i < end) {
+
+        QChar c = text.at(i);
+        bool afterWord = (i > start) && isWordChar(text.at(i - 1));
+
+        if (!afterWord && (c.isDigit()
+                || (c == QLatin1Char('.') && i + 1 < end
+                    && text.at(i + 1).isDigit()))) {
+            int numberEnd = skipNumber(text, i, end);
+            if (numberEnd == end || !isWordChar(text.at(numberEnd))) {
+                setFormat(i, numberEnd - i, _numericFormat);
+                i = numberEnd;
+                continue;
             }
         }
+
+        if (!isWordChar(c)) {
+            ++i;
+            continue;
+        }
+
+        int wordStart = i;
+        while (i < end && isWordChar(text.at(i))) {
+            ++i;
+        }
+
+        switch (keywords.typeOf(QStringRef(&text, wordStart, i - wordStart))) {
+        case SQLWordType::ReservedKeyword:
+            setFormat(wordStart, i - wordStart, _reservedKeywordFormat);
+            break;
+        case SQLWordType::BoolLiteral:
+            setFormat(wordStart, i - wordStart, _boolLiteralsFormat);
+            break;
+        default:
+            break;
+        }
     }
+}
 
-    return false;
+bool SQLSyntaxHighlighter::isWordChar(const QChar & c)
+{
+    return c.isLetterOrNumber() || c == QLatin1Char('_');
+}
+
+int SQLSyntaxHighlighter::skipNumber(const QString & text, int start, int end)
+{
+    // 12, 1.5, .5, 1e10, 1.5E-3
+    int i = start;
+    while (i < end && text.at(i).isDigit()) {
+        ++i;
+    }
+    if (i + 1 < end && text.at(i) == QLatin1Char('.')
+            && text.at(i + 1).isDigit()) {
+        ++i;
+        while (i < end && text.at(i).isDigit()) {
+            ++i;
+        }
+    }
+    if (i < end && (text.at(i) == QLatin1Char('e')
+                    || text.at(i) == QLatin1Char('E'))) {
+        int exponent = i + 1;
+        if (exponent < end && (text.at(exponent) == QLatin1Char('-')
+                               || text.at(exponent) == QLatin1Char('+'))) {
+            ++exponent;
+        }
+        if (exponent < end && text.at(exponent).isDigit()) {
+            i = exponent;
+            while (i < end && text.at(i).isDigit()) {
+                ++i;
+            }
+        }
+    }
+    return i;
 }
 
 } // namespace common
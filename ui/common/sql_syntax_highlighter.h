@@ -5,7 +5,6 @@
 
 #include <QSyntaxHighlighter>
 #include <QTextCharFormat>
-#include <QRegularExpression>
 
 class QTextDocument;
 
@@ -24,21 +23,11 @@ protected:
 
 private:
 
-    void addKeywordsRules();
-    void createSingleLineCommentRules();
+    // Formats numbers and keywords of text outside of strings and comments
+    void highlightWords(const QString & text, int start, int end);
 
-    bool isQuotedId(const QString &text,
-                    const QRegularExpressionMatch & match) const;
-
-    void appendKeywords(const QStringList & words,
-                        const QTextCharFormat & format);
-
-    struct HighlightingRule
-    {
-        QRegularExpression pattern;
-        QTextCharFormat format;
-    };
-    QVector<HighlightingRule> _keywordsRules;
+    static bool isWordChar(const QChar & c);
+    static int skipNumber(const QString & text, int start, int end);
 
     QTextCharFormat _singleLineCommentFormat;
     QTextCharFormat _quotationFormat;
@@ -22,7 +22,7 @@ TopWidget::TopWidget(presenters::ExportDatabaseForm *form, QWidget *parent)
             { _triggersDropCheckbox,            Option::AddDropTrigger },
             { _routinesCreateCheckbox,          Option::Routines },
             { _eventsCreateCheckbox,            Option::Events },
-            { _disableColumnStatisticsCheckbox, Option::NoColumnStatistics}
+            { _filePerTableCheckbox,            Option::FilePerTable }
     };
 
     connect(_form, &presenters::ExportDatabaseForm::optionsChanged,
@@ -174,13 +174,13 @@ void TopWidget::createWidgets()
 
     // -------------------------------------------------------------------------
 
-    _disableColumnStatisticsCheckbox = new QCheckBox(
-                tr("Disable column statistics (mysqldump v8+)"));
+    _filePerTableCheckbox = new QCheckBox(
+                tr("One file per table (in directory named as file)"));
 
-    connect(_disableColumnStatisticsCheckbox, &QCheckBox::stateChanged,
+    connect(_filePerTableCheckbox, &QCheckBox::stateChanged,
             this, &TopWidget::onOptionsCheckboxChanged);
 
-    _mainGridLayout->addWidget(_disableColumnStatisticsCheckbox, row, 0, 1, 2);
+    _mainGridLayout->addWidget(_filePerTableCheckbox, row, 0, 1, 2);
 
     row++;
 
@@ -204,7 +204,7 @@ void TopWidget::fillDataFromForm()
 {
 
     clearResults();
-    appendToResults(_form->currentCommand());
+    appendToResults(_form->exportSummary());
 
     if (_filenameEdit->text() != _form->filename()) {
         _filenameEdit->blockSignals(true);
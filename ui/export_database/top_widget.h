@@ -57,7 +57,7 @@ private:
     QCheckBox * _routinesCreateCheckbox;
     QCheckBox * _eventsCreateCheckbox;
 
-    QCheckBox * _disableColumnStatisticsCheckbox;
+    QCheckBox * _filePerTableCheckbox;
 
     QPlainTextEdit * _results;
 
@@ -3,6 +3,7 @@
 #include "output_format_widget.h"
 #include "row_selection_widget.h"
 #include "options_widget.h"
+#include "helpers/formatting.h"
 
 namespace meow {
 namespace ui {
@@ -74,10 +75,26 @@ void Dialog::createWidgets()
 
 void Dialog::onAccept()
 {
+    // rows are written in background, long exports can be cancelled
+    QProgressDialog progress(tr("Exporting rows..."), tr("Cancel"), 0, 0, this);
+    progress.setWindowModality(Qt::WindowModal);
+    progress.setMinimumDuration(500);
+
+    connect(&_presenter, &ui::presenters::ExportQueryPresenter::rowsExported,
+            &progress, [&progress](qulonglong count) {
+        progress.setLabelText(tr("Exported %1 rows...")
+                              .arg(meow::helpers::formatNumber(count)));
+    });
+    connect(&progress, &QProgressDialog::canceled,
+            &_presenter, &ui::presenters::ExportQueryPresenter::cancel);
+
     QApplication::setOverrideCursor(Qt::WaitCursor);
     QString error = _presenter.run();
     QApplication::restoreOverrideCursor();
 
+    _presenter.disconnect(&progress);
+    progress.reset();
+
     if (!error.isEmpty()) {
         showErrorMessage(error);
         return;
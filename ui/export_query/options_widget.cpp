@@ -20,6 +20,8 @@ void OptionsWidget::fillDataFromPresenter()
     _encloserEdit->setEnabled(_presenter->isOptionEditableEncloser());
     _terminatorEdit->setEnabled(_presenter->isOptionEditableLineTerminator());
     _nullValueEdit->setEnabled(_presenter->isOptionEditableNullValue());
+    _maxStatementSizeSpinBox->setEnabled(
+                _presenter->isOptionEditableMaxStatementSize());
 
     _includeColumnNamesCheckbox->setEnabled(
                 _presenter->isOptionEditableIncludeColumnNames());
@@ -46,6 +48,10 @@ void OptionsWidget::fillDataFromPresenter()
     _nullValueEdit->setText(_presenter->optionNullValue());
     _nullValueEdit->blockSignals(false);
 
+    _maxStatementSizeSpinBox->blockSignals(true);
+    _maxStatementSizeSpinBox->setValue(_presenter->optionMaxStatementSizeKB());
+    _maxStatementSizeSpinBox->blockSignals(false);
+
     _includeColumnNamesCheckbox->blockSignals(true);
     _includeColumnNamesCheckbox->setChecked(
                 _presenter->optionBoolIncludeColumnNames());
@@ -129,6 +135,26 @@ void OptionsWidget::createWidgets()
     _nullValueEdit = createLineEditWithAction();
     mainGroupLayout->addWidget(_nullValueEdit, 3, 2);
 
+    _maxStatementSizeLabel = new QLabel(tr("Max statement size:"));
+    mainGroupLayout->addWidget(_maxStatementSizeLabel, 4, 1);
+
+    _maxStatementSizeSpinBox = new QSpinBox;
+    _maxStatementSizeSpinBox->setRange(0, 1024 * 1024); // up to 1 GiB
+    _maxStatementSizeSpinBox->setSuffix(" KiB");
+    _maxStatementSizeSpinBox->setSpecialValueText(tr("Row per statement"));
+    _maxStatementSizeSpinBox->setToolTip(
+        tr("Rows are grouped into multi-row statements up to this size,"
+           " keep it below max_allowed_packet of server"));
+    mainGroupLayout->addWidget(_maxStatementSizeSpinBox, 4, 2);
+
+    connect(_maxStatementSizeSpinBox,
+#if QT_VERSION >= QT_VERSION_CHECK(5, 7, 0)
+            QOverload<int>::of(&QSpinBox::valueChanged),
+#else
+            static_cast<void(QSpinBox::*)(int)>(&QSpinBox::valueChanged),
+#endif
+            this, &OptionsWidget::onMaxStatementSizeChanged);
+
     connect(_separatorEdit, &QLineEdit::textChanged,
             this, &OptionsWidget::onLineEditTextChanged);
     connect(_encloserEdit, &QLineEdit::textChanged,
@@ -192,6 +218,11 @@ void OptionsWidget::onCheckboxStateChanged()
     }
 }
 
+void OptionsWidget::onMaxStatementSizeChanged(int value)
+{
+    _presenter->setOptionMaxStatementSizeKB(value);
+}
+
 void OptionsWidget::onLineEditAction()
 {
     QLineEdit * lineEdit = static_cast<QLineEdit *>(sender()->parent());
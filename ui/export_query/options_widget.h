@@ -28,6 +28,7 @@ private:
     Q_SLOT void onLineEditTextChanged();
     Q_SLOT void onCheckboxStateChanged();
     Q_SLOT void onLineEditAction();
+    Q_SLOT void onMaxStatementSizeChanged(int value);
 
     presenters::ExportQueryPresenter * _presenter;
 
@@ -42,11 +43,13 @@ private:
     QLabel * _encloserLabel;
     QLabel * _terminatorLabel;
     QLabel * _nullValueLabel;
+    QLabel * _maxStatementSizeLabel;
 
     QLineEdit * _separatorEdit;
     QLineEdit * _encloserEdit;
     QLineEdit * _terminatorEdit;
     QLineEdit * _nullValueEdit;
+    QSpinBox * _maxStatementSizeSpinBox;
 };
 
 } // namespace export_query
@@ -0,0 +1,257 @@
+#include "import_csv_dialog.h"
+#include "ui/presenters/import_csv_form.h"
+#include "db/entity/table_entity.h"
+#include "db/exception.h"
+
+namespace meow {
+namespace ui {
+namespace import_csv {
+
+Dialog::Dialog(presenters::ImportCSVForm * form)
+    : QDialog(nullptr, Qt::WindowCloseButtonHint),
+      _form(form)
+{
+    setMinimumSize(320, 300);
+    setWindowTitle(tr("Import CSV file into %1").arg(_form->table()->name()));
+
+    createWidgets();
+    fillDataFromForm();
+
+    connect(_form,
+            &presenters::ImportCSVForm::progress,
+            _progressBar,
+            &QProgressBar::setValue);
+
+    connect(_form,
+            &presenters::ImportCSVForm::rowsImported,
+            this,
+            &Dialog::onRowsImported);
+
+    resize(600, 400);
+}
+
+void Dialog::createWidgets()
+{
+    QGridLayout * mainGridLayout = new QGridLayout();
+    int row = 0;
+
+    // -------------------------------------------------------------------------
+
+    _filenameLabel = new QLabel(tr("Filename:"));
+    mainGridLayout->addWidget(_filenameLabel, row, 0);
+
+    QHBoxLayout * filenameLayout = new QHBoxLayout();
+
+    _filenameEdit = new QLineEdit;
+    _filenameLabel->setBuddy(_filenameEdit);
+
+    _filenameSelectionButton = new QPushButton(
+                QIcon(":/icons/folder_explore.png"),
+                tr(""));
+    connect(_filenameSelectionButton,
+            &QAbstractButton::clicked,
+            this,
+            &Dialog::onFilenameSelectionButtonClicked
+    );
+    _filenameSelectionButton->setMinimumWidth(30);
+
+    filenameLayout->addWidget(_filenameEdit, 20);
+    filenameLayout->addWidget(_filenameSelectionButton, 1);
+
+    mainGridLayout->addLayout(filenameLayout, row, 1);
+
+    row++;
+
+    // -------------------------------------------------------------------------
+
+    _encodingLabel = new QLabel(tr("Encoding:"));
+    mainGridLayout->addWidget(_encodingLabel, row, 0);
+    _encodingComboBox = new QComboBox();
+    _encodingLabel->setBuddy(_encodingComboBox);
+    mainGridLayout->addWidget(_encodingComboBox, row, 1);
+
+    row++;
+
+    // -------------------------------------------------------------------------
+
+    _separatorLabel = new QLabel(tr("Fields separated by:"));
+    mainGridLayout->addWidget(_separatorLabel, row, 0);
+    _separatorComboBox = new QComboBox();
+    _separatorComboBox->addItem(tr("Comma (,)"), QChar(','));
+    _separatorComboBox->addItem(tr("Semicolon (;)"), QChar(';'));
+    _separatorComboBox->addItem(tr("Tab"), QChar('\t'));
+    _separatorComboBox->addItem(tr("Pipe (|)"), QChar('|'));
+    _separatorLabel->setBuddy(_separatorComboBox);
+    mainGridLayout->addWidget(_separatorComboBox, row, 1);
+
+    row++;
+
+    // -------------------------------------------------------------------------
+
+    _encloserLabel = new QLabel(tr("Fields enclosed by:"));
+    mainGridLayout->addWidget(_encloserLabel, row, 0);
+    _encloserComboBox = new QComboBox();
+    _encloserComboBox->addItem(tr("Double quote (\")"), QChar('"'));
+    _encloserComboBox->addItem(tr("Single quote (')"), QChar('\''));
+    _encloserComboBox->addItem(tr("None"), QChar());
+    _encloserLabel->setBuddy(_encloserComboBox);
+    mainGridLayout->addWidget(_encloserComboBox, row, 1);
+
+    row++;
+
+    // -------------------------------------------------------------------------
+
+    _nullValueLabel = new QLabel(tr("NULL value:"));
+    mainGridLayout->addWidget(_nullValueLabel, row, 0);
+    _nullValueComboBox = new QComboBox();
+    _nullValueComboBox->addItem("\\N", QString("\\N"));
+    _nullValueComboBox->addItem("NULL", QString("NULL"));
+    _nullValueComboBox->addItem(tr("Empty field"), QString(""));
+    _nullValueComboBox->addItem(tr("None"), QString());
+    _nullValueLabel->setBuddy(_nullValueComboBox);
+    mainGridLayout->addWidget(_nullValueComboBox, row, 1);
+
+    row++;
+
+    // -------------------------------------------------------------------------
+
+    _headerCheckbox = new QCheckBox(
+                tr("First row contains column names"));
+    mainGridLayout->addWidget(_headerCheckbox, row, 1);
+
+    row++;
+
+    // -------------------------------------------------------------------------
+
+    _progressBar = new QProgressBar();
+    _progressBar->setRange(0, 100);
+    _progressBar->setValue(0);
+    mainGridLayout->addWidget(_progressBar, row, 0, 1, 2);
+
+    row++;
+
+    _results = new QPlainTextEdit;
+    _results->setReadOnly(true);
+    mainGridLayout->addWidget(_results, row, 0, 1, 2);
+    mainGridLayout->setRowStretch(row, 1);
+
+    row++;
+
+    // -------------------------------------------------------------------------
+
+    QHBoxLayout * buttonsLayout = new QHBoxLayout();
+    buttonsLayout->addStretch(1);
+
+    _importButton = new QPushButton(tr("Import"));
+    buttonsLayout->addWidget(_importButton);
+    connect(_importButton, &QAbstractButton::clicked,
+            this, &Dialog::onImport);
+
+    _cancelButton = new QPushButton(tr("Cancel"));
+    buttonsLayout->addWidget(_cancelButton);
+    connect(_cancelButton, &QAbstractButton::clicked,
+            this, &Dialog::onCancel);
+
+    mainGridLayout->addLayout(buttonsLayout, row, 0, 1, 2);
+
+    mainGridLayout->setColumnStretch(1, 1);
+    this->setLayout(mainGridLayout);
+}
+
+void Dialog::fillDataFromForm()
+{
+    _filenameEdit->setText(_form->filename());
+
+    _encodingComboBox->addItems(_form->supportedEncodings());
+    _encodingComboBox->setCurrentText(_form->encoding());
+
+    _separatorComboBox->setCurrentIndex(
+        _separatorComboBox->findData(_form->fieldSeparator()));
+    _encloserComboBox->setCurrentIndex(
+        _encloserComboBox->findData(_form->encloser()));
+    _nullValueComboBox->setCurrentIndex(
+        _nullValueComboBox->findData(_form->nullValue()));
+
+    _headerCheckbox->setChecked(_form->isFirstRowHeader());
+}
+
+void Dialog::fillFormFromData()
+{
+    _form->setFilename(_filenameEdit->text());
+    _form->setEncoding(_encodingComboBox->currentText());
+    _form->setFieldSeparator(_separatorComboBox->currentData().toChar());
+    _form->setEncloser(_encloserComboBox->currentData().toChar());
+    _form->setNullValue(_nullValueComboBox->currentData().toString());
+    _form->setFirstRowIsHeader(_headerCheckbox->isChecked());
+}
+
+void Dialog::setInputsEnabled(bool enabled)
+{
+    _filenameEdit->setEnabled(enabled);
+    _filenameSelectionButton->setEnabled(enabled);
+    _encodingComboBox->setEnabled(enabled);
+    _separatorComboBox->setEnabled(enabled);
+    _encloserComboBox->setEnabled(enabled);
+    _nullValueComboBox->setEnabled(enabled);
+    _headerCheckbox->setEnabled(enabled);
+    _importButton->setEnabled(enabled);
+}
+
+void Dialog::onFilenameSelectionButtonClicked()
+{
+    QString filename = QFileDialog::getOpenFileName(
+        this,
+        tr("Select CSV file"),
+        _filenameEdit->text(),
+        tr("CSV files (*.csv *.tsv *.txt);;All files (*)"));
+
+    if (!filename.isEmpty()) {
+        _filenameEdit->setText(QDir::toNativeSeparators(filename));
+    }
+}
+
+void Dialog::onCancel()
+{
+    if (_form->cancelImport() == false) {
+        // close if was not running
+        reject();
+    }
+}
+
+void Dialog::onImport()
+{
+    fillFormFromData();
+
+    if (_form->filename().isEmpty()) {
+        return;
+    }
+
+    setInputsEnabled(false);
+    _progressBar->setValue(0);
+    _results->clear();
+
+    try {
+        _form->startImport();
+        _results->setPlainText(_form->resultSummary());
+    } catch(meow::db::Exception & ex) {
+        _results->setPlainText(_form->resultSummary());
+        QMessageBox msgBox;
+        msgBox.setText(tr("Import failed, no rows are imported.\n%1")
+                       .arg(ex.message()));
+        msgBox.setStandardButtons(QMessageBox::Ok);
+        msgBox.setDefaultButton(QMessageBox::Ok);
+        msgBox.setIcon(QMessageBox::Critical);
+        msgBox.exec();
+    }
+
+    setInputsEnabled(true);
+}
+
+void Dialog::onRowsImported(qulonglong count)
+{
+    _results->setPlainText(tr("Imported rows: %1").arg(count));
+}
+
+} // namespace import_csv
+} // namespace ui
+} // namespace meow
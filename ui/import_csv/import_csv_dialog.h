@@ -0,0 +1,64 @@
+#ifndef UI_IMPORT_CSV_DIALOG_H
+#define UI_IMPORT_CSV_DIALOG_H
+
+#include <QtWidgets>
+
+namespace meow {
+namespace ui {
+
+namespace presenters {
+    class ImportCSVForm;
+}
+
+namespace import_csv {
+
+class Dialog : public QDialog
+{
+    Q_OBJECT
+public:
+    explicit Dialog(presenters::ImportCSVForm * form);
+
+private:
+
+    void createWidgets();
+    void fillDataFromForm();
+    void fillFormFromData();
+    void setInputsEnabled(bool enabled);
+
+    Q_SLOT void onFilenameSelectionButtonClicked();
+    Q_SLOT void onCancel();
+    Q_SLOT void onImport();
+    Q_SLOT void onRowsImported(qulonglong count);
+
+    presenters::ImportCSVForm * _form;
+
+    QLabel * _filenameLabel;
+    QLineEdit * _filenameEdit;
+    QPushButton * _filenameSelectionButton;
+
+    QLabel * _encodingLabel;
+    QComboBox * _encodingComboBox;
+
+    QLabel * _separatorLabel;
+    QComboBox * _separatorComboBox;
+
+    QLabel * _encloserLabel;
+    QComboBox * _encloserComboBox;
+
+    QLabel * _nullValueLabel;
+    QComboBox * _nullValueComboBox;
+
+    QCheckBox * _headerCheckbox;
+
+    QProgressBar * _progressBar;
+    QPlainTextEdit * _results;
+
+    QPushButton * _importButton;
+    QPushButton * _cancelButton;
+};
+
+} // namespace import_csv
+} // namespace ui
+} // namespace meow
+
+#endif // UI_IMPORT_CSV_DIALOG_H
@@ -5,12 +5,15 @@
 #include "app/app.h"
 #include "helpers/logger.h"
 #include "db/entity/database_entity.h"
+#include "db/entity/table_entity.h"
 #include "db/common.h"
 
 #include "ui/edit_database/dialog.h"
 #include "ui/presenters/edit_database_form.h"
 
 #include "ui/export_database/export_dialog.h"
+#include "ui/import_csv/import_csv_dialog.h"
+#include "ui/presenters/import_csv_form.h"
 #include "ui/presenters/export_database_form.h"
 
 namespace meow {
@@ -82,6 +85,10 @@ void DbTree::contextMenuEvent(QContextMenuEvent * event)
         menu.addAction(meow::app()->actions()->exportDatabase());
     }
 
+    if (currentItemSupportsImport()) {
+        menu.addAction(meow::app()->actions()->importCSV());
+    }
+
 
     menu.addSeparator();
 
@@ -342,6 +349,26 @@ void DbTree::createActions()
         dialog.exec();
     });
 
+    // import ==================================================================
+
+    connect(meow::app()->actions()->importCSV(),
+            &QAction::triggered,
+            [=](bool checked)
+    {
+        Q_UNUSED(checked);
+        if (!currentItemSupportsImport()) {
+            return;
+        }
+
+        db::Entity * currentEntity = this->treeModel()->currentEntity();
+
+        presenters::ImportCSVForm form(
+                    static_cast<db::TableEntity *>(currentEntity));
+
+        meow::ui::import_csv::Dialog dialog(&form);
+        dialog.exec();
+    });
+
     // refresh =================================================================
     _refreshAction = new QAction(QIcon(":/icons/arrow_refresh.png"),
                                  tr("Refresh"), this);
@@ -366,6 +393,19 @@ bool DbTree::currentItemSupportsDumping() const
     return false;
 }
 
+bool DbTree::currentItemSupportsImport() const
+{
+    auto treeModel = this->treeModel();
+
+    db::Entity * currentEntity = treeModel->currentEntity();
+    if (currentEntity && currentEntity->type() == db::Entity::Type::Table) {
+        return currentEntity->connection()
+                ->features()->supportsEditingTablesData();
+    }
+
+    return false;
+}
+
 bool DbTree::currentItemSupportsEditing() const
 {
     auto treeModel = this->treeModel();
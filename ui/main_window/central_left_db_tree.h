@@ -29,6 +29,7 @@ private:
 
     bool currentItemSupportsDumping() const;
     bool currentItemSupportsEditing() const;
+    bool currentItemSupportsImport() const;
 
     models::EntitiesTreeModel * treeModel() const;
 
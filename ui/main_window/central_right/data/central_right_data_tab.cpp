@@ -80,8 +80,22 @@ DataTab::DataTab(QWidget *parent) :
     connect(&_model, &models::DataTableModel::editingStarted,
             this, &DataTab::validateControls);
 
-    connect(&_model, &models::DataTableModel::dataRefreshed,
-            this, &DataTab::onDataRefreshed);
+    connect(&_model, &models::DataTableModel::dataLoaded,
+            this, &DataTab::onLoadData);
+
+    connect(&_model, &models::DataTableModel::moreRowsLoaded,
+            this, &DataTab::onMoreRowsLoaded);
+
+    connect(&_model, &models::DataTableModel::loadingProgress,
+            this, &DataTab::refreshDataLabelText);
+
+    connect(&_model, &models::DataTableModel::loadingStateChanged,
+            this, &DataTab::onLoadingStateChanged);
+
+    // rows are loaded on scroll from inside of view, show error later
+    connect(&_model, &models::DataTableModel::loadDataError,
+            this, &DataTab::errorDialog,
+            Qt::QueuedConnection);
 
     validateControls();
 }
@@ -155,6 +169,16 @@ void DataTab::createDataButtonsToolBar()
             this, &DataTab::onActionAllRows);
     _dataButtonsToolBar->addAction(_showAllRowsAction);
 
+    // Cancel loading
+    _cancelLoadingAction = new QAction(QIcon(":/icons/cancel.png"),
+                                       tr("Cancel"),
+                                       this);
+    _cancelLoadingAction->setToolTip(tr("Cancel loading of rows"));
+    _cancelLoadingAction->setEnabled(false);
+    connect(_cancelLoadingAction, &QAction::triggered,
+            this, &DataTab::onActionCancelLoading);
+    _dataButtonsToolBar->addAction(_cancelLoadingAction);
+
     // Separator
     _dataButtonsToolBar->addSeparator();
 
@@ -219,8 +243,7 @@ void DataTab::onActionAllRows()
 {
 
     try {
-        _model.setNoRowsCountLimit();
-        _model.loadData(true);
+        _model.loadAllData();
         refreshDataLabelText();
         validateShowToolBarState();
     } catch(meow::db::Exception & ex) {
@@ -241,6 +264,12 @@ void DataTab::onActionNextRows()
     }
 }
 
+void DataTab::onActionCancelLoading()
+{
+    _model.cancelLoading();
+    onLoadData(); // for rows received before cancel
+}
+
 void DataTab::onActionShowFilter(bool checked)
 {
     // Listening: Moonspell - Alma Matter
@@ -279,13 +308,15 @@ void DataTab::onDataDuplicateRowWithKeys()
     duplicateCurrentRowWithKeys();
 }
 
-void DataTab::onDataRefreshed()
+void DataTab::onMoreRowsLoaded()
 {
-    // TODO: just call onLoadData() ?
-    if (meow::app()->settings()->textSettings()->autoResizeTableColumns()) {
-        _dataTable->resizeColumnsToContents();
-    }
+    refreshDataLabelText();
+    validateShowToolBarState();
+}
 
+void DataTab::onLoadingStateChanged(bool isLoading)
+{
+    Q_UNUSED(isLoading);
     refreshDataLabelText();
     validateControls();
 }
@@ -296,10 +327,7 @@ void DataTab::setDBEntity(db::Entity * tableOrViewEntity, bool loadData)
     _model.incRowsCountForOneStep(true);
     _model.resetWhereFilter();
     _model.resetAllColumnsSort();
-    _model.setEntity(tableOrViewEntity, loadData);
-    if (loadData) {
-        onLoadData();
-    }
+    _model.setEntity(tableOrViewEntity, loadData); // see onLoadData()
     _dataFilter->setDBEntity(tableOrViewEntity);
 }
 
@@ -308,13 +336,14 @@ void DataTab::refresh()
     // TODO: catch db exception?
     applyModifications(); // close pending to avoid crash
     _model.refresh();
-    onLoadData();
 }
 
 void DataTab::loadData()
 {
     _model.loadData();
-    onLoadData();
+    if (!_model.isLoading()) {
+        onLoadData();
+    }
 }
 
 void DataTab::invalidateData()
@@ -390,8 +419,9 @@ void DataTab::disconnectRowChanged()
 
 void DataTab::validateShowToolBarState()
 {
-    _nextRowsAction->setDisabled(_model.allDataLoaded());
-    _showAllRowsAction->setDisabled(_model.allDataLoaded());
+    _nextRowsAction->setEnabled(_model.canLoadMoreData());
+    _showAllRowsAction->setEnabled(_model.canLoadMoreData());
+    _cancelLoadingAction->setEnabled(_model.isLoading());
 }
 
 void DataTab::validateDataToolBarState()
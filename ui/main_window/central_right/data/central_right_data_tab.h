@@ -46,10 +46,11 @@ public:
 
 private:
 
-    void onLoadData();
+    Q_SLOT void onLoadData();
 
     Q_SLOT void onActionAllRows();
     Q_SLOT void onActionNextRows();
+    Q_SLOT void onActionCancelLoading();
     Q_SLOT void onActionShowFilter(bool checked);
 
     void createDataTable();
@@ -57,7 +58,7 @@ private:
     void createDataButtonsToolBar();
     void createDataActionsToolBar();
 
-    void refreshDataLabelText();
+    Q_SLOT void refreshDataLabelText();
 
     void connectRowChanged();
     void disconnectRowChanged();
@@ -78,7 +79,8 @@ private:
     Q_SLOT void onDataInsertRow();
     Q_SLOT void onDataDuplicateRowWithoutKeys();
     Q_SLOT void onDataDuplicateRowWithKeys();
-    Q_SLOT void onDataRefreshed();
+    Q_SLOT void onMoreRowsLoaded();
+    Q_SLOT void onLoadingStateChanged(bool isLoading);
 
     Q_SIGNAL void changeRowSelection(const QModelIndex &index);
     Q_SLOT void onChangeRowSelectionRequest(const QModelIndex &index);
@@ -101,7 +103,7 @@ private:
     void validateDataDeleteActionState();
     Q_SLOT void validateControls();
 
-    void errorDialog(const QString & message);
+    Q_SLOT void errorDialog(const QString & message);
 
     QAbstractItemDelegate * currentItemDelegate() const;
     
@@ -115,6 +117,7 @@ private:
     QToolBar * _dataActionsToolBar;
     QAction * _nextRowsAction;
     QAction * _showAllRowsAction;
+    QAction * _cancelLoadingAction;
     QAction * _showFilterPanelAction;
     DataFilterWidget * _dataFilter;
     // bottom:
@@ -79,6 +79,9 @@ void QueryTab::createWidgets()
     connect(_queryPanel, &QueryPanel::execCurrentQueryRequested,
             this, &QueryTab::onActionExecCurrentQuery);
 
+    connect(_queryPanel, &QueryPanel::execFileRequested,
+            this, &QueryTab::onActionExecFile);
+
     connect(_queryPanel, &QueryPanel::cancelQueryRequested,
             this, &QueryTab::onActionCancelQuery);
 
@@ -99,6 +102,8 @@ void QueryTab::validateControls()
                 _presenter.isExecQueryActionEnabled());
     _queryPanel->execCurrentQueryAction()->setEnabled(
                 _presenter.isExecCurrentQueryActionEnabled());
+    _queryPanel->execFileAction()->setEnabled(
+                _presenter.isExecQueryActionEnabled());
     _queryPanel->cancelQueryAction()->setEnabled(
                 _presenter.isCancelQueryActionEnabled());
 }
@@ -117,6 +122,22 @@ void QueryTab::onActionExecCurrentQuery(int charPosition)
     _presenter.execQueries(_queryPanel->queryPlainText(), charPosition);
 }
 
+void QueryTab::onActionExecFile()
+{
+    QString filename = QFileDialog::getOpenFileName(
+        this,
+        tr("Run SQL file"),
+        QString(),
+        tr("SQL files (*.sql);;All files (*)"));
+
+    if (filename.isEmpty()) {
+        return;
+    }
+
+    beforeRunQueries();
+    _presenter.execScriptFile(filename);
+}
+
 void QueryTab::onActionCancelQuery()
 {
     if (!_presenter.cancelQueries()) {
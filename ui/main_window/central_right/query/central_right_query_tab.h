@@ -46,6 +46,7 @@ private:
 
     Q_SLOT void onActionExecQuery();
     Q_SLOT void onActionExecCurrentQuery(int charPosition);
+    Q_SLOT void onActionExecFile();
     Q_SLOT void onActionCancelQuery();
     Q_SLOT void onExecQueriesFinished();
     Q_SLOT void onExecQueryFinished(int queryIndex, int totalCount);
@@ -11,7 +11,14 @@ QueryDataTab::QueryDataTab(db::QueryDataPtr queryData, QWidget *parent)
     : QWidget(parent),
       _model(queryData)
 {
-    _model.setRowCount(-1); // Temp: take row/col count from query data
+    if (queryData->isFetching()) {
+        // rows are still coming, notify views about each portion
+        connect(queryData.get(), &db::QueryData::rowsFetched,
+                this, &QueryDataTab::onQueryDataRowsFetched);
+        _model.setRowCount(queryData->rowCount());
+    } else {
+        _model.setRowCount(-1); // Temp: take row/col count from query data
+    }
     _model.setColumnCount(-1);
 
     QVBoxLayout * mainLayout = new QVBoxLayout();
@@ -68,6 +75,11 @@ void QueryDataTab::onDataExportAction()
     dialog.exec();
 }
 
+void QueryDataTab::onQueryDataRowsFetched()
+{
+    _model.insertFetchedRows();
+}
+
 void QueryDataTab::onDataTableHeaderClicked(int column)
 {
     QHeaderView * header = _dataTable->horizontalHeader();
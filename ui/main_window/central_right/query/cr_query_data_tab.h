@@ -27,6 +27,7 @@ public:
 private:
 
     Q_SLOT void onDataTableHeaderClicked(int index);
+    Q_SLOT void onQueryDataRowsFetched();
 
     models::BaseDataTableModel _model;
     EditableQueryDataTableView  * _dataTable;
@@ -26,6 +26,7 @@ void QueryPanel::createWidgets()
     // http://doc.qt.io/qt-5/qtwidgets-widgets-codeeditor-example.html
     // http://doc.qt.io/qt-5/qtwidgets-richtext-syntaxhighlighter-example.html
     _queryTextEdit = new ui::common::SQLEditor();
+    _queryTextEdit->setAutocompletionEnabled(true);
     _queryTextEdit->setContextMenuPolicy(Qt::CustomContextMenu);
     _mainLayout->addWidget(_queryTextEdit);
 
@@ -66,6 +67,15 @@ void QueryPanel::createToolBar()
             this, &QueryPanel::onExecCurrentQueryAction);
 
 
+    _execFileAction = new QAction(QIcon(":/icons/folder.png"),
+                                  tr("Run SQL file..."), this);
+    _execFileAction->setToolTip(tr("Run SQL file"));
+    _execFileAction->setStatusTip(
+        tr("Run queries of SQL file without loading it into editor"));
+    connect(_execFileAction, &QAction::triggered,
+            this, &QueryPanel::execFileRequested);
+
+
     _cancelQueryAction = new QAction(QIcon(":/icons/cancel.png"),
                                           tr("Cancel running operation"), this);
     _cancelQueryAction->setToolTip(tr("Cancel running operation (Esc)"));
@@ -77,6 +87,7 @@ void QueryPanel::createToolBar()
 
     _toolBar->addAction(_execQueryAction);
     _toolBar->addAction(_cancelQueryAction);
+    _toolBar->addAction(_execFileAction);
 
     // TODO: add _execCurrentQueryAction to toolbar
 
@@ -110,6 +121,7 @@ void QueryPanel::onQueryTextEditContextMenu(const QPoint & pos)
     QList<QAction *> actions = {
         _execQueryAction,
         _execCurrentQueryAction,
+        _execFileAction,
         _cancelQueryAction
     };
 
@@ -26,6 +26,7 @@ public:
 
     Q_SIGNAL void execQueryRequested();
     Q_SIGNAL void execCurrentQueryRequested(int charPosition);
+    Q_SIGNAL void execFileRequested();
     Q_SIGNAL void cancelQueryRequested();
     
     QAction * execQueryAction() const {
@@ -34,6 +35,9 @@ public:
     QAction * execCurrentQueryAction() const {
         return _execCurrentQueryAction;
     }
+    QAction * execFileAction() const {
+        return _execFileAction;
+    }
     QAction * cancelQueryAction() const {
         return _cancelQueryAction;
     }
@@ -54,6 +58,7 @@ private:
     QToolBar * _toolBar;
     QAction * _execQueryAction;
     QAction * _execCurrentQueryAction;
+    QAction * _execFileAction;
     QAction * _cancelQueryAction;
     QAction * _separatorAction;
 };
@@ -33,6 +33,17 @@ void BaseDataTableModel::setColumnCount(int newColumnCount)
     _colCount = newColumnCount;
 }
 
+void BaseDataTableModel::insertFetchedRows()
+{
+    Q_ASSERT(_rowCount != -1);
+    int newRowCount = _queryData->rowCount();
+    if (newRowCount > _rowCount) {
+        beginInsertRows(QModelIndex(), _rowCount, newRowCount - 1);
+        _rowCount = newRowCount;
+        endInsertRows();
+    }
+}
+
 int BaseDataTableModel::columnCount(const QModelIndex &parent) const
 {
     Q_UNUSED(parent);
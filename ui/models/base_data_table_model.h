@@ -28,6 +28,7 @@ public:
             const QModelIndex &parent = QModelIndex()) const override;
 
     meow::db::QueryData * queryData() { return _queryData.get(); }
+    const meow::db::QueryData * queryData() const { return _queryData.get(); }
 
     meow::db::DataTypeCategoryIndex typeCategoryForColumn(int column) const {
         return _queryData->columnDataTypeCategory(column);
@@ -61,6 +62,8 @@ public:
     // But we already changed queryData + plus query may fail
     void setRowCount(int newRowCount); // set to -1 to take from queryData()
     void setColumnCount(int newColumnCount);
+    // grows explicit row count up to queryData() one, e.g. for streamed rows
+    void insertFetchedRows();
 
     QAbstractItemModel * createSortFilterModel();
 
@@ -1,6 +1,9 @@
 #include "data_table_model.h"
+#include <algorithm>
 #include "db/query_data_fetcher.h"
 #include "db/connection.h"
+#include "db/connection_pool.h"
+#include "db/connections_manager.h"
 #include "db/common.h"
 #include "db/query.h"
 #include "db/query_criteria.h"
@@ -10,6 +13,12 @@
 #include "db/entity/view_entity.h"
 #include <QColor>
 #include "app/app.h"
+#include "threads/db_thread.h"
+#include "threads/table_data_task.h"
+#include "threads/helpers.h"
+#include "db/connection_query_killer.h"
+#include "helpers/logger.h"
+#include <QEventLoop>
 
 namespace meow {
 namespace ui {
@@ -20,16 +29,31 @@ DataTableModel::DataTableModel(QObject *parent)
           meow::db::QueryDataPtr(new meow::db::QueryData()),
           parent),
       _entityChangedProcessed(false),
+      _fetchMoreFailed(false),
       _dbEntity(nullptr),
-      _wantedRowsCount(meow::db::DATA_MAX_ROWS)
+      _wantedRowsCount(meow::db::DATA_ROWS_PER_STEP),
+      _loadAppends(false),
+      _loadAllRows(false),
+      _loadSeeksByKey(false),
+      _loadReloadsPage(-1),
+      _keepAllRows(false),
+      _pageUseCounter(0),
+      _isPageReloadQueued(false)
 {
     QObject::connect(queryData(), &meow::db::QueryData::editingPrepared,
             this, &DataTableModel::editingStarted);
+
+    QObject::connect(meow::app()->dbConnectionsManager(),
+            &meow::db::ConnectionsManager::beforeConnectionClosed,
+            this, &DataTableModel::onConnectionClose);
 }
 
 DataTableModel::~DataTableModel()
 {
-
+    if (_loadTask) {
+        _loadTask->disconnect(this);
+        _loadTask->abort();
+    }
 }
 
 Qt::ItemFlags DataTableModel::flags(const QModelIndex &index) const
@@ -47,7 +71,7 @@ Qt::ItemFlags DataTableModel::flags(const QModelIndex &index) const
             _dbEntity->connection()->features()->supportsEditingTablesData();
     }
 
-    if (isEditable) {
+    if (isEditable && !isRowReleased(index.row())) {
         flags |= Qt::ItemIsEditable; // TODO: read-only tables?
     }
 
@@ -55,6 +79,33 @@ Qt::ItemFlags DataTableModel::flags(const QModelIndex &index) const
     return flags;
 }
 
+QVariant DataTableModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || _pages.empty()) {
+        return BaseDataTableModel::data(index, role);
+    }
+
+    int pageIndex = pageIndexForRow(index.row());
+    if (pageIndex == -1) {
+        return BaseDataTableModel::data(index, role);
+    }
+
+    const Page & page = _pages[pageIndex];
+    if (role == Qt::DisplayRole) {
+        page.lastUsed = ++_pageUseCounter;
+    }
+
+    if (page.isReleased) {
+        if (role == Qt::DisplayRole) {
+            page.isWanted = true;
+            queueWantedPagesReload();
+        }
+        return QVariant(); // blank until rows are selected again
+    }
+
+    return BaseDataTableModel::data(index, role);
+}
+
 bool DataTableModel::setData(const QModelIndex &index,
                              const QVariant &value,
                              int role)
@@ -144,6 +195,35 @@ QVariant DataTableModel::headerData(int section,
     return BaseDataTableModel::headerData(section, orientation, role);
 }
 
+bool DataTableModel::canFetchMore(const QModelIndex &parent) const
+{
+    if (parent.isValid() || _fetchMoreFailed) {
+        return false;
+    }
+
+    if (!meow::app()->settings()->dataFetching()->loadTableRowsOnScroll()) {
+        return false;
+    }
+
+    return canLoadMoreData();
+}
+
+void DataTableModel::fetchMore(const QModelIndex &parent)
+{
+    if (!canFetchMore(parent)) {
+        return;
+    }
+
+    incRowsCountForOneStep();
+
+    try {
+        loadData(true); // next rows are sought by key when possible
+    } catch(meow::db::Exception & ex) {
+        _fetchMoreFailed = true; // don't repeat on every scroll
+        emit loadDataError(ex.message());
+    }
+}
+
 void DataTableModel::setEntity(meow::db::Entity * tableOrViewEntity,
                                bool loadData)
 {
@@ -160,6 +240,8 @@ void DataTableModel::setEntity(meow::db::Entity * tableOrViewEntity,
 
 void DataTableModel::removeData()
 {
+    cancelLoading();
+
     int rowCount = this->rowCount();
     int columnCount = this->columnCount();
 
@@ -176,6 +258,10 @@ void DataTableModel::removeData()
     }
 
     queryData()->clearData();
+    _pages.clear();
+    _dataConnection.reset(); // back to pool, no rows reference it
+    _lastKeyValues.clear();
+    _fetchMoreFailed = false;
 }
 
 void DataTableModel::loadData(bool force)
@@ -188,75 +274,636 @@ void DataTableModel::loadData(bool force)
         return;
     }
 
-    meow::db::QueryDataFetcher * queryDataFetcher =
-        _dbEntity->connection()->createQueryDataFetcher();
+    if (isLoading()) { // next pages wait for current one
+        return;
+    }
 
-    std::shared_ptr<meow::db::QueryDataFetcher> fetcher(queryDataFetcher);
+    std::unique_ptr<meow::db::QueryDataFetcher> queryDataFetcher(
+        _dbEntity->connection()->createQueryDataFetcher());
 
     meow::db::ulonglong offset = 0;
-    int prevColCount = 0;
-    int prevRowCount = 0;
 
     if (_entityChangedProcessed) { // load from the same table/view
         offset = rowCount();
-        prevColCount = columnCount();
-        prevRowCount = rowCount();
     }
 
     meow::db::QueryCriteria queryCritera;
-    queryCritera.quotedDbAndTableName = meow::db::quotedFullName(_dbEntity);
-    queryCritera.where = _whereFilter;
+    fillSelectCriteria(queryDataFetcher.get(), &queryCritera);
     queryCritera.limit = _wantedRowsCount - offset;
     queryCritera.offset = offset;
+    queryCritera.lastKeyValues = _lastKeyValues;
+
+    QString SQL = queryDataFetcher->selectSQL(&queryCritera);
+
+    bool isAsc = true;
+    _loadKeyColumns = queryCritera.keyColumns;
+    _loadSeeksByKey = queryDataFetcher->canSeekByKey(&queryCritera, &isAsc);
+    _entityChangedProcessed = true;
+
+    startLoadTask(SQL, offset > 0);
+}
+
+void DataTableModel::fillSelectCriteria(
+        meow::db::QueryDataFetcher * fetcher,
+        meow::db::QueryCriteria * criteria) const
+{
+    criteria->quotedDbAndTableName = meow::db::quotedFullName(_dbEntity);
+    criteria->where = _whereFilter;
 
     auto textSettings = meow::app()->settings()->textSettings();
     bool limitDataLoadLen = textSettings->autoLimitLoadDataLength();
 
-    if (limitDataLoadLen) {
-        if (_dbEntity->type() == meow::db::Entity::Type::Table) {
-            auto table = static_cast<meow::db::TableEntity *>(_dbEntity);
-            queryCritera.select = queryDataFetcher->selectList(table);
+    if (_dbEntity->type() == meow::db::Entity::Type::Table) {
+        auto table = static_cast<meow::db::TableEntity *>(_dbEntity);
+        if (limitDataLoadLen) {
+            criteria->select = fetcher->selectList(table);
         }
+        criteria->keyColumns = fetcher->seekKeyColumns(table);
+    }
+
+    applyColumnsSortTo(criteria);
+}
+
+QString DataTableModel::pageSQL(const Page & page) const
+{
+    std::unique_ptr<meow::db::QueryDataFetcher> queryDataFetcher(
+        _dbEntity->connection()->createQueryDataFetcher());
+
+    // by keys of page rows: rows inserted or deleted since don't shift it
+    meow::db::QueryCriteria queryCritera;
+    fillSelectCriteria(queryDataFetcher.get(), &queryCritera);
+    queryCritera.noLimit = true;
+    queryCritera.rangeFirstKeyValues = page.firstKeyValues;
+    queryCritera.rangeLastKeyValues = page.lastKeyValues;
+
+    return queryDataFetcher->selectSQL(&queryCritera);
+}
+
+void DataTableModel::applyColumnsSortTo(db::QueryCriteria * criteria) const
+{
+    if (_columnsSort.empty()) {
+        return;
+    }
+
+    QStringList columnNames;
+
+    if (_dbEntity->type() == meow::db::Entity::Type::Table) {
+        auto table = static_cast<meow::db::TableEntity *>(_dbEntity);
+        columnNames = table->structure()->columnNames();
+    } else if (_dbEntity->type() == meow::db::Entity::Type::View) {
+        auto view = static_cast<meow::db::ViewEntity *>(_dbEntity);
+        columnNames = view->structure()->columnNames();
     }
 
-    if (!_columnsSort.empty()) {
+    for (const SortColumn & sort : _columnsSort) {
+
+        int columnIndex = sort.columnIndex;
+        bool isAscending = (sort.sortOrder == Qt::AscendingOrder);
 
-        QStringList columnNames;
+        if (columnIndex < columnNames.size()) {
 
-        if (_dbEntity->type() == meow::db::Entity::Type::Table) {
-            auto table = static_cast<meow::db::TableEntity *>(_dbEntity);
-            columnNames = table->structure()->columnNames();
-        } else if (_dbEntity->type() == meow::db::Entity::Type::View) {
-            auto view = static_cast<meow::db::ViewEntity *>(_dbEntity);
-            columnNames = view->structure()->columnNames();
+            db::QueryCriteria::SortColumn sort;
+            sort.columnName = columnNames[columnIndex];
+            sort.isAsc = isAscending;
+
+            criteria->sortColumns.push_back(sort);
         }
+    }
+}
 
-        for (const SortColumn & sort : _columnsSort) {
+QString DataTableModel::exportSQL() const
+{
+    Q_ASSERT(_dbEntity != nullptr);
 
-            int columnIndex = sort.columnIndex;
-            bool isAscending = (sort.sortOrder == Qt::AscendingOrder);
+    std::unique_ptr<meow::db::QueryDataFetcher> queryDataFetcher(
+        _dbEntity->connection()->createQueryDataFetcher());
 
-            if (columnIndex < columnNames.size()) {
+    // full values of all rows, so no select list for long texts
+    meow::db::QueryCriteria queryCritera;
+    queryCritera.quotedDbAndTableName = meow::db::quotedFullName(_dbEntity);
+    queryCritera.where = _whereFilter;
+    queryCritera.noLimit = true;
+
+    applyColumnsSortTo(&queryCritera);
+
+    return queryDataFetcher->selectSQL(&queryCritera);
+}
 
-                db::QueryCriteria::SortColumn sort;
-                sort.columnName = columnNames[columnIndex];
-                sort.isAsc = isAscending;
+void DataTableModel::reloadReleasedRows(const std::vector<int> & rows)
+{
+    MEOW_ASSERT_MAIN_THREAD
+
+    if (_dbEntity == nullptr) {
+        return;
+    }
 
-                queryCritera.sortColumns.push_back(sort);
+    std::vector<int> pageIndexes;
+    if (rows.empty()) {
+        for (std::size_t i = 0; i < _pages.size(); ++i) {
+            pageIndexes.push_back(static_cast<int>(i));
+        }
+    } else {
+        for (int row : rows) {
+            int pageIndex = pageIndexForRow(row);
+            if (pageIndex != -1 && (pageIndexes.empty()
+                                    || pageIndexes.back() != pageIndex)) {
+                pageIndexes.push_back(pageIndex); // rows are sorted
             }
         }
     }
 
-    if (queryData()->query() == nullptr) {
-        queryData()->setQueryPtr( // TODO: what a shitty code?
-            _dbEntity->connection()->createQuery()
-        );
-        queryData()->query()->setEntity(_dbEntity);
+    meow::db::Connection * connection = dataConnection();
+    threads::DbThread * thread = connection->thread();
+
+    for (int pageIndex : pageIndexes) {
+        if (!_pages[pageIndex].isReleased) {
+            continue; // also if reloaded meanwhile by events of loop below
+        }
+
+        QStringList firstKeyValues = _pages[pageIndex].firstKeyValues;
+
+        // own task: current load task may be appending next page
+        std::shared_ptr<threads::TableDataTask> task
+                = thread->createTableDataTask(pageSQL(_pages[pageIndex]),
+                                              _dbEntity);
+
+        QEventLoop loop;
+        bool isFinished = false;
+
+        connect(task.get(), &threads::ThreadTask::finished,
+                &loop, [&isFinished, &loop]() {
+            isFinished = true;
+            loop.quit();
+        });
+
+        // without thread task runs and finishes in postTask()
+        thread->postTask(task);
+        if (!isFinished) {
+            loop.exec();
+        }
+
+        if (task->isFailed()) {
+            throw meow::db::Exception(task->errorMessage());
+        }
+        if (_pages.size() <= static_cast<std::size_t>(pageIndex)
+                || _pages[pageIndex].firstKeyValues != firstKeyValues) {
+            throw meow::db::Exception(tr("Data was reloaded, try again"));
+        }
+        if (_pages[pageIndex].isReleased
+                && !replacePageRows(pageIndex, task->query())) {
+            throw meow::db::Exception(
+                tr("Rows have changed since they were loaded,"
+                   " refresh data and try again"));
+        }
     }
-    queryDataFetcher->run(&queryCritera, queryData());
+}
 
-    _entityChangedProcessed = true;
+void DataTableModel::setKeepAllRows(bool keep)
+{
+    _keepAllRows = keep;
+    if (!keep) {
+        releaseFarPages(-1);
+    }
+}
+
+bool DataTableModel::isLoading() const
+{
+    return _loadTask != nullptr;
+}
+
+void DataTableModel::cancelLoading(bool killQuery)
+{
+    if (!_loadTask) {
+        return;
+    }
+
+    std::shared_ptr<threads::TableDataTask> task = _loadTask;
+    _loadTask.reset();
+    _loadAllRows = false;
+    _loadReloadsPage = -1; // page stays released, reloaded when shown again
+
+    task->disconnect(this);
+    task->abort();
+
+    meow::db::Connection * connection = task->connection();
+
+    if (killQuery && task->isExecuting()
+            && connection->features()->supportsCancellingQuery()) {
+        try {
+            connection->createQueryKiller()->run();
+        } catch(meow::db::Exception & ex) {
+            meowLogC(Log::Category::Error)
+                << "Failed to cancel table data loading: " << ex.message();
+        }
+    }
+
+    if (!_loadAppends && columnCount() == 0) {
+        _entityChangedProcessed = false; // nothing is shown, load next time
+    }
+
+    emit loadingStateChanged(false); // rows received before cancel stay
+}
+
+void DataTableModel::startLoadTask(const QString & SQL,
+                                   bool append,
+                                   int reloadPage)
+{
+    meow::db::Connection * connection = dataConnection();
+
+    if (connection->features()->supportsCancellingQuery()) {
+        try {
+            // get id before async execution to allow KILL from main thread
+            connection->connectionIdOnServer();
+        } catch(meow::db::Exception & ex) {
+            Q_UNUSED(ex);
+        }
+    }
+
+    threads::DbThread * thread = connection->thread();
+
+    // keep local ref: without thread task runs and finishes in postTask()
+    std::shared_ptr<threads::TableDataTask> task
+            = thread->createTableDataTask(SQL, _dbEntity);
+    task->setStreamResults(
+        meow::app()->settings()->dataFetching()->streamQueryResults());
+
+    connect(task.get(), &threads::TableDataTask::queryExecuted,
+            this, &DataTableModel::onLoadTaskQueryExecuted);
+    connect(task.get(), &threads::TableDataTask::rowsReceived,
+            this, &DataTableModel::onLoadTaskRowsReceived);
+    connect(task.get(), &threads::ThreadTask::finished,
+            this, &DataTableModel::onLoadTaskFinished); // before post!
+
+    _loadTask = task;
+    _loadAppends = append;
+    _loadReloadsPage = reloadPage;
+
+    emit loadingStateChanged(true);
+
+    thread->postTask(task);
+}
+
+meow::db::Connection * DataTableModel::dataConnection()
+{
+    if (_dataConnection) { // next pages go to the same connection as rows
+        return _dataConnection.get();
+    }
+
+    meow::db::Connection * connection = _dbEntity->connection();
+
+    // keep main connection free for metadata while rows are loading
+    meow::db::ConnectionPool * pool = connection->pool();
+    if (pool) {
+        try {
+            _dataConnection = pool->acquire(); // nullptr if pool is full
+        } catch(meow::db::Exception & ex) {
+            meowLogCC(Log::Category::Error, connection)
+                << "Pooled connection failed: " << ex.message();
+        }
+    }
+
+    return _dataConnection ? _dataConnection.get() : connection;
+}
+
+void DataTableModel::onConnectionClose(meow::db::SessionEntity * session)
+{
+    if (_dbEntity && _dbEntity->connection() == session->connection()) {
+        setEntity(nullptr, false);
+    }
+}
+
+void DataTableModel::onLoadTaskQueryExecuted()
+{
+    MEOW_ASSERT_MAIN_THREAD
+
+    if (sender() != _loadTask.get()) {
+        return; // cancelled
+    }
+
+    if (_loadAppends || _loadReloadsPage != -1) {
+        return; // rows are appended when the page is received completely
+    }
+
+    queryData()->setQueryPtr(_loadTask->query());
+
+    insertLoadedColumns();
+    insertFetchedRows();
+
+    emit loadingProgress();
+}
+
+void DataTableModel::onLoadTaskRowsReceived()
+{
+    MEOW_ASSERT_MAIN_THREAD
+
+    if (sender() != _loadTask.get() || _loadAppends
+            || _loadReloadsPage != -1) {
+        return;
+    }
+
+    insertFetchedRows();
 
+    emit loadingProgress();
+}
+
+void DataTableModel::onLoadTaskFinished()
+{
+    MEOW_ASSERT_MAIN_THREAD
+
+    if (sender() != _loadTask.get()) {
+        return;
+    }
+
+    std::shared_ptr<threads::TableDataTask> task = _loadTask;
+    _loadTask.reset();
+
+    int reloadPage = _loadReloadsPage;
+    _loadReloadsPage = -1;
+
+    if (task->isFailed()) {
+        if (reloadPage != -1) {
+            _pages[reloadPage].isWanted = false; // not repeated on every paint
+        } else if (_loadAppends) {
+            _fetchMoreFailed = true; // don't repeat on every scroll
+        } else if (columnCount() == 0) {
+            _entityChangedProcessed = false;
+        }
+        _loadAllRows = false;
+        emit loadingStateChanged(false);
+        emit loadDataError(task->errorMessage());
+        return;
+    }
+
+    if (reloadPage != -1) {
+        replacePageRows(reloadPage, task->query());
+        emit loadingStateChanged(false);
+        releaseFarPages(reloadPage);
+        queueWantedPagesReload();
+        if (_loadAllRows) {
+            QMetaObject::invokeMethod(this, "loadNextPageOfAllRows",
+                                      Qt::QueuedConnection);
+        }
+        return;
+    }
+
+    int prevRowCount = rowCount();
+    meow::db::ulonglong firstStoredRow = _loadAppends ? storedRowCount() : 0;
+
+    if (_loadAppends) {
+        if (queryData()->query()) {
+            queryData()->query()->appendData(*task->query());
+        } else {
+            queryData()->setQueryPtr(task->query());
+        }
+    } else if (queryData()->query() != task->query().get()) {
+        queryData()->setQueryPtr(task->query());
+    }
+
+    insertLoadedColumns();
+    insertFetchedRows();
+
+    if (rowCount() > prevRowCount || !_loadAppends) {
+        rememberLastKeyValues();
+    }
+
+    if (!_loadAppends) {
+        _pages.clear();
+    }
+    if (!task->query()->isFetchLimited()) { // else LIMIT gives more rows
+        addLoadedPage(firstStoredRow);
+    }
+    releaseFarPages(static_cast<int>(_pages.size()) - 1);
+
+    emit loadingStateChanged(false);
+
+    if (_loadAppends) {
+        emit moreRowsLoaded();
+    } else {
+        emit dataLoaded();
+    }
+
+    if (_loadAllRows) { // queued: without thread tasks run synchronously
+        QMetaObject::invokeMethod(this, "loadNextPageOfAllRows",
+                                  Qt::QueuedConnection);
+    }
+
+    queueWantedPagesReload();
+}
+
+meow::db::ulonglong DataTableModel::storedRowCount() const
+{
+    const meow::db::QueryData * data = queryData();
+    if (data->query() == nullptr || data->resultCount() == 0) {
+        return 0;
+    }
+    return data->currentResult()->storedRowCount();
+}
+
+int DataTableModel::pageIndexForRow(int row) const
+{
+    if (_pages.empty() || row < 0 || row >= rowCount()) {
+        return -1;
+    }
+
+    meow::db::ulonglong storedRow = static_cast<meow::db::ulonglong>(row);
+
+    const meow::db::QueryData * data = queryData();
+    if (data->query() && data->resultCount() > 0) {
+        meow::db::QueryResultPt result = data->currentResult();
+        if (result->isEditing()) { // inserted/deleted rows shift numbers
+            int sourceRow = result->editableData()->sourceRowAt(row);
+            if (sourceRow < 0) {
+                return -1;
+            }
+            storedRow = static_cast<meow::db::ulonglong>(sourceRow);
+        }
+    }
+
+    auto it = std::upper_bound(_pages.begin(), _pages.end(), storedRow,
+        [](meow::db::ulonglong value, const Page & page) {
+            return value < page.firstRow;
+        });
+    if (it == _pages.begin()) {
+        return -1;
+    }
+    --it;
+    if (storedRow >= it->firstRow + it->rowCount) {
+        return -1;
+    }
+    return static_cast<int>(it - _pages.begin());
+}
+
+bool DataTableModel::isRowReleased(int row) const
+{
+    int pageIndex = pageIndexForRow(row);
+    return pageIndex != -1 && _pages[pageIndex].isReleased;
+}
+
+bool DataTableModel::canReleasePages() const
+{
+    const meow::db::QueryData * data = queryData();
+    if (data->query() == nullptr || data->resultCount() == 0) {
+        return false;
+    }
+    // quick filter reads all rows, edited row keeps reading its source row,
+    // overlay of inserted/deleted rows maps to source rows of the time
+    return !_keepAllRows
+            && data->currentResult()->canReleaseRows()
+            && !data->currentResult()->isEditing()
+            && filterPattern().isEmpty()
+            && _pages.size() > 1;
+}
+
+void DataTableModel::addLoadedPage(meow::db::ulonglong firstRow)
+{
+    meow::db::ulonglong lastRow = storedRowCount();
+    if (lastRow <= firstRow) {
+        return;
+    }
+
+    Page page;
+    page.firstRow = firstRow;
+    page.rowCount = lastRow - firstRow;
+    page.lastUsed = ++_pageUseCounter;
+
+    meow::db::QueryResultPt result = queryData()->currentResult();
+    if (_loadSeeksByKey && !result->isEditing()) { // rows are source ones
+        page.firstKeyValues = keyValuesAt(firstRow);
+        page.lastKeyValues = keyValuesAt(lastRow - 1);
+    }
+
+    _pages.push_back(page);
+}
+
+QStringList DataTableModel::keyValuesAt(meow::db::ulonglong row) const
+{
+    QStringList values;
+
+    meow::db::QueryResultPt result = queryData()->currentResult();
+    result->seekRecNo(row);
+    for (const QString & keyColumn : _loadKeyColumns) {
+        QString value = result->curRowColumn(keyColumn, true);
+        if (value.isNull()) { // not selected
+            return QStringList();
+        }
+        values << value;
+    }
+
+    return values;
+}
+
+void DataTableModel::releaseFarPages(int keepPage)
+{
+    if (!canReleasePages()) {
+        return;
+    }
+
+    meow::db::QueryResultPt result = queryData()->currentResult();
+    meow::db::ulonglong maxSize = meow::app()->settings()->dataFetching()
+            ->tableDataMaxBufferSize();
+
+    while (result->dataSize() > maxSize) {
+        int farthest = -1; // least recently shown
+        for (std::size_t i = 0; i < _pages.size(); ++i) {
+            const Page & page = _pages[i];
+            if (static_cast<int>(i) == keepPage || page.isReleased
+                    || page.firstKeyValues.isEmpty()) { // can't be reloaded
+                continue;
+            }
+            if (farthest == -1 || page.lastUsed < _pages[farthest].lastUsed) {
+                farthest = static_cast<int>(i);
+            }
+        }
+        if (farthest == -1) {
+            break;
+        }
+        Page & page = _pages[farthest];
+        result->releaseRows(page.firstRow, page.rowCount);
+        page.isReleased = true;
+        page.isWanted = false;
+    }
+}
+
+bool DataTableModel::replacePageRows(int pageIndex,
+                                     const db::QueryPtr & query)
+{
+    Page & page = _pages[pageIndex];
+
+    const meow::db::QueryData * data = queryData();
+    if (data->query() == nullptr || data->resultCount() == 0
+            || query->resultCount() == 0) {
+        return false;
+    }
+
+    meow::db::QueryResultPt result = data->currentResult();
+    meow::db::QueryResultPt pageResult = query->resultAt(0);
+
+    if (pageResult->columnCount() != result->columnCount()
+            || pageResult->storedRowCount() != page.rowCount) {
+        // table is changed, rows don't fit, stay released till refresh
+        meowLogC(Log::Category::Error)
+            << "Failed to reload rows of data page: rows have changed";
+        page.isWanted = false;
+        return false;
+    }
+
+    result->replaceRows(page.firstRow, pageResult);
+    page.isReleased = false;
+    page.lastUsed = ++_pageUseCounter;
+
+    if (result->isEditing()) { // rows may be shifted
+        emit dataChanged(index(0, 0), index(rowCount() - 1, columnCount() - 1));
+    } else {
+        int firstRow = static_cast<int>(page.firstRow);
+        int lastRow = static_cast<int>(page.firstRow + page.rowCount) - 1;
+        emit dataChanged(index(firstRow, 0), index(lastRow, columnCount() - 1));
+    }
+
+    return true;
+}
+
+void DataTableModel::queueWantedPagesReload() const
+{
+    if (_isPageReloadQueued) {
+        return;
+    }
+    _isPageReloadQueued = true;
+    // queued: data() is called while view paints
+    QMetaObject::invokeMethod(const_cast<DataTableModel *>(this),
+                              "reloadWantedPage",
+                              Qt::QueuedConnection);
+}
+
+void DataTableModel::reloadWantedPage()
+{
+    _isPageReloadQueued = false;
+
+    if (isLoading() || _dbEntity == nullptr) {
+        return; // requeued when current task finishes
+    }
+
+    int wanted = -1; // most recently shown
+    for (std::size_t i = 0; i < _pages.size(); ++i) {
+        const Page & page = _pages[i];
+        if (!page.isReleased || !page.isWanted) {
+            continue;
+        }
+        if (wanted == -1 || page.lastUsed > _pages[wanted].lastUsed) {
+            wanted = static_cast<int>(i);
+        }
+    }
+
+    if (wanted == -1) {
+        return;
+    }
+
+    _pages[wanted].isWanted = false;
+    startLoadTask(pageSQL(_pages[wanted]), false, wanted);
+}
+
+void DataTableModel::insertLoadedColumns()
+{
+    int prevColCount = columnCount();
     int newColumnCount = queryData()->columnCount();
 
     if (newColumnCount > prevColCount) {
@@ -264,17 +911,28 @@ void DataTableModel::loadData(bool force)
         setColumnCount(newColumnCount); // tell the model we have change in data
         endInsertColumns();
     }
+}
 
-    int newRowCount = queryData()->rowCount();
+void DataTableModel::rememberLastKeyValues()
+{
+    _lastKeyValues.clear();
 
-    if (newRowCount > prevRowCount) {
-        // Qt models require actual change in data to happen between
-        // beginInsertRows and endInsertRows. Since we got data from query
-        // emulate this by settings row count by hand. Otherwise proxy models
-        // go crazy.
-        beginInsertRows(QModelIndex(), prevRowCount, newRowCount-1);
-        setRowCount(newRowCount);
-        endInsertRows();
+    int rowCount = this->rowCount();
+
+    if (_loadKeyColumns.isEmpty() || rowCount == 0) {
+        return;
+    }
+
+    // new rows are appended to the end even when editing
+    meow::db::QueryResultPt result = queryData()->currentResult();
+    result->seekRecNo(rowCount - 1);
+    for (const QString & keyColumn : _loadKeyColumns) {
+        QString value = result->curRowColumn(keyColumn, true);
+        if (value.isNull()) { // not selected, fall back to offset
+            _lastKeyValues.clear();
+            break;
+        }
+        _lastKeyValues << value;
     }
 }
 
@@ -483,7 +1141,6 @@ void DataTableModel::refresh()
 {
     removeData();
     loadData(true);
-    emit dataRefreshed();
 }
 
 void DataTableModel::invalidateData()
@@ -503,6 +1160,13 @@ QString DataTableModel::rowCountStats() const
     }
     result += _dbEntity->name();
 
+    if (isLoading()) { // connection is busy, no row count query
+        result += ": " + QObject::tr("loading") + " ";
+        result += meow::helpers::formatNumber(rowCount()) + " ";
+        result += QObject::tr("rows") + " ...";
+        return result;
+    }
+
     if (_dbEntity->type() == meow::db::Entity::Type::Table) {
 
         meow::db::TableEntity * table =
@@ -543,9 +1207,38 @@ QString DataTableModel::rowCountStats() const
     return result;
 }
 
-void DataTableModel::setNoRowsCountLimit()
+void DataTableModel::loadAllData()
+{
+    // page by page to stop at buffer size limit and to seek pages by key,
+    // next page is requested when previous one is loaded
+    _loadAllRows = true;
+    loadNextPageOfAllRows();
+}
+
+void DataTableModel::loadNextPageOfAllRows()
 {
-    _wantedRowsCount = meow::db::DATA_MAX_ROWS;
+    if (!_loadAllRows) { // cancelled
+        return;
+    }
+
+    if (isLoading()) { // e.g. released page, continued when it is loaded
+        return;
+    }
+
+    if (!canLoadMoreData()) {
+        _loadAllRows = false;
+        return;
+    }
+
+    _wantedRowsCount = static_cast<meow::db::ulonglong>(rowCount())
+            + meow::db::DATA_ROWS_PER_STEP * 10;
+
+    try {
+        loadData(true);
+    } catch(meow::db::Exception & ex) {
+        _loadAllRows = false;
+        emit loadDataError(ex.message());
+    }
 }
 
 void DataTableModel::incRowsCountForOneStep(bool reset)
@@ -554,9 +1247,6 @@ void DataTableModel::incRowsCountForOneStep(bool reset)
         _wantedRowsCount = 0;
     }
     _wantedRowsCount += meow::db::DATA_ROWS_PER_STEP;
-    if (_wantedRowsCount > meow::db::DATA_MAX_ROWS) {
-        _wantedRowsCount = meow::db::DATA_MAX_ROWS;
-    }
 }
 
 bool DataTableModel::isLimited() const
@@ -569,9 +1259,25 @@ bool DataTableModel::isFiltered() const
     return !_whereFilter.isEmpty();
 }
 
-bool DataTableModel::allDataLoaded() const
+bool DataTableModel::isDataSizeLimited() const
+{
+    const meow::db::QueryData * data = queryData();
+    if (data->query() == nullptr || data->resultCount() == 0) {
+        return false;
+    }
+    meow::db::ulonglong maxSize = meow::app()->settings()->dataFetching()
+            ->tableDataMaxBufferSize();
+    // far pages are released to load next ones
+    return data->currentResult()->dataSize() >= maxSize && !canReleasePages();
+}
+
+bool DataTableModel::canLoadMoreData() const
 {
-    return !isLimited() || (_wantedRowsCount == meow::db::DATA_MAX_ROWS);
+    return _dbEntity != nullptr
+            && _entityChangedProcessed
+            && !isLoading()
+            && isLimited()
+            && !isDataSizeLimited();
 }
 
 void DataTableModel::applyWhereFilter(const QString & whereFilter)
@@ -2,6 +2,7 @@
 #define DATA_TABLE_MODEL_H
 
 #include <QObject>
+#include <memory>
 #include "base_data_table_model.h"
 #include "db/common.h"
 #include "ui/delegates/edit_query_data_delegate.h"
@@ -15,12 +16,22 @@ namespace meow {
 
 namespace db {
 class TableColumn;
+class SessionEntity;
+class QueryCriteria;
+class QueryDataFetcher;
+}
+
+namespace threads {
+class TableDataTask;
 }
 
 namespace ui {
 namespace models {
 
 // Intent: model for Table or View
+// Rows are loaded by pages on scroll. When decoded rows exceed the buffer
+// size, least recently shown pages are released and selected again by the
+// same SQL (next rows after key of previous page) once they are shown.
 class DataTableModel : public BaseDataTableModel,
                        public delegates::IItemDelegateConfig
 {
@@ -30,6 +41,7 @@ public:
     virtual ~DataTableModel() override;
 
     virtual Qt::ItemFlags flags(const QModelIndex &index) const override;
+    virtual QVariant data(const QModelIndex &index, int role) const override;
     virtual bool setData(const QModelIndex &index,
                  const QVariant &value,
                  int role = Qt::EditRole) override;
@@ -38,19 +50,34 @@ public:
     virtual QVariant headerData(int section, Qt::Orientation orientation,
                         int role = Qt::DisplayRole) const override;
 
+    // infinite scroll: next rows are loaded when view reaches the end
+    virtual bool canFetchMore(const QModelIndex &parent) const override;
+    virtual void fetchMore(const QModelIndex &parent) override;
+
     void setEntity(meow::db::Entity * tableOrViewEntity, bool loadData = true);
     meow::db::Entity * entity() const { return _dbEntity; }
 
     void removeData();
+    // rows are loaded in DbThread, see dataLoaded() and moreRowsLoaded()
     void loadData(bool force = false);
+    bool isLoading() const;
+    void cancelLoading(bool killQuery = true);
     void refresh();
     void invalidateData();
-
-    void setNoRowsCountLimit();
+    // SELECT of all rows with current filter and sort, see streamed export
+    QString exportSQL() const;
+    // Selects released pages of rows again (all if rows are empty) and
+    // waits for them, e.g. to read rows for export. Throws db::Exception
+    void reloadReleasedRows(const std::vector<int> & rows = {});
+    // true to keep loaded pages in memory over buffer size limit
+    void setKeepAllRows(bool keep);
+
+    void loadAllData();
     void incRowsCountForOneStep(bool reset = false);
     bool isLimited() const;
     bool isFiltered() const;
-    bool allDataLoaded() const;
+    bool isDataSizeLimited() const;
+    bool canLoadMoreData() const;
 
     void applyWhereFilter(const QString & whereFilter);
     void resetWhereFilter();
@@ -76,7 +103,11 @@ public:
     QList<db::TableColumn *> selectedTableColumns();
 
     Q_SIGNAL void editingStarted();
-    Q_SIGNAL void dataRefreshed();
+    Q_SIGNAL void dataLoaded(); // first page of (re)loaded data
+    Q_SIGNAL void moreRowsLoaded();
+    Q_SIGNAL void loadingProgress();
+    Q_SIGNAL void loadingStateChanged(bool isLoading);
+    Q_SIGNAL void loadDataError(const QString & message);
 
     void changeColumnSort(int columnIndex);
     bool isColumnSorted(int columnIndex) const;
@@ -86,10 +117,66 @@ public:
 
 private:
 
+    struct Page;
+
+    void startLoadTask(const QString & SQL, bool append, int reloadPage = -1);
+    // table, filter, select list, keys and sort of shown rows
+    void fillSelectCriteria(meow::db::QueryDataFetcher * fetcher,
+                            meow::db::QueryCriteria * criteria) const;
+    void applyColumnsSortTo(meow::db::QueryCriteria * criteria) const;
+    QString pageSQL(const Page & page) const; // selects rows of page again
+    QStringList keyValuesAt(meow::db::ulonglong row) const; // empty if none
+    meow::db::Connection * dataConnection();
+    Q_SLOT void loadNextPageOfAllRows();
+    void insertLoadedColumns();
+    void rememberLastKeyValues();
+
+    Q_SLOT void onLoadTaskQueryExecuted();
+    Q_SLOT void onLoadTaskRowsReceived();
+    Q_SLOT void onLoadTaskFinished();
+    Q_SLOT void onConnectionClose(meow::db::SessionEntity * session);
+
+    meow::db::ulonglong storedRowCount() const;
+    int pageIndexForRow(int row) const; // -1 if row is not in pages
+    bool isRowReleased(int row) const;
+    bool canReleasePages() const;
+    void addLoadedPage(meow::db::ulonglong firstRow);
+    void releaseFarPages(int keepPage);
+    // false if rows have changed and page stays released
+    bool replacePageRows(int pageIndex, const db::QueryPtr & query);
+    void queueWantedPagesReload() const;
+    Q_SLOT void reloadWantedPage();
+
     bool _entityChangedProcessed;
+    bool _fetchMoreFailed; // no auto loading until refresh
     meow::db::Entity * _dbEntity;
     meow::db::ulonglong _wantedRowsCount;
     QString _whereFilter;
+    QStringList _lastKeyValues; // of last loaded row, to seek the next page
+    QStringList _loadKeyColumns;
+    std::shared_ptr<threads::TableDataTask> _loadTask;
+    bool _loadAppends; // current task loads next page
+    bool _loadAllRows;
+    meow::db::ConnectionPtr _dataConnection; // pooled, rows and edits use it
+
+    struct Page
+    {
+        meow::db::ulonglong firstRow = 0; // in result storage
+        meow::db::ulonglong rowCount = 0;
+        // keys of first and last rows, empty if page can't be released
+        QStringList firstKeyValues;
+        QStringList lastKeyValues;
+        bool isReleased = false;
+        mutable quint64 lastUsed = 0; // when rows were shown
+        mutable bool isWanted = false; // shown while released
+    };
+
+    std::vector<Page> _pages; // by first row
+    bool _loadSeeksByKey; // rows are sorted by _loadKeyColumns
+    int _loadReloadsPage; // index of released page being loaded, -1 if none
+    bool _keepAllRows; // rows are being read, e.g. exported
+    mutable quint64 _pageUseCounter;
+    mutable bool _isPageReloadQueued;
 
     struct SortColumn
     {
@@ -221,6 +221,16 @@ void DatabaseEntitiesTableModel::setDataBase(
                    &meow::db::SessionEntity::entityInserted,
                    this,
                    &DatabaseEntitiesTableModel::onEntityInserted);
+
+        disconnect(_session.get(),
+                   &meow::db::SessionEntity::databaseEntitiesRefreshed,
+                   this,
+                   &DatabaseEntitiesTableModel::onDatabaseEntitiesRefreshed);
+
+        disconnect(_session.get(),
+                   &meow::db::SessionEntity::tablesStatusFetched,
+                   this,
+                   &DatabaseEntitiesTableModel::onTablesStatusFetched);
     }
 
     // retain database and its session
@@ -236,6 +246,14 @@ void DatabaseEntitiesTableModel::setDataBase(
                    &meow::db::SessionEntity::entityInserted,
                    this,
                    &DatabaseEntitiesTableModel::onEntityInserted);
+        connect(_session.get(),
+                   &meow::db::SessionEntity::databaseEntitiesRefreshed,
+                   this,
+                   &DatabaseEntitiesTableModel::onDatabaseEntitiesRefreshed);
+        connect(_session.get(),
+                   &meow::db::SessionEntity::tablesStatusFetched,
+                   this,
+                   &DatabaseEntitiesTableModel::onTablesStatusFetched);
     }
 
     insertAllRows();
@@ -304,6 +322,25 @@ int DatabaseEntitiesTableModel::entitiesCount() const
     return _entities.size();
 }
 
+void DatabaseEntitiesTableModel::onDatabaseEntitiesRefreshed(
+        meow::db::DataBaseEntity * database)
+{
+    if (database != _database.get()) return;
+
+    removeAllRows();
+    insertAllRows();
+}
+
+void DatabaseEntitiesTableModel::onTablesStatusFetched(
+        meow::db::DataBaseEntity * database)
+{
+    if (database != _database.get()) return;
+    if (!entitiesCount()) return;
+
+    emit dataChanged(index(0, 0),
+                     index(entitiesCount() - 1, columnCount() - 1));
+}
+
 } // namespace models
 } // namespace ui
 } // namespace meow
@@ -62,6 +62,9 @@ private:
 
     Q_SLOT void afterEntityRemoved(const meow::db::EntityPtr & entity);
     Q_SLOT void onEntityInserted(const meow::db::EntityPtr & entity);
+    Q_SLOT void onDatabaseEntitiesRefreshed(
+            meow::db::DataBaseEntity * database);
+    Q_SLOT void onTablesStatusFetched(meow::db::DataBaseEntity * database);
 
     int entitiesCount() const;
 
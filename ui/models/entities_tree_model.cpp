@@ -91,6 +91,11 @@ EntitiesTreeModel::EntitiesTreeModel(
             &meow::db::ConnectionsManager::activeDatabaseChanged,
             this,
             &models::EntitiesTreeModel::onDatabasesDataChanged);
+
+    connect(_dbConnectionsManager,
+            &meow::db::ConnectionsManager::databaseEntitiesRefreshed,
+            this,
+            &models::EntitiesTreeModel::onDatabaseEntitiesRefreshed);
 }
 
 Qt::ItemFlags EntitiesTreeModel::flags(const QModelIndex &index) const
@@ -568,6 +573,44 @@ void EntitiesTreeModel::onDatabasesDataChanged()
     }
 }
 
+void EntitiesTreeModel::onDatabaseEntitiesRefreshed(
+        meow::db::DataBaseEntity * database)
+{
+    TreeItem * databaseItem = itemForEntity(database);
+    if (!databaseItem) {
+        return;
+    }
+
+    QModelIndex databaseIndex = indexForEntity(database);
+
+    int oldCount = databaseItem->children.size();
+    if (oldCount > 0) {
+        beginRemoveRows(databaseIndex, 0, oldCount - 1);
+        databaseItem->removeChildren(0, oldCount);
+        endRemoveRows();
+    }
+
+    if (!databaseItem->childrenAdded) {
+        return; // added on fetchMore()
+    }
+
+    int newCount = 0;
+    try {
+        newCount = database->childCount();
+    } catch(meow::db::Exception & ex) {
+        emit loadDataError(ex.what());
+        return;
+    }
+
+    if (newCount > 0) {
+        beginInsertRows(databaseIndex, 0, newCount - 1);
+        for (int i = 0; i < newCount; ++i) {
+            databaseItem->appendChild(database->child(i)->retain());
+        }
+        endInsertRows();
+    }
+}
+
 bool EntitiesTreeModel::canFetchMore(const QModelIndex & parent) const
 {
     if (!parent.isValid())
@@ -85,6 +85,8 @@ private:
     Q_SLOT void onEntityInserted(meow::db::Entity * entity);
 
     Q_SLOT void onDatabasesDataChanged();
+    Q_SLOT void onDatabaseEntitiesRefreshed(
+            meow::db::DataBaseEntity * database);
 
     void reinitItems();
     void removeData();
@@ -42,6 +42,12 @@ bool QueryDataSortFilterProxyModel::lessThan(
     switch (columnType) {
 
     case db::DataTypeCategoryIndex::Integer: {
+        qint64 leftValue = 0;
+        qint64 rightValue = 0;
+        if (_queryData->integerDataAt(left.row(), left.column(), &leftValue)
+         && _queryData->integerDataAt(right.row(), right.column(), &rightValue)) {
+            return leftValue < rightValue; // decoded from binary, no parsing
+        }
         // Use biggest int type so even huge values don't overflow
         // TODO: still overflows if uint64_t and value > max<int64_t>()
         qlonglong leftData = sourceModel()->data(left).toLongLong();
@@ -51,6 +57,12 @@ bool QueryDataSortFilterProxyModel::lessThan(
     }
 
     case db::DataTypeCategoryIndex::Float: {
+        double leftValue = 0;
+        double rightValue = 0;
+        if (_queryData->floatDataAt(left.row(), left.column(), &leftValue)
+         && _queryData->floatDataAt(right.row(), right.column(), &rightValue)) {
+            return leftValue < rightValue;
+        }
         // Use double not float so even huge values don't overlow
         double leftData = sourceModel()->data(left).toDouble();
         double rightData = sourceModel()->data(right).toDouble();;
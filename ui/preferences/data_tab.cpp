@@ -0,0 +1,126 @@
+#include "data_tab.h"
+#include "ui/presenters/preferences_presenter.h"
+
+namespace meow {
+namespace ui {
+namespace preferences {
+
+DataTab::DataTab(presenters::PreferencesPresenter * presenter,
+                 QWidget *parent)
+    : QWidget(parent)
+    , _presenter(presenter)
+{
+    createWidgets();
+    fillDataFromPresenter();
+}
+
+void DataTab::createWidgets()
+{
+    QGridLayout * mainLayout = new QGridLayout;
+    mainLayout->setColumnStretch(0, 2);
+    mainLayout->setAlignment(Qt::AlignTop);
+
+    int row = 0;
+
+    // Stream query results ----------------------------------------------------
+    _streamQueryResultsCheckBox = new QCheckBox(
+        tr("Show first rows of query results while the rest are received"));
+    _streamQueryResultsCheckBox->setToolTip(
+        tr("Connection stays busy until all rows are received or loading"
+           " is cancelled"));
+    mainLayout->addWidget(_streamQueryResultsCheckBox, row, 0);
+    connect(_streamQueryResultsCheckBox, &QCheckBox::toggled,
+            [=](bool checked) {
+                _presenter->setStreamQueryResults(checked);
+            });
+    row++;
+
+    // Run queries in parallel -------------------------------------------------
+    _runQueriesInParallelCheckBox = new QCheckBox(
+        tr("Run independent SELECT queries of a batch in parallel"
+           " connections"));
+    _runQueriesInParallelCheckBox->setToolTip(
+        tr("Each query takes its own pooled connection, session variables"
+           " of the query tab are not seen there"));
+    mainLayout->addWidget(_runQueriesInParallelCheckBox, row, 0);
+    connect(_runQueriesInParallelCheckBox, &QCheckBox::toggled,
+            [=](bool checked) {
+                _presenter->setRunReadOnlyQueriesInParallel(checked);
+            });
+    row++;
+
+    // Receive binary results --------------------------------------------------
+    _receiveBinaryResultsCheckBox = new QCheckBox(
+        tr("Receive PostgreSQL query results in binary format"));
+    _receiveBinaryResultsCheckBox->setToolTip(
+        tr("Numbers and dates are not parsed from text, but each SELECT"
+           " is described by server first"));
+    mainLayout->addWidget(_receiveBinaryResultsCheckBox, row, 0);
+    connect(_receiveBinaryResultsCheckBox, &QCheckBox::toggled,
+            [=](bool checked) {
+                _presenter->setReceiveBinaryResults(checked);
+            });
+    row++;
+
+    // Load table rows on scroll -----------------------------------------------
+    _loadTableRowsOnScrollCheckBox = new QCheckBox(
+        tr("Load next rows of table data when scrolled to the end"));
+    mainLayout->addWidget(_loadTableRowsOnScrollCheckBox, row, 0);
+    connect(_loadTableRowsOnScrollCheckBox, &QCheckBox::toggled,
+            [=](bool checked) {
+                _presenter->setLoadTableRowsOnScroll(checked);
+            });
+    row++;
+
+    // Table data max buffer size ----------------------------------------------
+    _tableDataMaxBufferSizeLabel = new QLabel(
+        tr("Keep in memory rows of table data up to (MB):"));
+    _tableDataMaxBufferSizeLabel->setToolTip(
+        tr("Rows of far pages are released above this size and loaded"
+           " again when shown"));
+    mainLayout->addWidget(_tableDataMaxBufferSizeLabel, row, 0);
+    _tableDataMaxBufferSizeSpinBox = new QSpinBox();
+    _tableDataMaxBufferSizeSpinBox->setMinimum(1);
+    _tableDataMaxBufferSizeSpinBox->setMaximum(64 * 1024);
+    _tableDataMaxBufferSizeLabel->setBuddy(_tableDataMaxBufferSizeSpinBox);
+    mainLayout->addWidget(_tableDataMaxBufferSizeSpinBox, row, 1);
+    connect(_tableDataMaxBufferSizeSpinBox,
+            static_cast<void(QSpinBox::*)(int)>(&QSpinBox::valueChanged),
+            [=](int size) {
+                _presenter->setTableDataMaxBufferSizeMB(size);
+            });
+    row++;
+
+    this->setLayout(mainLayout);
+}
+
+void DataTab::fillDataFromPresenter()
+{
+    _streamQueryResultsCheckBox->blockSignals(true);
+    _streamQueryResultsCheckBox->setChecked(_presenter->streamQueryResults());
+    _streamQueryResultsCheckBox->blockSignals(false);
+
+    _runQueriesInParallelCheckBox->blockSignals(true);
+    _runQueriesInParallelCheckBox->setChecked(
+        _presenter->runReadOnlyQueriesInParallel());
+    _runQueriesInParallelCheckBox->blockSignals(false);
+
+    _receiveBinaryResultsCheckBox->blockSignals(true);
+    _receiveBinaryResultsCheckBox->setChecked(
+        _presenter->receiveBinaryResults());
+    _receiveBinaryResultsCheckBox->blockSignals(false);
+
+    _loadTableRowsOnScrollCheckBox->blockSignals(true);
+    _loadTableRowsOnScrollCheckBox->setChecked(
+        _presenter->loadTableRowsOnScroll());
+    _loadTableRowsOnScrollCheckBox->blockSignals(false);
+
+    _tableDataMaxBufferSizeSpinBox->blockSignals(true);
+    _tableDataMaxBufferSizeSpinBox->setValue(
+        _presenter->tableDataMaxBufferSizeMB());
+    _tableDataMaxBufferSizeSpinBox->blockSignals(false);
+}
+
+} // namespace preferences
+} // namespace ui
+} // namespace meow
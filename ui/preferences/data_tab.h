@@ -0,0 +1,39 @@
+#ifndef UI_PREFERENCES_DATA_TAB_H
+#define UI_PREFERENCES_DATA_TAB_H
+
+#include <QtWidgets>
+
+namespace meow {
+namespace ui {
+
+namespace presenters {
+    class PreferencesPresenter;
+}
+
+namespace preferences {
+
+class DataTab : public QWidget
+{
+    Q_OBJECT
+public:
+    explicit DataTab(presenters::PreferencesPresenter * presenter,
+                     QWidget *parent = nullptr);
+private:
+    void createWidgets();
+    void fillDataFromPresenter();
+
+    presenters::PreferencesPresenter * _presenter;
+
+    QCheckBox * _streamQueryResultsCheckBox;
+    QCheckBox * _runQueriesInParallelCheckBox;
+    QCheckBox * _receiveBinaryResultsCheckBox;
+    QCheckBox * _loadTableRowsOnScrollCheckBox;
+    QLabel * _tableDataMaxBufferSizeLabel;
+    QSpinBox * _tableDataMaxBufferSizeSpinBox;
+};
+
+} // namespace preferences
+} // namespace ui
+} // namespace meow
+
+#endif // UI_PREFERENCES_DATA_TAB_H
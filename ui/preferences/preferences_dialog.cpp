@@ -1,5 +1,6 @@
 #include "preferences_dialog.h"
 #include "general_tab.h"
+#include "data_tab.h"
 
 namespace meow {
 namespace ui {
@@ -69,6 +70,9 @@ void Dialog::createTabs()
     GeneralTab * generalTab = new GeneralTab(&_presenter);
     _rootTabs->addTab(generalTab, QIcon(":/icons/trigger.png"), tr("General"));
 
+    DataTab * dataTab = new DataTab(&_presenter);
+    _rootTabs->addTab(dataTab, QIcon(":/icons/data.png"), tr("Data"));
+
 }
 
 void Dialog::validateControls()
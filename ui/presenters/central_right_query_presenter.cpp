@@ -1,6 +1,7 @@
 #include "central_right_query_presenter.h"
 #include "db/user_query/user_query.h"
-#include "db/user_query/sentences_parser.h"
+#include "db/user_query/sentence_splitter.h"
+#include "db/common.h"
 #include "db/connection_query_killer.h"
 #include "helpers/formatting.h"
 
@@ -23,19 +24,27 @@ bool CentralRightQueryPresenter::isRunning() const
 bool CentralRightQueryPresenter::execQueries(
         const QString & SQL, int charPosition)
 {
-    meow::db::user_query::SentencesParser parser;
-    QList<meow::db::user_query::Sentence> sentences
-        = parser.parseByDelimiter(SQL);
+    namespace uq = meow::db::user_query;
+
+    uq::SentenceSplitter splitter(SQL);
+    uq::SentenceRef sentence;
+
+    if (charPosition == -1 && SQL.length() > db::SQL_SCRIPT_LAZY_SPLIT_SIZE) {
+        if (!splitter.next(&sentence)) return false;
+        // don't make user wait for splitting of whole dump
+        _query->runScriptInCurrentConnection(SQL);
+        return true;
+    }
 
     QStringList queries;
-    for (const meow::db::user_query::Sentence & sentence : sentences) {
+    while (splitter.next(&sentence)) {
 
         if (charPosition == -1) {
-            queries << sentence.text;
+            queries << sentence.text.toString();
         } else {
             if (sentence.position <= charPosition
                     && charPosition <= (sentence.position + sentence.text.length())) {
-                queries << sentence.text;
+                queries << sentence.text.toString();
                 break;
             }
         }
@@ -48,6 +57,12 @@ bool CentralRightQueryPresenter::execQueries(
     return true;
 }
 
+void CentralRightQueryPresenter::execScriptFile(const QString & filename)
+{
+    // split and run by chunks, no need to load it into editor
+    _query->runScriptFileInCurrentConnection(filename);
+}
+
 bool CentralRightQueryPresenter::hasError() const
 {
     return !_query->lastError().isEmpty();
@@ -80,7 +95,7 @@ QString CentralRightQueryPresenter::resultTabCaption(int index) const
 
 bool CentralRightQueryPresenter::isCancelQueryActionEnabled() const
 {
-    db::Connection * connection = _query->lastRunningConnection();
+    db::Connection * connection = _query->executionConnection();
 
     if (connection
             && connection->features()->supportsCancellingQuery()) {
@@ -95,20 +110,25 @@ bool CentralRightQueryPresenter::cancelQueries()
 
     _query->abort();
 
-    db::Connection * connection = _query->lastRunningConnection();
-
-    if (!connection) return true;
+    QList<db::Connection *> connections = _query->parallelConnections();
+    if (_query->executionConnection()) {
+        connections.prepend(_query->executionConnection());
+    }
 
-    db::ConnectionQueryKillerPtr killer = connection->createQueryKiller();
+    bool killed = true;
 
-    try {
-        killer->run();
-    } catch(meow::db::Exception & ex) {
-        _lastCancelError = ex.message();
-        return false;
+    // each parallel worker blocks in its own server query
+    for (db::Connection * connection : connections) {
+        db::ConnectionQueryKillerPtr killer = connection->createQueryKiller();
+        try {
+            killer->run();
+        } catch(meow::db::Exception & ex) {
+            _lastCancelError = ex.message();
+            killed = false;
+        }
     }
 
-    return true;
+    return killed;
 }
 
 } // namespace presenters
@@ -35,6 +35,8 @@ public:
 
     bool execQueries(const QString & SQL, int charPosition = -1);
 
+    void execScriptFile(const QString & filename);
+
     bool hasError() const;
 
     QString lastError() const;
@@ -103,6 +103,14 @@ void ConnectionParametersForm::setCompressed(bool compressed)
     }
 }
 
+void ConnectionParametersForm::setFullTableStatus(bool full)
+{
+    if (_connectionParams.fullTableStatus() != full) {
+        _connectionParams.setFullTableStatus(full);
+        emit changed();
+    }
+}
+
 void ConnectionParametersForm::setPort(quint16 port)
 {
     if (_connectionParams.port() != port) {
@@ -32,6 +32,8 @@ public:
     QString databases() const { return _connectionParams.databases(); }
     bool isLoginPrompt() const { return _connectionParams.isLoginPrompt(); }
     bool isCompressed() const { return _connectionParams.isCompressed(); }
+    bool fullTableStatus() const {
+        return _connectionParams.fullTableStatus(); }
     quint16 port() const { return _connectionParams.port(); }
     int index() const;
     const meow::db::ConnectionParameters & connectionParams() const {
@@ -53,6 +55,10 @@ public:
         return _connectionParams.supportsCompressionOption();
     }
 
+    bool supportsFullTableStatusOption() const {
+        return _connectionParams.supportsFullTableStatusOption();
+    }
+
     bool isSSHTunnel() const {
         return _connectionParams.isSSHTunnel();
     }
@@ -77,6 +83,7 @@ public:
     void setDatabases(const QString &databases);
     void setLoginPrompt(bool loginPrompt);
     void setCompressed(bool compressed);
+    void setFullTableStatus(bool full);
     void setPort(quint16 port);
 
     void setSSHHost(const QString & host);
@@ -13,7 +13,7 @@ namespace presenters {
 
 ExportDatabaseForm::ExportDatabaseForm(db::SessionEntity * session)
     : _session(session)
-    , _dumper(new meow::utils::exporting::MySQLDumpConsole(this))
+    , _dumper(new meow::utils::exporting::MySQLDumper(this))
     , _filename(generateFilename())
     , _filenameChangedByUser(false)
     , _options(0)
@@ -82,15 +82,15 @@ QString ExportDatabaseForm::generateFilename() const
 void ExportDatabaseForm::startExport()
 {
     // TODO: need to reset each time?
-    _dumper.reset(new meow::utils::exporting::MySQLDumpConsole(this));
+    _dumper.reset(new meow::utils::exporting::MySQLDumper(this));
 
     connect(_dumper.get(),
-            &meow::utils::exporting::MySQLDumpConsole::finished,
+            &meow::utils::exporting::MySQLDumper::finished,
             this,
             &ExportDatabaseForm::finished);
 
     connect(_dumper.get(),
-            &meow::utils::exporting::MySQLDumpConsole::progressMessage,
+            &meow::utils::exporting::MySQLDumper::progressMessage,
             this,
             &ExportDatabaseForm::progressMessage);
 
@@ -232,13 +232,11 @@ void ExportDatabaseForm::resetOptionsToDefault()
     //setOption(MySQLDumpOption::NoData, false);
     setOption(MySQLDumpOption::Routines, true);
     setOption(MySQLDumpOption::Triggers, true);
-    setOption(MySQLDumpOption::NoColumnStatistics,
-              _dumper->supportsColumnStatisticsOption());
 }
 
-QString ExportDatabaseForm::currentCommand() const
+QString ExportDatabaseForm::exportSummary() const
 {
-    return _dumper->currentCommand();
+    return _dumper->summary();
 }
 
 } // namespace presenters
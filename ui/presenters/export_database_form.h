@@ -2,7 +2,7 @@
 #define MODELS_EXPORT_DATABASE_FORM_H
 
 #include <memory>
-#include "utils/exporting/mysql_dump_console.h"
+#include "utils/exporting/mysql_dumper.h"
 
 namespace meow {
 
@@ -12,7 +12,7 @@ namespace db {
 
 namespace utils {
 namespace exporting {
-    class MySQLDumpConsole;
+    class MySQLDumper;
 }
 }
 
@@ -35,7 +35,7 @@ enum class MySQLDumpOption
     //NoData           = (1 << 11), // --no-data // TODO
     Routines           = (1 << 12), // --routines
     Triggers           = (1 << 13), // --triggers (enabled by default)
-    NoColumnStatistics = (1 << 14), // --column-statistics=0 (v8 and higher)
+    FilePerTable       = (1 << 14), // dir with a file per table
 
     // internal options:
 
@@ -89,8 +89,9 @@ public:
     }
 
     void setOption(MySQLDumpOption opt, bool enabled);
+    uint32_t options() const { return _options; }
 
-    QString currentCommand() const;
+    QString exportSummary() const;
 
     Q_SIGNAL void finished(bool success);
     Q_SIGNAL void progressMessage(const QString & str);
@@ -107,7 +108,7 @@ private:
     void setOptionPrivate(MySQLDumpOption opt, bool enabled);
 
     meow::db::SessionEntity * const _session;
-    std::unique_ptr<meow::utils::exporting::MySQLDumpConsole> _dumper;
+    std::unique_ptr<meow::utils::exporting::MySQLDumper> _dumper;
 
     QString _database;
 
@@ -46,6 +46,11 @@ ExportQueryPresenter::ExportQueryPresenter()
             this,
             &ExportQueryPresenter::modeChanged);
 
+    connect(_exporter.get(),
+            &utils::exporting::QueryDataExporter::rowsExported,
+            this,
+            &ExportQueryPresenter::rowsExported);
+
     settings::QueryDataExportStorage storage;
     storage.loadTo(_exporter.get());
 }
@@ -287,6 +292,11 @@ QString ExportQueryPresenter::optionNullValue() const
     return escapeOptionValue(_exporter->format()->nullValue());
 }
 
+int ExportQueryPresenter::optionMaxStatementSizeKB() const
+{
+    return _exporter->format()->maxStatementSize() / 1024;
+}
+
 bool ExportQueryPresenter::isOptionEditableFieldSeparator() const
 {
     return _exporter->format()->editableOptionsValue().contains(
@@ -315,6 +325,13 @@ bool ExportQueryPresenter::isOptionEditableNullValue() const
     );
 }
 
+bool ExportQueryPresenter::isOptionEditableMaxStatementSize() const
+{
+    return _exporter->format()->editableOptionsValue().contains(
+        OptionsValue::MaxStatementSize
+    );
+}
+
 void ExportQueryPresenter::setOptionFieldSeparator(const QString & value)
 {
     _exporter->format()->setOptionValue(OptionsValue::FieldSeparator,
@@ -339,6 +356,12 @@ void ExportQueryPresenter::setOptionNullValue(const QString & value)
                                         unescapeOptionValue(value));
 }
 
+void ExportQueryPresenter::setOptionMaxStatementSizeKB(int value)
+{
+    _exporter->format()->setOptionValue(OptionsValue::MaxStatementSize,
+                                        QString::number(value * 1024));
+}
+
 bool ExportQueryPresenter::optionBoolIncludeColumnNames() const
 {
     return _exporter->format()->optionBool(
@@ -474,6 +497,11 @@ QString ExportQueryPresenter::run()
     return QString();
 }
 
+void ExportQueryPresenter::cancel()
+{
+    _exporter->abort();
+}
+
 } // namespace presenter
 } // namespace ui
 } // namespace meow
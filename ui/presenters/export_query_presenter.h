@@ -59,16 +59,19 @@ public:
     QString optionEncloser() const;
     QString optionLineTerminator() const;
     QString optionNullValue() const;
+    int optionMaxStatementSizeKB() const;
 
     bool isOptionEditableFieldSeparator() const;
     bool isOptionEditableEncloser() const;
     bool isOptionEditableLineTerminator() const;
     bool isOptionEditableNullValue() const;
+    bool isOptionEditableMaxStatementSize() const;
 
     void setOptionFieldSeparator(const QString & value);
     void setOptionEncloser(const QString & value);
     void setOptionLineTerminator(const QString & value);
     void setOptionNullValue(const QString & value);
+    void setOptionMaxStatementSizeKB(int value);
 
     bool optionBoolIncludeColumnNames() const;
     bool optionBoolIncludeAutoIncrementColumn() const;
@@ -88,10 +91,12 @@ public:
     bool canRun() const;
 
     QString run();
+    void cancel(); // of running export
 
     Q_SIGNAL void formatChanged();
     Q_SIGNAL void filenameChanged();
     Q_SIGNAL void modeChanged();
+    Q_SIGNAL void rowsExported(qulonglong count);
 
 private:
 
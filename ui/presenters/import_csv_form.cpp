@@ -0,0 +1,154 @@
+#include "import_csv_form.h"
+#include "db/connection.h"
+#include "db/connection_pool.h"
+#include "db/entity/table_entity.h"
+#include "threads/db_thread.h"
+#include "threads/data_import_task.h"
+#include "helpers/logger.h"
+#include <QEventLoop>
+#include <QTextCodec>
+
+namespace meow {
+namespace ui {
+namespace presenters {
+
+ImportCSVForm::ImportCSVForm(db::TableEntity * table)
+    : _table(table)
+    , _encoding("UTF-8")
+    , _separator(',')
+    , _encloser('"')
+    , _nullValue("\\N")
+    , _isFirstRowHeader(true)
+    , _isAborted(false)
+{
+
+}
+
+QStringList ImportCSVForm::supportedEncodings() const
+{
+    QStringList codecNames;
+    for (const QByteArray & codec : QTextCodec::availableCodecs()) {
+        QString name = QString::fromUtf8(codec);
+        if (!codecNames.contains(name)) {
+            codecNames.push_back(name);
+        }
+    }
+    return codecNames;
+}
+
+void ImportCSVForm::startImport()
+{
+    _isAborted = false;
+
+    _importer.setFilename(_filename);
+    _importer.setEncoding(_encoding);
+    _importer.setFieldSeparator(_separator);
+    _importer.setEncloser(_encloser);
+    _importer.setNullValue(_nullValue);
+    _importer.setFirstRowIsHeader(_isFirstRowHeader);
+    _importer.setTable(_table); // reads structure, so in main thread
+
+    db::Connection * connection = _table->connection();
+
+    // don't block main connection while rows are loaded
+    db::ConnectionPtr pooledConnection;
+    db::ConnectionPool * pool = connection->pool();
+    if (pool) {
+        try {
+            pooledConnection = pool->acquire(); // nullptr if pool is full
+        } catch(meow::db::Exception & ex) {
+            meowLogCC(Log::Category::Error, connection)
+                << "Pooled connection failed: " << ex.message();
+        }
+    }
+    if (pooledConnection) {
+        connection = pooledConnection.get();
+    }
+
+    threads::DbThread * thread = connection->thread();
+
+    std::shared_ptr<threads::DataImportTask> task
+            = thread->createDataImportTask(&_importer);
+
+    QEventLoop loop;
+    bool isFinished = false;
+
+    connect(task.get(), &threads::DataImportTask::rowsImported,
+            this, &ImportCSVForm::rowsImported);
+    connect(task.get(), &threads::DataImportTask::progress,
+            this, &ImportCSVForm::progress);
+    connect(task.get(), &threads::ThreadTask::finished,
+            &loop, [&isFinished, &loop]() {
+        isFinished = true;
+        loop.quit();
+    });
+
+    _task = task;
+
+    // without thread task runs and finishes in postTask()
+    thread->postTask(task);
+    if (!isFinished) {
+        loop.exec(); // UI stays responsive, import can be cancelled
+    }
+
+    _task.reset();
+    task->disconnect(this);
+
+    if (task->isFailed()) {
+        throw db::Exception(task->errorMessage());
+    }
+}
+
+bool ImportCSVForm::cancelImport()
+{
+    if (_task) {
+        _isAborted = true;
+        _task->abort();
+        return true;
+    }
+    return false;
+}
+
+QString ImportCSVForm::resultSummary() const
+{
+    QString summary;
+
+    if (_isAborted) {
+        summary += tr("Import cancelled, no rows are imported.") + '\n';
+    } else {
+        summary += tr("Imported rows: %1, rejected rows: %2, warnings: %3")
+                .arg(_importer.importedRowsCount())
+                .arg(_importer.rejectedRowsCount())
+                .arg(_importer.warningsCount()) + '\n';
+    }
+
+    if (!_importer.importedColumns().isEmpty()) {
+        summary += tr("Columns: %1")
+                .arg(_importer.importedColumns().join(", ")) + '\n';
+    }
+
+    for (const utils::importing::CSVImporter::Issue & issue
+         : _importer.issues()) {
+        QString kind = issue.isRejected ? tr("Rejected") : tr("Warning");
+        if (issue.line > 0) {
+            summary += tr("%1, line %2: %3")
+                    .arg(kind).arg(issue.line).arg(issue.message);
+        } else {
+            summary += tr("%1: %2").arg(kind).arg(issue.message);
+        }
+        summary += '\n';
+    }
+
+    db::ulonglong issuesCount = _importer.rejectedRowsCount()
+            + _importer.warningsCount();
+    if (issuesCount > static_cast<db::ulonglong>(_importer.issues().size())) {
+        summary += tr("... and %1 more")
+                .arg(issuesCount - _importer.issues().size()) + '\n';
+    }
+
+    return summary;
+}
+
+} // namespace presenters
+} // namespace ui
+} // namespace meow
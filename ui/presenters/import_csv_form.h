@@ -0,0 +1,81 @@
+#ifndef UI_PRESENTERS_IMPORT_CSV_FORM_H
+#define UI_PRESENTERS_IMPORT_CSV_FORM_H
+
+#include <memory>
+#include <QObject>
+#include <QStringList>
+#include "db/common.h"
+#include "utils/importing/csv_importer.h"
+
+namespace meow {
+
+namespace db {
+class TableEntity;
+}
+
+namespace threads {
+class DataImportTask;
+}
+
+namespace ui {
+namespace presenters {
+
+// Intent: options and running of CSV file import into table
+class ImportCSVForm : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ImportCSVForm(db::TableEntity * table);
+
+    db::TableEntity * table() const { return _table; }
+
+    void setFilename(const QString & filename) { _filename = filename; }
+    const QString & filename() const { return _filename; }
+
+    QStringList supportedEncodings() const;
+    void setEncoding(const QString & encoding) { _encoding = encoding; }
+    const QString & encoding() const { return _encoding; }
+
+    void setFieldSeparator(QChar separator) { _separator = separator; }
+    QChar fieldSeparator() const { return _separator; }
+
+    void setEncloser(QChar encloser) { _encloser = encloser; }
+    QChar encloser() const { return _encloser; }
+
+    // null QString - no NULLs
+    void setNullValue(const QString & value) { _nullValue = value; }
+    const QString & nullValue() const { return _nullValue; }
+
+    void setFirstRowIsHeader(bool isHeader) { _isFirstRowHeader = isHeader; }
+    bool isFirstRowHeader() const { return _isFirstRowHeader; }
+
+    // Blocks until finished keeping UI responsive, throws on errors
+    void startImport();
+    bool cancelImport(); // false if was not running
+    bool isRunning() const { return _task != nullptr; }
+
+    QString resultSummary() const;
+
+    Q_SIGNAL void rowsImported(qulonglong count);
+    Q_SIGNAL void progress(int percent);
+
+private:
+    db::TableEntity * _table;
+    QString _filename;
+    QString _encoding;
+    QChar _separator;
+    QChar _encloser;
+    QString _nullValue;
+    bool _isFirstRowHeader;
+    bool _isAborted;
+
+    utils::importing::CSVImporter _importer;
+    std::shared_ptr<threads::DataImportTask> _task;
+};
+
+} // namespace presenters
+} // namespace ui
+} // namespace meow
+
+#endif // UI_PRESENTERS_IMPORT_CSV_FORM_H
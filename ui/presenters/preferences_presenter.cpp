@@ -52,6 +52,66 @@ void PreferencesPresenter::setApplicationLanguage(const QString & languageCode)
     _requiresRestart = true;
 }
 
+bool PreferencesPresenter::streamQueryResults() const
+{
+    return _userPreferencesCopy->dataFetchingSettings()->streamQueryResults();
+}
+
+void PreferencesPresenter::setStreamQueryResults(bool stream)
+{
+    _userPreferencesCopy->dataFetchingSettings()->setStreamQueryResults(stream);
+    setModified(true);
+}
+
+bool PreferencesPresenter::runReadOnlyQueriesInParallel() const
+{
+    return _userPreferencesCopy->dataFetchingSettings()
+            ->runReadOnlyQueriesInParallel();
+}
+
+void PreferencesPresenter::setRunReadOnlyQueriesInParallel(bool parallel)
+{
+    _userPreferencesCopy->dataFetchingSettings()
+            ->setRunReadOnlyQueriesInParallel(parallel);
+    setModified(true);
+}
+
+bool PreferencesPresenter::receiveBinaryResults() const
+{
+    return _userPreferencesCopy->dataFetchingSettings()->receiveBinaryResults();
+}
+
+void PreferencesPresenter::setReceiveBinaryResults(bool binary)
+{
+    _userPreferencesCopy->dataFetchingSettings()->setReceiveBinaryResults(binary);
+    setModified(true);
+}
+
+bool PreferencesPresenter::loadTableRowsOnScroll() const
+{
+    return _userPreferencesCopy->dataFetchingSettings()
+            ->loadTableRowsOnScroll();
+}
+
+void PreferencesPresenter::setLoadTableRowsOnScroll(bool load)
+{
+    _userPreferencesCopy->dataFetchingSettings()->setLoadTableRowsOnScroll(load);
+    setModified(true);
+}
+
+int PreferencesPresenter::tableDataMaxBufferSizeMB() const
+{
+    return _userPreferencesCopy->dataFetchingSettings()
+            ->tableDataMaxBufferSizeMB();
+}
+
+void PreferencesPresenter::setTableDataMaxBufferSizeMB(int size)
+{
+    _userPreferencesCopy->dataFetchingSettings()
+            ->setTableDataMaxBufferSizeMB(size);
+    setModified(true);
+}
+
 void PreferencesPresenter::setModified(bool modified)
 {
     if (_modified == modified) return;
@@ -21,6 +21,17 @@ public:
     QString applicationLanguageCode();
     void setApplicationLanguage(const QString & languageCode);
 
+    bool streamQueryResults() const;
+    void setStreamQueryResults(bool stream);
+    bool runReadOnlyQueriesInParallel() const;
+    void setRunReadOnlyQueriesInParallel(bool parallel);
+    bool receiveBinaryResults() const;
+    void setReceiveBinaryResults(bool binary);
+    bool loadTableRowsOnScroll() const;
+    void setLoadTableRowsOnScroll(bool load);
+    int tableDataMaxBufferSizeMB() const;
+    void setTableDataMaxBufferSizeMB(int size);
+
     void setModified(bool modified);
 
     bool isApplyEnabled() const {
@@ -26,6 +26,8 @@ SettingsTab::SettingsTab(QWidget * parent) : QWidget(parent)
                     _form->setNetworkType(networkTypes[index]);
                     _compressionCheckBox->setEnabled(
                         _form->supportsCompressionOption());
+                    _fullTableStatusCheckBox->setEnabled(
+                        _form->supportsFullTableStatusOption());
                 }
             });
     row++;
@@ -152,6 +154,22 @@ SettingsTab::SettingsTab(QWidget * parent) : QWidget(parent)
 
     row++;
 
+    // Full table status -------------------------------------------------------
+    _fullTableStatusCheckBox
+            = new QCheckBox(tr("Get full table status"));
+    _fullTableStatusCheckBox->setToolTip(
+        tr("Otherwise tables are listed at once and their sizes, rows count "
+           "and engines are loaded in background"));
+    connect(_fullTableStatusCheckBox, &QCheckBox::stateChanged,
+            [=](int newState) {
+                if (_form) {
+                    _form->setFullTableStatus(newState == Qt::Checked);
+                }
+            });
+    _mainGridLayout->addWidget(_fullTableStatusCheckBox, row, 1);
+
+    row++;
+
 
     // Databases ---------------------------------------------------------------
     _databasesLabel = new QLabel(tr("Databases:"));
@@ -203,6 +221,7 @@ void SettingsTab::fillDataFromForm()
     _filenameEdit->setText(_form->fileName());
     //_loginPromptCheckBox->setChecked(_form->isLoginPrompt());
     _compressionCheckBox->setChecked(_form->isCompressed());
+    _fullTableStatusCheckBox->setChecked(_form->fullTableStatus());
     _userEdit->setText(_form->userName());
     _passwordEdit->setText(_form->password());
     _databasesEdit->setText(_form->databases());
@@ -38,6 +38,7 @@ private:
     QCheckBox * _loginPromptCheckBox;
 
     QCheckBox * _compressionCheckBox;
+    QCheckBox * _fullTableStatusCheckBox;
 
     QLabel * _userLabel;
     QLineEdit * _userEdit;
@@ -0,0 +1,1235 @@
+#include "mysql_dumper.h"
+#include "ui/presenters/export_database_form.h"
+#include "db/entity/session_entity.h"
+#include "db/entity/database_entity.h"
+#include "db/entity/entity_factory.h"
+#include "db/connection.h"
+#include "db/exception.h"
+#include "db/query.h"
+#include "helpers/formatting.h"
+#include "helpers/logger.h"
+#include "threads/db_thread.h"
+#include "threads/helpers.h"
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QRegularExpression>
+
+namespace meow {
+namespace utils {
+namespace exporting {
+
+using Option = ui::presenters::MySQLDumpOption;
+
+namespace {
+
+bool isSystemDatabase(const QString & name)
+{
+    // not restorable, like in mysqldump --all-databases
+    return QString::compare(name, "information_schema", Qt::CaseInsensitive) == 0
+        || QString::compare(name, "performance_schema", Qt::CaseInsensitive) == 0;
+}
+
+QString safeFileName(const QString & name)
+{
+    QString result = name;
+    result.replace(QRegularExpression("[^\\w\\-. ]"), "_");
+    return result;
+}
+
+} // namespace
+
+// Intent: keeps query in running ones of dumper while in scope
+class MySQLDumper::RunningQueryScope
+{
+public:
+    RunningQueryScope(MySQLDumper * dumper, const db::QueryPtr & query)
+        : _dumper(dumper)
+        , _query(query)
+    {
+        _dumper->setRunningQuery(_query, true);
+    }
+    ~RunningQueryScope()
+    {
+        _dumper->setRunningQuery(_query, false);
+    }
+private:
+    MySQLDumper * _dumper;
+    db::QueryPtr _query;
+};
+
+MySQLDumper::MySQLDumper(ui::presenters::ExportDatabaseForm * form)
+    : QObject()
+    , _form(form)
+    , _options(0)
+    , _nextJobIndex(0)
+    , _isGlobalLockHeld(false)
+    , _isEachConnectionLocked(false)
+    , _workersRunning(0)
+    , _isRunning(false)
+    , _isAborted(false)
+    , _isFailed(false)
+    , _nextPartToWrite(0)
+{
+
+}
+
+MySQLDumper::~MySQLDumper()
+{
+    cancel();
+    // running tasks use dumper, queued ones are dropped with the threads
+    for (const db::ConnectionPtr & connection : _connections) {
+        connection->thread()->quit();
+        connection->thread()->wait();
+    }
+    _connections.clear();
+}
+
+void MySQLDumper::start()
+{
+    MEOW_ASSERT_MAIN_THREAD
+
+    if (_isRunning) {
+        return;
+    }
+
+    _isAborted = false;
+    _isFailed = false;
+
+    db::Connection * connection = _form->session()->connection();
+
+    _options = _form->options();
+    _filename = _form->filename();
+    _hostName = connection->connectionParams()->hostName();
+    _characterSet = connection->characterSet();
+
+    emit progressMessage(summary() + QChar::LineFeed);
+
+    try {
+        collectObjects();
+        openConnections();
+    } catch(meow::db::Exception & ex) {
+        meowLogC(Log::Category::Error) << "Dump failed: " << ex.message();
+        emit progressMessage(ex.message() + QChar::LineFeed);
+        _connections.clear();
+        _databases.clear();
+        emit finished(false);
+        return;
+    }
+
+    _isRunning = true;
+    postTask(_connections.front().get(), threads::DumpTask::Step::Prepare);
+}
+
+bool MySQLDumper::cancel()
+{
+    if (!_isRunning) {
+        return false;
+    }
+    if (!_isAborted) {
+        _isAborted = true;
+        emit progressMessage(tr("Cancelling...") + QChar::LineFeed);
+        abortRunningQueries();
+    }
+    return true;
+}
+
+QString MySQLDumper::summary() const
+{
+    QString source = _form->allDatabases()
+            ? tr("all databases")
+            : tr("database `%1`").arg(_form->database());
+
+    QString target = _form->filename();
+    if (_form->isOptionEnabled(Option::FilePerTable)) {
+        QFileInfo info(target);
+        target = tr("file per table in %1").arg(QDir::toNativeSeparators(
+                    info.absolutePath() + '/' + info.completeBaseName()));
+    }
+
+    db::ConnectionParameters * params
+            = _form->session()->connection()->connectionParams();
+
+    return tr("Dump of %1 to %2 (%3 connections)")
+            .arg(source)
+            .arg(target)
+            .arg(params->connectionPoolSize() > 0
+                 ? db::DUMP_CONNECTIONS_COUNT : 1);
+}
+
+void MySQLDumper::postTask(db::Connection * connection,
+                           threads::DumpTask::Step step)
+{
+    // keep local ref: without thread task runs and finishes in postTask()
+    auto task = std::make_shared<threads::DumpTask>(this, step, connection);
+
+    connect(task.get(), &threads::ThreadTask::finished,
+            this, &MySQLDumper::onTaskFinished); // before post!
+
+    connection->thread()->postTask(task);
+}
+
+void MySQLDumper::onTaskFinished()
+{
+    MEOW_ASSERT_MAIN_THREAD
+
+    auto task = static_cast<threads::DumpTask *>(sender());
+    db::Connection * coordinator = _connections.front().get();
+
+    switch (task->step()) {
+
+    case threads::DumpTask::Step::Prepare:
+        if (_isAborted) {
+            postTask(coordinator, threads::DumpTask::Step::Finish);
+            break;
+        }
+        _workersRunning = static_cast<int>(_connections.size());
+        for (const db::ConnectionPtr & connection : _connections) {
+            postTask(connection.get(), threads::DumpTask::Step::Work);
+        }
+        break;
+
+    case threads::DumpTask::Step::Work:
+        if (--_workersRunning == 0) {
+            postTask(coordinator, threads::DumpTask::Step::Finish);
+        }
+        break;
+
+    case threads::DumpTask::Step::Finish:
+        onRunFinished();
+        break;
+    }
+}
+
+void MySQLDumper::onRunFinished()
+{
+    // connections and entities belong to main thread
+    _connections.clear();
+    _databases.clear();
+    _jobs.clear();
+    _parts.clear();
+
+    _isRunning = false;
+
+    emit finished(!_isFailed);
+}
+
+void MySQLDumper::collectObjects()
+{
+    _databases.clear();
+
+    db::SessionEntity * session = _form->session();
+    db::Connection * connection = session->connection();
+
+    QStringList names;
+    if (_form->allDatabases()) {
+        for (const QString & name : connection->allDatabases()) {
+            if (!isSystemDatabase(name)) {
+                names << name;
+            }
+        }
+    } else {
+        names << _form->database();
+    }
+
+    for (const QString & name : names) {
+
+        DatabaseObjects objects;
+        objects.name = name;
+        objects.holder = db::EntityFactory::createDataBase(name, session);
+
+        // session shows only some databases
+        db::DataBaseEntity * database = session->databaseByName(name);
+        if (database == nullptr) {
+            database = objects.holder.get();
+        }
+
+        // tree may change while dump threads read entities, so they get
+        // copies with parent database for full names in create code
+        for (int i = 0; i < database->childCount(); ++i) {
+            db::Entity * entity = database->child(i);
+            QList<db::EntityPtr> * list = nullptr;
+            switch (entity->type()) {
+            case db::Entity::Type::Table:
+                list = &objects.tables;
+                break;
+            case db::Entity::Type::View:
+                list = &objects.views;
+                break;
+            case db::Entity::Type::Trigger:
+                list = &objects.triggers;
+                break;
+            case db::Entity::Type::Function:
+            case db::Entity::Type::Procedure:
+                list = &objects.routines;
+                break;
+            default:
+                break;
+            }
+            if (list) {
+                list->append(db::EntityFactory::createEntityInDatabase(
+                    entity->name(), entity->type(), objects.holder.get()));
+            }
+        }
+
+        _databases.push_back(std::move(objects));
+    }
+}
+
+void MySQLDumper::openConnections()
+{
+    _connections.clear();
+
+    db::ConnectionParameters * params
+            = _form->session()->connection()->connectionParams();
+
+    // no pool via SSH tunnel or with login prompt, but own connection
+    // opens own tunnel too
+    int count = params->connectionPoolSize() > 0
+            ? db::DUMP_CONNECTIONS_COUNT : 1;
+
+    for (int i = 0; i < count; ++i) {
+        db::ConnectionPtr dumpConnection = params->createConnection();
+        dumpConnection->thread(); // created in main thread
+        _connections.push_back(dumpConnection); // opened in prepare()
+    }
+}
+
+void MySQLDumper::prepare(db::Connection * connection)
+{
+    _jobs.clear();
+    _parts.clear();
+    _nextJobIndex = 0;
+    _nextPartToWrite = 0;
+    _isGlobalLockHeld = false;
+    _isEachConnectionLocked = false;
+
+    try {
+        for (const db::ConnectionPtr & dumpConnection : _connections) {
+            dumpConnection->setActive(true);
+            if (!_characterSet.isEmpty()) {
+                dumpConnection->setCharacterSet(_characterSet);
+            }
+            // get id now to allow KILL QUERY ID from another thread
+            dumpConnection->connectionIdOnServer();
+        }
+        startSnapshot();
+        planJobs(connection);
+    } catch(meow::db::Exception & ex) {
+        fail(ex.message());
+    }
+
+    _parts = std::vector<Part>(_jobs.size());
+}
+
+void MySQLDumper::finish(db::Connection * connection)
+{
+    {
+        QMutexLocker locker(&_writeMutex);
+        try {
+            if (!_isAborted) {
+                writeReadyParts();
+            }
+            closeOutput(!_isAborted); // no footer in incomplete dump
+        } catch(meow::db::Exception & ex) {
+            fail(ex.message());
+        }
+    }
+
+    if (_isGlobalLockHeld) {
+        try {
+            connection->query("UNLOCK TABLES");
+        } catch(meow::db::Exception & ex) {
+            Q_UNUSED(ex); // released on disconnect anyway
+        }
+    }
+
+    if (!_isFailed) {
+        emit progressMessage((_isAborted ? tr("Dump is cancelled")
+                                         : tr("Dump is completed"))
+                             + QChar::LineFeed);
+    }
+}
+
+void MySQLDumper::startSnapshot()
+{
+    // all connections start their transactions while tables are locked,
+    // so they read the same state of data
+    db::Connection * coordinator = _connections.front().get();
+
+    bool isLocked = false;
+    try {
+        coordinator->query("FLUSH TABLES WITH READ LOCK");
+        isLocked = true;
+    } catch(meow::db::Exception & ex) {
+        meowLogCC(Log::Category::Info, coordinator)
+            << "Dump runs without global read lock: " << ex.message();
+        if (!isOptionEnabled(Option::LockTables)) {
+            emit progressMessage(
+                tr("No global read lock (RELOAD privilege is required),"
+                   " connections may see different data") + QChar::LineFeed);
+        }
+    }
+
+    if (!isLocked && isOptionEnabled(Option::LockTables)) {
+        lockTables(); // instead of snapshot
+        _serverVersion = coordinator->getCell("SELECT VERSION()");
+        return;
+    }
+
+    try {
+        for (const db::ConnectionPtr & connection : _connections) {
+            connection->query("/*!40103 SET TIME_ZONE='+00:00' */");
+            connection->query(
+                "SET SESSION TRANSACTION ISOLATION LEVEL REPEATABLE READ");
+            connection->query(
+                "START TRANSACTION /*!40100 WITH CONSISTENT SNAPSHOT */");
+        }
+    } catch(meow::db::Exception & ex) {
+        if (isLocked) {
+            coordinator->query("UNLOCK TABLES");
+        }
+        throw;
+    }
+
+    // snapshot doesn't cover non-transactional tables like MyISAM, so
+    // lock tables keeps writes waiting until all rows are read
+    if (isLocked && isOptionEnabled(Option::LockTables)) {
+        _isGlobalLockHeld = true;
+    } else if (isLocked) {
+        coordinator->query("UNLOCK TABLES");
+    }
+
+    _serverVersion = coordinator->getCell("SELECT VERSION()");
+}
+
+void MySQLDumper::lockTables()
+{
+    // without global lock every connection locks all dumped tables and
+    // views for read, writes wait since the first one is locked, so all
+    // connections read the same data
+    db::Connection * coordinator = _connections.front().get();
+
+    QStringList names;
+    for (const DatabaseObjects & database : _databases) {
+        QList<db::EntityPtr> entities = database.tables;
+        entities << database.views;
+        for (const db::EntityPtr & entity : entities) {
+            names << quotedName(coordinator, database.name, entity->name())
+                     + " READ";
+        }
+    }
+
+    if (names.isEmpty()) {
+        return;
+    }
+
+    emit progressMessage(tr("Locking tables...") + QChar::LineFeed);
+
+    QString SQL = "LOCK TABLES " + names.join(", ");
+
+    for (const db::ConnectionPtr & connection : _connections) {
+        connection->query("/*!40103 SET TIME_ZONE='+00:00' */");
+        connection->query(SQL);
+    }
+
+    _isEachConnectionLocked = true;
+}
+
+void MySQLDumper::planJobs(db::Connection * connection)
+{
+    _plannedFilename.clear();
+    _plannedDatabase.clear();
+
+    bool createTables = isOptionEnabled(Option::CreateTable);
+
+    for (const DatabaseObjects & database : _databases) {
+
+        if (_isAborted) {
+            return;
+        }
+
+        if (isOptionEnabled(Option::CreateDatabase)
+                || isOptionEnabled(Option::AddDropDatabase)) {
+            Job job;
+            job.type = JobType::CreateDatabase;
+            job.database = database.name;
+            job.filename = filenameFor(database.name);
+            addJob(connection, job);
+        }
+
+        // tree may be listed without stats, see estimatedTableRows()
+        QHash<QString, db::ulonglong> tableRows
+            = estimatedTableRows(connection, database.name);
+
+        for (int i = 0; i < database.tables.size(); ++i) {
+            QString filename = filenameFor(database.name,
+                                           database.tables[i]->name());
+            if (createTables) {
+                Job job;
+                job.type = JobType::CreateEntity;
+                job.database = database.name;
+                job.entity = database.tables[i];
+                job.filename = filename;
+                addJob(connection, job);
+            }
+            planTableData(connection, database, i,
+                          tableRows.value(database.tables[i]->name(), 0),
+                          filename);
+        }
+
+        QList<db::EntityPtr> objects;
+        if (createTables) {
+            objects << database.views;
+        }
+        if (isOptionEnabled(Option::Triggers)) {
+            objects << database.triggers;
+        }
+        if (isOptionEnabled(Option::Routines)) {
+            objects << database.routines;
+        }
+
+        QString objectsFilename = objectsFilenameFor(database.name);
+
+        for (const db::EntityPtr & object : objects) {
+            Job job;
+            job.type = JobType::CreateEntity;
+            job.database = database.name;
+            job.entity = object;
+            job.filename = objectsFilename;
+            addJob(connection, job);
+        }
+
+        if (isOptionEnabled(Option::Events)
+                && connection->serverVersionInt() >= 50106) {
+            Job job;
+            job.type = JobType::Events;
+            job.database = database.name;
+            job.filename = objectsFilename;
+            addJob(connection, job);
+        }
+    }
+}
+
+QHash<QString, db::ulonglong> MySQLDumper::estimatedTableRows(
+        db::Connection * connection,
+        const QString & database)
+{
+    // cheap estimates of storage engine, enough to split big tables
+    db::QueryPtr results = connection->getResults(
+        "SELECT TABLE_NAME, TABLE_ROWS FROM information_schema.TABLES"
+        " WHERE TABLE_SCHEMA = " + connection->escapeString(database)
+        + " AND TABLE_TYPE = 'BASE TABLE'");
+
+    QHash<QString, db::ulonglong> rows;
+    while (results->isEof() == false) {
+        rows.insert(results->curRowColumn(0),
+                    results->curRowColumn(1).toULongLong());
+        results->seekNext();
+    }
+    return rows;
+}
+
+void MySQLDumper::planTableData(db::Connection * connection,
+                                const DatabaseObjects & database,
+                                int tableIndex,
+                                db::ulonglong estimatedRows,
+                                const QString & filename)
+{
+    const db::EntityPtr & table = database.tables[tableIndex];
+    QString name = connection->quoteIdentifier(table->name());
+
+    QString header = "\n--\n-- Dumping data for table " + name + "\n--\n\n";
+    QString footer;
+
+    if (isOptionEnabled(Option::AddLocks)) {
+        header += "LOCK TABLES " + name + " WRITE;\n";
+    }
+    if (isOptionEnabled(Option::DisableKeys)) {
+        header += "/*!40000 ALTER TABLE " + name + " DISABLE KEYS */;\n";
+        footer += "/*!40000 ALTER TABLE " + name + " ENABLE KEYS */;\n";
+    }
+    if (isOptionEnabled(Option::AddLocks)) {
+        footer += "UNLOCK TABLES;\n";
+    }
+
+    addText(connection, filename, database.name, header);
+
+    QStringList ranges = primaryKeyRanges(
+                connection,
+                quotedName(connection, database.name, table->name()),
+                estimatedRows);
+    if (ranges.isEmpty()) {
+        ranges << QString(); // all rows at once
+    }
+
+    for (const QString & range : ranges) {
+        Job job;
+        job.type = JobType::TableData;
+        job.database = database.name;
+        job.entity = table;
+        job.where = range;
+        job.filename = filename;
+        addJob(connection, job);
+    }
+
+    addText(connection, filename, database.name, footer);
+}
+
+QStringList MySQLDumper::primaryKeyRanges(db::Connection * connection,
+                                          const QString & quotedTable,
+                                          db::ulonglong estimatedRows)
+{
+    if (estimatedRows <= db::DUMP_CHUNK_ROWS) {
+        return {};
+    }
+
+    db::QueryPtr keys = connection->getResults(
+        "SHOW KEYS FROM " + quotedTable + " WHERE Key_name = 'PRIMARY'");
+
+    if (keys->recordCount() != 1) { // no key or compound one
+        return {};
+    }
+    keys->seekFirst();
+
+    QString column = connection->quoteIdentifier(
+                keys->curRowColumn("Column_name"));
+
+    QStringList bounds = connection->getRow(
+        "SELECT MIN(" + column + "), MAX(" + column + ") FROM " + quotedTable);
+
+    bool isMinValid = false;
+    bool isMaxValid = false;
+    qint64 min = bounds.value(0).toLongLong(&isMinValid);
+    qint64 max = bounds.value(1).toLongLong(&isMaxValid);
+
+    if (!isMinValid || !isMaxValid || max <= min) { // not integer key
+        return {};
+    }
+
+    // estimated rows are spread over key range evenly, good enough for
+    // auto increment keys
+    quint64 chunks = (estimatedRows + db::DUMP_CHUNK_ROWS - 1)
+            / db::DUMP_CHUNK_ROWS;
+    quint64 step = (static_cast<quint64>(max) - static_cast<quint64>(min))
+            / chunks + 1;
+
+    QStringList ranges;
+    qint64 from = min;
+
+    for (quint64 i = 0; i < chunks; ++i) {
+        qint64 to = static_cast<qint64>(static_cast<quint64>(from) + step);
+        QStringList conditions; // first and last ranges are open
+        if (i > 0) {
+            conditions << column + " >= " + QString::number(from);
+        }
+        if (i + 1 < chunks) {
+            conditions << column + " < " + QString::number(to);
+        }
+        ranges << conditions.join(" AND ");
+        from = to;
+    }
+
+    return ranges;
+}
+
+void MySQLDumper::addText(db::Connection * connection,
+                          const QString & filename,
+                          const QString & database,
+                          const QString & text)
+{
+    Job job;
+    job.type = JobType::Text;
+    job.text = text;
+    job.database = database;
+    job.filename = filename;
+    addJob(connection, job);
+}
+
+void MySQLDumper::addJob(db::Connection * connection, const Job & job)
+{
+    // every file and database switch continues with USE, CREATE DATABASE
+    // part has own one
+    if (job.type != JobType::CreateDatabase
+            && (job.filename != _plannedFilename
+                || job.database != _plannedDatabase)) {
+        Job use;
+        use.type = JobType::Text;
+        use.text = "\nUSE " + connection->quoteIdentifier(job.database)
+                + ";\n";
+        use.database = job.database;
+        use.filename = job.filename;
+        _jobs.push_back(use);
+    }
+
+    _plannedFilename = job.filename;
+    _plannedDatabase = job.database;
+    _jobs.push_back(job);
+}
+
+void MySQLDumper::runWorker(db::Connection * connection)
+{
+    while (!_isAborted) {
+
+        int index = _nextJobIndex++;
+        if (index >= static_cast<int>(_jobs.size())) {
+            break;
+        }
+
+        try {
+            runJob(connection,
+                   _jobs[static_cast<std::size_t>(index)],
+                   &_parts[static_cast<std::size_t>(index)]);
+        } catch(meow::db::Exception & ex) {
+            fail(ex.message());
+            break;
+        }
+
+        onJobDone(index);
+    }
+
+    if (_isEachConnectionLocked) { // others keep writes waiting
+        try {
+            connection->query("UNLOCK TABLES");
+        } catch(meow::db::Exception & ex) {
+            Q_UNUSED(ex); // released on disconnect anyway
+        }
+    }
+}
+
+void MySQLDumper::runJob(db::Connection * connection,
+                         const Job & job,
+                         Part * part)
+{
+    switch (job.type) {
+    case JobType::Text:
+        part->text = job.text;
+        break;
+    case JobType::CreateDatabase:
+        part->text = createDatabaseSQL(connection, job);
+        break;
+    case JobType::CreateEntity:
+        part->text = createEntitySQL(connection, job);
+        break;
+    case JobType::Events:
+        part->text = createEventsSQL(connection, job);
+        break;
+    case JobType::TableData:
+        dumpTableData(connection, job, part);
+        break;
+    }
+}
+
+QString MySQLDumper::createDatabaseSQL(db::Connection * connection,
+                                       const Job & job)
+{
+    QString name = connection->quoteIdentifier(job.database);
+
+    QString SQL = "\n--\n-- Current Database: " + name + "\n--\n\n";
+
+    if (isOptionEnabled(Option::AddDropDatabase)) {
+        SQL += "/*!40000 DROP DATABASE IF EXISTS " + name + "*/;\n\n";
+    }
+
+    if (isOptionEnabled(Option::CreateDatabase)) {
+        QString createCode = connection->getCell(
+                    "SHOW CREATE DATABASE " + name, 1);
+        createCode.replace(QRegularExpression("^CREATE DATABASE "),
+                           "CREATE DATABASE /*!32312 IF NOT EXISTS*/ ");
+        SQL += createCode + ";\n";
+    }
+
+    SQL += "\nUSE " + name + ";\n";
+
+    return SQL;
+}
+
+QString MySQLDumper::createEntitySQL(db::Connection * connection,
+                                     const Job & job)
+{
+    const db::Entity * entity = job.entity.get();
+    QString name = connection->quoteIdentifier(entity->name());
+    QString createCode = connection->getCreateCode(entity);
+
+    QString SQL;
+
+    switch (entity->type()) {
+
+    case db::Entity::Type::Table:
+        SQL = "\n--\n-- Table structure for table " + name + "\n--\n\n";
+        if (isOptionEnabled(Option::AddDropTable)) {
+            SQL += "DROP TABLE IF EXISTS " + name + ";\n";
+        }
+        SQL += createCode + ";\n";
+        break;
+
+    case db::Entity::Type::View:
+        SQL = "\n--\n-- View structure for view " + name + "\n--\n\n";
+        if (isOptionEnabled(Option::AddDropTable)) {
+            SQL += "DROP VIEW IF EXISTS " + name + ";\n";
+        }
+        SQL += createCode + ";\n";
+        break;
+
+    case db::Entity::Type::Trigger:
+        SQL = "\n--\n-- Trigger " + name + "\n--\n\n";
+        if (isOptionEnabled(Option::AddDropTrigger)) {
+            SQL += "DROP TRIGGER IF EXISTS " + name + ";\n";
+        }
+        SQL += "DELIMITER ;;\n" + createCode + " ;;\nDELIMITER ;\n";
+        break;
+
+    case db::Entity::Type::Function:
+    case db::Entity::Type::Procedure: {
+        QString typeStr = entity->type() == db::Entity::Type::Function
+                ? "FUNCTION" : "PROCEDURE";
+        SQL = "\n--\n-- Routine " + name + "\n--\n\n";
+        SQL += "DROP " + typeStr + " IF EXISTS " + name + ";\n";
+        SQL += "DELIMITER ;;\n" + createCode + " ;;\nDELIMITER ;\n";
+        break;
+    }
+
+    default:
+        break;
+    }
+
+    return SQL;
+}
+
+QString MySQLDumper::createEventsSQL(db::Connection * connection,
+                                     const Job & job)
+{
+    QString database = connection->quoteIdentifier(job.database);
+
+    QStringList names = connection->getColumn("SHOW EVENTS FROM " + database,
+                                              1);
+    if (names.isEmpty()) {
+        return QString();
+    }
+
+    QString SQL = "\n--\n-- Events for database " + database + "\n--\n\n";
+    SQL += "DELIMITER ;;\n";
+
+    for (const QString & eventName : names) {
+        QString name = connection->quoteIdentifier(eventName);
+        QString createCode = connection->getCell(
+            "SHOW CREATE EVENT "
+            + quotedName(connection, job.database, eventName), 3);
+        SQL += "/*!50106 DROP EVENT IF EXISTS " + name + " */;;\n";
+        SQL += createCode + " ;;\n";
+    }
+
+    SQL += "DELIMITER ;\n";
+
+    return SQL;
+}
+
+void MySQLDumper::dumpTableData(db::Connection * connection,
+                                const Job & job,
+                                Part * part)
+{
+    QString quotedTable = quotedName(connection, job.database,
+                                     job.entity->name());
+
+    QString SQL = "SELECT * FROM " + quotedTable;
+    if (!job.where.isEmpty()) {
+        SQL += " WHERE " + job.where;
+    }
+
+    emit progressMessage(tr("Dumping %1%2...")
+                         .arg(quotedTable)
+                         .arg(job.where.isEmpty()
+                              ? QString() : " (" + job.where + ")")
+                         + QChar::LineFeed);
+
+    // rows go to temp file until all previous parts are written
+    part->file.reset(new QTemporaryFile());
+    if (!part->file->open()) {
+        throw db::Exception(tr("Unable to create temporary file for dump"));
+    }
+
+    QTextStream stream(part->file.get());
+    stream.setCodec("UTF-8");
+
+    db::QueryPtr query = connection->createQuery();
+    query->setSQL(SQL);
+    query->setStreamed(true); // flat memory for any table size
+    query->execute();
+
+    if (!query->hasResult()) {
+        return;
+    }
+
+    RunningQueryScope runningQuery(this, query); // cancel kills it
+
+    enum class ValueFormat { String, Number, Hex };
+
+    std::size_t columnCount = query->columnCount();
+    std::vector<ValueFormat> formats(columnCount, ValueFormat::String);
+    for (std::size_t col = 0; col < columnCount; ++col) {
+        const db::DataTypePtr & type = query->column(col).dataType;
+        if (!type) {
+            continue;
+        }
+        if (type->index == db::DataTypeIndex::Bit
+                || type->categoryIndex == db::DataTypeCategoryIndex::Binary
+                || type->categoryIndex == db::DataTypeCategoryIndex::Spatial) {
+            formats[col] = ValueFormat::Hex;
+        } else if (type->categoryIndex == db::DataTypeCategoryIndex::Integer
+                || type->categoryIndex == db::DataTypeCategoryIndex::Float) {
+            formats[col] = ValueFormat::Number;
+        }
+    }
+
+    const QString insert = "INSERT INTO "
+            + connection->quoteIdentifier(job.entity->name()) + " VALUES ";
+    bool isExtendedInsert = isOptionEnabled(Option::ExtendedInsert);
+
+    QString statement;
+    db::ulonglong dumpedRowsCount = 0;
+
+    while (!_isAborted) {
+
+        if (query->isFetching()) {
+            query->clearFetchedRows(); // already in file
+            query->fetchMore(db::DATA_ROWS_PER_STEP);
+        }
+
+        db::ulonglong rowCount = query->recordCount();
+
+        for (db::ulonglong row = 0; row < rowCount && !_isAborted; ++row) {
+
+            query->seekRecNo(row);
+
+            QString values = "(";
+            for (std::size_t col = 0; col < columnCount; ++col) {
+                if (col > 0) {
+                    values += ',';
+                }
+                if (query->isNull(col)) {
+                    values += QLatin1String("NULL");
+                    continue;
+                }
+                QString value = query->curRowColumn(col, true);
+                switch (formats[col]) {
+                case ValueFormat::Number:
+                    values += value;
+                    break;
+                case ValueFormat::Hex:
+                    values += hexValue(value);
+                    break;
+                default:
+                    values += escapeValue(value);
+                    break;
+                }
+            }
+            values += ')';
+
+            if (!isExtendedInsert) {
+                stream << insert << values << ";\n";
+            } else {
+                if (!statement.isEmpty() && statement.length()
+                        + values.length() >= db::DUMP_MAX_INSERT_LENGTH) {
+                    stream << statement << ";\n";
+                    statement.clear();
+                }
+                if (statement.isEmpty()) {
+                    statement = insert + values;
+                } else {
+                    statement += ',' + values;
+                }
+            }
+
+            ++dumpedRowsCount;
+        }
+
+        if (!query->isFetching()) {
+            break;
+        }
+    }
+
+    if (_isAborted) {
+        query->abortFetching(); // killed on server, rest rows are not read
+        return;
+    }
+
+    if (query->isFetchLimited()) { // one portion exceeded buffer limit
+        throw db::Exception(tr("Too big rows in %1").arg(quotedTable));
+    }
+
+    if (!statement.isEmpty()) {
+        stream << statement << ";\n";
+    }
+
+    stream.flush();
+    if (stream.status() != QTextStream::Ok) {
+        throw db::Exception(tr("Failed to write temporary file for dump"));
+    }
+
+    emit progressMessage(tr("Dumped %1: %2 rows")
+                         .arg(quotedTable)
+                         .arg(helpers::formatNumber(dumpedRowsCount))
+                         + QChar::LineFeed);
+}
+
+void MySQLDumper::setRunningQuery(const db::QueryPtr & query, bool isRunning)
+{
+    QMutexLocker locker(&_queriesMutex);
+    if (isRunning) {
+        _runningQueries.append(query);
+        if (_isAborted) {
+            query->abortFetching(); // cancelled while executing
+        }
+    } else {
+        _runningQueries.removeOne(query);
+    }
+}
+
+void MySQLDumper::abortRunningQueries()
+{
+    // thread-safe, kills queries on server so workers don't wait for rows
+    QMutexLocker locker(&_queriesMutex);
+    for (const db::QueryPtr & query : _runningQueries) {
+        query->abortFetching();
+    }
+}
+
+void MySQLDumper::onJobDone(int index)
+{
+    QMutexLocker locker(&_writeMutex);
+
+    _parts[static_cast<std::size_t>(index)].isDone = true;
+
+    try {
+        writeReadyParts();
+    } catch(meow::db::Exception & ex) {
+        fail(ex.message());
+    }
+}
+
+void MySQLDumper::writeReadyParts()
+{
+    // parts are done in any order, but are written in order of jobs
+    while (_nextPartToWrite < static_cast<int>(_parts.size())
+           && _parts[static_cast<std::size_t>(_nextPartToWrite)].isDone) {
+
+        std::size_t index = static_cast<std::size_t>(_nextPartToWrite++);
+        Part & part = _parts[index];
+        const Job & job = _jobs[index];
+
+        if (job.filename != _outputFilename) {
+            closeOutput(true);
+            openOutput(job.filename);
+        }
+
+        if (!part.text.isEmpty()) {
+            *_outputStream << part.text;
+            part.text.clear();
+        }
+
+        if (part.file) {
+            _outputStream->flush(); // keep order with raw data below
+            part.file->seek(0);
+            while (!part.file->atEnd()) {
+                QByteArray block = part.file->read(1024 * 1024);
+                if (_output->write(block) != block.size()) {
+                    throw db::Exception(tr("Failed to write file `%1`: %2")
+                                        .arg(_outputFilename)
+                                        .arg(_output->errorString()));
+                }
+            }
+            part.file.reset(); // removes temp file
+        }
+
+        if (_outputStream->status() != QTextStream::Ok) {
+            throw db::Exception(tr("Failed to write file `%1`")
+                                .arg(_outputFilename));
+        }
+    }
+}
+
+void MySQLDumper::openOutput(const QString & filename)
+{
+    QDir().mkpath(QFileInfo(filename).absolutePath());
+
+    _output.reset(new QFile(filename));
+    if (!_output->open(QFile::WriteOnly | QFile::Truncate)) {
+        _output.reset();
+        throw db::Exception(tr("Unable to open file `%1`").arg(filename));
+    }
+
+    _outputStream.reset(new QTextStream(_output.get()));
+    _outputStream->setCodec("UTF-8");
+    _outputFilename = filename;
+
+    *_outputStream << fileHeader();
+}
+
+void MySQLDumper::closeOutput(bool isComplete)
+{
+    if (!_output) {
+        return;
+    }
+
+    if (isComplete) {
+        *_outputStream << fileFooter();
+    }
+    _outputStream->flush();
+    _outputStream.reset();
+    _output->close();
+    _output.reset();
+    _outputFilename.clear();
+}
+
+void MySQLDumper::fail(const QString & message)
+{
+    meowLogC(Log::Category::Error) << "Dump failed: " << message;
+
+    bool wasFailed = _isFailed.exchange(true);
+    _isAborted = true; // stop other workers
+
+    if (!wasFailed) {
+        emit progressMessage(message + QChar::LineFeed);
+        abortRunningQueries();
+    }
+}
+
+QString MySQLDumper::fileHeader() const
+{
+    QString header;
+    header += "-- " + qApp->applicationName() + ' '
+            + qApp->applicationVersion() + " dump\n";
+    header += "--\n";
+    header += "-- Host: " + _hostName + '\n';
+    header += "-- Server version: " + _serverVersion + '\n';
+    header += "-- ------------------------------------------------------\n\n";
+
+    if (isOptionEnabled(Option::SetCharset)) {
+        header += "/*!40101 SET @OLD_CHARACTER_SET_CLIENT"
+                  "=@@CHARACTER_SET_CLIENT */;\n";
+        header += "/*!40101 SET @OLD_CHARACTER_SET_RESULTS"
+                  "=@@CHARACTER_SET_RESULTS */;\n";
+        header += "/*!40101 SET @OLD_COLLATION_CONNECTION"
+                  "=@@COLLATION_CONNECTION */;\n";
+        header += "/*!40101 SET NAMES utf8 */;\n";
+        header += "/*!50503 SET NAMES utf8mb4 */;\n";
+    }
+    header += "/*!40103 SET @OLD_TIME_ZONE=@@TIME_ZONE */;\n";
+    header += "/*!40103 SET TIME_ZONE='+00:00' */;\n";
+    header += "/*!40014 SET @OLD_UNIQUE_CHECKS=@@UNIQUE_CHECKS,"
+              " UNIQUE_CHECKS=0 */;\n";
+    header += "/*!40014 SET @OLD_FOREIGN_KEY_CHECKS=@@FOREIGN_KEY_CHECKS,"
+              " FOREIGN_KEY_CHECKS=0 */;\n";
+    header += "/*!40101 SET @OLD_SQL_MODE=@@SQL_MODE,"
+              " SQL_MODE='NO_AUTO_VALUE_ON_ZERO' */;\n";
+    header += "/*!40111 SET @OLD_SQL_NOTES=@@SQL_NOTES, SQL_NOTES=0 */;\n";
+
+    return header;
+}
+
+QString MySQLDumper::fileFooter() const
+{
+    QString footer = "\n";
+    footer += "/*!40103 SET TIME_ZONE=@OLD_TIME_ZONE */;\n";
+    footer += "/*!40101 SET SQL_MODE=@OLD_SQL_MODE */;\n";
+    footer += "/*!40014 SET FOREIGN_KEY_CHECKS=@OLD_FOREIGN_KEY_CHECKS */;\n";
+    footer += "/*!40014 SET UNIQUE_CHECKS=@OLD_UNIQUE_CHECKS */;\n";
+    if (isOptionEnabled(Option::SetCharset)) {
+        footer += "/*!40101 SET CHARACTER_SET_CLIENT"
+                  "=@OLD_CHARACTER_SET_CLIENT */;\n";
+        footer += "/*!40101 SET CHARACTER_SET_RESULTS"
+                  "=@OLD_CHARACTER_SET_RESULTS */;\n";
+        footer += "/*!40101 SET COLLATION_CONNECTION"
+                  "=@OLD_COLLATION_CONNECTION */;\n";
+    }
+    footer += "/*!40111 SET SQL_NOTES=@OLD_SQL_NOTES */;\n\n";
+    footer += "-- Dump completed on "
+            + QDateTime::currentDateTime().toString("yyyy-MM-dd HH:mm:ss")
+            + '\n';
+    return footer;
+}
+
+QString MySQLDumper::filenameFor(const QString & database,
+                                 const QString & table) const
+{
+    if (!isOptionEnabled(Option::FilePerTable)) {
+        return _filename;
+    }
+
+    // <dir>/<database>.sql for CREATE DATABASE, <database>.<table>.sql
+    QFileInfo info(_filename);
+    QString filename = info.absolutePath() + '/' + info.completeBaseName()
+            + '/' + safeFileName(database);
+    if (!table.isEmpty()) {
+        filename += '.' + safeFileName(table);
+    }
+    return filename + ".sql";
+}
+
+QString MySQLDumper::objectsFilenameFor(const QString & database) const
+{
+    if (!isOptionEnabled(Option::FilePerTable)) {
+        return _filename;
+    }
+
+    // views, triggers, routines and events, to be loaded after tables
+    QFileInfo info(_filename);
+    return info.absolutePath() + '/' + info.completeBaseName()
+            + '/' + safeFileName(database) + "-objects.sql";
+}
+
+QString MySQLDumper::quotedName(db::Connection * connection,
+                                const QString & database,
+                                const QString & name) const
+{
+    return connection->quoteIdentifier(database)
+            + '.' + connection->quoteIdentifier(name);
+}
+
+QString MySQLDumper::escapeValue(const QString & value) const
+{
+    QString result;
+    result.reserve(value.size() + 2);
+    result += '\'';
+    for (const QChar & c : value) {
+        switch (c.unicode()) {
+        case 0:
+            result += QLatin1String("\\0");
+            break;
+        case '\n':
+            result += QLatin1String("\\n");
+            break;
+        case '\r':
+            result += QLatin1String("\\r");
+            break;
+        case 0x1A:
+            result += QLatin1String("\\Z");
+            break;
+        case '\\':
+            result += QLatin1String("\\\\");
+            break;
+        case '\'':
+            result += QLatin1String("\\'");
+            break;
+        default:
+            result += c;
+        }
+    }
+    result += '\'';
+    return result;
+}
+
+QString MySQLDumper::hexValue(const QString & bytes) const
+{
+    if (bytes.isEmpty()) {
+        return QString("''");
+    }
+    // binary and BIT values are kept as Latin-1, one char per byte, see
+    // MySQLQueryResult::appendRowTo()
+    return "0x" + QString::fromLatin1(bytes.toLatin1().toHex());
+}
+
+} // namespace exporting
+} // namespace utils
+} // namespace meow
@@ -0,0 +1,208 @@
+#ifndef UTILS_EXPORTING_MYSQL_DUMPER_H
+#define UTILS_EXPORTING_MYSQL_DUMPER_H
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <QFile>
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QTemporaryFile>
+#include <QTextStream>
+#include "db/common.h"
+#include "db/entity/entity.h"
+#include "db/query.h"
+#include "threads/dump_task.h"
+
+namespace meow {
+
+namespace db {
+class Connection;
+class DataBaseEntity;
+using ConnectionPtr = std::shared_ptr<Connection>;
+}
+
+namespace ui {
+namespace presenters {
+
+class ExportDatabaseForm;
+enum class MySQLDumpOption;
+
+}
+}
+
+namespace utils {
+namespace exporting {
+
+// Intent: dumps MySQL databases as SQL without external mysqldump.
+// Tables are read in parallel by own connections inside one consistent
+// snapshot, big tables are split into primary key ranges. Dump parts are
+// written in order to one file or to a file per table. Steps run as
+// DumpTask in threads of dump connections on copies of form options and
+// of objects to dump.
+class MySQLDumper : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit MySQLDumper(ui::presenters::ExportDatabaseForm * form);
+
+    ~MySQLDumper() override;
+
+    void start();
+    bool cancel();
+
+    bool isRunning() const { return _isRunning; }
+
+    QString summary() const; // what is dumped and where
+
+    Q_SIGNAL void finished(bool success);
+    Q_SIGNAL void progressMessage(const QString & str);
+
+    // dump threads, see DumpTask
+    void prepare(db::Connection * connection);
+    void runWorker(db::Connection * connection);
+    void finish(db::Connection * connection);
+
+private:
+
+    class RunningQueryScope;
+
+    enum class JobType {
+        Text,
+        CreateDatabase,
+        CreateEntity,
+        TableData,
+        Events
+    };
+
+    // one piece of dump, pieces are written in order of jobs
+    struct Job
+    {
+        JobType type = JobType::Text;
+        QString text;
+        QString database;
+        db::EntityPtr entity;
+        QString where; // range of table rows, all rows if empty
+        QString filename; // output of part
+    };
+
+    struct Part
+    {
+        bool isDone = false;
+        QString text;
+        std::unique_ptr<QTemporaryFile> file; // table rows
+    };
+
+    struct DatabaseObjects
+    {
+        QString name;
+        // copies of session tree objects, only dumper uses them
+        std::shared_ptr<db::DataBaseEntity> holder;
+        QList<db::EntityPtr> tables;
+        QList<db::EntityPtr> views;
+        QList<db::EntityPtr> triggers;
+        QList<db::EntityPtr> routines;
+    };
+
+    using Option = ui::presenters::MySQLDumpOption;
+
+    bool isOptionEnabled(Option option) const {
+        return (_options & static_cast<uint32_t>(option))
+                == static_cast<uint32_t>(option);
+    }
+
+    Q_SLOT void onTaskFinished();
+    void postTask(db::Connection * connection,
+                  threads::DumpTask::Step step);
+    void onRunFinished();
+
+    void collectObjects();
+    void openConnections();
+
+    // dump threads
+    void startSnapshot();
+    void lockTables();
+    void planJobs(db::Connection * connection);
+    QHash<QString, db::ulonglong> estimatedTableRows(
+            db::Connection * connection,
+            const QString & database);
+    void planTableData(db::Connection * connection,
+                       const DatabaseObjects & database,
+                       int tableIndex,
+                       db::ulonglong estimatedRows,
+                       const QString & filename);
+    QStringList primaryKeyRanges(db::Connection * connection,
+                                 const QString & quotedTable,
+                                 db::ulonglong estimatedRows);
+    void addText(db::Connection * connection,
+                 const QString & filename,
+                 const QString & database,
+                 const QString & text);
+    void addJob(db::Connection * connection, const Job & job);
+    void runJob(db::Connection * connection, const Job & job, Part * part);
+    QString createDatabaseSQL(db::Connection * connection, const Job & job);
+    QString createEntitySQL(db::Connection * connection, const Job & job);
+    QString createEventsSQL(db::Connection * connection, const Job & job);
+    void dumpTableData(db::Connection * connection,
+                       const Job & job,
+                       Part * part);
+    void setRunningQuery(const db::QueryPtr & query, bool isRunning);
+    void abortRunningQueries();
+    void onJobDone(int index);
+    void writeReadyParts();
+    void openOutput(const QString & filename);
+    void closeOutput(bool isComplete);
+    void fail(const QString & message);
+
+    QString fileHeader() const;
+    QString fileFooter() const;
+    QString filenameFor(const QString & database,
+                        const QString & table = QString()) const;
+    QString objectsFilenameFor(const QString & database) const;
+    QString quotedName(db::Connection * connection,
+                       const QString & database,
+                       const QString & name) const;
+    QString escapeValue(const QString & value) const;
+    QString hexValue(const QString & bytes) const;
+
+    ui::presenters::ExportDatabaseForm * _form;
+
+    // copied from form and session when dump starts
+    uint32_t _options;
+    QString _filename;
+    QString _hostName;
+    QString _characterSet;
+
+    std::vector<DatabaseObjects> _databases;
+    std::vector<db::ConnectionPtr> _connections;
+    std::vector<Job> _jobs;
+    std::vector<Part> _parts;
+    std::atomic<int> _nextJobIndex;
+    QString _plannedFilename;
+    QString _plannedDatabase;
+    QString _serverVersion;
+    bool _isGlobalLockHeld; // FLUSH TABLES WITH READ LOCK till the end
+    bool _isEachConnectionLocked; // LOCK TABLES in every connection
+    int _workersRunning;
+
+    std::atomic<bool> _isRunning;
+    std::atomic<bool> _isAborted;
+    std::atomic<bool> _isFailed;
+
+    QMutex _queriesMutex; // guards queries below
+    QList<db::QueryPtr> _runningQueries; // to kill them on cancel
+
+    QMutex _writeMutex; // guards parts and output below
+    int _nextPartToWrite;
+    QString _outputFilename;
+    std::unique_ptr<QFile> _output;
+    std::unique_ptr<QTextStream> _outputStream;
+};
+
+} // namespace exporting
+} // namespace utils
+} // namespace meow
+
+#endif // UTILS_EXPORTING_MYSQL_DUMPER_H
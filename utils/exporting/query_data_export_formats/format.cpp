@@ -1,5 +1,5 @@
 #include "format.h"
-#include "ui/models/base_data_table_model.h"
+#include "db/query_data.h"
 #include <QCoreApplication>
 
 namespace meow {
@@ -8,27 +8,26 @@ namespace exporting {
 
 QString QueryDataExportFormat::headerName(int col) const
 {
-    Q_ASSERT(_model);
-    return _model->headerData(col, Qt::Horizontal, Qt::DisplayRole).toString();
+    Q_ASSERT(_data);
+    return _data->columnName(col);
 }
 
 QString QueryDataExportFormat::data(int row, int col) const
 {
-    Q_ASSERT(_model);
-    return _model->data(_model->createIndexForRowCol(row, col),
-                        Qt::DisplayRole).toString();
+    Q_ASSERT(_data);
+    return _data->displayDataAt(row, col);
 }
 
 bool QueryDataExportFormat::isNull(int row, int col) const
 {
-    Q_ASSERT(_model);
-    return _model->isNullAt(row, col);
+    Q_ASSERT(_data);
+    return _data->isNullAt(row, col);
 }
 
 bool QueryDataExportFormat::isNumericDataType(int col) const
 {
-    Q_ASSERT(_model);
-    db::DataTypeCategoryIndex type = _model->typeCategoryForColumn(col);
+    Q_ASSERT(_data);
+    db::DataTypeCategoryIndex type = _data->columnDataTypeCategory(col);
     return type == db::DataTypeCategoryIndex::Integer
         || type == db::DataTypeCategoryIndex::Float;
 }
@@ -63,12 +62,12 @@ QString QueryDataExportFormat::appNameWithVersion() const
 int QueryDataExportFormat::nextVisibleColumn(int curIndex) const {
 
     if (curIndex < -1) return -1;
-    if (curIndex+1 > _model->columnCount()-1) return -1;
+    if (curIndex+1 > _data->columnCount()-1) return -1;
 
     ++curIndex; // result == next
 
     if (isIncludeAutoIncrementColumn() == false) {
-        if (_model->columnIsAutoIncrement(curIndex)) {
+        if (_data->columnIsAutoIncrement(curIndex)) {
             // skip auto incr column
             // recursion won't be deep for typical table or query
             return nextVisibleColumn(curIndex + 1);
@@ -79,7 +78,7 @@ int QueryDataExportFormat::nextVisibleColumn(int curIndex) const {
 }
 
 int QueryDataExportFormat::totalColumnsCount() const {
-    return _model->columnCount();
+    return _data->columnCount();
 }
 
 } // namespace exporting
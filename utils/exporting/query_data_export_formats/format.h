@@ -11,10 +11,8 @@
 
 namespace meow {
 
-namespace ui {
-namespace models {
-class BaseDataTableModel;
-}
+namespace db {
+class QueryData;
 }
 
 namespace utils {
@@ -29,7 +27,8 @@ public:
         FieldSeparator,
         Encloser,
         LineTerminator,
-        NullValue
+        NullValue,
+        MaxStatementSize // bytes of multi-row statement, 0 - row per statement
     };
 
     using OptionsValueMap = QMap<OptionsValue, QString>;
@@ -97,9 +96,14 @@ public:
     QString nullValue() const {
         return optionValue(OptionsValue::NullValue);
     }
+    int maxStatementSize() const {
+        return optionValue(OptionsValue::MaxStatementSize).toInt();
+    }
 
-    void setData(ui::models::BaseDataTableModel * model) {
-        _model = model;
+    // Formats read rows of current result of data directly, so they can be
+    // used both for grid models and for headless exports
+    void setData(db::QueryData * data) {
+        _data = data;
     }
 
     void setOptionValue(OptionsValue option, const QString & value) {
@@ -181,7 +185,8 @@ public:
             OptionsValue::FieldSeparator,
             OptionsValue::Encloser,
             OptionsValue::LineTerminator,
-            OptionsValue::NullValue
+            OptionsValue::NullValue,
+            OptionsValue::MaxStatementSize
         };
     }
 
@@ -223,7 +228,7 @@ protected:
 
     int nextVisibleColumn(int curIndex) const;
 
-    ui::models::BaseDataTableModel * _model = nullptr;
+    db::QueryData * _data = nullptr;
     OptionsValueMap _optionsValue;
     OptionsBoolSet _optionsBool;
     QString _sourceName;
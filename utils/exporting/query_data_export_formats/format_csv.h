@@ -2,7 +2,7 @@
 #define MEOW_UTILS_EXPORTING_QUERY_DATA_EXPORT_FORMAT_CSV_H
 
 #include "format.h"
-#include "ui/models/base_data_table_model.h"
+#include "db/query_data.h"
 
 namespace meow {
 namespace utils {
@@ -46,14 +46,14 @@ public:
 
     virtual QString row(int indexRow) const override {
 
-        Q_ASSERT(_model);
+        Q_ASSERT(_data);
 
         QStringList colsData;
 
         int col = -1;
         while ((col = nextVisibleColumn(col)) != -1) {
             QString colData;
-            if (_model->isNullAt(indexRow, col)) {
+            if (isNull(indexRow, col)) {
                 colData = nullValue();
             } else {
                 colData = data(indexRow, col);
@@ -3,7 +3,7 @@
 
 #include "format.h"
 #include <QDateTime>
-#include "ui/models/base_data_table_model.h"
+#include "db/query_data.h"
 
 namespace meow {
 namespace utils {
@@ -105,7 +105,7 @@ public:
 
     virtual QString row(int indexRow) const override {
 
-        Q_ASSERT(_model);
+        Q_ASSERT(_data);
 
         const QString LE = lineTerminator();
         QString r = "        <tr>" + LE;
@@ -113,7 +113,7 @@ public:
         int col = -1;
         while ((col = nextVisibleColumn(col)) != -1) {
             QString colData;
-            if (_model->isNullAt(indexRow, col)) {
+            if (isNull(indexRow, col)) {
                 colData = nullValue();
             } else {
                 colData = data(indexRow, col);
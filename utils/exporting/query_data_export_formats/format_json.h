@@ -2,7 +2,7 @@
 #define MEOW_UTILS_EXPORTING_QUERY_DATA_EXPORT_FORMAT_JSON_H
 
 #include "format.h"
-#include "ui/models/base_data_table_model.h"
+#include "db/query_data.h"
 #include <QJsonDocument>
 #include <QJsonArray>
 #include <QJsonObject>
@@ -51,7 +51,7 @@ public:
 
     virtual QString row(int indexRow) const override {
 
-        Q_ASSERT(_model);
+        Q_ASSERT(_data);
 
         QJsonObject rowObject;
         QJsonArray rowArray;
@@ -62,7 +62,7 @@ public:
 
             QJsonValue jsonVal(QJsonValue::Null); // null
 
-            if (!_model->isNullAt(indexRow, col)) {
+            if (!isNull(indexRow, col)) {
 
                 QString colData = data(indexRow, col);
 
@@ -2,7 +2,7 @@
 #define MEOW_UTILS_EXPORTING_QUERY_DATA_EXPORT_FORMAT_PHP_ARRAY_H
 
 #include "format.h"
-#include "ui/models/base_data_table_model.h"
+#include "db/query_data.h"
 
 namespace meow {
 namespace utils {
@@ -40,7 +40,7 @@ public:
 
     virtual QString row(int indexRow) const override {
 
-        Q_ASSERT(_model);
+        Q_ASSERT(_data);
 
         const QString LE = lineTerminator();
         QString r = "\tarray(" + LE;
@@ -48,7 +48,7 @@ public:
         int col = -1;
         while ((col = nextVisibleColumn(col)) != -1) {
             QString colData;
-            if (_model->isNullAt(indexRow, col)) {
+            if (isNull(indexRow, col)) {
                 colData = "NULL";
             } else {
                 colData = data(indexRow, col);
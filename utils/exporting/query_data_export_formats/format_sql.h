@@ -2,8 +2,8 @@
 #define MEOW_UTILS_EXPORTING_QUERY_DATA_EXPORT_FORMAT_SQL
 
 #include "format.h"
-#include "ui/models/base_data_table_model.h"
-#include "ui/models/data_table_model.h"
+#include "db/query_data.h"
+#include "db/entity/entity.h"
 
 namespace meow {
 namespace utils {
@@ -17,11 +17,18 @@ public:
         return "sql";
     }
 
-    virtual QString row(int indexRow) const override {
+    virtual QString header() const override {
+        // format is reused by next exports
+        _sqlOperationIntoPartCached.clear();
+        _batchPrefix.clear();
+        _batchValues.clear();
+        _batchSize = 0;
+        return QString();
+    }
 
-        Q_ASSERT(_model);
+    virtual QString row(int indexRow) const override {
 
-        QString sql = sqlOperationIntoPart();
+        Q_ASSERT(_data);
 
         QStringList colsData;
 
@@ -31,21 +38,50 @@ public:
             colsData.push_back(colData);
         }
 
-        sql += colsData.join(", ");
-        sql += ");" + lineTerminator();
+        QString values = "(" + colsData.join(", ") + ")";
+
+        int maxSize = maxStatementSize();
+        if (maxSize <= 0) {
+            return sqlBeforeRow(indexRow)
+                    + sqlOperationIntoPart() + " " + values
+                    + ";" + lineTerminator();
+        }
+
+        // rows are grouped into multi-row statements, each one is kept
+        // under max size like under max_allowed_packet of server
+        QString sql;
+        int valuesSize = utf8Size(values) + utf8Size(lineTerminator()) + 1;
+        if (!_batchValues.isEmpty() && _batchSize + valuesSize > maxSize) {
+            sql = flushBatch();
+        }
+
+        if (_batchValues.isEmpty()) {
+            _batchValues = sqlOperationIntoPart() + lineTerminator() + values;
+            _batchSize = utf8Size(_batchValues) + 1;
+        } else {
+            _batchValues += "," + lineTerminator() + values;
+            _batchSize += valuesSize;
+        }
+        _batchPrefix += sqlBeforeRow(indexRow);
 
         return sql;
     }
 
+    virtual QString footer() const override {
+        return flushBatch();
+    }
+
     virtual OptionsValueMap defaultOptionsValue() const override {
         return {
             {OptionsValue::LineTerminator, QString("\r\n")},
+            {OptionsValue::MaxStatementSize, QString::number(1024 * 1024)},
         };
     }
 
     virtual OptionsValueSet editableOptionsValue() const override {
         return {
-            OptionsValue::LineTerminator
+            OptionsValue::LineTerminator,
+            OptionsValue::MaxStatementSize
         };
     }
 
@@ -68,30 +104,36 @@ protected:
 
     virtual QString sqlOperation() const = 0;
 
+    // statements that go before statement with row
+    virtual QString sqlBeforeRow(int row) const {
+        Q_UNUSED(row);
+        return QString();
+    }
+
     QString sqlQuoteId(const QString & str) const {
-        return _model->connection()->quoteIdentifier(str);
+        return _data->query()->connection()->quoteIdentifier(str);
     }
 
     QString sqlEscapeStr(const QString & str) const {
-        return _model->connection()->escapeString(str);
+        return _data->query()->connection()->escapeString(str);
     }
 
     QString sqlTableName() const {
-        Q_ASSERT(_model);
-        auto tableData = dynamic_cast<ui::models::DataTableModel *>(_model);
-        if (tableData != nullptr) {
-            return tableData->entity()->name();
+        Q_ASSERT(_data);
+        db::Entity * entity = _data->query()->entity();
+        if (entity != nullptr) {
+            return entity->name();
         } else {
             return "UnknownTable";
         }
     }
 
     QString sqlColumnName(int col) const {
-        return _model->queryData()->columnName(col);
+        return _data->columnName(col);
     }
 
     QString sqlData(int row, int col) const {
-        Q_ASSERT(_model);
+        Q_ASSERT(_data);
         if (isNull(row, col)) {
             return "NULL";
         }
@@ -100,9 +142,9 @@ protected:
 
         // TODO: move db-specific formatting to specific
         // NativeQueryResult subclass?
-        if (_model->connection()->connectionParams()->serverType()
+        if (_data->query()->connection()->connectionParams()->serverType()
                 == db::ServerType::MySQL) {
-            if (_model->queryData()->dataTypeForColumn(col)->index
+            if (_data->dataTypeForColumn(col)->index
                     == meow::db::DataTypeIndex::Bit) {
                 return "b" + data;
             }
@@ -112,11 +154,39 @@ protected:
     }
 
     QString sqlWhereForRow(int row) const {
-        return _model->queryData()->whereForRow(row);
+        return _data->whereForRow(row);
     }
 
 private:
 
+    QString flushBatch() const
+    {
+        if (_batchValues.isEmpty()) {
+            return QString();
+        }
+        QString sql = _batchPrefix + _batchValues + ";" + lineTerminator();
+        _batchPrefix.clear();
+        _batchValues.clear();
+        _batchSize = 0;
+        return sql;
+    }
+
+    static int utf8Size(const QString & str)
+    {
+        int size = 0;
+        for (const QChar & c : str) {
+            ushort code = c.unicode();
+            if (code < 0x80) {
+                size += 1;
+            } else if (code < 0x800 || c.isSurrogate()) {
+                size += 2; // surrogate pair is 4 bytes
+            } else {
+                size += 3;
+            }
+        }
+        return size;
+    }
+
     QString sqlOperationIntoPart() const
     {
         if (!_sqlOperationIntoPartCached.isEmpty()) {
@@ -139,7 +209,7 @@ private:
             sql += " (" + sqlColumnNames.join(", ") + ")";
         }
 
-        sql += " VALUES (";
+        sql += " VALUES";
 
         _sqlOperationIntoPartCached = sql;
 
@@ -147,6 +217,9 @@ private:
     }
 
     mutable QString _sqlOperationIntoPartCached;
+    mutable QString _batchPrefix;
+    mutable QString _batchValues;
+    mutable int _batchSize = 0;
 };
 
 
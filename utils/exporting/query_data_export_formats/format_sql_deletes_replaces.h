@@ -21,15 +21,17 @@ public:
         return QObject::tr("SQL DELETEs/INSERTs");
     }
 
-    virtual QString row(int indexRow) const override {
+protected:
+
+    // with multi-row INSERT all DELETEs of its rows go first
+    virtual QString sqlBeforeRow(int indexRow) const override {
 
         QString deleteSql = "DELETE FROM ";
         deleteSql += sqlQuoteId(sqlTableName());
         deleteSql += " WHERE " + sqlWhereForRow(indexRow);
         deleteSql += ";" + lineTerminator();
 
-        return deleteSql
-            + QueryDataExportFormatSQLInserts::row(indexRow);
+        return deleteSql;
     }
 };
 
@@ -2,7 +2,7 @@
 #define MEOW_UTILS_EXPORTING_QUERY_DATA_EXPORT_FORMAT_WIKI_H
 
 #include "format.h"
-#include "ui/models/base_data_table_model.h"
+#include "db/query_data.h"
 
 namespace meow {
 namespace utils {
@@ -49,7 +49,7 @@ public:
 
     virtual QString row(int indexRow) const override {
 
-        Q_ASSERT(_model);
+        Q_ASSERT(_data);
 
         const QString LE = lineTerminator();
         QString r = "|| ";
@@ -57,7 +57,7 @@ public:
         int col = -1;
         while ((col = nextVisibleColumn(col)) != -1) {
             QString colData;
-            if (!_model->isNullAt(indexRow, col)) {
+            if (!isNull(indexRow, col)) {
                 colData = data(indexRow, col);
 
                 if (!isNumericDataType(col)) {
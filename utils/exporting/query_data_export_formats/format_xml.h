@@ -2,7 +2,7 @@
 #define MEOW_UTILS_EXPORTING_QUERY_DATA_EXPORT_FORMAT_XML_H
 
 #include "format.h"
-#include "ui/models/base_data_table_model.h"
+#include "db/query_data.h"
 
 namespace meow {
 namespace utils {
@@ -63,7 +63,7 @@ public:
 
     virtual QString row(int indexRow) const override {
 
-        Q_ASSERT(_model);
+        Q_ASSERT(_data);
 
         const QString LE = lineTerminator();
 
@@ -78,7 +78,7 @@ public:
                 QString name = _colNamesCache[col];
                 field += " name=\"" + name + '"';
             }
-            if (_model->isNullAt(indexRow, col)) {
+            if (isNull(indexRow, col)) {
                 field += " xsi:nil=\"true\" />" + LE;
             } else {
                 QString colData = data(indexRow, col);
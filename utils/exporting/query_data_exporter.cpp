@@ -1,11 +1,18 @@
 #include "query_data_exporter.h"
 #include "query_data_export_formats/format_factory.h"
 #include "ui/models/data_table_model.h"
+#include "db/connection.h"
+#include "db/connection_pool.h"
+#include "db/entity/table_entity.h"
+#include "threads/db_thread.h"
+#include "threads/data_export_task.h"
+#include "helpers/logger.h"
 
 #include <QTextCodec>
 #include <algorithm> // std::sort
 #include <QGuiApplication>
 #include <QClipboard>
+#include <QEventLoop>
 
 namespace meow {
 namespace utils {
@@ -66,6 +73,27 @@ private:
     std::vector<int> _selectedRows;
 };
 
+// Keeps all rows of table data in memory while they are exported
+class KeepAllRowsLocker
+{
+public:
+    explicit KeepAllRowsLocker(ui::models::DataTableModel * tableData)
+        : _tableData(tableData)
+    {
+        if (_tableData) {
+            _tableData->setKeepAllRows(true);
+        }
+    }
+    ~KeepAllRowsLocker()
+    {
+        if (_tableData) {
+            _tableData->setKeepAllRows(false);
+        }
+    }
+private:
+    ui::models::DataTableModel * _tableData;
+};
+
 QueryDataExporter::QueryDataExporter()
     : QObject()
     , _encoding(defaultFileEncoding())
@@ -158,7 +186,7 @@ void QueryDataExporter::run()
     Q_ASSERT(format);
     if (!format) return;
 
-    format->setData(_model);
+    _isAborted = false;
 
     QString tableName;
 
@@ -171,9 +199,7 @@ void QueryDataExporter::run()
 
     format->setSourceName(tableName);
     format->setEncoding(_encoding);
-    format->setSQLQuery(_model->queryData()->query()->SQL());
-    format->setRowsCount((rowSelection() == RowSelection::Complete)
-                         ? allRowsCount() : selectedRowsCount());
+    format->setOutputFile(nullptr);
 
     if (_tableView) {
         for (int col = 0; col < _model->columnCount(); ++col) {
@@ -181,6 +207,39 @@ void QueryDataExporter::run()
         }
     }
 
+    if (canExportStreamed(tableData)) {
+        runStreamed(tableData, format);
+        return;
+    }
+
+    QueryDataRowsIterator rowsIterator;
+    rowsIterator.setData(_model);
+    if (_rowSelection == RowSelection::Selection) {
+        rowsIterator.setSelectionOnly(_selection);
+    }
+
+    // rows of released pages are read from the model below, so select them
+    // again and don't release any till the end
+    KeepAllRowsLocker keepAllRows(tableData);
+    if (tableData != nullptr && rowsIterator.hasNextRow()) {
+        std::vector<int> rows; // all if complete
+        if (_rowSelection == RowSelection::Selection) {
+            while (rowsIterator.hasNextRow()) {
+                rows.push_back(rowsIterator.getNextRow());
+            }
+            rowsIterator.reset();
+        }
+        tableData->reloadReleasedRows(rows);
+        if (_isAborted) {
+            return;
+        }
+    }
+
+    format->setData(_model->queryData());
+    format->setSQLQuery(_model->queryData()->query()->SQL());
+    format->setRowsCount((rowSelection() == RowSelection::Complete)
+                         ? allRowsCount() : selectedRowsCount());
+
     std::unique_ptr<QFile> file;
     std::unique_ptr<QTextStream> stream;
     QString clipboardString;
@@ -203,20 +262,28 @@ void QueryDataExporter::run()
 
     *stream.get() << format->header();
 
-    QueryDataRowsIterator rowsIterator;
-    rowsIterator.setData(_model);
-    if (_rowSelection == RowSelection::Selection) {
-        rowsIterator.setSelectionOnly(_selection);
-    }
+    qulonglong exportedCount = 0;
 
-    while (rowsIterator.hasNextRow()) {
+    while (rowsIterator.hasNextRow() && !_isAborted) {
         int rowIndex = rowsIterator.getNextRow();
         *stream.get() << format->row(rowIndex);
+        if (++exportedCount % db::DATA_ROWS_PER_STEP == 0) {
+            emit rowsExported(exportedCount);
+        }
         if (rowIndex % 10 == 0) {
             QCoreApplication::processEvents();
         }
     }
 
+    if (_isAborted) {
+        if (file) {
+            stream->flush();
+            file->close();
+            file->remove();
+        }
+        return;
+    }
+
     *stream.get() << format->footer();
 
     stream->flush();
@@ -231,6 +298,98 @@ void QueryDataExporter::run()
 
 }
 
+void QueryDataExporter::abort()
+{
+    _isAborted = true;
+    if (_exportTask) {
+        _exportTask->abort();
+    }
+}
+
+bool QueryDataExporter::canExportStreamed(
+        ui::models::DataTableModel * tableData) const
+{
+    // all rows of table/view are read again from server instead of the model
+    // that may keep only first pages; unsaved edits need the model
+    return _mode == Mode::File
+        && _rowSelection == RowSelection::Complete
+        && tableData != nullptr
+        && tableData->entity() != nullptr
+        && !tableData->isModified();
+}
+
+void QueryDataExporter::runStreamed(ui::models::DataTableModel * tableData,
+                                    const QueryDataExportFormatPtr & format)
+{
+    db::Entity * entity = tableData->entity();
+    db::Connection * connection = entity->connection();
+
+    // don't block main connection while all rows are read
+    db::ConnectionPtr pooledConnection;
+    db::ConnectionPool * pool = connection->pool();
+    if (pool) {
+        try {
+            pooledConnection = pool->acquire(); // nullptr if pool is full
+        } catch(meow::db::Exception & ex) {
+            meowLogCC(Log::Category::Error, connection)
+                << "Pooled connection failed: " << ex.message();
+        }
+    }
+    if (pooledConnection) {
+        connection = pooledConnection.get();
+    }
+
+    QString SQL = tableData->exportSQL();
+    format->setSQLQuery(SQL);
+
+    db::ulonglong rowsCountHint = 0;
+    if (!tableData->isLimited() && !tableData->isFiltered()) {
+        rowsCountHint = static_cast<db::ulonglong>(allRowsCount());
+    } else if (entity->type() == db::Entity::Type::Table
+               && !tableData->isFiltered()) {
+        rowsCountHint = static_cast<db::TableEntity *>(entity)->rowsCount();
+    }
+
+    threads::DbThread * thread = connection->thread();
+
+    std::shared_ptr<threads::DataExportTask> task
+            = thread->createDataExportTask(SQL, entity);
+    task->setFormat(format);
+    task->setFilename(_filename);
+    task->setEncoding(_encoding);
+    task->setRowsCountHint(rowsCountHint);
+
+    QEventLoop loop;
+    bool isFinished = false;
+
+    connect(task.get(), &threads::DataExportTask::rowsExported,
+            this, &QueryDataExporter::rowsExported);
+    connect(task.get(), &threads::ThreadTask::finished,
+            &loop, [&isFinished, &loop]() {
+        isFinished = true;
+        loop.quit();
+    });
+
+    _exportTask = task;
+    if (_isAborted) {
+        task->abort();
+    }
+
+    // without thread task runs and finishes in postTask()
+    thread->postTask(task);
+    if (!isFinished) {
+        loop.exec(); // UI stays responsive, export can be aborted
+    }
+
+    _exportTask.reset();
+    task->disconnect(this);
+    format->setData(nullptr); // data of task is gone
+
+    if (task->isFailed()) {
+        throw db::Exception(task->errorMessage());
+    }
+}
+
 void QueryDataExporter::updateFilenameExtByFormat()
 {
     if (mode() != Mode::File) return;
@@ -5,6 +5,7 @@
 #include <QMap>
 #include <QItemSelectionModel>
 #include <QTableView>
+#include <memory>
 #include "query_data_export_formats/format.h"
 
 namespace meow {
@@ -12,9 +13,14 @@ namespace meow {
 namespace ui {
 namespace models {
 class BaseDataTableModel;
+class DataTableModel;
 }
 }
 
+namespace threads {
+class DataExportTask;
+}
+
 namespace utils {
 namespace exporting {
 
@@ -90,10 +96,12 @@ public:
     int selectedRowsCount() const;
 
     void run();
+    void abort(); // stops running export, partial file is removed
 
     Q_SIGNAL void modeChanged();
     Q_SIGNAL void formatChanged();
     Q_SIGNAL void filenameChanged();
+    Q_SIGNAL void rowsExported(qulonglong count);
 
     static const Mode defaultMode = Mode::Clipboard;
     static const RowSelection defaultRowSelection = RowSelection::Selection;
@@ -102,6 +110,10 @@ private:
 
     void updateFilenameExtByFormat();
 
+    bool canExportStreamed(ui::models::DataTableModel * tableData) const;
+    void runStreamed(ui::models::DataTableModel * tableData,
+                     const QueryDataExportFormatPtr & format);
+
     ui::models::BaseDataTableModel * _model = nullptr;
     QItemSelectionModel * _selection = nullptr;
     QTableView * _tableView = nullptr;
@@ -113,6 +125,9 @@ private:
     QString _formatId = "csv";
 
     QMap<QString, QueryDataExportFormatPtr> _formats;
+
+    std::shared_ptr<threads::DataExportTask> _exportTask;
+    bool _isAborted = false;
 };
 
 } // namespace exporting
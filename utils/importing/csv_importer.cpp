@@ -0,0 +1,222 @@
+#include <algorithm>
+#include "csv_importer.h"
+#include "csv_reader.h"
+#include "db/bulk_loader.h"
+#include "db/connection.h"
+#include "db/entity/table_entity.h"
+#include "db/table_structure.h"
+#include "db/exception.h"
+#include <QObject>
+
+namespace meow {
+namespace utils {
+namespace importing {
+
+CSVImporter::CSVImporter()
+    : _encoding("UTF-8")
+    , _separator(',')
+    , _encloser('"')
+    , _isFirstRowHeader(true)
+    , _table(nullptr)
+    , _expectedFieldsCount(0)
+    , _importedRowsCount(0)
+    , _rejectedRowsCount(0)
+    , _warningsCount(0)
+{
+
+}
+
+CSVImporter::~CSVImporter()
+{
+    // loader rolls back unfinished transaction
+}
+
+void CSVImporter::setTable(db::TableEntity * table)
+{
+    _table = table;
+    table->connection()->parseTableStructure(table);
+    _tableColumns = db::tableColumnNames(table->structure());
+}
+
+void CSVImporter::start(db::Connection * connection)
+{
+    Q_ASSERT(_table != nullptr);
+
+    _importedRowsCount = 0;
+    _rejectedRowsCount = 0;
+    _warningsCount = 0;
+    _issues.clear();
+    _bufferedLines.clear();
+
+    _file.setFileName(_filename);
+    if (!_file.open(QFile::ReadOnly)) {
+        throw db::Exception(
+            QObject::tr("Unable to open file `%1`").arg(_filename));
+    }
+
+    _reader.reset(new CSVReader(&_file));
+    _reader->setEncoding(_encoding);
+    _reader->setFieldSeparator(_separator);
+    _reader->setEncloser(_encloser);
+
+    QStringList header;
+    if (_isFirstRowHeader && !_reader->readRow(&header)) {
+        throw db::Exception(QObject::tr("File `%1` is empty").arg(_filename));
+    }
+
+    mapColumns(header);
+
+    _loader = connection->createBulkLoader(_table, _importedColumns);
+    _loader->begin();
+}
+
+bool CSVImporter::importPortion()
+{
+    Q_ASSERT(_loader);
+
+    QStringList fields;
+    QStringList values;
+    bool isFileEnd = false;
+
+    while (_loader->bufferedRowsCount() < db::BULK_LOAD_ROWS_PER_FLUSH
+           && _loader->bufferSize() < db::BULK_LOAD_MAX_BUFFER_SIZE) {
+
+        if (!_reader->readRow(&fields)) {
+            isFileEnd = true;
+            break;
+        }
+
+        if (fields.size() == 1 && fields.first().isEmpty()) {
+            continue; // blank line
+        }
+
+        if (fields.size() != _expectedFieldsCount) {
+            ++_rejectedRowsCount;
+            addIssue(_reader->lineNumber(),
+                     QObject::tr("Row has %1 fields instead of %2")
+                        .arg(fields.size())
+                        .arg(_expectedFieldsCount),
+                     true);
+            continue;
+        }
+
+        values.clear();
+        for (int index : _fieldIndices) {
+            const QString & field = fields[index];
+            if (!_nullValue.isNull() && field == _nullValue) {
+                values << QString();
+            } else {
+                values << field;
+            }
+        }
+
+        _loader->addRow(values);
+        _bufferedLines.push_back(_reader->lineNumber());
+    }
+
+    flush();
+
+    return !isFileEnd;
+}
+
+void CSVImporter::commit()
+{
+    _loader->commit();
+    _loader.reset();
+    _file.close();
+}
+
+void CSVImporter::rollback()
+{
+    if (_loader) {
+        _loader->rollback();
+        _loader.reset();
+    }
+    _importedRowsCount = 0;
+    _file.close();
+}
+
+int CSVImporter::progressPercent() const
+{
+    qint64 size = _file.size();
+    if (size <= 0 || !_reader) {
+        return 0;
+    }
+    return static_cast<int>(_reader->bytesRead() * 100 / size);
+}
+
+void CSVImporter::mapColumns(const QStringList & headerFields)
+{
+    _fieldIndices.clear();
+    _importedColumns.clear();
+
+    if (headerFields.isEmpty()) { // all table columns in order
+        for (int i = 0; i < _tableColumns.size(); ++i) {
+            _fieldIndices.push_back(i);
+            _importedColumns << _tableColumns[i];
+        }
+        _expectedFieldsCount = _tableColumns.size();
+        return;
+    }
+
+    // fields of unknown columns are skipped
+    for (int i = 0; i < headerFields.size(); ++i) {
+        QString name = headerFields[i].trimmed();
+        for (const QString & column : _tableColumns) {
+            if (QString::compare(column, name, Qt::CaseInsensitive) == 0) {
+                if (!_importedColumns.contains(column)) {
+                    _fieldIndices.push_back(i);
+                    _importedColumns << column;
+                }
+                break;
+            }
+        }
+    }
+
+    if (_importedColumns.isEmpty()) {
+        throw db::Exception(
+            QObject::tr("No column in header of file matches"
+                        " columns of table `%1`").arg(_table->name()));
+    }
+
+    _expectedFieldsCount = headerFields.size();
+}
+
+void CSVImporter::flush()
+{
+    db::ulonglong rowsCount = _bufferedLines.size();
+    if (rowsCount == 0) {
+        return;
+    }
+
+    db::BulkLoader::FlushResult result = _loader->flush();
+
+    // issues are samples, counts are totals of server
+    for (const db::BulkLoader::Issue & issue : result.issues) {
+        qint64 line = 0;
+        if (issue.row >= 0
+                && static_cast<std::size_t>(issue.row) < _bufferedLines.size()) {
+            line = _bufferedLines[static_cast<std::size_t>(issue.row)];
+        }
+        addIssue(line, issue.message, issue.isRejected);
+    }
+
+    db::ulonglong rejectedCount = std::min(rowsCount, result.rejectedCount);
+    _rejectedRowsCount += rejectedCount;
+    _warningsCount += result.warningsCount;
+    _importedRowsCount += rowsCount - rejectedCount;
+    _bufferedLines.clear();
+}
+
+void CSVImporter::addIssue(qint64 line,
+                           const QString & message,
+                           bool isRejected)
+{
+    if (_issues.size() < db::IMPORT_MAX_REPORTED_REJECTS) {
+        _issues.append({line, message, isRejected});
+    }
+}
+
+} // namespace importing
+} // namespace utils
+} // namespace meow
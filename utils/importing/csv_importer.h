@@ -0,0 +1,101 @@
+#ifndef MEOW_UTILS_IMPORTING_CSV_IMPORTER_H
+#define MEOW_UTILS_IMPORTING_CSV_IMPORTER_H
+
+#include <memory>
+#include <vector>
+#include <QFile>
+#include <QList>
+#include <QStringList>
+#include "db/common.h"
+
+namespace meow {
+
+namespace db {
+class Connection;
+class TableEntity;
+class BulkLoader;
+}
+
+namespace utils {
+namespace importing {
+
+class CSVReader;
+
+// Intent: imports rows of CSV file into table portion by portion.
+// CSV columns are mapped to table columns by names of header row or by
+// position, rows are sent by bulk loader of connection in one transaction.
+class CSVImporter
+{
+public:
+
+    struct Issue
+    {
+        qint64 line; // in file, from 1, 0 if unknown
+        QString message;
+        bool isRejected; // or imported with changed values
+    };
+
+    CSVImporter();
+    ~CSVImporter();
+
+    void setFilename(const QString & filename) { _filename = filename; }
+    void setEncoding(const QString & encoding) { _encoding = encoding; }
+    void setFieldSeparator(QChar separator) { _separator = separator; }
+    void setEncloser(QChar encloser) { _encloser = encloser; }
+    // null QString - no NULLs, empty one - empty fields are NULLs
+    void setNullValue(const QString & value) { _nullValue = value; }
+    void setFirstRowIsHeader(bool isHeader) { _isFirstRowHeader = isHeader; }
+
+    // Table and its column names, call in main thread
+    void setTable(db::TableEntity * table);
+
+    // Opens file, maps columns and begins transaction, throws on errors
+    void start(db::Connection * connection);
+    // Loads next portion, returns false when all rows are loaded
+    bool importPortion();
+    void commit();
+    void rollback(); // nothing is imported
+
+    const QStringList & importedColumns() const { return _importedColumns; }
+    db::ulonglong importedRowsCount() const { return _importedRowsCount; }
+    db::ulonglong rejectedRowsCount() const { return _rejectedRowsCount; }
+    db::ulonglong warningsCount() const { return _warningsCount; }
+    const QList<Issue> & issues() const { return _issues; } // first ones
+    int progressPercent() const;
+
+private:
+
+    void mapColumns(const QStringList & headerFields);
+    void flush();
+    void addIssue(qint64 line, const QString & message, bool isRejected);
+
+    QString _filename;
+    QString _encoding;
+    QChar _separator;
+    QChar _encloser;
+    QString _nullValue;
+    bool _isFirstRowHeader;
+
+    db::TableEntity * _table;
+    QStringList _tableColumns;
+
+    QFile _file;
+    std::unique_ptr<CSVReader> _reader;
+    std::unique_ptr<db::BulkLoader> _loader;
+
+    std::vector<int> _fieldIndices; // of CSV for each imported column
+    int _expectedFieldsCount;
+    QStringList _importedColumns;
+    std::vector<qint64> _bufferedLines; // of loader rows
+
+    db::ulonglong _importedRowsCount;
+    db::ulonglong _rejectedRowsCount;
+    db::ulonglong _warningsCount;
+    QList<Issue> _issues;
+};
+
+} // namespace importing
+} // namespace utils
+} // namespace meow
+
+#endif // MEOW_UTILS_IMPORTING_CSV_IMPORTER_H
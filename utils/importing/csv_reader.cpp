@@ -0,0 +1,187 @@
+#include "csv_reader.h"
+#include <algorithm>
+#include <QTextCodec>
+
+namespace meow {
+namespace utils {
+namespace importing {
+
+static const int CSV_READ_BLOCK_SIZE = 1024 * 1024; // bytes
+
+CSVReader::CSVReader(QIODevice * device)
+    : _device(device)
+    , _separator(',')
+    , _encloser('"')
+    , _position(0)
+    , _isDeviceAtEnd(false)
+    , _bytesRead(0)
+    , _lineNumber(0)
+    , _nextLineNumber(1)
+{
+    setEncoding("UTF-8");
+}
+
+CSVReader::~CSVReader()
+{
+
+}
+
+void CSVReader::setEncoding(const QString & encoding)
+{
+    QTextCodec * codec = QTextCodec::codecForName(encoding.toLatin1());
+    if (codec == nullptr) {
+        codec = QTextCodec::codecForName("UTF-8");
+    }
+    // stateful, so multibyte chars may be split between blocks
+    _decoder.reset(codec->makeDecoder());
+}
+
+bool CSVReader::readRow(QStringList * fields)
+{
+    while (true) {
+
+        if (_isDeviceAtEnd && _position >= _buffer.size()) {
+            return false;
+        }
+
+        fields->clear();
+        int lineBreaks = 0;
+        int rowEnd = parseRow(fields, _isDeviceAtEnd, &lineBreaks);
+
+        if (rowEnd >= 0) {
+            _position = rowEnd;
+            _lineNumber = _nextLineNumber;
+            _nextLineNumber += lineBreaks + 1;
+            return true;
+        }
+
+        fillBuffer(); // row is parsed again with more data
+    }
+}
+
+bool CSVReader::fillBuffer()
+{
+    _buffer.remove(0, _position);
+    _position = 0;
+
+    // row longer than block grows next block, so long rows are not
+    // rescanned too many times
+    qint64 blockSize = std::max(CSV_READ_BLOCK_SIZE, _buffer.size());
+
+    QByteArray bytes = _device->read(blockSize);
+    if (bytes.isEmpty()) {
+        _isDeviceAtEnd = true;
+        return false;
+    }
+
+    _bytesRead += bytes.size();
+    _buffer += _decoder->toUnicode(bytes);
+
+    return true;
+}
+
+int CSVReader::parseRow(QStringList * fields,
+                        bool isLastBlock,
+                        int * lineBreaks)
+{
+    const QChar * data = _buffer.constData();
+    const int size = _buffer.size();
+    const ushort separator = _separator.unicode();
+    const ushort encloser = _encloser.unicode();
+    const bool hasEncloser = !_encloser.isNull();
+
+    int i = _position;
+
+    while (true) {
+
+        if (hasEncloser && i < size && data[i].unicode() == encloser) {
+
+            QString field(QLatin1String("")); // not NULL if empty
+            ++i;
+
+            while (true) {
+                int closing = _buffer.indexOf(_encloser, i); // SIMD in Qt
+                if (closing < 0) {
+                    if (!isLastBlock) {
+                        return -1;
+                    }
+                    field += _buffer.midRef(i); // unclosed, take the rest
+                    i = size;
+                    break;
+                }
+                *lineBreaks += static_cast<int>(
+                    std::count(data + i, data + closing, QChar('\n')));
+                field += _buffer.midRef(i, closing - i);
+                if (closing + 1 >= size && !isLastBlock) {
+                    return -1; // next char tells if encloser is doubled
+                }
+                if (closing + 1 < size
+                        && data[closing + 1].unicode() == encloser) {
+                    field += _encloser;
+                    i = closing + 2;
+                    continue;
+                }
+                i = closing + 1;
+                break;
+            }
+
+            // chars after closing encloser are kept like others do
+            int start = i;
+            while (i < size) {
+                ushort c = data[i].unicode();
+                if (c == separator || c == '\n' || c == '\r') {
+                    break;
+                }
+                ++i;
+            }
+            if (i > start) {
+                field += _buffer.midRef(start, i - start);
+            }
+
+            fields->append(field);
+
+        } else {
+
+            int start = i;
+            while (i < size) {
+                ushort c = data[i].unicode();
+                if (c == separator || c == '\n' || c == '\r') {
+                    break;
+                }
+                ++i;
+            }
+
+            fields->append(_buffer.mid(start, i - start));
+        }
+
+        if (i >= size) {
+            return isLastBlock ? size : -1;
+        }
+
+        ushort c = data[i].unicode();
+
+        if (c == separator) {
+            ++i;
+            continue;
+        }
+
+        // \n, \r\n or \r
+        if (c == '\r') {
+            if (i + 1 >= size && !isLastBlock) {
+                return -1;
+            }
+            ++i;
+            if (i < size && data[i].unicode() == '\n') {
+                ++i;
+            }
+        } else {
+            ++i;
+        }
+
+        return i;
+    }
+}
+
+} // namespace importing
+} // namespace utils
+} // namespace meow
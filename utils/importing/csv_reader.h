@@ -0,0 +1,57 @@
+#ifndef MEOW_UTILS_IMPORTING_CSV_READER_H
+#define MEOW_UTILS_IMPORTING_CSV_READER_H
+
+#include <memory>
+#include <QIODevice>
+#include <QStringList>
+#include <QTextDecoder>
+
+namespace meow {
+namespace utils {
+namespace importing {
+
+// Intent: streaming CSV/TSV tokenizer. Device is read and decoded by big
+// blocks, fields are cut from decoded buffer with tight scans for special
+// chars, so there is no per char state machine for plain fields.
+// Enclosed fields may span lines and escape encloser by doubling it.
+class CSVReader
+{
+public:
+    explicit CSVReader(QIODevice * device);
+    ~CSVReader();
+
+    void setEncoding(const QString & encoding);
+    void setFieldSeparator(QChar separator) { _separator = separator; }
+    void setEncloser(QChar encloser) { _encloser = encloser; } // null - none
+
+    // Reads next record, returns false at end of data
+    bool readRow(QStringList * fields);
+
+    qint64 lineNumber() const { return _lineNumber; } // of last row, from 1
+    qint64 bytesRead() const { return _bytesRead; }
+
+private:
+
+    bool fillBuffer(); // appends next block, false at end of data
+
+    // Returns position after row, -1 if buffer ends before row does
+    int parseRow(QStringList * fields, bool isLastBlock, int * lineBreaks);
+
+    QIODevice * _device;
+    std::unique_ptr<QTextDecoder> _decoder;
+    QChar _separator;
+    QChar _encloser;
+
+    QString _buffer;
+    int _position;
+    bool _isDeviceAtEnd;
+    qint64 _bytesRead;
+    qint64 _lineNumber;
+    qint64 _nextLineNumber;
+};
+
+} // namespace importing
+} // namespace utils
+} // namespace meow
+
+#endif // MEOW_UTILS_IMPORTING_CSV_READER_H